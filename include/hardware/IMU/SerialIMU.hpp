@@ -0,0 +1,107 @@
+#pragma once
+
+#include "hardware/IMU/IMU.hpp"
+#include "hardware/serial/SerialPort.hpp"
+#include <atomic>
+#include <cstdint>
+
+namespace lemlib {
+/**
+ * @brief IMU implementation for a custom gyro connected through a SerialPort
+ *
+ * The device sends the unbounded rotation of the gyro on a channel of the port, in standard orientation
+ * (counterclockwise is positive). See SerialPort for the frame format. The device is expected to calibrate itself when
+ * it powers on.
+ */
+class SerialIMU : public IMU {
+    public:
+        /**
+         * @brief Construct a new SerialIMU object
+         *
+         * @param port the port the device is connected to. Must outlive the IMU
+         * @param channel the channel the device sends the rotation on
+         * @param ticksPerRotation the value the device sends for one full counterclockwise rotation
+         * @param timeout how long the IMU can go without sending a value before it is considered disconnected
+         *
+         * @b Example:
+         * @code {.cpp}
+         * lemlib::SerialPort coprocessor(1, 115200);
+         * // gyro sending centidegrees on channel 2
+         * lemlib::SerialIMU imu(&coprocessor, 2, 36000);
+         * @endcode
+         */
+        SerialIMU(SerialPort* port, std::uint8_t channel, int ticksPerRotation = 36000, Time timeout = 100_msec);
+        /**
+         * @brief calibrate the IMU
+         *
+         * The device calibrates itself, so this function does nothing
+         *
+         * @return 0 success
+         */
+        int calibrate() override;
+        /**
+         * @brief check if the IMU is calibrated
+         *
+         * The device only sends values once it is calibrated, so the IMU is calibrated if it is connected
+         *
+         * @return true the IMU is calibrated
+         * @return false the IMU is not calibrated
+         */
+        int isCalibrated() override;
+        /**
+         * @brief check if the IMU is calibrating
+         *
+         * @return true the IMU has not sent a value within the timeout
+         * @return false the IMU is sending values
+         */
+        int isCalibrating() override;
+        /**
+         * @brief whether the IMU is connected
+         *
+         * The IMU is connected if it has sent a value within the timeout
+         *
+         * @return true the IMU is connected
+         * @return false the IMU is not connected
+         */
+        int isConnected() override;
+        /**
+         * @brief Get the rotation of the IMU
+         *
+         * This function uses the following values of errno when an error state is reached:
+         *
+         * ENODEV: the IMU has not sent a value within the timeout
+         *
+         * @return Angle the rotation of the IMU
+         * @return INFINITY error occurred, setting errno
+         */
+        Angle getRotation() override;
+        /**
+         * @brief Set the rotation of the IMU
+         *
+         * The device is not told about the new rotation, an offset is saved instead
+         *
+         * This function uses the following values of errno when an error state is reached:
+         *
+         * ENODEV: the IMU has not sent a value within the timeout
+         *
+         * @param rotation the rotation to set the measured rotation to
+         * @return int 0 success
+         * @return INT_MAX error occurred, setting errno
+         */
+        int setRotation(Angle rotation) override;
+    private:
+        /**
+         * @brief get the latest rotation sent by the device, if it is recent enough
+         *
+         * @return 0 on success
+         * @return INT_MAX on failure, setting errno
+         */
+        int readTicks(std::int32_t& ticks);
+
+        SerialPort* m_port;
+        std::uint8_t m_channel;
+        int m_ticksPerRotation;
+        Time m_timeout;
+        std::atomic<std::int64_t> m_offset = 0; /** ticks added to the value sent by the device */
+};
+} // namespace lemlib
@@ -0,0 +1,227 @@
+#pragma once
+
+#include "hardware/IMU/IMU.hpp"
+#include "hardware/concurrency/Queue.hpp"
+#include "hardware/concurrency/Snapshot.hpp"
+#include "hardware/odom/Odometry.hpp"
+#include "pros/gps.hpp"
+#include "pros/rtos.hpp"
+#include "units/Pose.hpp"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+
+namespace lemlib {
+/**
+ * @brief A pose measured by the V5 GPS Sensor
+ */
+struct GPSReading {
+        units::Pose pose; /** position and heading of the robot on the field, in standard orientation */
+        Length error = 0_m; /** RMS error of the position estimated by the sensor */
+        Time time = 0_sec; /** time the pose is valid at, since PROS initialized */
+};
+
+/**
+ * @brief IMU and pose source implementation for the V5 GPS Sensor
+ *
+ * The GPS measures the heading of the robot, so it can be used as an IMU. It also measures the position of the robot
+ * on the field, with (0, 0) at the center of the field.
+ *
+ * Poses measured by the GPS are already old when they are read, because the sensor needs time to process each camera
+ * frame. If an Odometry object is given, each reading is rolled forward by how much odometry says the robot moved
+ * since the reading was measured. This way, a GPS reading can be compared directly to the current odometry pose.
+ */
+class V5GPS : public IMU {
+    public:
+        /**
+         * @brief Construct a new V5 GPS Sensor
+         *
+         * @param gps the GPS sensor
+         * @param odometry odometry used to compensate for the latency of the sensor, or nullptr. Must outlive the GPS
+         * @param latency the time between the GPS measuring a pose and the pose being read
+         *
+         * @b Example:
+         * @code {.cpp}
+         * void initialize() {
+         *    // Create a new V5 GPS Sensor on port 1
+         *    lemlib::V5GPS gps = pros::Gps(1);
+         * }
+         * @endcode
+         */
+        V5GPS(pros::Gps gps, Odometry* odometry = nullptr, Time latency = 0_sec);
+        /**
+         * @brief calibrate the V5 GPS Sensor
+         *
+         * The GPS calibrates itself when it powers on, so this function does nothing
+         *
+         * @return 0 upon success
+         */
+        int calibrate() override;
+        /**
+         * @brief check if the V5 GPS Sensor is calibrated
+         *
+         * @return true the GPS is calibrated
+         * @return false the GPS is not calibrated
+         */
+        int isCalibrated() override;
+        /**
+         * @brief check if the V5 GPS Sensor is calibrating
+         *
+         * @return true the GPS is calibrating
+         * @return false the GPS is not calibrating
+         */
+        int isCalibrating() override;
+        /**
+         * @brief whether the V5 GPS Sensor is connected
+         *
+         * @return true the GPS is connected
+         * @return false the GPS is not connected
+         */
+        int isConnected() override;
+        /**
+         * @brief Get the rotation of the V5 GPS Sensor
+         *
+         * This function returns the unbounded heading of the GPS, in standard orientation
+         *
+         * This function uses the following values of errno when an error state is reached:
+         *
+         * ENXIO: The given value is not within the range of V5 ports (1-21).
+         * ENODEV: The port cannot be configured as a GPS
+         * EAGAIN: The sensor is still calibrating
+         *
+         * @return Angle the rotation of the GPS
+         * @return INFINITY if an error occurred, setting errno
+         *
+         * @b Example:
+         * @code {.cpp}
+         * void initialize() {
+         *    lemlib::V5GPS gps = pros::Gps(1);
+         *    const Angle rotation = gps.getRotation();
+         *    if (rotation == from_stDeg(INFINITY)) {
+         *        std::cout << "Error getting rotation!" << std::endl;
+         *    } else {
+         *        std::cout << "Rotation: " << to_stDeg(rotation) << std::endl;
+         *    }
+         * }
+         * @endcode
+         */
+        Angle getRotation() override;
+        /**
+         * @brief Set the rotation of the V5 GPS Sensor
+         *
+         * The GPS measures its heading relative to the field, so the new rotation is stored as an offset, which only
+         * applies to getRotation(). The heading of the pose is not affected.
+         *
+         * This function uses the following values of errno when an error state is reached:
+         *
+         * ENXIO: The given value is not within the range of V5 ports (1-21).
+         * ENODEV: The port cannot be configured as a GPS
+         * EAGAIN: The sensor is still calibrating
+         *
+         * @param rotation the rotation to set the measured rotation to
+         * @return 0 upon success
+         * @return INT_MAX if an error occurred, setting errno
+         */
+        int setRotation(Angle rotation) override;
+        /**
+         * @brief Get the latest pose measured by the GPS
+         *
+         * If the sampler is running, the latest sample is returned, compensated for latency. Otherwise, the sensor is
+         * read directly, and the pose is not compensated, as there is no odometry history to compensate with.
+         *
+         * This function uses the following values of errno when an error state is reached:
+         *
+         * ENXIO: The given value is not within the range of V5 ports (1-21).
+         * ENODEV: The port cannot be configured as a GPS
+         * EAGAIN: The sensor is still calibrating
+         *
+         * @return GPSReading the latest reading
+         * @return GPSReading with an INFINITY error if an error occurred, setting errno
+         *
+         * @b Example:
+         * @code {.cpp}
+         * void opcontrol() {
+         *    const lemlib::GPSReading reading = gps.getReading();
+         *    if (reading.error < 2_in) odom.setPose(reading.pose);
+         * }
+         * @endcode
+         */
+        GPSReading getReading();
+        /**
+         * @brief Start reading the sensor in a sampler task, at the fastest data rate of the sensor
+         *
+         * If the sampler is already running, this function does nothing.
+         *
+         * This function uses the following values of errno when an error state is reached:
+         *
+         * ENXIO: The given value is not within the range of V5 ports (1-21).
+         * ENODEV: The port cannot be configured as a GPS
+         *
+         * @param priority the priority of the sampler task
+         * @return 0 on success
+         * @return INT_MAX on failure, setting errno
+         */
+        int startSampling(std::uint32_t priority = TASK_PRIORITY_MAX - 2);
+        /**
+         * @brief Stop the sampler task
+         *
+         * Samples that have not been read are discarded
+         */
+        void stopSampling();
+        /**
+         * @brief Read the samples taken since the last call, oldest first
+         *
+         * Only one task may read samples. If samples are not read fast enough, new samples are dropped. The buffer
+         * holds SAMPLE_CAPACITY samples.
+         *
+         * @param out where to store the samples
+         * @return std::size_t the number of samples read. 0 if the sampler is not running
+         */
+        std::size_t readSamples(std::span<GPSReading> out);
+        ~V5GPS();
+
+        static constexpr Time DATA_RATE = 5_msec; /** the fastest data rate of the sensor */
+        static constexpr std::size_t SAMPLE_CAPACITY = 32; /** the number of samples the sampler can buffer */
+        static constexpr std::size_t HISTORY_SIZE = 64; /** the number of odometry states kept for compensation */
+    private:
+        /**
+         * @brief state shared with the sampler task
+         */
+        struct Sampler {
+                SPSCQueue<GPSReading, SAMPLE_CAPACITY> samples;
+                Snapshot<GPSReading> latest;
+                std::atomic<bool> running = true;
+                std::optional<pros::Task> task;
+                // odometry states, only accessed by the sampler task
+                std::array<OdomState, HISTORY_SIZE> history {};
+                std::size_t historyCount = 0;
+                std::size_t historyNext = 0;
+        };
+
+        /**
+         * @brief read the pose from the sensor, without compensating for latency
+         *
+         * @return 0 on success
+         * @return INT_MAX on failure, setting errno
+         */
+        int read(GPSReading& reading);
+        /**
+         * @brief the loop run by the sampler task
+         */
+        void sample();
+        /**
+         * @brief roll a reading forward, using the odometry history
+         */
+        units::Pose compensate(const Sampler& sampler, const units::Pose& pose, Time measured, const OdomState& now);
+
+        pros::Gps m_gps;
+        Odometry* m_odometry;
+        Time m_latency;
+        std::atomic<double> m_rotationOffset = 0; /** radians added to the rotation */
+        std::unique_ptr<Sampler> m_sampler;
+};
+} // namespace lemlib
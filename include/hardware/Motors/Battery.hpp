@@ -0,0 +1,45 @@
+#pragma once
+
+#include "units/units.hpp"
+
+namespace lemlib {
+/**
+ * @brief Start sampling the battery in the background, if it isn't sampled already
+ *
+ * Reading the battery directly is slow compared to the rest of a control loop, and the voltage changes slowly, so the
+ * battery is instead sampled every 100 ms by a low priority task, and the samples are smoothed with a low pass filter.
+ * This function reads the battery once, so the voltage is valid right away, and starts the task. It is called when
+ * voltage compensation is enabled, so the first compensated move doesn't have to read the battery or start a task.
+ *
+ * @b Example:
+ * @code {.cpp}
+ * void initialize() {
+ *     lemlib::startBatterySampling();
+ * }
+ * @endcode
+ */
+void startBatterySampling();
+
+/**
+ * @brief Get the voltage of the battery, measured in the background
+ *
+ * If the battery isn't sampled yet, this function starts sampling it, see startBatterySampling(). After that, this
+ * function only reads the cached voltage, so it never blocks.
+ *
+ * If the battery can't be read, the last valid voltage is kept.
+ *
+ * @return Voltage the filtered battery voltage
+ * @return INFINITY if the battery has never been read successfully
+ *
+ * @b Example:
+ * @code {.cpp}
+ * void opcontrol() {
+ *     while (true) {
+ *         std::cout << "Battery: " << to_volt(lemlib::getBatteryVoltage()) << " V" << std::endl;
+ *         pros::delay(1000);
+ *     }
+ * }
+ * @endcode
+ */
+Voltage getBatteryVoltage();
+} // namespace lemlib
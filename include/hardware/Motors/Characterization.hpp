@@ -0,0 +1,203 @@
+#pragma once
+
+#include "hardware/Motors/MotorGroup.hpp"
+#include "hardware/Motors/VelocityController.hpp"
+#include <cstddef>
+#include <vector>
+
+namespace lemlib {
+/**
+ * @brief Settings of a Characterization
+ */
+struct CharacterizationSettings {
+        Divided<Voltage, Time> rampRate = 0.25_volt / 1_sec; /** how fast the voltage rises in the quasi-static test */
+        Voltage rampVoltage = 7_volt; /** the voltage the quasi-static test stops at */
+        Voltage stepVoltage = 6_volt; /** the voltage of the step test */
+        Time stepDuration = 2_sec; /** how long the step test lasts */
+        Time restDuration = 2_sec; /** how long the mechanism is left to stop between the tests */
+        Time period = 10_msec; /** the expected time between updates, used to size the sample buffer */
+        AngularVelocity minVelocity = 0.05_rps; /** samples slower than this aren't used, as static friction applies */
+};
+
+/**
+ * @brief A measurement taken during a Characterization
+ */
+struct CharacterizationSample {
+        Time time; /** time of the measurement */
+        Voltage voltage; /** the voltage applied */
+        Angle angle; /** the measured angle */
+        AngularVelocity velocity; /** the velocity, calculated when the constants are fit */
+        AngularAcceleration acceleration; /** the acceleration, calculated when the constants are fit */
+        bool step; /** whether the sample is from the step test, or the quasi-static test */
+};
+
+/**
+ * @brief The constants found by a Characterization
+ */
+struct CharacterizationResult {
+        VelocityGains gains; /** the feedforward gains. kP is always 0, as it can't be found this way */
+        Number rSquared; /** how much of the variation in voltage is explained by the gains, from 0 to 1 */
+        std::size_t samples; /** the number of samples used to fit the gains */
+};
+
+/**
+ * @brief Finds the feedforward constants of a motor or motor group
+ *
+ * Two tests are run. In the quasi-static test, the voltage rises slowly, so the acceleration is negligible and the
+ * voltage is explained by kS and kV. In the step test, a constant voltage is applied to a stopped mechanism, so the
+ * acceleration is large and kA can be found. kS, kV and kA are then fit to all the samples by least squares:
+ *
+ * voltage = kS * sign(velocity) + kV * velocity + kA * acceleration
+ *
+ * The samples are stored in a buffer allocated by the constructor, so running the tests doesn't allocate memory. If
+ * the buffer fills up, for example because update() is called more often than the period in the settings, later
+ * samples are ignored.
+ *
+ * This class doesn't read any hardware. update() is called with the angle of the mechanism, and returns the voltage
+ * to apply, so it can be used with a simulated motor on a computer. characterize() runs it on a Motor or MotorGroup.
+ *
+ * The mechanism must be free to move in the positive direction for the whole test. A drivetrain characterized at
+ * 7 volts can travel several tiles.
+ *
+ * @b Example:
+ * @code {.cpp}
+ * // a test built on a computer, with the simulated DC motor from tests/include/SimulatedMotor.hpp
+ * int main() {
+ *     host::SimulatedMotor motor;
+ *     lemlib::Characterization characterization;
+ *     Time time = 0_sec;
+ *     while (!characterization.isFinished()) {
+ *         motor.setVoltage(characterization.update(motor.getAngle(), time));
+ *         motor.simulate(10_msec);
+ *         time += 10_msec;
+ *     }
+ *     const lemlib::CharacterizationResult result = characterization.fit();
+ *     std::cout << "kV: " << to_volt(result.gains.kV * 1_rpm) << " V/rpm" << std::endl;
+ * }
+ * @endcode
+ */
+class Characterization {
+    public:
+        /**
+         * @brief Construct a new Characterization object, and allocate its sample buffer
+         *
+         * @param settings the settings of the tests
+         */
+        Characterization(CharacterizationSettings settings = {});
+        /**
+         * @brief Add a measurement, and get the voltage to apply until the next update
+         *
+         * @param angle the angle of the mechanism
+         * @param time the time of the measurement
+         * @return Voltage the voltage of a V5 motor to apply, 0 once the tests are finished
+         */
+        Voltage update(Angle angle, Time time);
+        /**
+         * @brief Whether both tests are finished
+         *
+         * @return true the tests are finished
+         * @return false the tests are running
+         */
+        bool isFinished() const;
+        /**
+         * @brief Fit the feedforward constants to the samples
+         *
+         * The velocity and acceleration of each sample are calculated here, from the angles of its neighbours.
+         *
+         * This function uses the following values of errno when an error state is reached:
+         *
+         * EDOM: there are too few samples, or they can't tell the constants apart
+         *
+         * @return CharacterizationResult the constants
+         * @return INFINITY for every constant on failure, setting errno
+         */
+        CharacterizationResult fit();
+        /**
+         * @brief Save the samples, and the constants from the last fit(), as a CSV file
+         *
+         * The constants are written as comments at the start of the file. The samples are in seconds, volts and
+         * radians.
+         *
+         * This function uses the errno values of fopen
+         *
+         * @param path the path of the file, for example "/usd/characterization.csv"
+         * @return 0 on success
+         * @return INT_MAX on failure, setting errno
+         */
+        int save(const char* path) const;
+        /**
+         * @brief Get the samples recorded so far
+         *
+         * @return const std::vector<CharacterizationSample>& the samples
+         */
+        const std::vector<CharacterizationSample>& getSamples() const;
+        /**
+         * @brief Clear the samples, so the tests can be run again
+         */
+        void reset();
+    private:
+        enum class Phase { QUASISTATIC, REST, STEP, FINISHED };
+
+        CharacterizationSettings m_settings;
+        std::vector<CharacterizationSample> m_samples;
+        Phase m_phase = Phase::QUASISTATIC;
+        bool m_started = false; /** whether the current phase has started */
+        Time m_phaseStart = 0_sec;
+        CharacterizationResult m_result;
+};
+
+/**
+ * @brief Run a Characterization on a motor, and fit its feedforward constants
+ *
+ * This function blocks until the tests finish, which takes about 32 seconds with the default settings. The motor is
+ * stopped at the end. If voltage compensation is enabled, the constants are for the reference voltage.
+ *
+ * This function uses the following values of errno when an error state is reached:
+ *
+ * ENODEV: the port cannot be configured as a motor
+ *
+ * EDOM: the constants couldn't be fit
+ *
+ * If the file can't be saved, the constants are still returned, and errno is set by fopen
+ *
+ * @param motor the motor to characterize
+ * @param settings the settings of the tests
+ * @param path where to save the samples and constants, or nullptr to not save them
+ * @return CharacterizationResult the constants, for the velocity of the motor
+ * @return INFINITY for every constant on failure, setting errno
+ *
+ * @b Example:
+ * @code {.cpp}
+ * void autonomous() {
+ *     lemlib::Motor motor = pros::Motor(1);
+ *     const lemlib::CharacterizationResult result = lemlib::characterize(motor, {}, "/usd/flywheel.csv");
+ *     motor.setVelocityGains(result.gains);
+ * }
+ * @endcode
+ */
+CharacterizationResult characterize(Motor& motor, CharacterizationSettings settings = {}, const char* path = nullptr);
+/**
+ * @brief Run a Characterization on a motor group, and fit its feedforward constants
+ *
+ * Same as characterize(Motor&), but the constants are for the output velocity of the group, after gearing.
+ *
+ * @param motorGroup the motor group to characterize
+ * @param settings the settings of the tests
+ * @param path where to save the samples and constants, or nullptr to not save them
+ * @return CharacterizationResult the constants, for the output velocity of the group
+ * @return INFINITY for every constant on failure, setting errno
+ *
+ * @b Example:
+ * @code {.cpp}
+ * void autonomous() {
+ *     pros::Motor motor1(1, pros::v5::MotorGears::blue);
+ *     pros::Motor motor2(2, pros::v5::MotorGears::blue);
+ *     lemlib::MotorGroup motorGroup({motor1, motor2}, 450_rpm);
+ *     const lemlib::CharacterizationResult result = lemlib::characterize(motorGroup, {}, "/usd/drive.csv");
+ *     motorGroup.setVelocityGains(result.gains);
+ * }
+ * @endcode
+ */
+CharacterizationResult characterize(MotorGroup& motorGroup, CharacterizationSettings settings = {},
+                                    const char* path = nullptr);
+} // namespace lemlib
@@ -0,0 +1,188 @@
+#pragma once
+
+#include "hardware/Motors/MotorGroup.hpp"
+#include "hardware/concurrency/Snapshot.hpp"
+#include "pros/rtos.hpp"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <variant>
+
+namespace lemlib {
+/**
+ * @brief How much a mechanism has been limited by a CurrentBudget
+ */
+struct CurrentBudgetStats {
+        std::uint32_t updates = 0; /** the number of updates since the mechanism was added */
+        std::uint32_t limitedUpdates = 0; /** updates where the mechanism got less current than it wanted */
+        Number lowestFraction = 1_num; /** the smallest fraction of the current it wanted that it got */
+        Number averageFraction = 1_num; /** the average fraction of the current it wanted, over the limited updates */
+        Current limit = 0_amp; /** the current limit of each motor, set by the last update */
+};
+
+/**
+ * @brief Shares the current available to the motors between mechanisms, by priority
+ *
+ * The V5 brain limits the total current of all motors, and when it is exceeded, the motors are throttled without
+ * regard for what they are doing. A CurrentBudget instead sets the current limit of each motor itself, so the total
+ * stays under the budget, and the mechanisms which matter most keep their torque.
+ *
+ * Every update, the current of each motor is read once. A mechanism which is drawing close to its limit is assumed to
+ * want its maximum current, otherwise it wants what it is drawing. The budget is then given out from the highest
+ * priority down. If a priority level wants less than what is left, each of its motors gets what it wants, plus up to
+ * 0.25 amps of headroom so it can speed up, as far as what is left allows. A motor which uses its headroom draws close
+ * to its limit, so it gets its maximum current in the next update if the budget allows it. Otherwise, what is left is
+ * shared between the mechanisms of the level in proportion to what they want, and lower priorities get no current
+ * while this lasts. This way, the current limits of all the motors never add up to more than the budget.
+ *
+ * Every motor in a MotorGroup gets the same limit, as they share the load of the mechanism.
+ *
+ * @b Example:
+ * @code {.cpp}
+ * pros::Motor left1(1, pros::v5::MotorGears::blue);
+ * pros::Motor left2(2, pros::v5::MotorGears::blue);
+ * pros::Motor right1(-3, pros::v5::MotorGears::blue);
+ * pros::Motor right2(-4, pros::v5::MotorGears::blue);
+ * lemlib::MotorGroup leftDrive({left1, left2}, 450_rpm);
+ * lemlib::MotorGroup rightDrive({right1, right2}, 450_rpm);
+ * lemlib::Motor intake = pros::Motor(5);
+ * lemlib::CurrentBudget budget(8_amp);
+ *
+ * void initialize() {
+ *     // the drivetrain keeps its torque, the intake gets what is left
+ *     budget.add(&leftDrive, 1);
+ *     budget.add(&rightDrive, 1);
+ *     const int intakeIndex = budget.add(&intake, 0);
+ *     budget.start();
+ *     pros::delay(10000);
+ *     const lemlib::CurrentBudgetStats stats = budget.getStats(intakeIndex);
+ *     std::cout << "intake limited " << stats.limitedUpdates << " times" << std::endl;
+ * }
+ * @endcode
+ */
+class CurrentBudget {
+    public:
+        static constexpr std::size_t MAX_MECHANISMS = 16; /** the maximum number of mechanisms */
+
+        /**
+         * @brief Construct a new CurrentBudget object
+         *
+         * @param budget the total current all the added mechanisms can draw
+         */
+        explicit CurrentBudget(Current budget = 20_amp);
+        /**
+         * @brief Add a motor to the budget
+         *
+         * This function must not be called while the task is running, or from a different task than update().
+         *
+         * This function uses the following values of errno when an error state is reached:
+         *
+         * ENOSPC: there are already MAX_MECHANISMS mechanisms
+         * EEXIST: the motor has already been added
+         *
+         * @param motor the motor. Must outlive the CurrentBudget
+         * @param priority mechanisms with a higher priority get current first
+         * @param maxCurrent the current limit of the motor when it isn't limited by the budget
+         * @return int the index of the mechanism, used by getStats()
+         * @return INT_MAX on failure, setting errno
+         */
+        int add(Motor* motor, int priority, Current maxCurrent = 2.5_amp);
+        /**
+         * @brief Add a motor group to the budget
+         *
+         * This function must not be called while the task is running, or from a different task than update().
+         *
+         * This function uses the following values of errno when an error state is reached:
+         *
+         * ENOSPC: there are already MAX_MECHANISMS mechanisms
+         * EEXIST: the motor group has already been added
+         *
+         * @param motorGroup the motor group. Must outlive the CurrentBudget
+         * @param priority mechanisms with a higher priority get current first
+         * @param maxCurrent the current limit of each motor in the group when it isn't limited by the budget
+         * @return int the index of the mechanism, used by getStats()
+         * @return INT_MAX on failure, setting errno
+         */
+        int add(MotorGroup* motorGroup, int priority, Current maxCurrent = 2.5_amp);
+        /**
+         * @brief Read the current of every motor, and set their current limits
+         *
+         * This function is called by the task. It should only be called directly when the task is not running.
+         */
+        void update();
+        /**
+         * @brief Start the task which updates the current limits
+         *
+         * If the task is already running, this function does nothing
+         *
+         * @param priority the priority of the task
+         * @param period the time between updates
+         */
+        void start(std::uint32_t priority = TASK_PRIORITY_DEFAULT, Time period = 10_msec);
+        /**
+         * @brief Stop the task
+         *
+         * The current limits stay as they were set by the last update
+         */
+        void stop();
+        /**
+         * @brief Set the total current all the added mechanisms can draw
+         *
+         * @param budget the budget
+         */
+        void setBudget(Current budget);
+        /**
+         * @brief Get the total current all the added mechanisms can draw
+         *
+         * @return Current the budget
+         */
+        Current getBudget() const;
+        /**
+         * @brief Get how much a mechanism has been limited
+         *
+         * This function can be called from any task
+         *
+         * This function uses the following values of errno when an error state is reached:
+         *
+         * EINVAL: there is no mechanism with the index
+         *
+         * @param index the index returned by add()
+         * @return CurrentBudgetStats the stats of the mechanism
+         * @return CurrentBudgetStats with 0 updates on failure, setting errno
+         */
+        CurrentBudgetStats getStats(int index) const;
+        /**
+         * @brief Reset the stats of every mechanism
+         *
+         * This function must not be called while the task is running
+         */
+        void resetStats();
+        ~CurrentBudget();
+    private:
+        /**
+         * @brief a mechanism sharing the budget
+         */
+        struct Mechanism {
+                std::variant<Motor*, MotorGroup*> device;
+                int priority = 0;
+                Current maxCurrent = 0_amp; /** the limit of each motor when the budget doesn't limit it */
+                Current limit = 0_amp; /** the limit of each motor, set by the last update */
+                Current wanted = 0_amp; /** the total current the mechanism wants, during an update */
+                int motors = 0; /** the number of connected motors, during an update */
+                CurrentBudgetStats stats; /** only accessed by the task */
+                Snapshot<CurrentBudgetStats> published; /** the stats, for other tasks */
+        };
+
+        int add(std::variant<Motor*, MotorGroup*> device, int priority, Current maxCurrent);
+
+        std::array<Mechanism, MAX_MECHANISMS> m_mechanisms;
+        std::array<std::size_t, MAX_MECHANISMS> m_order {}; /** indices of the mechanisms, highest priority first */
+        std::size_t m_count = 0;
+        std::atomic<double> m_budget; /** amps */
+
+        std::optional<pros::Task> m_task;
+        std::atomic<bool> m_running = false;
+};
+} // namespace lemlib
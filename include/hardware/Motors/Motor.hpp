@@ -1,5 +1,9 @@
 #pragma once
 
+#include "hardware/Motors/SlewLimiter.hpp"
+#include "hardware/Motors/StallDetector.hpp"
+#include "hardware/Motors/ThermalModel.hpp"
+#include "hardware/Motors/VelocityController.hpp"
 #include "hardware/encoder/Encoder.hpp"
 #include "pros/motors.hpp"
 
@@ -30,6 +34,15 @@ class Motor : public Encoder {
         /**
          * @brief move the motor at a percent power from -1.0 to +1.0
          *
+         * If voltage compensation is enabled, the output is scaled by the battery voltage, so the same percent gives
+         * the same speed as the battery drains. See setVoltageCompensation()
+         *
+         * If a thermal model is attached, it is updated, and the output is scaled by its derating. See
+         * setThermalModel()
+         *
+         * If a voltage slew limit is set, the change of the output is limited after the derating and the stall
+         * detector, so reverse pulses ramp too. See setVoltageSlew()
+         *
          * This function uses the following values of errno when an error state is reached:
          *
          * ENODEV: the port cannot be configured as a motor
@@ -55,11 +68,20 @@ class Motor : public Encoder {
         /**
          * @brief move the motor at a given angular velocity
          *
+         * In VelocityMode::INTERNAL, the velocity is rounded to the nearest rpm and controlled by the motor itself.
+         * In VelocityMode::FEEDFORWARD, the voltage is calculated by the motor's VelocityController, so this function
+         * must be called every iteration of the control loop. See setVelocityMode()
+         *
+         * If a velocity slew limit is set, the change of the target velocity is limited, and in
+         * VelocityMode::FEEDFORWARD the acceleration of the limited velocity replaces the given acceleration. See
+         * setVelocitySlew()
+         *
          * This function uses the following values of errno when an error state is reached:
          *
          * ENODEV: the port cannot be configured as a motor
          *
          * @param velocity the target angular velocity to move the motor at
+         * @param acceleration the target angular acceleration, only used in VelocityMode::FEEDFORWARD
          * @return 0 on success
          * @return INT_MAX on failure, setting errno
          *
@@ -76,7 +98,7 @@ class Motor : public Encoder {
          * }
          * @endcode
          */
-        int moveVelocity(AngularVelocity velocity);
+        int moveVelocity(AngularVelocity velocity, AngularAcceleration acceleration = 0_radps2);
         /**
          * @brief brake the motor
          *
@@ -154,6 +176,190 @@ class Motor : public Encoder {
          * @endcode
          */
         BrakeMode getBrakeMode() const;
+        /**
+         * @brief get the current drawn by the motor
+         *
+         * This function uses the following values of errno when an error state is reached:
+         *
+         * ENODEV: the port cannot be configured as a motor
+         *
+         * @return Current the current drawn by the motor
+         * @return INFINITY on failure, setting errno
+         *
+         * @b Example:
+         * @code {.cpp}
+         * void initialize() {
+         *     lemlib::Motor motor = pros::Motor(1);
+         *     std::cout << "Current: " << to_amp(motor.getCurrent()) << " A" << std::endl;
+         * }
+         * @endcode
+         */
+        Current getCurrent() const;
+        /**
+         * @brief set the maximum current the motor can draw
+         *
+         * This function uses the following values of errno when an error state is reached:
+         *
+         * ENODEV: the port cannot be configured as a motor
+         *
+         * @param limit the current limit. V5 motors can't draw more than 2.5 amps
+         * @return 0 on success
+         * @return INT_MAX on failure, setting errno
+         *
+         * @b Example:
+         * @code {.cpp}
+         * void initialize() {
+         *     lemlib::Motor motor = pros::Motor(1);
+         *     // limit the motor to 1.5 amps
+         *     motor.setCurrentLimit(1.5_amp);
+         * }
+         * @endcode
+         */
+        int setCurrentLimit(Current limit);
+        /**
+         * @brief get the maximum current the motor can draw
+         *
+         * This function uses the following values of errno when an error state is reached:
+         *
+         * ENODEV: the port cannot be configured as a motor
+         *
+         * @return Current the current limit
+         * @return INFINITY on failure, setting errno
+         */
+        Current getCurrentLimit() const;
+        /**
+         * @brief get the temperature reported by the motor
+         *
+         * The motor reports its temperature in steps of 5 degrees celsius. See ThermalModel for a prediction which
+         * reacts faster.
+         *
+         * This function uses the following values of errno when an error state is reached:
+         *
+         * ENODEV: the port cannot be configured as a motor
+         *
+         * @return Temperature the temperature of the motor
+         * @return INFINITY on failure, setting errno
+         *
+         * @b Example:
+         * @code {.cpp}
+         * void initialize() {
+         *     lemlib::Motor motor = pros::Motor(1);
+         *     std::cout << "Temperature: " << units::to_celsius(motor.getTemperature()) << " C" << std::endl;
+         * }
+         * @endcode
+         */
+        Temperature getTemperature() const;
+        /**
+         * @brief attach a thermal model to the motor
+         *
+         * Every call to move() reads the current and temperature of the motor to update the model, then scales the
+         * output by ThermalModel::getDeratingScale(). moveVelocity() in VelocityMode::INTERNAL doesn't use move(), so
+         * it doesn't update the model.
+         *
+         * This function does not return a value or set errno, as it is impossible for it to fail
+         *
+         * @param model the thermal model, which must outlive the motor, or nullptr to detach it
+         *
+         * @b Example:
+         * @code {.cpp}
+         * lemlib::ThermalModel thermal;
+         *
+         * void initialize() {
+         *     lemlib::Motor motor = pros::Motor(1);
+         *     // reduce the power from 45 degrees, instead of halving it at 55 degrees
+         *     thermal.setDerating(lemlib::ThermalDerating());
+         *     motor.setThermalModel(&thermal);
+         * }
+         * @endcode
+         */
+        void setThermalModel(ThermalModel* model);
+        /**
+         * @brief get the thermal model attached to the motor
+         *
+         * @return ThermalModel* the thermal model, or nullptr if there is none
+         */
+        ThermalModel* getThermalModel() const;
+        /**
+         * @brief attach a stall detector to the motor
+         *
+         * Every call to move() reads the current and angle of the motor to update the detector, after the output is
+         * derated by the thermal model. While a reverse pulse runs, the motor moves at the voltage of the pulse
+         * instead, and while the detector brakes a stalled motor with StallAction::BRAKE, move() brakes the motor.
+         * moveVelocity() in VelocityMode::INTERNAL doesn't use move(), so it doesn't update the detector.
+         *
+         * This function does not return a value or set errno, as it is impossible for it to fail
+         *
+         * @param detector the stall detector, which must outlive the motor, or nullptr to detach it
+         *
+         * @b Example:
+         * @code {.cpp}
+         * lemlib::StallDetector stall({.action = lemlib::StallAction::BRAKE});
+         *
+         * void initialize() {
+         *     lemlib::Motor motor = pros::Motor(1);
+         *     motor.setStallDetector(&stall);
+         * }
+         * @endcode
+         */
+        void setStallDetector(StallDetector* detector);
+        /**
+         * @brief get the stall detector attached to the motor
+         *
+         * @return StallDetector* the stall detector, or nullptr if there is none
+         */
+        StallDetector* getStallDetector() const;
+        /**
+         * @brief limit how fast the voltage commanded by move() can change
+         *
+         * Sudden reversals draw large current spikes and make wheels slip. The limits are in volts of a V5 motor, and
+         * are applied every time move() is called, so move() should be called periodically, like in a control loop.
+         *
+         * This function does not return a value or set errno, as it is impossible for it to fail
+         *
+         * @param limits the limits, or the default limits to disable slew limiting
+         *
+         * @b Example:
+         * @code {.cpp}
+         * void initialize() {
+         *     lemlib::Motor motor = pros::Motor(1);
+         *     // take half a second to go from 0 to 12 volts, and a quarter of a second to stop
+         *     motor.setVoltageSlew({24_volt / 1_sec, 48_volt / 1_sec});
+         * }
+         * @endcode
+         */
+        void setVoltageSlew(SlewLimits<Voltage> limits);
+        /**
+         * @brief get the limits of the voltage commanded by move()
+         *
+         * @return SlewLimits<Voltage> the limits
+         */
+        SlewLimits<Voltage> getVoltageSlew() const;
+        /**
+         * @brief limit how fast the velocity commanded by moveVelocity() can change
+         *
+         * The limits are applied every time moveVelocity() is called, so it should be called periodically, like in a
+         * control loop.
+         *
+         * This function does not return a value or set errno, as it is impossible for it to fail
+         *
+         * @param limits the limits, or the default limits to disable slew limiting
+         *
+         * @b Example:
+         * @code {.cpp}
+         * void initialize() {
+         *     lemlib::Motor motor = pros::Motor(1);
+         *     // accelerate at up to 10 rotations per second squared, with a jerk of 100 rotations per second cubed
+         *     motor.setVelocitySlew({10_rps2, 10_rps2, 100_rps3});
+         * }
+         * @endcode
+         */
+        void setVelocitySlew(SlewLimits<AngularVelocity> limits);
+        /**
+         * @brief get the limits of the velocity commanded by moveVelocity()
+         *
+         * @return SlewLimits<AngularVelocity> the limits
+         */
+        SlewLimits<AngularVelocity> getVelocitySlew() const;
         /**
          * @brief whether the motor is connected
          *
@@ -335,6 +541,86 @@ class Motor : public Encoder {
          * @endcode
          */
         void setReversed(bool reversed);
+        /**
+         * @brief set the battery voltage that move() is compensated for
+         *
+         * Without compensation, move(1.0) outputs the maximum voltage of the motor, but the voltage the motor can
+         * actually output drops as the battery drains, so the robot slows down over a match. With compensation, the
+         * output of move() is scaled by the reference voltage divided by the battery voltage. The motor then behaves
+         * as if the battery was always at the reference voltage, so move(1.0) gives full power when the battery is at
+         * the reference voltage, and the same speed when the battery is higher. If the battery is lower than the
+         * reference voltage, the output is limited to the maximum voltage of the motor.
+         *
+         * Enabling compensation starts sampling the battery in the background, see startBatterySampling(), so
+         * compensation does not slow down move().
+         *
+         * This function does not return a value or set errno, as it is impossible for it to fail
+         *
+         * @param reference the battery voltage to compensate for, or 0 volts to disable compensation
+         *
+         * @b Example:
+         * @code {.cpp}
+         * void initialize() {
+         *     lemlib::Motor motor = pros::Motor(1);
+         *     // move at the same speed as with an 11.5V battery, no matter the charge
+         *     motor.setVoltageCompensation(11.5_volt);
+         *     motor.move(1.0);
+         * }
+         * @endcode
+         */
+        void setVoltageCompensation(Voltage reference);
+        /**
+         * @brief get the battery voltage that move() is compensated for
+         *
+         * @return Voltage the reference voltage, or 0 volts if compensation is disabled
+         */
+        Voltage getVoltageCompensation() const;
+        /**
+         * @brief set how moveVelocity() controls the velocity of the motor
+         *
+         * In VelocityMode::FEEDFORWARD, moveVelocity() calculates a voltage from the gains set with
+         * setVelocityGains() and the velocity measured from the angle of the motor. This responds to changes in load
+         * much faster than the internal controller of the motor. The velocity estimate is reset when the mode is set.
+         *
+         * This function does not return a value or set errno, as it is impossible for it to fail
+         *
+         * @param mode the velocity mode
+         *
+         * @b Example:
+         * @code {.cpp}
+         * void opcontrol() {
+         *     lemlib::Motor motor = pros::Motor(1, pros::v5::MotorGears::blue);
+         *     motor.setVelocityGains({1.2_volt, 12_volt / 600_rpm, 0.2_volt / 1_rps2, 2_volt / 100_rpm});
+         *     motor.setVelocityMode(lemlib::VelocityMode::FEEDFORWARD);
+         *     while (true) {
+         *         motor.moveVelocity(300_rpm);
+         *         pros::delay(10);
+         *     }
+         * }
+         * @endcode
+         */
+        void setVelocityMode(VelocityMode mode);
+        /**
+         * @brief get how moveVelocity() controls the velocity of the motor
+         *
+         * @return VelocityMode the velocity mode
+         */
+        VelocityMode getVelocityMode() const;
+        /**
+         * @brief set the gains used by moveVelocity() in VelocityMode::FEEDFORWARD
+         *
+         * The gains are for the velocity of the motor, and voltage of a V5 motor. Enabling voltage compensation keeps
+         * them accurate as the battery drains, see setVoltageCompensation()
+         *
+         * @param gains the feedforward and feedback gains
+         */
+        void setVelocityGains(VelocityGains gains);
+        /**
+         * @brief get the gains used by moveVelocity() in VelocityMode::FEEDFORWARD
+         *
+         * @return VelocityGains the gains
+         */
+        VelocityGains getVelocityGains() const;
         /**
          * @brief Get the port the motor is connected to
          *
@@ -363,5 +649,12 @@ class Motor : public Encoder {
          */
         int getAbsoluteCounts();
         pros::Motor m_motor;
+        Voltage m_compensation = 0_volt; /** the battery voltage move() is compensated for, 0 if disabled */
+        VelocityMode m_velocityMode = VelocityMode::INTERNAL;
+        VelocityController m_velocityController;
+        ThermalModel* m_thermalModel = nullptr;
+        StallDetector* m_stallDetector = nullptr;
+        SlewLimiter<Voltage> m_voltageSlew;
+        SlewLimiter<AngularVelocity> m_velocitySlew;
 };
 } // namespace lemlib
\ No newline at end of file
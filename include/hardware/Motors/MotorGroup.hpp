@@ -62,6 +62,12 @@ class MotorGroup : Encoder {
         /**
          * @brief move the motors at a percent power from -1.0 to +1.0
          *
+         * If voltage compensation is enabled, the output of every motor is scaled by the battery voltage, so the same
+         * percent gives the same speed as the battery drains. See setVoltageCompensation()
+         *
+         * If a voltage slew limit is set, the change of the output is limited once for the whole group, after the
+         * stall detector, so reverse pulses ramp too. See setVoltageSlew()
+         *
          * This function uses the following values of errno when an error state is reached:
          *
          * ENODEV: the port cannot be configured as a motor
@@ -91,11 +97,20 @@ class MotorGroup : Encoder {
         /**
          * @brief move the motors at a given angular velocity
          *
+         * In VelocityMode::INTERNAL, the velocity of each motor is rounded to the nearest rpm and controlled by the
+         * motor itself. In VelocityMode::FEEDFORWARD, the voltage is calculated by the group's VelocityController, so
+         * this function must be called every iteration of the control loop. See setVelocityMode()
+         *
+         * If a velocity slew limit is set, the change of the target velocity is limited, and in
+         * VelocityMode::FEEDFORWARD the acceleration of the limited velocity replaces the given acceleration. See
+         * setVelocitySlew()
+         *
          * This function uses the following values of errno when an error state is reached:
          *
          * ENODEV: the port cannot be configured as a motor
          *
          * @param velocity the target angular velocity to move the motors at
+         * @param acceleration the target angular acceleration, only used in VelocityMode::FEEDFORWARD
          * @return 0 on success
          * @return INT_MAX on failure, setting errno
          *
@@ -116,7 +131,7 @@ class MotorGroup : Encoder {
          * }
          * @endcode
          */
-        int moveVelocity(AngularVelocity velocity);
+        int moveVelocity(AngularVelocity velocity, AngularAcceleration acceleration = 0_radps2);
         /**
          * @brief brake the motors
          *
@@ -206,6 +221,51 @@ class MotorGroup : Encoder {
          * @endcode
          */
         std::vector<BrakeMode> getBrakeModes();
+        /**
+         * @brief get the current drawn by each motor in the group
+         *
+         * Motors which are disconnected are not included, so the size of the vector is the number of connected motors
+         *
+         * @return std::vector<Current> the current drawn by each motor, INFINITY for motors which failed
+         *
+         * @b Example:
+         * @code {.cpp}
+         * void initialize() {
+         *     pros::Motor motor1(1, pros::v5::MotorGears::green);
+         *     pros::Motor motor2(2, pros::v5::MotorGears::green);
+         *     lemlib::MotorGroup motorGroup({motor1, motor2}, 200_rpm);
+         *
+         *     for (Current current : motorGroup.getCurrents()) {
+         *         std::cout << "Current: " << to_amp(current) << " A" << std::endl;
+         *     }
+         * }
+         * @endcode
+         */
+        std::vector<Current> getCurrents();
+        /**
+         * @brief set the maximum current each motor in the group can draw
+         *
+         * This function uses the following values of errno when an error state is reached:
+         *
+         * ENODEV: the port cannot be configured as a motor
+         *
+         * @param limit the current limit of each motor. V5 motors can't draw more than 2.5 amps
+         * @return 0 on success
+         * @return INT_MAX on failure, setting errno
+         *
+         * @b Example:
+         * @code {.cpp}
+         * void initialize() {
+         *     pros::Motor motor1(1, pros::v5::MotorGears::green);
+         *     pros::Motor motor2(2, pros::v5::MotorGears::green);
+         *     lemlib::MotorGroup motorGroup({motor1, motor2}, 200_rpm);
+         *
+         *     // limit each motor to 1.5 amps
+         *     motorGroup.setCurrentLimit(1.5_amp);
+         * }
+         * @endcode
+         */
+        int setCurrentLimit(Current limit);
         /**
          * @brief whether any of the motors in the motor group are connected
          *
@@ -441,6 +501,180 @@ class MotorGroup : Encoder {
          * @endcode
          */
         void removeMotor(Motor motor);
+        /**
+         * @brief set the battery voltage that move() is compensated for
+         *
+         * This applies Motor::setVoltageCompensation() to every motor in the group, including motors added later.
+         *
+         * @param reference the battery voltage to compensate for, or 0 volts to disable compensation
+         *
+         * @b Example:
+         * @code {.cpp}
+         * void initialize() {
+         *     pros::Motor motor1(1, pros::v5::MotorGears::green);
+         *     pros::Motor motor2(2, pros::v5::MotorGears::green);
+         *     lemlib::MotorGroup motorGroup({motor1, motor2}, 200_rpm);
+         *
+         *     // move at the same speed as with an 11.5V battery, no matter the charge
+         *     motorGroup.setVoltageCompensation(11.5_volt);
+         *     motorGroup.move(1.0);
+         * }
+         * @endcode
+         */
+        void setVoltageCompensation(Voltage reference);
+        /**
+         * @brief get the battery voltage that move() is compensated for
+         *
+         * @return Voltage the reference voltage, or 0 volts if compensation is disabled
+         */
+        Voltage getVoltageCompensation() const;
+        /**
+         * @brief set how moveVelocity() controls the velocity of the motors
+         *
+         * In VelocityMode::FEEDFORWARD, moveVelocity() calculates a voltage from the gains set with
+         * setVelocityGains() and the velocity measured from the average angle of the group. The group has a single
+         * velocity estimate, and every motor gets the same voltage, so the motors can't fight each other. The
+         * velocity estimate is reset when the mode is set.
+         *
+         * @param mode the velocity mode
+         *
+         * @b Example:
+         * @code {.cpp}
+         * void opcontrol() {
+         *     pros::Motor motor1(1, pros::v5::MotorGears::blue);
+         *     pros::Motor motor2(2, pros::v5::MotorGears::blue);
+         *     lemlib::MotorGroup motorGroup({motor1, motor2}, 450_rpm);
+         *
+         *     motorGroup.setVelocityGains({1.2_volt, 12_volt / 450_rpm, 0.2_volt / 1_rps2, 2_volt / 100_rpm});
+         *     motorGroup.setVelocityMode(lemlib::VelocityMode::FEEDFORWARD);
+         *     while (true) {
+         *         motorGroup.moveVelocity(300_rpm);
+         *         pros::delay(10);
+         *     }
+         * }
+         * @endcode
+         */
+        void setVelocityMode(VelocityMode mode);
+        /**
+         * @brief get how moveVelocity() controls the velocity of the motors
+         *
+         * @return VelocityMode the velocity mode
+         */
+        VelocityMode getVelocityMode() const;
+        /**
+         * @brief set the gains used by moveVelocity() in VelocityMode::FEEDFORWARD
+         *
+         * The gains are for the output velocity of the group, after gearing, and the voltage of a V5 motor.
+         *
+         * @param gains the feedforward and feedback gains
+         */
+        void setVelocityGains(VelocityGains gains);
+        /**
+         * @brief get the gains used by moveVelocity() in VelocityMode::FEEDFORWARD
+         *
+         * @return VelocityGains the gains
+         */
+        VelocityGains getVelocityGains() const;
+        /**
+         * @brief attach a stall detector to the motor group
+         *
+         * The detector watches the whole group, using the average current of the motors and the average angle of the
+         * group. Every call to move() updates it, as does moveVelocity() in VelocityMode::FEEDFORWARD. While a reverse
+         * pulse runs, every motor moves at the voltage of the pulse instead, and while the detector brakes a stalled
+         * group with StallAction::BRAKE, every motor is braked. moveVelocity() in VelocityMode::INTERNAL doesn't update
+         * the detector.
+         *
+         * This function does not return a value or set errno, as it is impossible for it to fail
+         *
+         * @param detector the stall detector, which must outlive the motor group, or nullptr to detach it
+         *
+         * @b Example:
+         * @code {.cpp}
+         * lemlib::StallDetector stall({.action = lemlib::StallAction::REVERSE_PULSE});
+         *
+         * void initialize() {
+         *     pros::Motor motor1(1, pros::v5::MotorGears::green);
+         *     pros::Motor motor2(2, pros::v5::MotorGears::green);
+         *     lemlib::MotorGroup intake({motor1, motor2}, 200_rpm);
+         *     intake.setStallDetector(&stall);
+         * }
+         * @endcode
+         */
+        void setStallDetector(StallDetector* detector);
+        /**
+         * @brief get the stall detector attached to the motor group
+         *
+         * @return StallDetector* the stall detector, or nullptr if there is none
+         */
+        StallDetector* getStallDetector() const;
+        /**
+         * @brief limit how fast the voltage commanded by move() can change
+         *
+         * Sudden reversals draw large current spikes and make wheels slip. The limits are in volts of a V5 motor, and
+         * are applied every time move() is called, so move() should be called periodically, like in a control loop.
+         * The group keeps one limiter for all of its motors, and it also limits the voltage calculated by
+         * moveVelocity() in VelocityMode::FEEDFORWARD.
+         *
+         * This function does not return a value or set errno, as it is impossible for it to fail
+         *
+         * @param limits the limits, or the default limits to disable slew limiting
+         *
+         * @b Example:
+         * @code {.cpp}
+         * void initialize() {
+         *     pros::Motor motor1(1, pros::v5::MotorGears::green);
+         *     pros::Motor motor2(2, pros::v5::MotorGears::green);
+         *     lemlib::MotorGroup motorGroup({motor1, motor2}, 200_rpm);
+         *
+         *     // take half a second to go from 0 to 12 volts, and a quarter of a second to stop
+         *     motorGroup.setVoltageSlew({24_volt / 1_sec, 48_volt / 1_sec});
+         * }
+         * @endcode
+         */
+        void setVoltageSlew(SlewLimits<Voltage> limits);
+        /**
+         * @brief get the limits of the voltage commanded by move()
+         *
+         * @return SlewLimits<Voltage> the limits
+         */
+        SlewLimits<Voltage> getVoltageSlew() const;
+        /**
+         * @brief limit how fast the velocity commanded by moveVelocity() can change
+         *
+         * The limits are of the output of the group, after gearing. They are applied every time moveVelocity() is
+         * called, so it should be called periodically, like in a control loop.
+         *
+         * This function does not return a value or set errno, as it is impossible for it to fail
+         *
+         * @param limits the limits, or the default limits to disable slew limiting
+         *
+         * @b Example:
+         * @code {.cpp}
+         * void initialize() {
+         *     pros::Motor motor1(1, pros::v5::MotorGears::green);
+         *     pros::Motor motor2(2, pros::v5::MotorGears::green);
+         *     lemlib::MotorGroup motorGroup({motor1, motor2}, 200_rpm);
+         *
+         *     // accelerate at up to 5 rotations per second squared, and stop twice as fast
+         *     motorGroup.setVelocitySlew({5_rps2, 10_rps2});
+         * }
+         * @endcode
+         */
+        void setVelocitySlew(SlewLimits<AngularVelocity> limits);
+        /**
+         * @brief get the limits of the velocity commanded by moveVelocity()
+         *
+         * @return SlewLimits<AngularVelocity> the limits
+         */
+        SlewLimits<AngularVelocity> getVelocitySlew() const;
+        /**
+         * @brief get the theoretical maximum output velocity of the motor group, after gearing
+         *
+         * This function does not return a value or set errno, as it is impossible for it to fail
+         *
+         * @return AngularVelocity the output velocity passed to the constructor
+         */
+        AngularVelocity getOutputVelocity() const;
     private:
         /**
          * @brief Configure a motor so its ready to join the motor group
@@ -468,7 +702,32 @@ class MotorGroup : Encoder {
          * @return const std::vector<Motor> vector of lemlib::Motor objects
          */
         const std::vector<Motor> getMotors();
+        /**
+         * @brief Get the average angle of the given motors, after gearing
+         *
+         * This lets functions which already called getMotors() get the angle without calling it again
+         *
+         * @param motors the motors, from getMotors()
+         * @return Angle the average angle
+         * @return INFINITY if the angle of every motor could not be read
+         */
+        Angle getAverageAngle(const std::vector<Motor>& motors);
+        /**
+         * @brief Move the given motors at the same percent, after the voltage slew limit and the stall detector
+         *
+         * @param motors the motors, from getMotors()
+         * @param percent the percent to move the motors at
+         * @return 0 on success
+         * @return INT_MAX on failure, setting errno
+         */
+        int moveMotors(const std::vector<Motor>& motors, double percent);
         const AngularVelocity m_outputVelocity;
+        Voltage m_compensation = 0_volt; /** the battery voltage move() is compensated for, 0 if disabled */
+        VelocityMode m_velocityMode = VelocityMode::INTERNAL;
+        VelocityController m_velocityController; /** shared by every motor in the group */
+        StallDetector* m_stallDetector = nullptr;
+        SlewLimiter<Voltage> m_voltageSlew; /** shared by every motor in the group */
+        SlewLimiter<AngularVelocity> m_velocitySlew;
         /**
          * This member variable is a vector of motor ports
          *
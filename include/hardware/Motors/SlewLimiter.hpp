@@ -0,0 +1,199 @@
+#pragma once
+
+#include "units/units.hpp"
+#include <algorithm>
+#include <cmath>
+#include <optional>
+
+namespace lemlib {
+/**
+ * @brief Limits of a SlewLimiter
+ *
+ * The rate is how fast the value may change, and the jerk is how fast the rate may change. The accelerating rate is
+ * used while the magnitude of the value grows, and the decelerating rate while it shrinks, so a mechanism can be
+ * allowed to stop faster than it starts. A reversal first decelerates to 0, then accelerates. Infinite limits, the
+ * default, don't limit anything.
+ *
+ * @tparam Q the type of value to limit, like Voltage or AngularVelocity
+ *
+ * @b Example:
+ * @code {.cpp}
+ * // speed up at 24 volts per second, slow down at 48 volts per second
+ * lemlib::SlewLimits<Voltage> limits {24_volt / 1_sec, 48_volt / 1_sec};
+ * @endcode
+ */
+template <isQuantity Q> struct SlewLimits {
+        Divided<Q, Time> accelerating = Divided<Q, Time>(INFINITY); /** the rate while the magnitude grows */
+        Divided<Q, Time> decelerating = Divided<Q, Time>(INFINITY); /** the rate while the magnitude shrinks */
+        Divided<Divided<Q, Time>, Time> jerk = Divided<Divided<Q, Time>, Time>(INFINITY); /** change of the rate */
+};
+
+/**
+ * @brief Limits how fast a command changes
+ *
+ * Reversing a motor from full power forward to full power backward draws a large current spike, and can make the
+ * wheels slip. The limiter moves its output towards the target at a limited rate instead, and with a jerk limit, the
+ * rate itself ramps up and down, so the output eases into the target without overshooting it. A reversal with a jerk
+ * limit eases from the decelerating rate to the accelerating rate before the output crosses 0.
+ *
+ * The limiter only stores its output, its rate, and the time of the last update, so it never allocates. Updates more
+ * than MAX_STEP apart are treated as MAX_STEP apart, as the command was held while no updates happened, so a command
+ * after a pause can't jump. This means the limiter should be updated periodically, like in a control loop.
+ *
+ * The limiter can be used with Motor::setVoltageSlew() and Motor::setVelocitySlew(), and the MotorGroup equivalents.
+ * It doesn't read any hardware, so it can be tested on a computer.
+ *
+ * @tparam Q the type of value to limit, like Voltage or AngularVelocity
+ *
+ * @b Example:
+ * @code {.cpp}
+ * lemlib::SlewLimiter<Voltage> limiter({24_volt / 1_sec, 48_volt / 1_sec});
+ *
+ * void opcontrol() {
+ *     pros::Controller controller(pros::E_CONTROLLER_MASTER);
+ *     while (true) {
+ *         const Voltage target = from_volt(controller.get_analog(pros::E_CONTROLLER_ANALOG_LEFT_Y) / 127.0 * 12);
+ *         const Voltage output = limiter.update(target, from_usec(pros::micros()));
+ *         pros::delay(10);
+ *     }
+ * }
+ * @endcode
+ */
+template <isQuantity Q> class SlewLimiter {
+    public:
+        using Rate = Divided<Q, Time>;
+        using Jerk = Divided<Rate, Time>;
+
+        static constexpr Time MAX_STEP = 50_msec; /** the longest time between updates that is used as is */
+
+        /**
+         * @brief Construct a new SlewLimiter object
+         *
+         * @param limits the limits, which don't limit anything by default
+         * @param initial the initial output
+         */
+        SlewLimiter(SlewLimits<Q> limits = {}, Q initial = Q(0))
+            : m_limits(limits),
+              m_value(initial) {}
+
+        /**
+         * @brief Move the output towards the target
+         *
+         * The first update only records the time, so the output doesn't change, unless nothing is limited
+         *
+         * @param target the value the output should reach
+         * @param time the time of the update
+         * @return Q the limited output
+         */
+        Q update(Q target, Time time) {
+            if (!isLimited()) {
+                m_value = target;
+                m_rate = Rate(0);
+                m_time = time;
+                return m_value;
+            }
+            const Time dt = m_time ? units::clamp(time - *m_time, 0_sec, MAX_STEP) : 0_sec;
+            m_time = time;
+            const double error = (target - m_value).internal();
+            if (error == 0) {
+                m_rate = Rate(0);
+                return m_value;
+            }
+            if (dt == 0_sec) return m_value;
+            // the magnitude grows when moving away from 0
+            const double value = m_value.internal();
+            const bool accelerating = value == 0 || (error > 0) == (value > 0);
+            const double limit = (accelerating ? m_limits.accelerating : m_limits.decelerating).internal();
+            const double jerk = m_limits.jerk.internal();
+            const double maxChange = jerk * dt.internal();
+            // with a jerk limit, the rate has to start ramping down early enough to stop at the target. Close to the
+            // target, it is reached in one step, which is within the jerk limit
+            const double arrival = std::min(std::abs(error) / dt.internal(), maxChange);
+            double desired = std::min(limit, std::max(rampDown(std::abs(error), 0, jerk, maxChange), arrival));
+            // when reversing, the rate also has to ramp down to the accelerating rate by the time the output crosses 0
+            if (!accelerating && std::abs(error) > std::abs(value)) {
+                const double crossing = m_limits.accelerating.internal();
+                desired = std::min(desired, rampDown(std::abs(value), crossing, jerk, maxChange));
+            }
+            desired = std::copysign(desired, error);
+            const double rate = m_rate.internal();
+            // the rate never exceeds the limit of the direction the output is moving in, even if it was faster before
+            m_rate = Rate(std::clamp(rate + std::clamp(desired - rate, -maxChange, maxChange), -limit, limit));
+            const double step = m_rate.internal() * dt.internal();
+            if ((step > 0) == (error > 0) && std::abs(step) >= std::abs(error)) {
+                // the target was reached
+                m_value = target;
+                m_rate = Rate(0);
+            } else {
+                m_value = Q(value + step);
+            }
+            return m_value;
+        }
+
+        /**
+         * @brief Get the limited output
+         *
+         * @return Q the output of the last update
+         */
+        Q getValue() const { return m_value; }
+
+        /**
+         * @brief Get how fast the output is changing
+         *
+         * @return Rate the rate of the output
+         */
+        Rate getRate() const { return m_rate; }
+
+        /**
+         * @brief Whether any of the limits are finite
+         *
+         * @return true the output is limited
+         * @return false the output always equals the target
+         */
+        bool isLimited() const {
+            return std::isfinite(m_limits.accelerating.internal()) || std::isfinite(m_limits.decelerating.internal()) ||
+                   std::isfinite(m_limits.jerk.internal());
+        }
+
+        /**
+         * @brief Set the limits
+         *
+         * @param limits the limits
+         */
+        void setLimits(SlewLimits<Q> limits) { m_limits = limits; }
+
+        /**
+         * @brief Get the limits
+         *
+         * @return SlewLimits<Q> the limits
+         */
+        SlewLimits<Q> getLimits() const { return m_limits; }
+
+        /**
+         * @brief Set the output, and forget the time of the last update
+         *
+         * @param value the new output
+         */
+        void reset(Q value = Q(0)) {
+            m_value = value;
+            m_rate = Rate(0);
+            m_time.reset();
+        }
+    private:
+        /**
+         * @brief a rate which can ramp down to a final rate within a distance, with the jerk limit
+         *
+         * The rate ramps down in steps of maxChange, which covers more distance than ramping down continuously, so the
+         * rate is lowered by half a step to stop in time
+         */
+        static double rampDown(double distance, double final, double jerk, double maxChange) {
+            if (!std::isfinite(jerk) || !std::isfinite(final)) return INFINITY;
+            return std::sqrt(final * final + 2 * jerk * distance) - maxChange / 2;
+        }
+
+        SlewLimits<Q> m_limits;
+        Q m_value;
+        Rate m_rate = Rate(0);
+        std::optional<Time> m_time;
+};
+} // namespace lemlib
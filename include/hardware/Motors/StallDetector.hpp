@@ -0,0 +1,171 @@
+#pragma once
+
+#include "hardware/Motors/VelocityController.hpp"
+#include "hardware/concurrency/Queue.hpp"
+#include <atomic>
+#include <functional>
+#include <optional>
+
+namespace lemlib {
+/**
+ * @brief What a StallDetector does to the motor when it stalls
+ */
+enum class StallAction {
+    NONE, /** only report the stall */
+    BRAKE, /** brake the motor for a while, then try again */
+    REVERSE_PULSE, /** briefly reverse the motor, which often clears a jammed intake, then try again */
+};
+
+/**
+ * @brief Settings of a StallDetector
+ *
+ * A motor is stalled when it is being driven, is drawing current, but isn't moving in the commanded direction. The
+ * stall clears once the motor moves faster than the clear velocity, or stops being driven. The velocities are of the
+ * output of the motor or motor group, after gearing.
+ */
+struct StallSettings {
+        Voltage minVoltage = 3_volt; /** motors commanded less than this aren't being driven, so can't stall */
+        Current minCurrent = 1.5_amp; /** the current of each motor needed to count as stalled */
+        AngularVelocity stallVelocity = 0.1_rps; /** slower than this in the commanded direction counts as stalled */
+        AngularVelocity clearVelocity = 0.3_rps; /** faster than this in the commanded direction clears the stall */
+        Time stallTime = 250_msec; /** how long the motor must be stalled before the stall is reported */
+        Time clearTime = 100_msec; /** how long the motor must be moving before the stall clears */
+        StallAction action = StallAction::NONE;
+        Voltage reverseVoltage = 6_volt; /** the voltage of the reverse pulse */
+        Time reverseTime = 250_msec; /** how long the reverse pulse lasts */
+        Time brakeTime = 1_sec; /** how long the motor is braked, before it is driven again to see if it moves */
+};
+
+class StallDetector;
+
+/**
+ * @brief A stall starting or clearing
+ */
+struct StallEvent {
+        const StallDetector* detector = nullptr; /** the detector which raised the event */
+        bool stalled = false; /** true if the stall started, false if it cleared */
+        Time time = 0_sec; /** when the event happened */
+};
+
+/**
+ * @brief Detects when a motor or motor group stalls
+ *
+ * A jammed intake, or a drivetrain pushing against another robot, draws high current without moving, which wastes the
+ * battery and overheats the motors. The detector compares the commanded voltage, the current, and the velocity, which
+ * is estimated from the angle. Both the start and the end of a stall have to last for a configurable time, and the
+ * stall clears at a higher velocity than it starts at, so noise doesn't cause repeated events.
+ *
+ * Events are passed to a callback, which is called by the task moving the motor, so it should be short. They are also
+ * pushed to a lock-free queue, so another task can handle them with popEvent().
+ *
+ * The detector is attached to a Motor or MotorGroup with setStallDetector(), which updates it every time the motor
+ * moves. Each update takes constant time. update() can also be called directly, which allows testing with a simulated
+ * motor on a computer.
+ *
+ * @b Example:
+ * @code {.cpp}
+ * lemlib::Motor intake = pros::Motor(1);
+ * lemlib::StallDetector intakeStall({.action = lemlib::StallAction::REVERSE_PULSE});
+ *
+ * void opcontrol() {
+ *     intake.setStallDetector(&intakeStall);
+ *     intakeStall.setCallback([](const lemlib::StallEvent& event) {
+ *         if (event.stalled) pros::c::controller_rumble(pros::E_CONTROLLER_MASTER, ".");
+ *     });
+ *     while (true) {
+ *         intake.move(1);
+ *         pros::delay(10);
+ *     }
+ * }
+ * @endcode
+ */
+class StallDetector {
+    public:
+        static constexpr std::size_t EVENT_QUEUE_SIZE = 16; /** events not popped yet, later events are dropped */
+
+        /**
+         * @brief Construct a new StallDetector object
+         *
+         * @param settings the settings of the detector
+         */
+        StallDetector(StallSettings settings = {});
+        /**
+         * @brief Update the detector, and get the voltage to apply to the motor
+         *
+         * @param commanded the voltage the motor was commanded to move at, for a V5 motor
+         * @param current the current drawn by each motor
+         * @param angle the angle of the motor
+         * @param time the time of the measurements
+         * @return Voltage the voltage to apply, which is the commanded voltage unless an action is running
+         */
+        Voltage update(Voltage commanded, Current current, Angle angle, Time time);
+        /**
+         * @brief Whether the motor is stalled
+         *
+         * @return true the motor is stalled
+         * @return false the motor is not stalled
+         */
+        bool isStalled() const;
+        /**
+         * @brief Whether the motor should be braked, because it is stalled, the action is StallAction::BRAKE, and the
+         * brake time isn't over
+         *
+         * @return true the motor should be braked
+         * @return false the motor should be moved at the voltage from update()
+         */
+        bool isBraking() const;
+        /**
+         * @brief Set the function called when a stall starts or clears
+         *
+         * @param callback the function, or nullptr to remove it
+         */
+        void setCallback(std::function<void(const StallEvent&)> callback);
+        /**
+         * @brief Pop the oldest event which hasn't been popped yet
+         *
+         * This function can be called from any single task
+         *
+         * @return std::optional<StallEvent> the event, or std::nullopt if there are none
+         */
+        std::optional<StallEvent> popEvent();
+        /**
+         * @brief Get the number of times the motor has stalled
+         *
+         * @return std::uint32_t the number of stalls
+         */
+        std::uint32_t getStallCount() const;
+        /**
+         * @brief Set the settings of the detector
+         *
+         * @param settings the settings
+         */
+        void setSettings(StallSettings settings);
+        /**
+         * @brief Get the settings of the detector
+         *
+         * @return StallSettings the settings
+         */
+        StallSettings getSettings() const;
+        /**
+         * @brief Clear the stall, and forget the previous measurements
+         */
+        void reset();
+    private:
+        /**
+         * @brief report an event to the callback and the queue
+         */
+        void raise(bool stalled, Time time);
+
+        StallSettings m_settings;
+        VelocityEstimator m_velocity;
+        bool m_stalled = false;
+        std::optional<Time> m_since; /** when the current stall or clear condition started */
+        std::optional<Time> m_pulseEnd; /** when the reverse pulse ends, if it is running */
+        std::optional<Time> m_brakeEnd; /** when the motor stops being braked, if it is braked */
+        Time m_retry = 0_sec; /** when the next reverse pulse or brake can start, if the motor is still stalled */
+        Voltage m_pulseVoltage = 0_volt;
+        std::function<void(const StallEvent&)> m_callback;
+        SPSCQueue<StallEvent, EVENT_QUEUE_SIZE> m_events;
+        std::atomic<std::uint32_t> m_stalls = 0;
+};
+} // namespace lemlib
@@ -0,0 +1,193 @@
+#pragma once
+
+#include "units/Temperature.hpp"
+#include "units/units.hpp"
+#include <span>
+
+namespace lemlib {
+/**
+ * @brief Coefficients of a ThermalModel
+ *
+ * The default coefficients are rough values for a V5 motor. They should be fit for each mechanism with
+ * ThermalModel::fit(), as the cooling depends on how the motor is mounted.
+ */
+struct ThermalCoefficients {
+        /** how much hotter than ambient the motor ends up, per amp squared of constant current */
+        Divided<Temperature, Multiplied<Current, Current>> heating = 12.8_kelvin / (1_amp * 1_amp);
+        Time timeConstant = 300_sec; /** how long the motor takes to get 63% of the way to its final temperature */
+        Time sensorTimeConstant = 30_sec; /** how far the temperature sensor lags behind the windings */
+        Temperature ambient = 25_celsius; /** the temperature the motor cools down to */
+};
+
+/**
+ * @brief A temperature measurement, with the current drawn by the motor at the time
+ *
+ * This is trivially copyable, so it can be logged with a Logger and loaded again to fit a ThermalModel
+ */
+struct ThermalSample {
+        Time time;
+        Current current;
+        Temperature temperature;
+};
+
+/**
+ * @brief Gradually lowers the power of a motor as it heats up
+ *
+ * The motor halves its own power when it reaches 55 degrees celsius, which is a sudden loss of performance. Derating
+ * lowers the power gradually from the start temperature instead, so the motor heats up slower and the driver can
+ * notice it before the motor cuts its power.
+ */
+struct ThermalDerating {
+        Temperature start = 45_celsius; /** the power starts being reduced at this temperature */
+        Temperature end = 55_celsius; /** the power is reduced to the minimum at this temperature */
+        Number minimum = 0.5_num; /** the fraction of the power left at the end temperature */
+};
+
+/**
+ * @brief Predicts the temperature of a motor from the current it draws
+ *
+ * The temperature reported by the motor changes in steps of 5 degrees, and lags behind the windings of the motor, so
+ * it can't be used to react before the motor overheats. This model instead predicts the temperature of the windings
+ * from the heat the current produces:
+ *
+ * d(temperature)/dt = (ambient + heating * current^2 - temperature) / timeConstant
+ *
+ * The temperature the sensor should report is predicted too, as the temperature of the windings delayed by the
+ * sensor time constant. The sensor is assumed to report the temperature rounded down to a step. When the reported
+ * step doesn't match the predicted sensor temperature, both predictions are shifted to match it, so the model can't
+ * drift away from reality.
+ *
+ * The model can be attached to a Motor with Motor::setThermalModel(), which updates it every time the motor moves,
+ * and can derate the power of the motor. This class doesn't read any hardware, so it can be tested on a computer.
+ *
+ * @b Example:
+ * @code {.cpp}
+ * lemlib::Motor intake = pros::Motor(1);
+ * lemlib::ThermalModel intakeThermal;
+ *
+ * void opcontrol() {
+ *     intakeThermal.setDerating(lemlib::ThermalDerating());
+ *     intake.setThermalModel(&intakeThermal);
+ *     while (true) {
+ *         intake.move(1);
+ *         const Time left = intakeThermal.getTimeToDerate(intake.getCurrent());
+ *         std::cout << "seconds until the intake overheats: " << to_sec(left) << std::endl;
+ *         pros::delay(10);
+ *     }
+ * }
+ * @endcode
+ */
+class ThermalModel {
+    public:
+        static constexpr Temperature DERATE_TEMPERATURE = 55_celsius; /** V5 motors halve their power from here */
+
+        /**
+         * @brief Construct a new ThermalModel object
+         *
+         * @param coefficients the coefficients of the model
+         */
+        ThermalModel(ThermalCoefficients coefficients = {});
+        /**
+         * @brief Advance the model to the given time
+         *
+         * @param current the current drawn by the motor
+         * @param measured the temperature reported by the motor, or INFINITY if it couldn't be read
+         * @param time the time of the measurement
+         * @return Temperature the predicted temperature
+         */
+        Temperature update(Current current, Temperature measured, Time time);
+        /**
+         * @brief Get the predicted temperature of the motor
+         *
+         * @return Temperature the predicted temperature, or the ambient temperature if the model hasn't been updated
+         */
+        Temperature getTemperature() const;
+        /**
+         * @brief Get the temperature the sensor of the motor is predicted to measure, before it is rounded
+         *
+         * @return Temperature the predicted sensor temperature
+         */
+        Temperature getSensorTemperature() const;
+        /**
+         * @brief Predict how long until the windings reach a temperature, if the motor keeps drawing the same current
+         *
+         * @param temperature the temperature
+         * @param current the current drawn by the motor
+         * @return Time the time until the windings reach the temperature, 0 if they already have
+         * @return INFINITY if the temperature will never be reached
+         */
+        Time getTimeToTemperature(Temperature temperature, Current current) const;
+        /**
+         * @brief Predict how long until the motor halves its power, if it keeps drawing the same current
+         *
+         * The motor halves its power when its sensor reports DERATE_TEMPERATURE, so this is when the predicted sensor
+         * temperature reaches it. The sensor lags behind the windings, so this is later than
+         * getTimeToTemperature(DERATE_TEMPERATURE), and the sensor can still reach it after the current is lowered.
+         *
+         * @param current the current drawn by the motor
+         * @return Time the time until the sensor reaches DERATE_TEMPERATURE, 0 if it already has
+         * @return INFINITY if the sensor will never reach DERATE_TEMPERATURE
+         */
+        Time getTimeToDerate(Current current) const;
+        /**
+         * @brief Enable derating, used by Motor::move() when the model is attached to the motor
+         *
+         * @param derating how the power is reduced
+         */
+        void setDerating(ThermalDerating derating);
+        /**
+         * @brief Disable derating
+         */
+        void disableDerating();
+        /**
+         * @brief Get the fraction of the power the motor should use at the predicted temperature
+         *
+         * @return Number from the derating minimum to 1, always 1 if derating is disabled
+         */
+        Number getDeratingScale() const;
+        /**
+         * @brief Set the coefficients of the model
+         *
+         * @param coefficients the coefficients
+         */
+        void setCoefficients(ThermalCoefficients coefficients);
+        /**
+         * @brief Get the coefficients of the model
+         *
+         * @return ThermalCoefficients the coefficients
+         */
+        ThermalCoefficients getCoefficients() const;
+        /**
+         * @brief Fit the coefficients to logged samples
+         *
+         * The model is run on the logged currents, without corrections, and the coefficients are searched for the
+         * smallest squared error between the predicted and reported sensor temperatures. The log should start with
+         * the motor at the ambient temperature, include it heating up under load and cooling down, and last several
+         * minutes, as the reported temperature changes in steps of 5 degrees. Fitting a long log takes a while, so it
+         * is best done on a computer, or before a match.
+         *
+         * This function uses the following values of errno when an error state is reached:
+         *
+         * EDOM: there are too few samples
+         *
+         * @param samples the samples, in the order they were taken
+         * @param ambient the temperature of the motor when the log started
+         * @return ThermalCoefficients the fitted coefficients
+         * @return INFINITY heating and time constants on failure, setting errno
+         */
+        static ThermalCoefficients fit(std::span<const ThermalSample> samples, Temperature ambient);
+    private:
+        /**
+         * @brief advance the predictions, assuming the current was constant since the last update
+         */
+        void predict(Current current, Time dt);
+
+        ThermalCoefficients m_coefficients;
+        bool m_initialized = false;
+        Temperature m_temperature; /** the predicted temperature of the windings */
+        Temperature m_sensorTemperature; /** the predicted temperature of the sensor, before rounding */
+        Time m_time = 0_sec;
+        bool m_derate = false;
+        ThermalDerating m_derating;
+};
+} // namespace lemlib
@@ -0,0 +1,170 @@
+#pragma once
+
+#include "units/Angle.hpp"
+
+namespace lemlib {
+/**
+ * @brief How a Motor or MotorGroup controls its velocity in moveVelocity()
+ */
+enum class VelocityMode {
+    INTERNAL, /** the velocity is controlled by the PID controller inside the motor */
+    FEEDFORWARD, /** the voltage is calculated on the brain by a VelocityController */
+};
+
+/**
+ * @brief Gains of a VelocityController
+ *
+ * The feedforward gains model the voltage needed to move at a velocity and acceleration:
+ *
+ * voltage = kS * sign(velocity) + kV * velocity + kA * acceleration
+ *
+ * kS is the voltage needed to overcome static friction, kV the voltage needed per unit of velocity, and kA the
+ * voltage needed per unit of acceleration. kP corrects the error between the target velocity and the measured
+ * velocity, which the feedforward can't account for, like the load on the mechanism.
+ *
+ * The velocities are of the output of the motor or motor group, after gearing. The voltages are of a V5 motor, so
+ * the same gains work for EXP motors, which have a lower maximum voltage but the same maximum velocity.
+ *
+ * @b Example:
+ * @code {.cpp}
+ * // 1.2V to start moving, 12V per 600 rpm, 0.2V per rotation per second squared, and 2V per 100 rpm of error
+ * lemlib::VelocityGains gains {1.2_volt, 12_volt / 600_rpm, 0.2_volt / 1_rps2, 2_volt / 100_rpm};
+ * @endcode
+ */
+struct VelocityGains {
+        Voltage kS = 0_volt;
+        Divided<Voltage, AngularVelocity> kV = 0_volt / 1_radps;
+        Divided<Voltage, AngularAcceleration> kA = 0_volt / 1_radps2;
+        Divided<Voltage, AngularVelocity> kP = 0_volt / 1_radps;
+};
+
+/**
+ * @brief Estimates angular velocity from angle measurements
+ *
+ * The angle measurements are differentiated, and the result is smoothed by a low pass filter. Motors only measure
+ * their position every 10 ms, so if the angle hasn't changed, the estimator waits for a new measurement instead of
+ * estimating a velocity of 0, unless the angle hasn't changed for long enough that the mechanism must be stopped.
+ *
+ * This class doesn't read any hardware, so it can be used with any sensor, and tested on a computer.
+ *
+ * @b Example:
+ * @code {.cpp}
+ * void opcontrol() {
+ *     lemlib::V5RotationSensor encoder(1);
+ *     lemlib::VelocityEstimator estimator;
+ *     while (true) {
+ *         const AngularVelocity velocity = estimator.update(encoder.getAngle(), from_usec(pros::micros()));
+ *         std::cout << to_rpm(velocity) << " rpm" << std::endl;
+ *         pros::delay(10);
+ *     }
+ * }
+ * @endcode
+ */
+class VelocityEstimator {
+    public:
+        /**
+         * @brief Construct a new VelocityEstimator object
+         *
+         * @param timeConstant the time constant of the low pass filter. Larger values reduce noise, but add delay
+         * @param timeout how long the angle can stay the same before the velocity is estimated to be 0
+         */
+        VelocityEstimator(Time timeConstant = 20_msec, Time timeout = 25_msec);
+        /**
+         * @brief Add an angle measurement
+         *
+         * @param angle the measured angle
+         * @param time the time of the measurement
+         * @return AngularVelocity the estimated velocity
+         */
+        AngularVelocity update(Angle angle, Time time);
+        /**
+         * @brief Get the estimated velocity, without adding a measurement
+         *
+         * @return AngularVelocity the estimated velocity, or 0 if no measurements have been added
+         */
+        AngularVelocity getVelocity() const;
+        /**
+         * @brief Forget all measurements, so the next measurement starts a new estimate
+         */
+        void reset();
+    private:
+        Time m_timeConstant;
+        Time m_timeout;
+        bool m_initialized = false;
+        Angle m_angle = 0_stRad; /** the angle of the last measurement used */
+        Time m_time = 0_sec; /** the time of the last measurement used */
+        AngularVelocity m_velocity = 0_radps;
+};
+
+/**
+ * @brief Feedforward plus feedback velocity controller
+ *
+ * The motor's internal velocity controller only accepts integer rpm, and reacts slowly to changes in load. This
+ * controller instead calculates the voltage needed for the target velocity and acceleration with feedforward, and
+ * corrects the remaining error with proportional feedback on the velocity measured by a VelocityEstimator. It is
+ * meant to be run every iteration of a control loop, and is used by Motor and MotorGroup in VelocityMode::FEEDFORWARD.
+ *
+ * Like the VelocityEstimator, this class doesn't read any hardware.
+ *
+ * @b Example:
+ * @code {.cpp}
+ * void opcontrol() {
+ *     lemlib::Motor motor = pros::Motor(1);
+ *     lemlib::VelocityController controller({1.2_volt, 12_volt / 600_rpm, 0_volt / 1_radps2, 2_volt / 100_rpm});
+ *     while (true) {
+ *         const Voltage voltage = controller.update(motor.getAngle(), from_usec(pros::micros()), 300_rpm);
+ *         motor.move(to_volt(voltage) / 12);
+ *         pros::delay(10);
+ *     }
+ * }
+ * @endcode
+ */
+class VelocityController {
+    public:
+        /**
+         * @brief Construct a new VelocityController object
+         *
+         * @param gains the gains of the controller
+         * @param estimator the velocity estimator used for feedback
+         */
+        VelocityController(VelocityGains gains = {}, VelocityEstimator estimator = {});
+        /**
+         * @brief Add an angle measurement, and calculate the voltage to reach the target
+         *
+         * @param angle the measured angle
+         * @param time the time of the measurement
+         * @param velocity the target velocity
+         * @param acceleration the target acceleration
+         * @return Voltage the voltage of a V5 motor needed to reach the target
+         */
+        Voltage update(Angle angle, Time time, AngularVelocity velocity, AngularAcceleration acceleration = 0_radps2);
+        /**
+         * @brief Set the gains of the controller
+         *
+         * @param gains the new gains
+         */
+        void setGains(VelocityGains gains);
+        /**
+         * @brief Get the gains of the controller
+         *
+         * @return VelocityGains the gains
+         */
+        VelocityGains getGains() const;
+        /**
+         * @brief Get the estimated velocity, from the last call to update()
+         *
+         * @return AngularVelocity the estimated velocity
+         */
+        AngularVelocity getVelocity() const;
+        /**
+         * @brief Reset the velocity estimator
+         *
+         * This should be called when the controller hasn't been updated for a while, so old measurements don't affect
+         * the estimate
+         */
+        void reset();
+    private:
+        VelocityGains m_gains;
+        VelocityEstimator m_estimator;
+};
+} // namespace lemlib
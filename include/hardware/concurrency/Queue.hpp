@@ -0,0 +1,347 @@
+#pragma once
+
+#include "pros/rtos.hpp"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+
+namespace lemlib {
+/**
+ * @brief Lock-free single producer, single consumer queue
+ *
+ * A SPSCQueue lets one task push values, and another task pop them in the order they were pushed, without using a
+ * mutex. Pushing and popping are wait-free, so neither task ever waits for the other. The queue has fixed storage, and
+ * never allocates.
+ *
+ * If the queue is full, new values are dropped rather than overwriting old ones, as the producer can't safely remove
+ * values the consumer might be reading. The number of dropped values is counted, so the consumer can tell that it
+ * missed some.
+ *
+ * The queue can notify a task every time a value is pushed, so the consumer can sleep until there is data instead of
+ * polling.
+ *
+ * @tparam T the type of value to store. It should be cheap to copy
+ * @tparam N the maximum number of values in the queue. Must be a power of 2
+ *
+ * @b Example:
+ * @code {.cpp}
+ * lemlib::SPSCQueue<int, 16> queue;
+ *
+ * void producer() {
+ *     queue.push(5);
+ * }
+ *
+ * void consumer() {
+ *     while (std::optional<int> value = queue.pop()) std::cout << *value << std::endl;
+ * }
+ * @endcode
+ */
+template <typename T, std::size_t N> class SPSCQueue {
+        static_assert(N > 0 && (N & (N - 1)) == 0, "The capacity of a SPSCQueue must be a power of 2");
+    public:
+        /**
+         * @brief Construct a new SPSCQueue object
+         *
+         * @param notify the task to notify when a value is pushed, usually the consumer
+         *
+         * @b Example:
+         * @code {.cpp}
+         * void consumer() {
+         *     lemlib::SPSCQueue<int, 16> queue(pros::Task::current());
+         *     startProducer(&queue);
+         *     std::array<int, 16> values;
+         *     while (true) {
+         *         // sleep until something is pushed
+         *         pros::Task::notify_take(true, TIMEOUT_MAX);
+         *         const std::size_t count = queue.pop(values);
+         *     }
+         * }
+         * @endcode
+         */
+        explicit SPSCQueue(std::optional<pros::Task> notify = std::nullopt) : m_notify(notify) {}
+
+        /**
+         * @brief push a value to the queue
+         *
+         * This function never blocks. It may only be called by the producer.
+         *
+         * @param value the value to push
+         * @return true the value was pushed
+         * @return false the queue is full, the value was dropped
+         */
+        bool push(const T& value) {
+            const std::uint32_t head = m_head.load(std::memory_order_relaxed);
+            if (head - m_tail.load(std::memory_order_acquire) == N) {
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            m_values[head & MASK] = value;
+            // publish the value to the consumer
+            m_head.store(head + 1, std::memory_order_release);
+            if (m_notify) m_notify->notify();
+            return true;
+        }
+
+        /**
+         * @brief push several values to the queue at once
+         *
+         * Either all of the values are pushed, or none of them are, so the consumer never sees part of a message. The
+         * consumer sees all of the values at the same time.
+         *
+         * This function never blocks. It may only be called by the producer.
+         *
+         * @param values the values to push
+         * @return true the values were pushed
+         * @return false there isn't enough space in the queue, the values were dropped
+         */
+        bool push(std::span<const T> values) {
+            const std::uint32_t head = m_head.load(std::memory_order_relaxed);
+            if (N - (head - m_tail.load(std::memory_order_acquire)) < values.size()) {
+                m_dropped.fetch_add(values.size(), std::memory_order_relaxed);
+                return false;
+            }
+            for (std::size_t i = 0; i < values.size(); i++) m_values[(head + i) & MASK] = values[i];
+            // publish the values to the consumer
+            m_head.store(head + values.size(), std::memory_order_release);
+            if (m_notify) m_notify->notify();
+            return true;
+        }
+
+        /**
+         * @brief pop the oldest value from the queue
+         *
+         * This function never blocks. It may only be called by the consumer.
+         *
+         * @return std::optional<T> the oldest value, or std::nullopt if the queue is empty
+         */
+        std::optional<T> pop() {
+            const std::uint32_t tail = m_tail.load(std::memory_order_relaxed);
+            if (tail == m_head.load(std::memory_order_acquire)) return std::nullopt;
+            const T value = m_values[tail & MASK];
+            // let the producer reuse the slot
+            m_tail.store(tail + 1, std::memory_order_release);
+            return value;
+        }
+
+        /**
+         * @brief pop as many values as fit in a span, oldest first
+         *
+         * This function never blocks. It may only be called by the consumer.
+         *
+         * @param out where to store the values
+         * @return std::size_t the number of values popped
+         */
+        std::size_t pop(std::span<T> out) {
+            const std::uint32_t tail = m_tail.load(std::memory_order_relaxed);
+            const std::size_t available = m_head.load(std::memory_order_acquire) - tail;
+            const std::size_t count = available < out.size() ? available : out.size();
+            for (std::size_t i = 0; i < count; i++) out[i] = m_values[(tail + i) & MASK];
+            m_tail.store(tail + count, std::memory_order_release);
+            return count;
+        }
+
+        /**
+         * @brief get the number of values in the queue
+         *
+         * The result is only a snapshot, as the other task may push or pop at any time
+         *
+         * @return std::size_t the number of values in the queue
+         */
+        std::size_t size() const {
+            return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_acquire);
+        }
+
+        /**
+         * @brief whether the queue is empty
+         *
+         * @return true the queue is empty
+         * @return false the queue is not empty
+         */
+        bool empty() const { return size() == 0; }
+
+        /**
+         * @brief get the maximum number of values in the queue
+         *
+         * @return std::size_t the capacity of the queue
+         */
+        static constexpr std::size_t capacity() { return N; }
+
+        /**
+         * @brief get the number of values dropped because the queue was full
+         *
+         * @return std::uint32_t the number of values dropped
+         */
+        std::uint32_t getDropped() const { return m_dropped.load(std::memory_order_relaxed); }
+    private:
+        static constexpr std::uint32_t MASK = N - 1;
+
+        std::array<T, N> m_values {};
+        // the indices are never wrapped, only masked when used, so a full queue can be told apart from an empty one
+        std::atomic<std::uint32_t> m_head = 0; /** index of the next value to push, only written by the producer */
+        std::atomic<std::uint32_t> m_tail = 0; /** index of the next value to pop, only written by the consumer */
+        std::atomic<std::uint32_t> m_dropped = 0;
+        std::optional<pros::Task> m_notify;
+};
+
+/**
+ * @brief Lock-free multiple producer, single consumer queue
+ *
+ * A MPSCQueue lets any number of tasks push values, and one task pop them, without using a mutex. Like SPSCQueue, it
+ * has fixed storage, drops values when it is full, and can notify a task when a value is pushed.
+ *
+ * Each slot has a sequence number, which tells producers when the slot is free and the consumer when it holds a value.
+ * Producers claim a slot with a compare-and-swap, which only has to be retried if another producer claimed the slot
+ * first. Popping is wait-free. If a producer is preempted after claiming a slot, but before writing it, the consumer
+ * sees the queue as empty until the producer finishes, rather than waiting for it.
+ *
+ * @tparam T the type of value to store. It should be cheap to copy
+ * @tparam N the maximum number of values in the queue. Must be a power of 2
+ *
+ * @b Example:
+ * @code {.cpp}
+ * lemlib::MPSCQueue<int, 16> queue;
+ *
+ * void producer1() { queue.push(1); }
+ *
+ * void producer2() { queue.push(2); }
+ *
+ * void consumer() {
+ *     while (std::optional<int> value = queue.pop()) std::cout << *value << std::endl;
+ * }
+ * @endcode
+ */
+template <typename T, std::size_t N> class MPSCQueue {
+        static_assert(N > 0 && (N & (N - 1)) == 0, "The capacity of a MPSCQueue must be a power of 2");
+    public:
+        /**
+         * @brief Construct a new MPSCQueue object
+         *
+         * @param notify the task to notify when a value is pushed, usually the consumer
+         */
+        explicit MPSCQueue(std::optional<pros::Task> notify = std::nullopt) : m_notify(notify) {
+            for (std::size_t i = 0; i < N; i++) m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief push a value to the queue
+         *
+         * This function never blocks, and can be called from any task
+         *
+         * @param value the value to push
+         * @return true the value was pushed
+         * @return false the queue is full, the value was dropped
+         */
+        bool push(const T& value) {
+            std::uint32_t head = m_head.load(std::memory_order_relaxed);
+            Cell* cell;
+            while (true) {
+                cell = &m_cells[head & MASK];
+                const std::int32_t diff =
+                    static_cast<std::int32_t>(cell->sequence.load(std::memory_order_acquire) - head);
+                if (diff == 0) {
+                    // the slot is free, try to claim it. On failure, head is updated to the new value
+                    if (m_head.compare_exchange_weak(head, head + 1, std::memory_order_relaxed)) break;
+                } else if (diff < 0) {
+                    // the slot still holds a value from the previous lap, so the queue is full
+                    m_dropped.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                } else {
+                    // another producer claimed the slot first
+                    head = m_head.load(std::memory_order_relaxed);
+                }
+            }
+            cell->value = value;
+            // publish the value to the consumer
+            cell->sequence.store(head + 1, std::memory_order_release);
+            if (m_notify) m_notify->notify();
+            return true;
+        }
+
+        /**
+         * @brief pop the oldest value from the queue
+         *
+         * This function never blocks. It may only be called by the consumer.
+         *
+         * @return std::optional<T> the oldest value, or std::nullopt if the queue is empty
+         */
+        std::optional<T> pop() {
+            const std::uint32_t tail = m_tail.load(std::memory_order_relaxed);
+            Cell& cell = m_cells[tail & MASK];
+            // the value hasn't been written yet
+            if (cell.sequence.load(std::memory_order_acquire) != tail + 1) return std::nullopt;
+            const T value = cell.value;
+            // free the slot for the next lap
+            cell.sequence.store(tail + N, std::memory_order_release);
+            m_tail.store(tail + 1, std::memory_order_release);
+            return value;
+        }
+
+        /**
+         * @brief pop as many values as fit in a span, oldest first
+         *
+         * This function never blocks. It may only be called by the consumer.
+         *
+         * @param out where to store the values
+         * @return std::size_t the number of values popped
+         */
+        std::size_t pop(std::span<T> out) {
+            std::size_t count = 0;
+            while (count < out.size()) {
+                std::optional<T> value = pop();
+                if (!value) break;
+                out[count++] = *value;
+            }
+            return count;
+        }
+
+        /**
+         * @brief get the number of values in the queue
+         *
+         * The result is only a snapshot, as other tasks may push or pop at any time. It includes values that are still
+         * being written.
+         *
+         * @return std::size_t the number of values in the queue
+         */
+        std::size_t size() const {
+            return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_acquire);
+        }
+
+        /**
+         * @brief whether the queue is empty
+         *
+         * @return true the queue is empty
+         * @return false the queue is not empty
+         */
+        bool empty() const { return size() == 0; }
+
+        /**
+         * @brief get the maximum number of values in the queue
+         *
+         * @return std::size_t the capacity of the queue
+         */
+        static constexpr std::size_t capacity() { return N; }
+
+        /**
+         * @brief get the number of values dropped because the queue was full
+         *
+         * @return std::uint32_t the number of values dropped
+         */
+        std::uint32_t getDropped() const { return m_dropped.load(std::memory_order_relaxed); }
+    private:
+        static constexpr std::uint32_t MASK = N - 1;
+
+        struct Cell {
+                std::atomic<std::uint32_t> sequence; /** tail + 1 when the cell holds a value, head when it is free */
+                T value {};
+        };
+
+        std::array<Cell, N> m_cells;
+        std::atomic<std::uint32_t> m_head = 0; /** index of the next slot to claim */
+        std::atomic<std::uint32_t> m_tail = 0; /** index of the next value to pop, only written by the consumer */
+        std::atomic<std::uint32_t> m_dropped = 0;
+        std::optional<pros::Task> m_notify;
+};
+} // namespace lemlib
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace lemlib {
+/**
+ * @brief Lock-free single value publisher
+ *
+ * A Snapshot lets one task publish a value, and any number of tasks read the latest published value, without using a
+ * mutex. This means a low priority task reading the value can never block a high priority task publishing it, which
+ * would cause priority inversion.
+ *
+ * The value is stored in two slots, each guarded by a sequence counter. The publisher writes to the slot readers are
+ * not using, then switches readers over to it. A reader that preempts the publisher mid-write reads the other slot,
+ * which is complete, so it never has to wait for the publisher. On a single core, waiting for a lower priority
+ * publisher would never end. A reader that was preempted by the publisher retries, so readers always get a consistent
+ * value, never half of an old one and half of a new one.
+ *
+ * Only one task may publish to a Snapshot.
+ *
+ * @tparam T the type of value to publish. It should be cheap to copy
+ *
+ * @b Example:
+ * @code {.cpp}
+ * lemlib::Snapshot<units::Pose> pose;
+ *
+ * void producer() {
+ *     pose.publish(units::Pose(1_in, 2_in, 90_cDeg));
+ * }
+ *
+ * void consumer() {
+ *     const units::Pose current = pose.read();
+ * }
+ * @endcode
+ */
+template <typename T> class Snapshot {
+    public:
+        /**
+         * @brief Construct a new Snapshot object
+         *
+         * @param initial the initial value
+         */
+        Snapshot(const T& initial = T()) {
+            m_slots[0].value = initial;
+            m_slots[1].value = initial;
+        }
+
+        /**
+         * @brief publish a new value
+         *
+         * This function never blocks. It may only be called by one task.
+         *
+         * @param value the value to publish
+         */
+        void publish(const T& value) {
+            const std::uint32_t index = 1 - m_current.load(std::memory_order_relaxed);
+            Slot& slot = m_slots[index];
+            const std::uint32_t sequence = slot.sequence.load(std::memory_order_relaxed);
+            // an odd sequence number tells readers that a write is in progress
+            slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            slot.value = value;
+            slot.sequence.store(sequence + 2, std::memory_order_release);
+            // switch readers over to the new value
+            m_current.store(index, std::memory_order_release);
+            m_version.fetch_add(1, std::memory_order_release);
+        }
+
+        /**
+         * @brief read the latest published value
+         *
+         * This function does not block the publisher. If a publish overwrites the value while it is being copied, the
+         * copy is retried.
+         *
+         * @return T the latest published value
+         */
+        T read() const {
+            while (true) {
+                const Slot& slot = m_slots[m_current.load(std::memory_order_acquire)];
+                const std::uint32_t before = slot.sequence.load(std::memory_order_acquire);
+                // the publisher has already started overwriting this slot, so there is a newer value
+                if (before & 1) continue;
+                const T value = slot.value;
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (slot.sequence.load(std::memory_order_relaxed) == before) return value;
+            }
+        }
+
+        /**
+         * @brief get the number of values that have been published
+         *
+         * This can be used to check whether a new value has been published since the last read
+         *
+         * @return std::uint32_t the number of values published
+         */
+        std::uint32_t getVersion() const { return m_version.load(std::memory_order_acquire); }
+    private:
+        struct Slot {
+                std::atomic<std::uint32_t> sequence = 0;
+                T value;
+        };
+
+        Slot m_slots[2];
+        std::atomic<std::uint32_t> m_current = 0;
+        std::atomic<std::uint32_t> m_version = 0;
+};
+} // namespace lemlib
@@ -0,0 +1,206 @@
+#pragma once
+
+#include "hardware/concurrency/Snapshot.hpp"
+#include "hardware/distance/DistanceSensor.hpp"
+#include "pros/rtos.hpp"
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits.h>
+
+namespace lemlib {
+/**
+ * @brief The filtered reading of a single distance sensor
+ */
+struct FilteredDistance {
+        Length distance = 0_m; /** confidence weighted median of the recent readings */
+        Number confidence = Number(0); /** mean confidence of the recent readings, from 0 to 1 */
+        LinearVelocity objectVelocity = 0_mps; /** velocity of the object in the latest reading */
+        Time time = 0_sec; /** time of the latest reading, since PROS initialized */
+        bool valid = false; /** whether there are any recent readings */
+};
+
+/**
+ * @brief Samples a set of distance sensors together, and filters their readings
+ *
+ * Each update reads every sensor in a single pass, filters the readings, and publishes the results for all sensors
+ * at once through a Snapshot. This way, code using several sensors together, like localization, always gets readings
+ * taken at the same time.
+ *
+ * The filter keeps a window of the most recent readings of each sensor:
+ * - readings with a confidence below the minimum, or which failed, are dropouts, and aren't added to the window
+ * - readings identical to the previous reading are repeats of the same device update, so they aren't added either.
+ *   They still show the sensor is working, so a robot sitting still keeps a valid result
+ * - the filtered distance is the median of the window, with each reading weighted by its confidence
+ * - if there hasn't been a confident reading for longer than the timeout, the window is cleared and the result is
+ *   invalid
+ *
+ * @tparam N the number of sensors
+ * @tparam W the number of readings in the window of each sensor
+ *
+ * @b Example:
+ * @code {.cpp}
+ * lemlib::V5Distance front = pros::Distance(1);
+ * lemlib::V5Distance left = pros::Distance(2);
+ * lemlib::V5Distance right = pros::Distance(3);
+ * lemlib::V5Distance back = pros::Distance(4);
+ * lemlib::DistanceFilter<4> distances({&front, &left, &right, &back});
+ *
+ * void opcontrol() {
+ *     while (true) {
+ *         distances.update();
+ *         for (const lemlib::FilteredDistance& reading : distances.get()) {
+ *             if (reading.valid) std::cout << to_in(reading.distance) << std::endl;
+ *         }
+ *         pros::delay(10);
+ *     }
+ * }
+ * @endcode
+ */
+template <std::size_t N, std::size_t W = 5> class DistanceFilter {
+        static_assert(W > 0, "The window of a DistanceFilter must hold at least 1 reading");
+    public:
+        /**
+         * @brief Construct a new DistanceFilter object
+         *
+         * @param sensors the sensors to sample. Must outlive the filter
+         * @param minConfidence readings with a lower confidence are ignored
+         * @param timeout how long a sensor can go without a confident reading before its result is invalid
+         */
+        DistanceFilter(const std::array<DistanceSensor*, N>& sensors, Number minConfidence = Number(0.25),
+                       Time timeout = 500_msec)
+            : m_sensors(sensors),
+              m_minConfidence(minConfidence),
+              m_timeout(timeout) {}
+
+        /**
+         * @brief Sample every sensor, and publish the filtered results
+         *
+         * This function should be called periodically by a single task. The results are published even if some
+         * sensors fail.
+         *
+         * This function uses the errno values of the sensors when an error state is reached
+         *
+         * @return 0 on success
+         * @return INT_MAX if any sensor failed, setting errno
+         */
+        int update() {
+            int result = 0;
+            std::array<FilteredDistance, N> results;
+            const Time now = from_usec(pros::micros());
+            for (std::size_t i = 0; i < N; i++) {
+                if (sample(i, now) == INT_MAX) result = INT_MAX;
+                results[i] = filter(i, now);
+            }
+            m_results.publish(results);
+            return result;
+        }
+
+        /**
+         * @brief Get the latest results of all sensors
+         *
+         * This function never blocks, and can be called from any task
+         *
+         * @return std::array<FilteredDistance, N> the results, in the same order as the sensors
+         */
+        std::array<FilteredDistance, N> get() const { return m_results.read(); }
+
+        /**
+         * @brief Get the latest result of a single sensor
+         *
+         * @param index the index of the sensor
+         * @return FilteredDistance the result
+         */
+        FilteredDistance get(std::size_t index) const { return m_results.read()[index]; }
+    private:
+        /**
+         * @brief the recent readings of a single sensor
+         */
+        struct Window {
+                std::array<double, W> distances {}; /** meters */
+                std::array<double, W> confidences {};
+                std::size_t count = 0;
+                std::size_t next = 0;
+                double lastDistance = NAN; /** the last reading, used to detect repeats */
+                double lastConfidence = NAN;
+                LinearVelocity objectVelocity = 0_mps;
+                Time time = 0_sec; /** time of the latest confident reading, including repeats */
+        };
+
+        /**
+         * @brief read a sensor, and add the reading to its window if it is new
+         */
+        int sample(std::size_t index, Time now) {
+            DistanceSensor* sensor = m_sensors[index];
+            Window& window = m_windows[index];
+            // the distance and confidence have to come from the same device update
+            const auto [distance, confidence] = sensor->getReading();
+            if (distance == from_m(INFINITY) || confidence == Number(INFINITY)) return INT_MAX;
+            // once the window was cleared, the reading is new even if it is the same as before
+            const bool repeat = window.count > 0 && distance.internal() == window.lastDistance &&
+                                confidence.internal() == window.lastConfidence;
+            window.lastDistance = distance.internal();
+            window.lastConfidence = confidence.internal();
+            if (confidence < m_minConfidence) return 0;
+            // repeats of the last device update don't add any information, but the sensor is still working
+            if (repeat) {
+                window.time = now;
+                return 0;
+            }
+            const LinearVelocity velocity = sensor->getObjectVelocity();
+            if (velocity == from_mps(INFINITY)) return INT_MAX;
+            window.distances[window.next] = distance.internal();
+            window.confidences[window.next] = confidence.internal();
+            window.next = (window.next + 1) % W;
+            if (window.count < W) window.count++;
+            window.objectVelocity = velocity;
+            window.time = now;
+            return 0;
+        }
+
+        /**
+         * @brief calculate the filtered result of a sensor from its window
+         */
+        FilteredDistance filter(std::size_t index, Time now) {
+            Window& window = m_windows[index];
+            // drop old readings, so a sensor that keeps failing or losing the object isn't trusted
+            if (window.count > 0 && now - window.time > m_timeout) window.count = 0;
+            if (window.count == 0) return FilteredDistance();
+            // sort the readings by distance, the window is small so insertion sort is fastest
+            std::array<std::size_t, W> order;
+            double totalConfidence = 0;
+            for (std::size_t i = 0; i < window.count; i++) {
+                std::size_t j = i;
+                while (j > 0 && window.distances[order[j - 1]] > window.distances[i]) {
+                    order[j] = order[j - 1];
+                    j--;
+                }
+                order[j] = i;
+                totalConfidence += window.confidences[i];
+            }
+            // the weighted median is the first reading where the cumulative confidence reaches half of the total
+            double cumulative = 0;
+            std::size_t median = order[window.count - 1];
+            for (std::size_t i = 0; i < window.count; i++) {
+                cumulative += window.confidences[order[i]];
+                if (cumulative >= totalConfidence / 2) {
+                    median = order[i];
+                    break;
+                }
+            }
+            FilteredDistance result;
+            result.distance = from_m(window.distances[median]);
+            result.confidence = Number(totalConfidence / window.count);
+            result.objectVelocity = window.objectVelocity;
+            result.time = window.time;
+            result.valid = true;
+            return result;
+        }
+
+        std::array<DistanceSensor*, N> m_sensors;
+        Number m_minConfidence;
+        Time m_timeout;
+        std::array<Window, N> m_windows {};
+        Snapshot<std::array<FilteredDistance, N>> m_results;
+};
+} // namespace lemlib
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "units/units.hpp"
+
+namespace lemlib {
+/**
+ * @brief A distance and its confidence, measured together
+ */
+struct DistanceReading {
+        Length distance = 0_m; /** the distance measured by the sensor */
+        Number confidence = Number(0); /** the confidence of the sensor in the distance, from 0 to 1 */
+};
+
+class DistanceSensor {
+    public:
+        /**
+         * @brief whether the distance sensor is connected
+         *
+         * @return true the distance sensor is connected
+         * @return false the distance sensor is not connected
+         * @return INT_MAX error occurred, setting errno
+         */
+        virtual int isConnected() = 0;
+        /**
+         * @brief Get the distance to the object in front of the sensor
+         *
+         * @return Length the distance measured by the sensor
+         * @return INFINITY error occurred, setting errno
+         */
+        virtual Length getDistance() = 0;
+        /**
+         * @brief Get how confident the sensor is in the distance it measured
+         *
+         * The confidence ranges from 0 (no confidence) to 1 (full confidence). If the sensor can't detect an object,
+         * the confidence is 0.
+         *
+         * @return Number the confidence of the sensor
+         * @return INFINITY error occurred, setting errno
+         */
+        virtual Number getConfidence() = 0;
+        /**
+         * @brief Get the distance and the confidence of the sensor in it, from the same measurement
+         *
+         * Sensors which read the distance to calculate the confidence should override this, so the distance is only
+         * read once
+         *
+         * @return DistanceReading the distance and confidence
+         * @return INFINITY distance or confidence if an error occurred, setting errno
+         */
+        virtual DistanceReading getReading() {
+            const Length distance = getDistance();
+            if (distance == from_m(INFINITY)) return {distance, Number(INFINITY)};
+            return {distance, getConfidence()};
+        }
+        /**
+         * @brief Get the velocity of the object in front of the sensor
+         *
+         * The velocity is positive when the object is moving away from the sensor
+         *
+         * @return LinearVelocity the velocity of the object
+         * @return INFINITY error occurred, setting errno
+         */
+        virtual LinearVelocity getObjectVelocity() = 0;
+        virtual ~DistanceSensor() = default;
+};
+} // namespace lemlib
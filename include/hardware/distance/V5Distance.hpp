@@ -0,0 +1,102 @@
+#pragma once
+
+#include "hardware/distance/DistanceSensor.hpp"
+#include "pros/distance.hpp"
+
+namespace lemlib {
+class V5Distance : public DistanceSensor {
+    public:
+        /**
+         * @brief Construct a new V5 Distance Sensor
+         *
+         * @param sensor the distance sensor
+         *
+         * @b Example:
+         * @code {.cpp}
+         * void initialize() {
+         *    // Create a new V5 Distance Sensor on port 1
+         *    lemlib::V5Distance sensor = pros::Distance(1);
+         * }
+         * @endcode
+         */
+        V5Distance(pros::Distance sensor);
+        /**
+         * @brief whether the V5 Distance Sensor is connected
+         *
+         * @return true the sensor is connected
+         * @return false the sensor is not connected
+         */
+        int isConnected() override;
+        /**
+         * @brief Get the distance to the object in front of the sensor
+         *
+         * If the sensor can't detect an object, the maximum range of the sensor (9999mm) is returned.
+         *
+         * This function uses the following values of errno when an error state is reached:
+         *
+         * ENXIO: the port is not within the range of valid ports (1-21)
+         * ENODEV: the port cannot be configured as a V5 Distance Sensor
+         *
+         * @return Length the distance measured by the sensor
+         * @return INFINITY error occurred, setting errno
+         *
+         * @b Example:
+         * @code {.cpp}
+         * void initialize() {
+         *     lemlib::V5Distance sensor = pros::Distance(1);
+         *     const Length distance = sensor.getDistance();
+         *     if (distance == from_in(INFINITY)) {
+         *         std::cout << "Error getting distance!" << std::endl;
+         *     } else {
+         *         std::cout << "Distance: " << to_in(distance) << std::endl;
+         *     }
+         * }
+         * @endcode
+         */
+        Length getDistance() override;
+        /**
+         * @brief Get how confident the sensor is in the distance it measured
+         *
+         * The sensor only measures confidence for objects further than 200mm away. Closer objects are measured
+         * accurately, so they have a confidence of 1.
+         *
+         * This function uses the following values of errno when an error state is reached:
+         *
+         * ENXIO: the port is not within the range of valid ports (1-21)
+         * ENODEV: the port cannot be configured as a V5 Distance Sensor
+         *
+         * @return Number the confidence, from 0 to 1
+         * @return INFINITY error occurred, setting errno
+         */
+        Number getConfidence() override;
+        /**
+         * @brief Get the distance and the confidence of the sensor in it, from the same measurement
+         *
+         * The distance is only read once, so the confidence always belongs to the returned distance, even if the
+         * sensor updates in between.
+         *
+         * This function uses the following values of errno when an error state is reached:
+         *
+         * ENXIO: the port is not within the range of valid ports (1-21)
+         * ENODEV: the port cannot be configured as a V5 Distance Sensor
+         *
+         * @return DistanceReading the distance and confidence
+         * @return INFINITY distance or confidence if an error occurred, setting errno
+         */
+        DistanceReading getReading() override;
+        /**
+         * @brief Get the velocity of the object in front of the sensor
+         *
+         * This function uses the following values of errno when an error state is reached:
+         *
+         * ENXIO: the port is not within the range of valid ports (1-21)
+         * ENODEV: the port cannot be configured as a V5 Distance Sensor
+         *
+         * @return LinearVelocity the velocity of the object
+         * @return INFINITY error occurred, setting errno
+         */
+        LinearVelocity getObjectVelocity() override;
+    private:
+        pros::Distance m_sensor;
+};
+} // namespace lemlib
@@ -2,11 +2,15 @@
 
 #include "hardware/encoder/Encoder.hpp"
 #include "pros/adi.hpp"
+#include <atomic>
+#include <cstdint>
 
 namespace lemlib {
 /**
- * @brief Encoder implementation for the Optical Shaft Encoder
+ * @brief Encoder implementation for the Optical Shaft Encoder, or any other quadrature encoder on the ADI ports
  *
+ * The 32 bit tick count reported by VEXOS is unwrapped into a 64 bit count, so the angle never overflows. Setting the
+ * angle does not reset the hardware counter, so no ticks are lost, and it is safe to call from any task.
  */
 class ADIEncoder : public Encoder {
     public:
@@ -16,16 +20,22 @@ class ADIEncoder : public Encoder {
          * Even though VEXOS knows whether the encoder is reversed, it has no API to get this information. As such, its
          * necessary to pass this info to the constructor.
          *
+         * The Optical Shaft Encoder measures 360 ticks per rotation. Custom quadrature encoders may measure a different
+         * number of ticks per rotation, counting every edge of both channels.
+         *
          * @param encoder the pros::ADIEncoder object to use
-         * @param reversed whether the encoder is reversed or not
+         * @param ticksPerRotation the number of ticks the encoder measures in one rotation. If it isn't positive, every
+         * function fails with EINVAL
          *
          * @b Example:
          * @code {.cpp}
          * void initialize() {
          *     lemlib::ADIEncoder encoder = pros::adi::Encoder('A', 'B');
+         *     // custom encoder with a 500 line disk
+         *     lemlib::ADIEncoder custom(pros::adi::Encoder('C', 'D'), 2000);
          * }
          */
-        ADIEncoder(pros::adi::Encoder encoder);
+        ADIEncoder(pros::adi::Encoder encoder, int ticksPerRotation = 360);
         /**
          * @brief whether the encoder is connected
          *
@@ -37,6 +47,8 @@ class ADIEncoder : public Encoder {
          *
          * ENODEV: the port could not be configured as an encoder
          *
+         * EINVAL: the number of ticks per rotation isn't positive
+         *
          * @return 1 if there are no errors
          * @return INT_MAX if there is an error, setting errno
          */
@@ -52,6 +64,8 @@ class ADIEncoder : public Encoder {
          *
          * ENODEV: the port could not be configured as an encoder
          *
+         * EINVAL: the number of ticks per rotation isn't positive
+         *
          * @return Angle the relative angle of the encoder
          * @return INFINITY if there is an error, setting errno
          *
@@ -79,6 +93,8 @@ class ADIEncoder : public Encoder {
          *
          * ENODEV: the port could not be configured as an encoder
          *
+         * EINVAL: the number of ticks per rotation isn't positive
+         *
          * @param angle the angle to set the measured angle to
          * @return 0 on success
          * @return INT_MAX on failure, setting errno
@@ -97,8 +113,61 @@ class ADIEncoder : public Encoder {
          * }
          */
         int setAngle(Angle angle) override;
+        /**
+         * @brief Get the velocity of the encoder
+         *
+         * The velocity is estimated from the time between changes in the tick count, rather than the change in ticks
+         * over a fixed time. At low speeds, where only a few ticks are counted per call, this is much more accurate.
+         * If no tick has been counted for a while, the velocity decays towards 0, as it can be at most 1 tick over the
+         * time since the last tick. After 100ms without a tick the encoder is at a standstill, and the velocity is 0.
+         * The first ticks after a standstill are measured over at most 100ms, so they don't read as a tiny velocity.
+         *
+         * This function keeps the state of the estimate, so it should be called periodically by a single task.
+         *
+         * This function uses the following values of errno when an error state is reached:
+         *
+         * ENODEV: the port could not be configured as an encoder
+         *
+         * EINVAL: the number of ticks per rotation isn't positive
+         *
+         * @return AngularVelocity the velocity of the encoder
+         * @return INFINITY if there is an error, setting errno
+         *
+         * @b Example:
+         * @code {.cpp}
+         * void opcontrol() {
+         *     lemlib::ADIEncoder encoder = pros::adi::Encoder('A', 'B');
+         *     while (true) {
+         *         std::cout << "Velocity: " << to_rpm(encoder.getVelocity()) << std::endl;
+         *         pros::delay(10);
+         *     }
+         * }
+         * @endcode
+         */
+        AngularVelocity getVelocity();
     private:
+        /**
+         * @brief read the hardware counter and unwrap it into a 64 bit count
+         *
+         * @param count where to store the unwrapped count
+         * @return 0 on success
+         * @return INT_MAX on failure, setting errno
+         */
+        int readTicks(std::int64_t& count);
+        /**
+         * @brief convert a tick count to an angle
+         */
+        Angle toAngle(double ticks) const;
+
         pros::adi::Encoder m_encoder;
-        Angle m_offset = 0_stDeg;
+        int m_ticksPerRotation;
+        std::atomic<std::int64_t> m_count = 0; /** last unwrapped tick count */
+        std::atomic<std::int64_t> m_offset = 0; /** ticks added to the count to get the relative angle */
+
+        // velocity estimate, only accessed by getVelocity
+        bool m_velocityInitialized = false;
+        std::int64_t m_lastChangeCount = 0;
+        std::uint64_t m_lastChangeTime = 0; /** microseconds */
+        double m_ticksPerMicrosecond = 0;
 };
 } // namespace lemlib
\ No newline at end of file
@@ -1,12 +1,37 @@
 #pragma once
 
+#include "hardware/concurrency/Queue.hpp"
+#include "hardware/concurrency/Snapshot.hpp"
 #include "hardware/encoder/Encoder.hpp"
 #include "pros/rotation.hpp"
+#include "pros/rtos.hpp"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
 
 namespace lemlib {
+/**
+ * @brief A single measurement taken by the Rotation sensor sampler
+ */
+struct RotationSample {
+        std::int64_t position = 0; /** exact relative position, in centidegrees */
+        Angle angle = 0_stRad; /** relative angle */
+        AngularVelocity velocity = 0_degps; /** velocity measured by the sensor */
+        Time time = 0_sec; /** time the sample was taken, since PROS initialized */
+};
+
 /**
  * @brief Encoder implementation for the V5 Rotation sensor
  *
+ * The sensor measures position in integer centidegrees, which are used directly, so precision does not decrease as
+ * the angle grows.
+ *
+ * By default, each function call reads the sensor. The sensor can also be read by a sampler task, at up to the
+ * fastest data rate of the sensor (5ms). The sampler accumulates the position in 64 bits, so it never overflows, and
+ * pushes every sample to a buffer. This way, code running slower than the sensor, like a 10ms control loop, can
+ * process every sample instead of only the latest one.
  */
 class Rotation : public Encoder {
     public:
@@ -102,7 +127,132 @@ class Rotation : public Encoder {
          * @endcode
          */
         int setAngle(Angle angle) override;
+        /**
+         * @brief Get the velocity measured by the encoder
+         *
+         * The velocity is measured by the sensor itself, so it has less noise than the derivative of the angle.
+         * If the sampler is running, the velocity of the latest sample is returned.
+         *
+         * This function uses the following values of errno when an error state is reached:
+         *
+         * ENXIO: the port is not within the range of valid ports (1-21)
+         * ENODEV: the port cannot be configured as an V5 Rotation sensor
+         *
+         * @return AngularVelocity the velocity measured by the encoder
+         * @return INFINITY if there is an error, setting errno
+         *
+         * @b Example:
+         * @code {.cpp}
+         * void initialize() {
+         *     lemlib::Rotation encoder = pros::Rotation(1);
+         *     const AngularVelocity velocity = encoder.getVelocity();
+         *     if (velocity == from_rpm(INFINITY)) {
+         *         std::cout << "Error getting velocity!" << std::endl;
+         *     } else {
+         *         std::cout << "Velocity: " << to_rpm(velocity) << std::endl;
+         *     }
+         * }
+         * @endcode
+         */
+        AngularVelocity getVelocity();
+        /**
+         * @brief Set how often the sensor sends new data
+         *
+         * The sensor sends new data every 10ms by default. The data rate is rounded to a multiple of 5ms, and can't be
+         * faster than 5ms.
+         *
+         * This function uses the following values of errno when an error state is reached:
+         *
+         * ENXIO: the port is not within the range of valid ports (1-21)
+         * ENODEV: the port cannot be configured as an V5 Rotation sensor
+         *
+         * @param rate the time between updates
+         * @return 0 on success
+         * @return INT_MAX on failure, setting errno
+         */
+        int setDataRate(Time rate);
+        /**
+         * @brief Start reading the sensor in a sampler task
+         *
+         * This also sets the data rate of the sensor to the sampling period. While the sampler is running, getAngle()
+         * and getVelocity() return the latest sample without reading the sensor, and setAngle() is applied by the
+         * sampler before its next sample. If the sampler is already running, this function does nothing.
+         *
+         * This function uses the following values of errno when an error state is reached:
+         *
+         * ENXIO: the port is not within the range of valid ports (1-21)
+         * ENODEV: the port cannot be configured as an V5 Rotation sensor
+         *
+         * @param period the time between samples. Can't be faster than 5ms
+         * @param priority the priority of the sampler task
+         * @return 0 on success
+         * @return INT_MAX on failure, setting errno
+         *
+         * @b Example:
+         * @code {.cpp}
+         * lemlib::Rotation encoder = pros::Rotation(1);
+         *
+         * void initialize() {
+         *     encoder.startSampling(5_msec);
+         * }
+         *
+         * void opcontrol() {
+         *     std::array<lemlib::RotationSample, 8> samples;
+         *     while (true) {
+         *         // process every sample since the last loop
+         *         const std::size_t count = encoder.readSamples(samples);
+         *         for (std::size_t i = 0; i < count; i++) std::cout << to_stDeg(samples[i].angle) << std::endl;
+         *         pros::delay(10);
+         *     }
+         * }
+         * @endcode
+         */
+        int startSampling(Time period = 5_msec, std::uint32_t priority = TASK_PRIORITY_MAX - 1);
+        /**
+         * @brief Stop the sampler task
+         *
+         * The angle measured by the sampler is kept, so getAngle() does not jump. Samples that have not been read
+         * are discarded.
+         */
+        void stopSampling();
+        /**
+         * @brief Read the samples taken since the last call, oldest first
+         *
+         * Only one task may read samples. If samples are not read fast enough, the buffer fills up and new samples are
+         * dropped. The buffer holds SAMPLE_CAPACITY samples.
+         *
+         * @param out where to store the samples
+         * @return std::size_t the number of samples read. 0 if the sampler is not running
+         */
+        std::size_t readSamples(std::span<RotationSample> out);
+        /**
+         * @brief Get the number of samples dropped because they were not read fast enough
+         *
+         * @return std::uint32_t the number of samples dropped since the sampler was started
+         */
+        std::uint32_t getDroppedSamples() const;
+        ~Rotation();
+
+        static constexpr std::size_t SAMPLE_CAPACITY = 64; /** the number of samples the sampler can buffer */
     private:
+        /**
+         * @brief state shared with the sampler task
+         */
+        struct Sampler {
+                SPSCQueue<RotationSample, SAMPLE_CAPACITY> samples;
+                Snapshot<RotationSample> latest;
+                Snapshot<std::int64_t> requestedPosition;
+                std::atomic<bool> running = true;
+                std::optional<pros::Task> task;
+        };
+
+        /**
+         * @brief the loop run by the sampler task
+         */
+        void sample(std::uint32_t periodMs, std::int32_t position, std::int64_t accumulated);
+
         pros::Rotation m_encoder;
+        std::unique_ptr<Sampler> m_sampler;
+        std::int64_t m_offset = 0; /** position kept from the sampler after it stops, in centidegrees */
 };
 } // namespace lemlib
\ No newline at end of file
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "hardware/encoder/Encoder.hpp"
+#include "hardware/serial/SerialPort.hpp"
+#include <atomic>
+#include <cstdint>
+
+namespace lemlib {
+/**
+ * @brief Encoder implementation for a custom encoder connected through a SerialPort
+ *
+ * The device sends the tick count of the encoder on a channel of the port. See SerialPort for the frame format.
+ */
+class SerialEncoder : public Encoder {
+    public:
+        /**
+         * @brief Construct a new SerialEncoder object
+         *
+         * @param port the port the device is connected to. Must outlive the encoder
+         * @param channel the channel the device sends the tick count on
+         * @param ticksPerRotation the number of ticks the encoder measures in one rotation
+         * @param timeout how long the encoder can go without sending a value before it is considered disconnected
+         *
+         * @b Example:
+         * @code {.cpp}
+         * lemlib::SerialPort coprocessor(1, 115200);
+         * // encoder with 8192 ticks per rotation on channel 0
+         * lemlib::SerialEncoder encoder(&coprocessor, 0, 8192);
+         * @endcode
+         */
+        SerialEncoder(SerialPort* port, std::uint8_t channel, int ticksPerRotation, Time timeout = 100_msec);
+        /**
+         * @brief whether the encoder is connected
+         *
+         * The encoder is connected if it has sent a value within the timeout
+         *
+         * @return 0 if its not connected
+         * @return 1 if it is connected
+         */
+        int isConnected() override;
+        /**
+         * @brief Get the relative angle measured by the encoder
+         *
+         * This function uses the following values of errno when an error state is reached:
+         *
+         * ENODEV: the encoder has not sent a value within the timeout
+         *
+         * @return Angle the relative angle measured by the encoder
+         * @return INFINITY if there is an error, setting errno
+         *
+         * @b Example:
+         * @code {.cpp}
+         * void opcontrol() {
+         *     const Angle angle = encoder.getAngle();
+         *     if (angle == from_stDeg(INFINITY)) {
+         *         std::cout << "Error getting relative angle!" << std::endl;
+         *     } else {
+         *         std::cout << "Relative angle: " << to_stDeg(angle) << std::endl;
+         *     }
+         * }
+         * @endcode
+         */
+        Angle getAngle() override;
+        /**
+         * @brief Set the relative angle of the encoder
+         *
+         * The device is not told about the new angle, an offset is saved instead. This function is non-blocking.
+         *
+         * This function uses the following values of errno when an error state is reached:
+         *
+         * ENODEV: the encoder has not sent a value within the timeout
+         *
+         * @param angle the relative angle to set the measured angle to
+         * @return 0 on success
+         * @return INT_MAX on failure, setting errno
+         */
+        int setAngle(Angle angle) override;
+    private:
+        /**
+         * @brief get the latest tick count, if it is recent enough
+         *
+         * @return 0 on success
+         * @return INT_MAX on failure, setting errno
+         */
+        int readTicks(std::int32_t& ticks);
+
+        SerialPort* m_port;
+        std::uint8_t m_channel;
+        int m_ticksPerRotation;
+        Time m_timeout;
+        std::atomic<std::int64_t> m_offset = 0; /** ticks added to the tick count to get the relative angle */
+};
+} // namespace lemlib
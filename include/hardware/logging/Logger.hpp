@@ -0,0 +1,251 @@
+#pragma once
+
+#include "pros/rtos.hpp"
+#include "units/units.hpp"
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <limits.h>
+#include <optional>
+#include <type_traits>
+
+namespace lemlib {
+/**
+ * @brief Logs fixed size binary records to a file, usually on the SD card, without blocking the code logging them
+ *
+ * Writing to the SD card can take several milliseconds, which is far too long to wait for in a control loop. Instead,
+ * records are copied into one of two buffers. When that buffer is full, or has held records for longer than the flush
+ * period, the buffers are swapped, and a low priority task writes the full buffer to the file in one large write while
+ * the other buffer is filled. If the task hasn't finished writing when the second buffer is full, new records are
+ * dropped and counted, so logging never blocks.
+ *
+ * All memory is part of the Logger object, the buffers are never resized.
+ *
+ * The file starts with an 8 byte header: the characters "LLOG", then the size of each record as a little endian 32 bit
+ * integer. The records follow, with no padding between them, in the memory layout of the robot.
+ *
+ * The same code runs on a computer, without the task: call flush() instead to write the full buffer. This makes it easy
+ * to test code which reads the log files.
+ *
+ * @tparam T the type of the records. Must be trivially copyable
+ * @tparam N the number of records in each buffer
+ *
+ * @b Example:
+ * @code {.cpp}
+ * struct Record {
+ *     std::uint32_t time;
+ *     float left;
+ *     float right;
+ * };
+ *
+ * lemlib::Logger<Record> logger("/usd/drive.bin");
+ *
+ * void autonomous() {
+ *     if (logger.start() == INT_MAX) std::cout << "Could not open the log file!" << std::endl;
+ *     while (true) {
+ *         logger.append({pros::millis(), leftVelocity, rightVelocity});
+ *         pros::delay(10);
+ *     }
+ * }
+ * @endcode
+ */
+template <typename T, std::size_t N = 512> class Logger {
+        static_assert(std::is_trivially_copyable_v<T>, "Logger records must be trivially copyable");
+        static_assert(N > 0, "The buffers of a Logger must hold at least 1 record");
+    public:
+        /**
+         * @brief Construct a new Logger object
+         *
+         * The file is not opened until open() or start() is called
+         *
+         * @param path the path of the file. Files on the SD card start with /usd/
+         * @param flushPeriod the longest time a record waits in a buffer before the buffers are swapped
+         */
+        Logger(const char* path, Time flushPeriod = 1_sec)
+            : m_path(path),
+              m_flushPeriod(flushPeriod) {}
+
+        /**
+         * @brief Open the file, replacing it if it exists, and write the header
+         *
+         * If the file is already open, this function does nothing
+         *
+         * This function uses the errno values of fopen and fwrite when an error state is reached, for example:
+         *
+         * ENXIO: there is no SD card
+         *
+         * @return 0 on success
+         * @return INT_MAX on failure, setting errno
+         */
+        int open() {
+            if (m_file != nullptr) return 0;
+            m_file = std::fopen(m_path, "wb");
+            if (m_file == nullptr) return INT_MAX;
+            // the buffers are already large, so writes go straight to the file
+            std::setvbuf(m_file, nullptr, _IONBF, 0);
+            const std::uint32_t size = sizeof(T);
+            const std::array<std::uint8_t, 8> header = {'L',
+                                                        'L',
+                                                        'O',
+                                                        'G',
+                                                        static_cast<std::uint8_t>(size),
+                                                        static_cast<std::uint8_t>(size >> 8),
+                                                        static_cast<std::uint8_t>(size >> 16),
+                                                        static_cast<std::uint8_t>(size >> 24)};
+            if (std::fwrite(header.data(), 1, header.size(), m_file) != header.size()) {
+                std::fclose(m_file);
+                m_file = nullptr;
+                return INT_MAX;
+            }
+            m_bufferStart = pros::millis();
+            return 0;
+        }
+
+        /**
+         * @brief Open the file, and start the task which writes the buffers to it
+         *
+         * If the task is already running, this function does nothing
+         *
+         * This function uses the same values of errno as open() when an error state is reached
+         *
+         * @param priority the priority of the task. It should be lower than the priority of the code logging records
+         * @return 0 on success
+         * @return INT_MAX on failure, setting errno
+         */
+        int start(std::uint32_t priority = TASK_PRIORITY_MIN + 1) {
+            if (open() == INT_MAX) return INT_MAX;
+            if (m_running.exchange(true)) return 0;
+            m_task = pros::Task(
+                [this] {
+                    while (m_running) {
+                        flush();
+                        pros::delay(10);
+                    }
+                },
+                priority, TASK_STACK_DEPTH_DEFAULT, "logger");
+            return 0;
+        }
+
+        /**
+         * @brief Stop the task, write every record that hasn't been written yet, and close the file
+         *
+         * Records must not be appended while this function runs
+         *
+         * @return 0 on success
+         * @return INT_MAX if a write failed, setting errno
+         */
+        int stop() {
+            if (m_running.exchange(false)) {
+                // wait for the task to finish writing
+                m_task->join();
+                m_task.reset();
+            }
+            if (m_file == nullptr) return 0;
+            int result = flush() == INT_MAX ? INT_MAX : 0;
+            // the partly filled buffer is only written when the logger stops
+            if (m_count > 0) {
+                if (std::fwrite(m_buffers[m_active].data(), sizeof(T), m_count, m_file) != m_count) result = INT_MAX;
+                m_written.fetch_add(m_count, std::memory_order_relaxed);
+                m_count = 0;
+            }
+            if (std::fclose(m_file) != 0) result = INT_MAX;
+            m_file = nullptr;
+            return result;
+        }
+
+        /**
+         * @brief Add a record to the log
+         *
+         * This function never blocks. It may only be called by a single task.
+         *
+         * @param record the record
+         * @return true the record was added
+         * @return false both buffers are full, so the record was dropped
+         */
+        bool append(const T& record) {
+            if (m_count == N || (m_count > 0 && from_msec(pros::millis() - m_bufferStart) >= m_flushPeriod)) swap();
+            if (m_count == N) {
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            m_buffers[m_active][m_count++] = record;
+            return true;
+        }
+
+        /**
+         * @brief Write the buffer waiting to be written, if there is one
+         *
+         * This function is called by the task, and blocks while the file is written. It should only be called directly
+         * when the task is not running, for example on a computer.
+         *
+         * This function uses the errno values of fwrite when an error state is reached
+         *
+         * @return int the number of records written
+         * @return INT_MAX if the write failed, setting errno. The records are lost
+         */
+        int flush() {
+            if (m_file == nullptr) return 0;
+            // only one buffer can be waiting at a time, as the buffers are only swapped when the other one is empty
+            for (std::size_t i = 0; i < 2; i++) {
+                const std::size_t count = m_pending[i].load(std::memory_order_acquire);
+                if (count == 0) continue;
+                const std::size_t written = std::fwrite(m_buffers[i].data(), sizeof(T), count, m_file);
+                m_written.fetch_add(written, std::memory_order_relaxed);
+                // let the logging task reuse the buffer
+                m_pending[i].store(0, std::memory_order_release);
+                return written == count ? static_cast<int>(count) : INT_MAX;
+            }
+            return 0;
+        }
+
+        /**
+         * @brief Get the number of records dropped because both buffers were full
+         *
+         * @return std::uint32_t the number of records dropped
+         */
+        std::uint32_t getDropped() const { return m_dropped.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Get the number of records written to the file
+         *
+         * @return std::uint32_t the number of records written
+         */
+        std::uint32_t getWritten() const { return m_written.load(std::memory_order_relaxed); }
+
+        ~Logger() { stop(); }
+    private:
+        /**
+         * @brief hand the active buffer to the task, and start filling the other buffer, if the task is done with it
+         */
+        void swap() {
+            const std::size_t other = 1 - m_active;
+            if (m_pending[other].load(std::memory_order_acquire) != 0) return;
+            m_pending[m_active].store(m_count, std::memory_order_release);
+            m_active = other;
+            m_count = 0;
+            m_bufferStart = pros::millis();
+        }
+
+        const char* m_path;
+        Time m_flushPeriod;
+        std::FILE* m_file = nullptr;
+
+        std::array<std::array<T, N>, 2> m_buffers;
+        // the number of records in each buffer waiting to be written, 0 if the buffer can be filled
+        std::array<std::atomic<std::size_t>, 2> m_pending = {0, 0};
+
+        // the buffer being filled, only accessed by the logging task
+        std::size_t m_active = 0;
+        std::size_t m_count = 0;
+        std::uint32_t m_bufferStart = 0;
+
+        std::atomic<std::uint32_t> m_dropped = 0;
+        std::atomic<std::uint32_t> m_written = 0;
+
+        std::optional<pros::Task> m_task;
+        std::atomic<bool> m_running = false;
+};
+} // namespace lemlib
@@ -0,0 +1,322 @@
+#pragma once
+
+#include "units/Angle.hpp"
+#include <cerrno>
+#include <compare>
+#include <cstdint>
+#include <limits>
+
+namespace lemlib {
+/**
+ * @brief The fixed point format used to store a quantity
+ *
+ * A format has an integer representation type, and the value of the least significant bit of that representation.
+ * By default, quantities are stored in the Q16.16 format in their base unit type. This can be changed for a unit
+ * by specializing this struct, or for a single Fixed by passing a custom format.
+ *
+ * @tparam Q the type of quantity stored in the format
+ *
+ * @b Example:
+ * @code {.cpp}
+ * // store voltages as integer millivolts, like the V5 motors do
+ * struct MillivoltFormat {
+ *     using Rep = std::int32_t;
+ *     static constexpr Voltage lsb = 1_mvolt;
+ * };
+ * using FixedVoltage = lemlib::Fixed<Voltage, MillivoltFormat>;
+ * @endcode
+ */
+template <isQuantity Q> struct FixedFormat {
+        using Rep = std::int32_t; /** integer representation */
+        static constexpr Q lsb = Q(1.0 / 65536); /** value of the least significant bit */
+};
+
+/**
+ * @brief Angles are stored as integer centidegrees
+ *
+ * Every VEX encoder has a resolution that evenly divides 36000 ticks per rotation (300, 900, 1800, 360 and 36000), so
+ * converting encoder ticks to an angle in this format is exact.
+ */
+template <> struct FixedFormat<Angle> {
+        using Rep = std::int32_t; /** integer representation */
+        static constexpr Angle lsb = Angle(M_PI / 18000); /** value of the least significant bit */
+        static constexpr Rep perRotation = 36000; /** number of least significant bits in 1 rotation */
+};
+
+/**
+ * @brief Time is stored as integer microseconds
+ *
+ * A 64 bit representation is used, as 32 bits of microseconds overflows after about 35 minutes
+ */
+template <> struct FixedFormat<Time> {
+        using Rep = std::int64_t; /** integer representation */
+        static constexpr Time lsb = Time(1E-6); /** value of the least significant bit */
+};
+
+/**
+ * @class Fixed
+ *
+ * @brief A quantity stored as a fixed point integer
+ *
+ * Fixed point quantities don't depend on floating point rounding, so they give bit-identical results on every
+ * platform. This makes them useful for deterministic replay, and for code that should avoid the FPU. All arithmetic
+ * saturates at the limits of the representation instead of overflowing.
+ *
+ * Fixed point quantities don't convert implicitly to and from double-based quantities. The conversion has to be
+ * asked for explicitly, as it may round or saturate.
+ *
+ * @tparam Q the type of quantity to store
+ * @tparam Format the fixed point format to store the quantity in
+ *
+ * @b Example:
+ * @code {.cpp}
+ * void update(int ticks) {
+ *     // convert encoder ticks to an angle without any floating point math
+ *     const lemlib::FixedAngle angle = lemlib::FixedAngle::fromTicks(ticks, 360);
+ *     // convert back to a double-based angle to do trigonometry
+ *     std::cout << to_stDeg(angle.toQuantity()) << std::endl;
+ * }
+ * @endcode
+ */
+template <isQuantity Q, typename Format = FixedFormat<Q>> class Fixed {
+    public:
+        using Rep = typename Format::Rep;
+
+        /**
+         * @brief Construct a new Fixed object
+         *
+         * This constructor initializes the value to 0
+         */
+        constexpr Fixed() : m_raw(0) {}
+
+        /**
+         * @brief Construct a new Fixed object from a double-based quantity
+         *
+         * The quantity is rounded to the nearest representable value. Values outside of the range of the
+         * representation, including INFINITY, are saturated. NaN is converted to 0.
+         *
+         * @param quantity the quantity to convert
+         */
+        explicit constexpr Fixed(Q quantity) : m_raw(fromDouble(quantity.internal() / Format::lsb.internal())) {}
+
+        /**
+         * @brief Create a new Fixed object from its raw integer representation
+         *
+         * @param raw the raw integer representation
+         * @return Fixed
+         */
+        static constexpr Fixed fromRaw(Rep raw) {
+            Fixed result;
+            result.m_raw = raw;
+            return result;
+        }
+
+        /**
+         * @brief Create a new Fixed angle from encoder ticks
+         *
+         * The conversion only uses integer math. If the ticks per rotation evenly divides the number of least
+         * significant bits in a rotation, which is the case for all VEX encoders, the conversion is exact. Otherwise,
+         * the result is rounded to the nearest representable value, with ties rounded away from 0.
+         *
+         * This function uses the following values of errno when an error state is reached:
+         *
+         * EDOM: the ticks per rotation is not positive. The result saturates like a division by 0, and a constant
+         * expression with such a resolution doesn't compile
+         *
+         * @param ticks the number of ticks measured by the encoder
+         * @param ticksPerRotation the number of ticks the encoder measures in one rotation, which must be positive
+         * @return Fixed
+         */
+        static constexpr Fixed fromTicks(std::int64_t ticks, std::int64_t ticksPerRotation)
+            requires requires { Format::perRotation; }
+        {
+            if (ticksPerRotation <= 0) {
+                errno = EDOM;
+                return ticks == 0 ? Fixed() : (ticks < 0 ? min() : max());
+            }
+            const std::int64_t perRotation = Format::perRotation;
+            if (perRotation % ticksPerRotation == 0) return fromWide(ticks * (perRotation / ticksPerRotation));
+            // round to nearest, with ties away from 0
+            const std::int64_t scaled = ticks * perRotation;
+            const std::int64_t half = ticksPerRotation / 2;
+            return fromWide((scaled < 0 ? scaled - half : scaled + half) / ticksPerRotation);
+        }
+
+        /**
+         * @brief get the raw integer representation
+         *
+         * @return Rep
+         */
+        constexpr Rep raw() const { return m_raw; }
+
+        /**
+         * @brief convert to a double-based quantity
+         *
+         * @return Q
+         */
+        constexpr Q toQuantity() const { return Q(m_raw * Format::lsb.internal()); }
+
+        /**
+         * @brief convert to a double-based quantity
+         *
+         * @return Q
+         */
+        explicit constexpr operator Q() const { return toQuantity(); }
+
+        /**
+         * @brief the largest representable value
+         *
+         * @return Fixed
+         */
+        static constexpr Fixed max() { return fromRaw(std::numeric_limits<Rep>::max()); }
+
+        /**
+         * @brief the smallest representable value
+         *
+         * @return Fixed
+         */
+        static constexpr Fixed min() { return fromRaw(std::numeric_limits<Rep>::min()); }
+
+        /**
+         * @brief the value of the least significant bit
+         *
+         * @return Q
+         */
+        static constexpr Q resolution() { return Format::lsb; }
+
+        /**
+         * @brief saturating addition
+         *
+         * @param other the quantity to add
+         * @return Fixed
+         */
+        constexpr Fixed operator+(Fixed other) const {
+            Rep result;
+            if (__builtin_add_overflow(m_raw, other.m_raw, &result)) return other.m_raw > 0 ? max() : min();
+            return fromRaw(result);
+        }
+
+        /**
+         * @brief saturating subtraction
+         *
+         * @param other the quantity to subtract
+         * @return Fixed
+         */
+        constexpr Fixed operator-(Fixed other) const {
+            Rep result;
+            if (__builtin_sub_overflow(m_raw, other.m_raw, &result)) return other.m_raw < 0 ? max() : min();
+            return fromRaw(result);
+        }
+
+        /**
+         * @brief saturating negation
+         *
+         * @return Fixed
+         */
+        constexpr Fixed operator-() const { return Fixed() - *this; }
+
+        /**
+         * @brief saturating multiplication by an integer
+         *
+         * @param factor the integer to multiply by
+         * @return Fixed
+         */
+        constexpr Fixed operator*(Rep factor) const {
+            Rep result;
+            if (__builtin_mul_overflow(m_raw, factor, &result)) return (m_raw < 0) != (factor < 0) ? min() : max();
+            return fromRaw(result);
+        }
+
+        /**
+         * @brief division by an integer, rounding towards 0
+         *
+         * Dividing by 0 saturates, and dividing 0 by 0 results in 0
+         *
+         * @param divisor the integer to divide by
+         * @return Fixed
+         */
+        constexpr Fixed operator/(Rep divisor) const {
+            if (divisor == 0) return m_raw == 0 ? Fixed() : (m_raw < 0 ? min() : max());
+            // the only division that overflows is min() / -1
+            if (divisor == -1) return -*this;
+            return fromRaw(m_raw / divisor);
+        }
+
+        /**
+         * @brief saturating multiplication by a ratio, such as a gear ratio
+         *
+         * The multiplication is done before the division, so no precision is lost. The result is rounded to the
+         * nearest representable value, with ties rounded away from 0.
+         *
+         * @param numerator the numerator of the ratio
+         * @param denominator the denominator of the ratio
+         * @return Fixed
+         */
+        constexpr Fixed scale(std::int32_t numerator, std::int32_t denominator) const {
+            if (denominator < 0) {
+                numerator = -numerator;
+                denominator = -denominator;
+            }
+            if (denominator == 0) {
+                if (m_raw == 0 || numerator == 0) return Fixed();
+                return (m_raw < 0) != (numerator < 0) ? min() : max();
+            }
+            std::int64_t product;
+            if (__builtin_mul_overflow(static_cast<std::int64_t>(m_raw), numerator, &product))
+                return (m_raw < 0) != (numerator < 0) ? min() : max();
+            const std::int64_t half = denominator / 2;
+            return fromWide((product < 0 ? product - half : product + half) / denominator);
+        }
+
+        /**
+         * @brief set the value of this quantity to its current value plus another quantity, saturating
+         *
+         * @param other the quantity to add
+         */
+        constexpr Fixed& operator+=(Fixed other) { return *this = *this + other; }
+
+        /**
+         * @brief set the value of this quantity to its current value minus another quantity, saturating
+         *
+         * @param other the quantity to subtract
+         */
+        constexpr Fixed& operator-=(Fixed other) { return *this = *this - other; }
+
+        constexpr bool operator==(const Fixed& other) const = default;
+        constexpr auto operator<=>(const Fixed& other) const = default;
+    private:
+        /**
+         * @brief convert a 64 bit integer to the representation, saturating
+         */
+        static constexpr Fixed fromWide(std::int64_t value) {
+            if (value > static_cast<std::int64_t>(std::numeric_limits<Rep>::max())) return max();
+            if (value < static_cast<std::int64_t>(std::numeric_limits<Rep>::min())) return min();
+            return fromRaw(static_cast<Rep>(value));
+        }
+
+        /**
+         * @brief convert a double to the representation, rounding to nearest and saturating
+         */
+        static constexpr Rep fromDouble(double value) {
+            if (value != value) return 0; // NaN
+            if (value >= static_cast<double>(std::numeric_limits<Rep>::max())) return std::numeric_limits<Rep>::max();
+            if (value <= static_cast<double>(std::numeric_limits<Rep>::min())) return std::numeric_limits<Rep>::min();
+            // round to nearest, with ties away from 0
+            return static_cast<Rep>(value < 0 ? value - 0.5 : value + 0.5);
+        }
+
+        Rep m_raw; /** the raw integer representation */
+};
+
+template <isQuantity Q, typename Format> constexpr Fixed<Q, Format> operator*(typename Format::Rep factor,
+                                                                             Fixed<Q, Format> quantity) {
+    return quantity * factor;
+}
+
+// define some common fixed point types
+using FixedAngle = Fixed<Angle>;
+using FixedLength = Fixed<Length>;
+using FixedTime = Fixed<Time>;
+using FixedAngularVelocity = Fixed<AngularVelocity>;
+using FixedLinearVelocity = Fixed<LinearVelocity>;
+} // namespace lemlib
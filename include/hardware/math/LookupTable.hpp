@@ -0,0 +1,227 @@
+#pragma once
+
+#include "units/Angle.hpp"
+#include "units/units.hpp"
+#include <array>
+#include <cstddef>
+
+namespace lemlib {
+/**
+ * @brief The method used to interpolate between the entries of a LookupTable
+ */
+enum class Interpolation {
+    LINEAR, /** straight lines between entries */
+    CUBIC /** monotone cubic curves between entries, which don't overshoot the data */
+};
+
+/**
+ * @class LookupTable
+ *
+ * @brief A fixed size table which maps an input quantity to an output quantity by interpolating between entries
+ *
+ * Lookup tables are useful for things like motor torque/speed curves, battery voltage compensation, or shooter speed
+ * by distance. The table has fixed storage, never allocates, and can be constructed at compile time.
+ *
+ * If the inputs of the table are evenly spaced, finding the entries to interpolate between takes O(1) time. Otherwise,
+ * a binary search is used, which takes O(log N) time. Inputs outside of the range of the table are clamped to the
+ * first or last entry.
+ *
+ * @tparam In the type of the input quantity
+ * @tparam Out the type of the output quantity
+ * @tparam N the number of entries in the table. Must be at least 2
+ *
+ * @b Example:
+ * @code {.cpp}
+ * // flywheel speed needed to score from a given distance
+ * constexpr lemlib::LookupTable<Length, AngularVelocity, 4> flywheelSpeed(
+ *     {1_ft, 3_ft, 6_ft, 10_ft}, {2000_rpm, 2400_rpm, 2900_rpm, 3300_rpm}, lemlib::Interpolation::CUBIC);
+ *
+ * void shoot(Length distance) { flywheel.moveVelocity(flywheelSpeed(distance)); }
+ * @endcode
+ */
+template <isQuantity In, isQuantity Out, std::size_t N> class LookupTable {
+        static_assert(N >= 2, "A LookupTable needs at least 2 entries");
+    public:
+        /**
+         * @brief Construct a new LookupTable object
+         *
+         * The inputs must be sorted in strictly increasing order. If the inputs are evenly spaced, lookups will run in
+         * O(1) time.
+         *
+         * @param inputs the input of each entry
+         * @param outputs the output of each entry
+         * @param interpolation the method used to interpolate between entries
+         */
+        constexpr LookupTable(const std::array<In, N>& inputs, const std::array<Out, N>& outputs,
+                              Interpolation interpolation = Interpolation::LINEAR)
+            : m_interpolation(interpolation) {
+            for (std::size_t i = 0; i < N; i++) {
+                m_inputs[i] = inputs[i].internal();
+                m_outputs[i] = outputs[i].internal();
+            }
+            // check whether the inputs are evenly spaced, allowing for some floating point error
+            const double step = (m_inputs[N - 1] - m_inputs[0]) / (N - 1);
+            m_uniform = true;
+            for (std::size_t i = 1; i < N; i++) {
+                const double error = m_inputs[i] - (m_inputs[0] + step * i);
+                if ((error < 0 ? -error : error) > step * 1e-9) m_uniform = false;
+            }
+            m_inverseStep = 1 / step;
+            calculateSlopes();
+        }
+
+        /**
+         * @brief Construct a new LookupTable object with evenly spaced inputs
+         *
+         * Lookups in tables constructed with this function always run in O(1) time
+         *
+         * @param first the input of the first entry
+         * @param last the input of the last entry
+         * @param outputs the output of each entry
+         * @param interpolation the method used to interpolate between entries
+         * @return LookupTable
+         *
+         * @b Example:
+         * @code {.cpp}
+         * // motor torque at 0, 50, 100, 150, and 200 rpm
+         * constexpr auto torqueCurve = lemlib::LookupTable<AngularVelocity, Torque, 5>::uniform(
+         *     0_rpm, 200_rpm, {2.1_Nm, 1.6_Nm, 1.05_Nm, 0.5_Nm, 0_Nm});
+         * @endcode
+         */
+        static constexpr LookupTable uniform(In first, In last, const std::array<Out, N>& outputs,
+                                             Interpolation interpolation = Interpolation::LINEAR) {
+            return LookupTable(first.internal(), last.internal(), outputs, interpolation);
+        }
+
+        /**
+         * @brief look up the output for a given input
+         *
+         * @param input the input to look up
+         * @return Out the interpolated output
+         */
+        constexpr Out lookup(In input) const {
+            const double x = input.internal();
+            // clamp the input to the range of the table
+            if (!(x > m_inputs[0])) return Out(m_outputs[0]);
+            if (x >= m_inputs[N - 1]) return Out(m_outputs[N - 1]);
+            // find the entries the input is in between, and how far between them it is
+            const std::size_t i = findSegment(x);
+            const double h = m_inputs[i + 1] - m_inputs[i];
+            const double t = (x - m_inputs[i]) / h;
+            const double y0 = m_outputs[i];
+            const double y1 = m_outputs[i + 1];
+            if (m_interpolation == Interpolation::LINEAR) return Out(y0 + t * (y1 - y0));
+            // cubic hermite spline
+            const double t2 = t * t;
+            const double t3 = t2 * t;
+            return Out((2 * t3 - 3 * t2 + 1) * y0 + (t3 - 2 * t2 + t) * h * m_slopes[i] + (3 * t2 - 2 * t3) * y1 +
+                       (t3 - t2) * h * m_slopes[i + 1]);
+        }
+
+        /**
+         * @brief look up the output for a given input
+         *
+         * @param input the input to look up
+         * @return Out the interpolated output
+         */
+        constexpr Out operator()(In input) const { return lookup(input); }
+
+        /**
+         * @brief get the input of the first entry
+         *
+         * @return In the smallest input in the table
+         */
+        constexpr In getMinInput() const { return In(m_inputs[0]); }
+
+        /**
+         * @brief get the input of the last entry
+         *
+         * @return In the largest input in the table
+         */
+        constexpr In getMaxInput() const { return In(m_inputs[N - 1]); }
+
+        /**
+         * @brief whether the inputs of the table are evenly spaced, in which case lookups run in O(1) time
+         *
+         * @return true the inputs are evenly spaced
+         * @return false the inputs are not evenly spaced
+         */
+        constexpr bool isUniform() const { return m_uniform; }
+    private:
+        /**
+         * @brief Construct a new LookupTable object with evenly spaced inputs
+         */
+        constexpr LookupTable(double first, double last, const std::array<Out, N>& outputs,
+                              Interpolation interpolation)
+            : m_interpolation(interpolation),
+              m_uniform(true) {
+            const double step = (last - first) / (N - 1);
+            for (std::size_t i = 0; i < N; i++) {
+                m_inputs[i] = first + step * i;
+                m_outputs[i] = outputs[i].internal();
+            }
+            // prevent floating point error from moving the last entry
+            m_inputs[N - 1] = last;
+            m_inverseStep = 1 / step;
+            calculateSlopes();
+        }
+
+        /**
+         * @brief find the index of the entry before the input
+         *
+         * The input must be within the range of the table
+         */
+        constexpr std::size_t findSegment(double x) const {
+            if (m_uniform) {
+                // the input is evenly spaced, so the index can be calculated directly
+                const std::size_t i = static_cast<std::size_t>((x - m_inputs[0]) * m_inverseStep);
+                return i < N - 2 ? i : N - 2;
+            }
+            // binary search
+            std::size_t lo = 0;
+            std::size_t hi = N - 1;
+            while (hi - lo > 1) {
+                const std::size_t mid = (lo + hi) / 2;
+                if (m_inputs[mid] <= x) lo = mid;
+                else hi = mid;
+            }
+            return lo;
+        }
+
+        /**
+         * @brief calculate the slope of the curve at each entry, used for cubic interpolation
+         *
+         * This uses the Fritsch-Carlson method, which guarantees that the curve does not overshoot the data. This is
+         * important for physical data like torque curves, where an overshoot would be a value that can't exist.
+         */
+        constexpr void calculateSlopes() {
+            // slopes of the line segments between entries
+            std::array<double, N - 1> secants {};
+            for (std::size_t i = 0; i < N - 1; i++)
+                secants[i] = (m_outputs[i + 1] - m_outputs[i]) / (m_inputs[i + 1] - m_inputs[i]);
+            // the endpoints use the slope of the only segment they touch
+            m_slopes[0] = secants[0];
+            m_slopes[N - 1] = secants[N - 2];
+            for (std::size_t i = 1; i < N - 1; i++) {
+                // the slope is 0 at local extrema
+                if (secants[i - 1] * secants[i] <= 0) {
+                    m_slopes[i] = 0;
+                    continue;
+                }
+                // weighted harmonic mean of the neighbouring secants
+                const double h0 = m_inputs[i] - m_inputs[i - 1];
+                const double h1 = m_inputs[i + 1] - m_inputs[i];
+                const double w0 = 2 * h1 + h0;
+                const double w1 = h1 + 2 * h0;
+                m_slopes[i] = (w0 + w1) / (w0 / secants[i - 1] + w1 / secants[i]);
+            }
+        }
+
+        std::array<double, N> m_inputs {}; /** inputs of each entry, in base units */
+        std::array<double, N> m_outputs {}; /** outputs of each entry, in base units */
+        std::array<double, N> m_slopes {}; /** slope of the curve at each entry, used for cubic interpolation */
+        Interpolation m_interpolation; /** the method used to interpolate between entries */
+        bool m_uniform = false; /** whether the inputs are evenly spaced */
+        double m_inverseStep = 0; /** 1 / the spacing between inputs, only valid if the inputs are evenly spaced */
+};
+} // namespace lemlib
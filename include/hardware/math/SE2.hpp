@@ -0,0 +1,265 @@
+#pragma once
+
+#include "units/Pose.hpp"
+#include <cstddef>
+#include <span>
+
+namespace lemlib {
+/**
+ * @class SE2
+ *
+ * @brief A rigid transform in 2D space, made up of a translation and a rotation
+ *
+ * Unlike units::Pose, which only stores a position and an orientation, an SE2 transform caches the sine and cosine of
+ * its rotation when it is constructed. This means composing transforms and transforming points doesn't need any
+ * trigonometric function calls, which makes it cheap to transform large batches of points, such as sensor readings.
+ *
+ * Transforms compose from right to left, just like matrices. If `robot` is the transform from the robot frame to the
+ * field frame, and `sensor` is the transform from the sensor frame to the robot frame, then `robot * sensor` is the
+ * transform from the sensor frame to the field frame.
+ */
+class SE2 {
+    public:
+        /**
+         * @brief Construct a new SE2 object
+         *
+         * This constructor initializes the transform to the identity transform
+         */
+        constexpr SE2() : m_x(0.0), m_y(0.0), m_theta(0.0), m_sin(0.0), m_cos(1.0) {}
+
+        /**
+         * @brief Construct a new SE2 object
+         *
+         * @param x x translation
+         * @param y y translation
+         * @param theta rotation
+         */
+        SE2(Length x, Length y, Angle theta)
+            : m_x(x),
+              m_y(y),
+              m_theta(theta),
+              m_sin(std::sin(theta.internal())),
+              m_cos(std::cos(theta.internal())) {}
+
+        /**
+         * @brief Construct a new SE2 object from a pose
+         *
+         * @param pose the pose to construct the transform from
+         */
+        SE2(units::Pose pose) : SE2(pose.getX(), pose.getY(), pose.getOrientation()) {}
+
+        /**
+         * @brief Convert the transform to a pose
+         *
+         * @return units::Pose
+         */
+        units::Pose toPose() const { return units::Pose(m_x, m_y, m_theta); }
+
+        /**
+         * @brief get the x translation
+         *
+         * @return Length x translation
+         */
+        Length getX() const { return m_x; }
+
+        /**
+         * @brief get the y translation
+         *
+         * @return Length y translation
+         */
+        Length getY() const { return m_y; }
+
+        /**
+         * @brief get the rotation
+         *
+         * @return Angle rotation
+         */
+        Angle getTheta() const { return m_theta; }
+
+        /**
+         * @brief get the cached sine of the rotation
+         *
+         * @return Number sine of the rotation
+         */
+        Number getSin() const { return Number(m_sin); }
+
+        /**
+         * @brief get the cached cosine of the rotation
+         *
+         * @return Number cosine of the rotation
+         */
+        Number getCos() const { return Number(m_cos); }
+
+        /**
+         * @brief compose two transforms
+         *
+         * The resulting transform applies other first, then this transform
+         *
+         * @param other the transform to apply first
+         * @return SE2
+         */
+        SE2 operator*(const SE2& other) const {
+            // the sine and cosine of the sum of the rotations can be calculated with the angle sum identities, so
+            // there is no need to call any trigonometric functions
+            return SE2(m_x + other.m_x * m_cos - other.m_y * m_sin, m_y + other.m_x * m_sin + other.m_y * m_cos,
+                       m_theta + other.m_theta, m_sin * other.m_cos + m_cos * other.m_sin,
+                       m_cos * other.m_cos - m_sin * other.m_sin);
+        }
+
+        /**
+         * @brief compose another transform with this transform, storing the result in this transform
+         *
+         * @param other the transform to apply first
+         * @return SE2&
+         */
+        SE2& operator*=(const SE2& other) {
+            *this = *this * other;
+            return *this;
+        }
+
+        /**
+         * @brief get the inverse of the transform
+         *
+         * Composing a transform with its inverse results in the identity transform
+         *
+         * @return SE2
+         */
+        SE2 inverse() const {
+            return SE2((m_x * m_cos + m_y * m_sin) * -1.0, m_x * m_sin - m_y * m_cos, m_theta * -1.0, -m_sin, m_cos);
+        }
+
+        /**
+         * @brief transform a point
+         *
+         * The point is rotated, and then translated
+         *
+         * @param point the point to transform
+         * @return units::V2Position the transformed point
+         */
+        units::V2Position operator*(units::V2Position point) const { return apply(point); }
+
+        /**
+         * @brief transform a point
+         *
+         * The point is rotated, and then translated
+         *
+         * @param point the point to transform
+         * @return units::V2Position the transformed point
+         */
+        units::V2Position apply(units::V2Position point) const {
+            const Length x = point.getX();
+            const Length y = point.getY();
+            return units::V2Position(m_x + x * m_cos - y * m_sin, m_y + x * m_sin + y * m_cos);
+        }
+
+        /**
+         * @brief transform a batch of points
+         *
+         * Points are read from the input span and written to the output span. The spans may be the same span, in
+         * which case the points are transformed in place. Only as many points as fit in the smaller of the two spans
+         * are transformed.
+         *
+         * @param in the points to transform
+         * @param out where to store the transformed points
+         * @return std::size_t the number of points transformed
+         *
+         * @b Example:
+         * @code {.cpp}
+         * void processScan(const units::Pose& robot, std::span<units::V2Position> points) {
+         *     // transform the points from the robot frame to the field frame
+         *     const lemlib::SE2 transform = robot;
+         *     transform.apply(points, points);
+         * }
+         * @endcode
+         */
+        std::size_t apply(std::span<const units::V2Position> in, std::span<units::V2Position> out) const {
+            const std::size_t count = in.size() < out.size() ? in.size() : out.size();
+            for (std::size_t i = 0; i < count; i++) out[i] = apply(in[i]);
+            return count;
+        }
+
+        /**
+         * @brief interpolate between this transform and another transform
+         *
+         * Interpolation follows the constant-curvature arc between the two transforms, which is the path a
+         * differential drive robot would follow when moving at a constant linear and angular velocity. The rotation
+         * between the two transforms is wrapped, so interpolation always turns the shortest way.
+         *
+         * @param other the transform to interpolate to
+         * @param t how far to interpolate, from 0 (this transform) to 1 (the other transform)
+         * @return SE2 the interpolated transform
+         */
+        SE2 interpolate(const SE2& other, double t) const {
+            // find the twist that takes this transform to the other transform, scale it, then apply it
+            const SE2 delta = inverse() * other;
+            return *this * exp(log(delta) * t);
+        }
+    private:
+        /**
+         * @brief rotations smaller than this use the taylor series in exp() and log(). The first term left out is
+         * below 1e-17 there, so the series is exact to double precision
+         */
+        static constexpr double SMALL_ANGLE = 1e-4;
+
+        /**
+         * @brief a twist is the velocity of a rigid body, integrated over 1 unit of time
+         */
+        struct Twist {
+                double x; /** x translation, in meters */
+                double y; /** y translation, in meters */
+                double theta; /** rotation, in radians */
+
+                Twist operator*(double factor) const { return {x * factor, y * factor, theta * factor}; }
+        };
+
+        /**
+         * @brief Construct a new SE2 object with a known sine and cosine
+         */
+        SE2(Length x, Length y, Angle theta, double sin, double cos)
+            : m_x(x),
+              m_y(y),
+              m_theta(theta),
+              m_sin(sin),
+              m_cos(cos) {}
+
+        /**
+         * @brief convert a twist to a transform
+         */
+        static SE2 exp(const Twist& twist) {
+            const double sin = std::sin(twist.theta);
+            const double cos = std::cos(twist.theta);
+            // use the taylor series when the rotation is small, as 1 - cos loses all its precision
+            double a, b;
+            if (std::abs(twist.theta) < SMALL_ANGLE) {
+                a = 1 - twist.theta * twist.theta / 6;
+                b = twist.theta / 2 - twist.theta * twist.theta * twist.theta / 24;
+            } else {
+                a = sin / twist.theta;
+                b = (1 - cos) / twist.theta;
+            }
+            return SE2(Length(a * twist.x - b * twist.y), Length(b * twist.x + a * twist.y), Angle(twist.theta), sin,
+                       cos);
+        }
+
+        /**
+         * @brief convert a transform to a twist
+         */
+        static Twist log(const SE2& transform) {
+            // wrap the rotation to [-pi, pi], as the arc is undefined for a full rotation
+            const double theta = std::remainder(transform.m_theta.internal(), 2 * M_PI);
+            const double halfTheta = theta / 2;
+            // half theta / tan(half theta), which is 0 / 0 at no rotation, so the taylor series is used when the
+            // rotation is small
+            const double a = std::abs(theta) < SMALL_ANGLE ? 1 - theta * theta / 12 : halfTheta / std::tan(halfTheta);
+            const double x = transform.m_x.internal();
+            const double y = transform.m_y.internal();
+            return {a * x + halfTheta * y, -halfTheta * x + a * y, theta};
+        }
+
+        Length m_x; /** x translation */
+        Length m_y; /** y translation */
+        Angle m_theta; /** rotation */
+        double m_sin; /** cached sine of the rotation */
+        double m_cos; /** cached cosine of the rotation */
+};
+} // namespace lemlib
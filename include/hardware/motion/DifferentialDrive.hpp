@@ -0,0 +1,155 @@
+#pragma once
+
+#include "hardware/Motors/MotorGroup.hpp"
+#include "hardware/Motors/VelocityController.hpp"
+#include "units/Pose.hpp"
+
+namespace lemlib {
+/**
+ * @brief The linear velocities of the wheels on each side of a DifferentialDrive
+ */
+struct WheelSpeeds {
+        LinearVelocity left = 0_mps;
+        LinearVelocity right = 0_mps;
+};
+
+/**
+ * @brief Kinematics of a tank drive, driving a MotorGroup on each side
+ *
+ * Chassis velocities are in the frame of the robot: x is forwards, and the orientation is the angular velocity,
+ * counterclockwise positive, which matches Odometry. A differential drive can't move sideways, so y is ignored.
+ *
+ * Inverse kinematics turn a chassis velocity into wheel speeds:
+ *
+ * left = x - orientation * trackWidth / 2, right = x + orientation * trackWidth / 2
+ *
+ * If a wheel would have to go faster than the drive can, both wheel speeds are scaled down by the same factor. This
+ * keeps the ratio of the angular velocity to the linear velocity, which is the curvature of the path, so the robot
+ * still follows the same arc, just slower. Forward kinematics turn measured wheel speeds back into a chassis velocity.
+ *
+ * The velocities of the motor groups are of the wheels, so the output velocity of each group must be the velocity of
+ * its wheels at full power.
+ *
+ * @b Example:
+ * @code {.cpp}
+ * pros::Motor left1(-1, pros::v5::MotorGears::blue);
+ * pros::Motor left2(-2, pros::v5::MotorGears::blue);
+ * pros::Motor right1(3, pros::v5::MotorGears::blue);
+ * pros::Motor right2(4, pros::v5::MotorGears::blue);
+ * lemlib::MotorGroup leftDrive({left1, left2}, 450_rpm);
+ * lemlib::MotorGroup rightDrive({right1, right2}, 450_rpm);
+ * lemlib::DifferentialDrive drive(leftDrive, rightDrive, 12_in, 3.25_in);
+ *
+ * void opcontrol() {
+ *     pros::Controller controller(pros::E_CONTROLLER_MASTER);
+ *     while (true) {
+ *         const double throttle = controller.get_analog(pros::E_CONTROLLER_ANALOG_LEFT_Y) / 127.0;
+ *         const double turn = controller.get_analog(pros::E_CONTROLLER_ANALOG_RIGHT_X) / 127.0;
+ *         // turning right is clockwise, which is a negative angular velocity
+ *         drive.move(units::VelocityPose(drive.getMaxSpeed() * throttle, 0_mps, 360_degps * -turn));
+ *         pros::delay(10);
+ *     }
+ * }
+ * @endcode
+ */
+class DifferentialDrive {
+    public:
+        /**
+         * @brief Construct a new DifferentialDrive object
+         *
+         * @param left the motor group on the left side, which must outlive the drive
+         * @param right the motor group on the right side, which must outlive the drive
+         * @param trackWidth the distance between the left and right wheels
+         * @param wheelDiameter the diameter of the wheels
+         */
+        DifferentialDrive(MotorGroup& left, MotorGroup& right, Length trackWidth, Length wheelDiameter);
+        /**
+         * @brief Calculate the wheel speeds needed for a chassis velocity, without limiting them
+         *
+         * @param velocity the chassis velocity
+         * @return WheelSpeeds the wheel speeds
+         */
+        WheelSpeeds toWheelSpeeds(units::VelocityPose velocity) const;
+        /**
+         * @brief Calculate the chassis velocity the wheel speeds move the robot at
+         *
+         * @param speeds the wheel speeds
+         * @return units::VelocityPose the chassis velocity
+         */
+        units::VelocityPose toChassisVelocity(WheelSpeeds speeds) const;
+        /**
+         * @brief Scale the wheel speeds down so neither is faster than the maximum, keeping the curvature
+         *
+         * @param speeds the wheel speeds
+         * @param maxSpeed the maximum speed of a wheel
+         * @return WheelSpeeds the scaled wheel speeds, or the same speeds if neither is too fast
+         */
+        static WheelSpeeds desaturate(WheelSpeeds speeds, LinearVelocity maxSpeed);
+        /**
+         * @brief Move the robot at a chassis velocity
+         *
+         * The wheel speeds and accelerations are calculated and desaturated first, then both motor groups are
+         * commanded one after the other, with MotorGroup::moveVelocity(), so both sides change in the same tick. The
+         * acceleration is only used in VelocityMode::FEEDFORWARD.
+         *
+         * This function uses the following values of errno when an error state is reached:
+         *
+         * ENODEV: the port cannot be configured as a motor
+         *
+         * @param velocity the chassis velocity
+         * @param acceleration the chassis acceleration
+         * @return 0 on success
+         * @return INT_MAX if either side failed to move, setting errno
+         */
+        int move(units::VelocityPose velocity,
+                 units::AccelerationPose acceleration = units::AccelerationPose());
+        /**
+         * @brief Get the measured chassis velocity
+         *
+         * The velocity of each side is estimated from the angle of its motor group, so this function should be called
+         * periodically, like in a control loop.
+         *
+         * This function uses the following values of errno when an error state is reached:
+         *
+         * ENODEV: the port cannot be configured as a motor
+         *
+         * @return units::VelocityPose the measured chassis velocity
+         * @return INFINITY if the angle of either side could not be read, setting errno
+         */
+        units::VelocityPose getVelocity();
+        /**
+         * @brief Get the speed of the wheels at full power, which is the speed of the slower side
+         *
+         * @return LinearVelocity the maximum wheel speed
+         */
+        LinearVelocity getMaxSpeed() const;
+        /**
+         * @brief Get the distance between the left and right wheels
+         *
+         * @return Length the track width
+         */
+        Length getTrackWidth() const;
+        /**
+         * @brief Get the diameter of the wheels
+         *
+         * @return Length the wheel diameter
+         */
+        Length getWheelDiameter() const;
+    private:
+        /**
+         * @brief convert the angular velocity of a wheel to the linear velocity of its edge
+         */
+        LinearVelocity toLinear(AngularVelocity velocity) const;
+        /**
+         * @brief convert the linear velocity of the edge of a wheel to its angular velocity
+         */
+        AngularVelocity toAngular(LinearVelocity velocity) const;
+
+        MotorGroup& m_left;
+        MotorGroup& m_right;
+        const Length m_trackWidth;
+        const Length m_wheelDiameter;
+        VelocityEstimator m_leftVelocity;
+        VelocityEstimator m_rightVelocity;
+};
+} // namespace lemlib
@@ -0,0 +1,231 @@
+#pragma once
+
+#include "units/Angle.hpp"
+#include <cerrno>
+#include <cmath>
+
+namespace lemlib {
+/**
+ * @brief Limits of a MotionProfile
+ *
+ * An infinite jerk, the default, makes a trapezoidal profile, which changes its acceleration instantly. A finite jerk
+ * makes an S-curve profile, which ramps the acceleration up and down, so the mechanism is jolted less.
+ *
+ * @tparam P the type of position, like Angle or Length
+ *
+ * @b Example:
+ * @code {.cpp}
+ * // an S-curve profile of a lift, in rotations of its output
+ * lemlib::ProfileConstraints<Angle> constraints {2_rps, 8_rps2, 40_rps3};
+ * @endcode
+ */
+template <isQuantity P> struct ProfileConstraints {
+        using Velocity = Divided<P, Time>;
+        using Acceleration = Divided<Velocity, Time>;
+        using Jerk = Divided<Acceleration, Time>;
+
+        Velocity maxVelocity;
+        Acceleration maxAcceleration;
+        Jerk maxJerk = Jerk(INFINITY);
+};
+
+/**
+ * @brief The position, velocity, and acceleration of a MotionProfile at a point in time
+ *
+ * @tparam P the type of position, like Angle or Length
+ */
+template <isQuantity P> struct ProfileState {
+        P position;
+        Divided<P, Time> velocity;
+        Divided<Divided<P, Time>, Time> acceleration;
+};
+
+/**
+ * @brief A profile which moves a mechanism from rest at one position to rest at another
+ *
+ * The profile speeds up, cruises at the maximum velocity, and slows down, without exceeding the constraints. Short
+ * moves never reach the maximum velocity, or with a finite jerk, the maximum acceleration. The phases are computed
+ * once, when the profile is constructed, and each sample is evaluated analytically, so sampling takes constant time.
+ * Slowing down mirrors speeding up, so only the first half has to be evaluated.
+ *
+ * This class doesn't read any hardware, so it can be tested on a computer.
+ *
+ * @tparam P the type of position, like Angle or Length
+ *
+ * @b Example:
+ * @code {.cpp}
+ * void autonomous() {
+ *     // move a lift from 0 to 3 rotations
+ *     const lemlib::AngularProfile profile(0_stRot, 3_stRot, {2_rps, 8_rps2, 40_rps3});
+ *     const Time start = from_usec(pros::micros());
+ *     while (from_usec(pros::micros()) - start < profile.getDuration()) {
+ *         const lemlib::ProfileState<Angle> state = profile.sample(from_usec(pros::micros()) - start);
+ *         std::cout << to_stRot(state.position) << " " << to_rps(state.velocity) << std::endl;
+ *         pros::delay(10);
+ *     }
+ * }
+ * @endcode
+ */
+template <isQuantity P> class MotionProfile {
+    public:
+        using Velocity = Divided<P, Time>;
+        using Acceleration = Divided<Velocity, Time>;
+
+        /**
+         * @brief Construct a new MotionProfile object
+         *
+         * This function uses the following values of errno when an error state is reached:
+         *
+         * EINVAL: a constraint is not positive. The profile stays at the start position, and takes no time
+         *
+         * @param start the position the profile starts at
+         * @param goal the position the profile ends at
+         * @param constraints the limits of the profile
+         */
+        MotionProfile(P start, P goal, ProfileConstraints<P> constraints)
+            : m_start(start),
+              m_goal(goal) {
+            const double distance = (goal - start).internal();
+            const double velocity = constraints.maxVelocity.internal();
+            const double acceleration = constraints.maxAcceleration.internal();
+            m_jerk = constraints.maxJerk.internal();
+            if (!(velocity > 0 && acceleration > 0 && m_jerk > 0)) {
+                errno = EINVAL;
+                m_goal = start;
+                return;
+            }
+            m_sign = distance < 0 ? -1 : 1;
+            m_distance = std::abs(distance);
+            if (m_distance == 0) return;
+            // the distance covered while speeding up to the maximum velocity, which is the same as slowing down
+            const auto accelPhase = [&](double peak) {
+                // without enough time to reach the maximum acceleration, the acceleration only ramps up and down
+                if (peak * m_jerk < acceleration * acceleration) {
+                    m_peakAcceleration = std::sqrt(peak * m_jerk);
+                    m_jerkTime = std::sqrt(peak / m_jerk);
+                    m_accelTime = 2 * m_jerkTime;
+                } else {
+                    m_peakAcceleration = acceleration;
+                    m_jerkTime = acceleration / m_jerk;
+                    m_accelTime = peak / acceleration + m_jerkTime;
+                }
+                m_peakVelocity = peak;
+                return peak * m_accelTime / 2;
+            };
+            const double accelDistance = accelPhase(velocity);
+            if (2 * accelDistance <= m_distance) {
+                m_cruiseTime = (m_distance - 2 * accelDistance) / velocity;
+            } else {
+                // the profile is too short to reach the maximum velocity, so find the peak velocity which makes the
+                // distance of speeding up and slowing down equal to the total distance
+                // peak * (peak / acceleration + acceleration / jerk) = distance, when the acceleration is reached
+                const double ratio = acceleration / m_jerk;
+                double peak = acceleration / 2 * (std::sqrt(ratio * ratio + 4 * m_distance / acceleration) - ratio);
+                // 2 * peak * sqrt(peak / jerk) = distance, when it isn't
+                if (peak * m_jerk < acceleration * acceleration) peak = std::cbrt(std::pow(m_distance / 2, 2) * m_jerk);
+                accelPhase(peak);
+            }
+            m_duration = 2 * m_accelTime + m_cruiseTime;
+        }
+
+        /**
+         * @brief Get the state of the profile at a point in time
+         *
+         * @param time the time since the start of the profile. Times before the start give the start position, and
+         * times after the end give the goal position, both at rest
+         * @return ProfileState<P> the state of the profile
+         */
+        ProfileState<P> sample(Time time) const {
+            const double t = time.internal();
+            if (t <= 0) return {m_start, Velocity(0), Acceleration(0)};
+            if (t >= m_duration) return {m_goal, Velocity(0), Acceleration(0)};
+            Phase phase;
+            if (t < m_accelTime) {
+                phase = speedUp(t);
+            } else if (t < m_accelTime + m_cruiseTime) {
+                phase = {m_peakVelocity * m_accelTime / 2 + m_peakVelocity * (t - m_accelTime), m_peakVelocity, 0};
+            } else {
+                // slowing down is speeding up backwards from the goal
+                const Phase mirror = speedUp(m_duration - t);
+                phase = {m_distance - mirror.position, mirror.velocity, -mirror.acceleration};
+            }
+            return {m_start + P(m_sign * phase.position), Velocity(m_sign * phase.velocity),
+                    Acceleration(m_sign * phase.acceleration)};
+        }
+
+        /**
+         * @brief Get how long the profile takes
+         *
+         * @return Time the duration of the profile
+         */
+        Time getDuration() const { return Time(m_duration); }
+
+        /**
+         * @brief Get the position the profile starts at
+         *
+         * @return P the start position
+         */
+        P getStart() const { return m_start; }
+
+        /**
+         * @brief Get the position the profile ends at
+         *
+         * @return P the goal position
+         */
+        P getGoal() const { return m_goal; }
+
+        /**
+         * @brief Get the highest velocity of the profile
+         *
+         * @return Velocity the peak velocity, which is lower than the maximum velocity if the profile is too short to
+         * reach it
+         */
+        Velocity getPeakVelocity() const { return Velocity(m_sign * m_peakVelocity); }
+    private:
+        /**
+         * @brief the distance, velocity, and acceleration from the start, with the sign removed
+         */
+        struct Phase {
+                double position;
+                double velocity;
+                double acceleration;
+        };
+
+        /**
+         * @brief evaluate the part of the profile where it speeds up
+         */
+        Phase speedUp(double t) const {
+            if (t < m_jerkTime) {
+                // the acceleration ramps up
+                return {m_jerk * t * t * t / 6, m_jerk * t * t / 2, m_jerk * t};
+            }
+            if (t <= m_accelTime - m_jerkTime) {
+                // constant acceleration, after the ramp up, which covered a * tj^2 / 6 at a velocity of a * tj / 2
+                const double dt = t - m_jerkTime;
+                const double velocity = m_peakAcceleration * m_jerkTime / 2;
+                return {m_peakAcceleration * m_jerkTime * m_jerkTime / 6 + velocity * dt +
+                            m_peakAcceleration * dt * dt / 2,
+                        velocity + m_peakAcceleration * dt, m_peakAcceleration};
+            }
+            // the acceleration ramps down to 0 at the peak velocity
+            const double left = m_accelTime - t;
+            return {m_peakVelocity * m_accelTime / 2 - m_peakVelocity * left + m_jerk * left * left * left / 6,
+                    m_peakVelocity - m_jerk * left * left / 2, m_jerk * left};
+        }
+
+        P m_start;
+        P m_goal;
+        double m_sign = 1;
+        double m_distance = 0;
+        double m_jerk = INFINITY;
+        double m_peakVelocity = 0;
+        double m_peakAcceleration = 0;
+        double m_jerkTime = 0; /** how long the acceleration takes to ramp up, 0 for a trapezoidal profile */
+        double m_accelTime = 0; /** how long the profile takes to reach the peak velocity */
+        double m_cruiseTime = 0;
+        double m_duration = 0;
+};
+
+using AngularProfile = MotionProfile<Angle>;
+using LinearProfile = MotionProfile<Length>;
+} // namespace lemlib
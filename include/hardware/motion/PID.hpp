@@ -0,0 +1,200 @@
+#pragma once
+
+#include "units/units.hpp"
+#include <cmath>
+#include <optional>
+
+namespace lemlib {
+/**
+ * @brief Gains of a PID controller
+ *
+ * @tparam Input the type of the setpoint and measurement, like Angle
+ * @tparam Output the type of the output, like Voltage
+ *
+ * @b Example:
+ * @code {.cpp}
+ * // 12 volts per rotation of error, 2 volts per rotation second of accumulated error, and 0.5 volts per rps
+ * lemlib::PIDGains<Angle, Voltage> gains {12_volt / 1_stRot, 2_volt / (1_stRot * 1_sec), 0.5_volt / 1_rps};
+ * @endcode
+ */
+template <isQuantity Input, isQuantity Output> struct PIDGains {
+        Divided<Output, Input> kP = Divided<Output, Input>(0);
+        Divided<Output, Multiplied<Input, Time>> kI = Divided<Output, Multiplied<Input, Time>>(0);
+        Divided<Output, Divided<Input, Time>> kD = Divided<Output, Divided<Input, Time>>(0);
+};
+
+/**
+ * @brief Limits and filtering of a PID controller
+ *
+ * @tparam Output the type of the output, like Voltage
+ */
+template <isQuantity Output> struct PIDSettings {
+        Output minOutput = Output(-INFINITY);
+        Output maxOutput = Output(INFINITY);
+        Output maxIntegral = Output(INFINITY); /** the largest magnitude of the integral term */
+        /** how fast the integral unwinds while the output is limited, INFINITY to only clamp the integral */
+        Time antiWindupTime = 100_msec;
+        Time derivativeTimeConstant = 0_sec; /** the time constant of the low pass filter on the derivative */
+};
+
+/**
+ * @brief PID controller typed with units
+ *
+ * The integral term is stored as part of the output, so changing kI doesn't make the output jump. While the output is
+ * limited, the difference between the limited and unlimited output is fed back into the integral, which unwinds it
+ * towards 0 instead of letting it grow while the mechanism can't respond. This is called back-calculation. The
+ * integral term is also clamped to a maximum.
+ *
+ * The derivative is of the measurement rather than the error, so changing the setpoint doesn't cause a spike, and it is
+ * smoothed by a low pass filter, as differentiating amplifies noise. The time between updates is measured from the
+ * timestamps, so the controller stays correct if the loop runs late.
+ *
+ * Updates never allocate and take constant time. This class doesn't read any hardware, so it can be tested on a
+ * computer.
+ *
+ * @tparam Input the type of the setpoint and measurement, like Angle
+ * @tparam Output the type of the output, like Voltage
+ *
+ * @b Example:
+ * @code {.cpp}
+ * pros::Motor motor1(1, pros::v5::MotorGears::red);
+ * pros::Motor motor2(-2, pros::v5::MotorGears::red);
+ * lemlib::MotorGroup lift({motor1, motor2}, 100_rpm);
+ * lemlib::PID<Angle, Voltage> liftPID({12_volt / 1_stRot, 2_volt / (1_stRot * 1_sec), 0.5_volt / 1_rps},
+ *                                     {.minOutput = from_volt(-12), .maxOutput = 12_volt});
+ *
+ * void autonomous() {
+ *     while (true) {
+ *         const Voltage output = liftPID.update(1.5_stRot, lift.getAngle(), from_usec(pros::micros()));
+ *         lift.move(to_num(output / 12_volt));
+ *         pros::delay(10);
+ *     }
+ * }
+ * @endcode
+ */
+template <isQuantity Input, isQuantity Output> class PID {
+    public:
+        /**
+         * @brief Construct a new PID object
+         *
+         * @param gains the gains of the controller
+         * @param settings the limits and filtering of the controller
+         */
+        PID(PIDGains<Input, Output> gains, PIDSettings<Output> settings = {})
+            : m_gains(gains),
+              m_settings(settings) {}
+
+        /**
+         * @brief Calculate the output
+         *
+         * The first update after construction or reset() only uses the proportional term, as there is no previous
+         * update to measure the time from
+         *
+         * @param setpoint the target value
+         * @param measurement the measured value
+         * @param time the time of the measurement
+         * @return Output the output, within the output limits
+         */
+        Output update(Input setpoint, Input measurement, Time time) {
+            const Input error = setpoint - measurement;
+            const Time dt = m_time ? time - *m_time : 0_sec;
+            if (dt > 0_sec) {
+                const Divided<Input, Time> rate = (measurement - *m_measurement) / dt;
+                // exact first order filter, so the smoothing doesn't depend on the loop rate
+                const double alpha = -std::expm1(-to_num(dt / m_settings.derivativeTimeConstant));
+                m_rate += (rate - m_rate) * alpha;
+            }
+            if (dt > 0_sec || !m_time) {
+                m_time = time;
+                m_measurement = measurement;
+            }
+            m_error = error;
+            const Output proportional = m_gains.kP * error;
+            const Output derivative = m_gains.kD * m_rate * -1;
+            const Output unlimited = proportional + m_integral + derivative;
+            m_output = units::clamp(unlimited, m_settings.minOutput, m_settings.maxOutput);
+            if (dt > 0_sec) {
+                m_integral += m_gains.kI * error * dt;
+                // back-calculation, the integral is moved towards the value that would keep the output at its limit.
+                // It is only unwound to 0, as a large proportional term would push it far past 0, and the mechanism
+                // would stop short of the setpoint until it winds back up
+                const Output correction = (m_output - unlimited) * to_num(dt / m_settings.antiWindupTime);
+                if (units::sgn(correction) == -units::sgn(m_integral)) {
+                    m_integral = units::abs(correction) >= units::abs(m_integral) ? Output(0) : m_integral + correction;
+                }
+                m_integral = units::clamp(m_integral, m_settings.maxIntegral * -1, m_settings.maxIntegral);
+            }
+            return m_output;
+        }
+
+        /**
+         * @brief Get the output of the last update
+         *
+         * @return Output the output
+         */
+        Output getOutput() const { return m_output; }
+
+        /**
+         * @brief Get the error of the last update
+         *
+         * @return Input the setpoint minus the measurement
+         */
+        Input getError() const { return m_error; }
+
+        /**
+         * @brief Get the integral term, which is used by the next update
+         *
+         * @return Output the integral term
+         */
+        Output getIntegral() const { return m_integral; }
+
+        /**
+         * @brief Set the gains of the controller
+         *
+         * @param gains the gains
+         */
+        void setGains(PIDGains<Input, Output> gains) { m_gains = gains; }
+
+        /**
+         * @brief Get the gains of the controller
+         *
+         * @return PIDGains<Input, Output> the gains
+         */
+        PIDGains<Input, Output> getGains() const { return m_gains; }
+
+        /**
+         * @brief Set the limits and filtering of the controller
+         *
+         * @param settings the settings
+         */
+        void setSettings(PIDSettings<Output> settings) { m_settings = settings; }
+
+        /**
+         * @brief Get the limits and filtering of the controller
+         *
+         * @return PIDSettings<Output> the settings
+         */
+        PIDSettings<Output> getSettings() const { return m_settings; }
+
+        /**
+         * @brief Clear the integral and derivative, and forget the time of the last update
+         */
+        void reset() {
+            m_time.reset();
+            m_measurement.reset();
+            m_rate = Divided<Input, Time>(0);
+            m_integral = Output(0);
+            m_output = Output(0);
+            m_error = Input(0);
+        }
+    private:
+        PIDGains<Input, Output> m_gains;
+        PIDSettings<Output> m_settings;
+        std::optional<Time> m_time;
+        std::optional<Input> m_measurement;
+        Divided<Input, Time> m_rate = Divided<Input, Time>(0); /** the filtered rate of the measurement */
+        Output m_integral = Output(0);
+        Output m_output = Output(0);
+        Input m_error = Input(0);
+};
+} // namespace lemlib
@@ -0,0 +1,129 @@
+#pragma once
+
+#include "hardware/Motors/MotorGroup.hpp"
+#include "hardware/motion/MotionProfile.hpp"
+#include <optional>
+
+namespace lemlib {
+/**
+ * @brief Moves a MotorGroup to a target angle along a MotionProfile
+ *
+ * Moving to a target with the PID controller inside the motors gives no control over the velocity or acceleration on
+ * the way. A ProfiledMove instead plans a profile from the current angle to the target, and every update, commands
+ * the velocity and acceleration of the profile at that time with MotorGroup::moveVelocity(). The error between the
+ * profile and the measured angle is corrected by adding kP times the error to the velocity. In
+ * VelocityMode::FEEDFORWARD, the acceleration of the profile is used as the feedforward acceleration, which tracks the
+ * profile most closely.
+ *
+ * The angles and velocities are of the output of the motor group, after gearing.
+ *
+ * @b Example:
+ * @code {.cpp}
+ * pros::Motor motor1(1, pros::v5::MotorGears::red);
+ * pros::Motor motor2(-2, pros::v5::MotorGears::red);
+ * lemlib::MotorGroup lift({motor1, motor2}, 100_rpm);
+ * // S-curve profile, correcting 5 rotations per second for every rotation of error
+ * lemlib::ProfiledMove liftMove(lift, {1_rps, 4_rps2, 20_rps3}, 5_rps / 1_stRot);
+ *
+ * void autonomous() {
+ *     // blocks until the profile ends, and holds the lift there
+ *     lift.setBrakeMode(lemlib::BrakeMode::HOLD);
+ *     liftMove.moveTo(2_stRot);
+ *     // or update it in a loop which does other things too
+ *     liftMove.start(0_stRot);
+ *     while (!liftMove.isFinished()) {
+ *         liftMove.update();
+ *         pros::delay(10);
+ *     }
+ * }
+ * @endcode
+ */
+class ProfiledMove {
+    public:
+        /**
+         * @brief Construct a new ProfiledMove object
+         *
+         * @param motors the motor group to move, which must outlive the ProfiledMove
+         * @param constraints the limits of the profiles
+         * @param kP the velocity added per unit of error between the profile and the measured angle
+         */
+        ProfiledMove(MotorGroup& motors, ProfileConstraints<Angle> constraints,
+                     Divided<AngularVelocity, Angle> kP = 0_radps / 1_stRad);
+        /**
+         * @brief Plan a profile from the current angle to the target, starting now
+         *
+         * This function uses the following values of errno when an error state is reached:
+         *
+         * ENODEV: the port cannot be configured as a motor
+         *
+         * EINVAL: a constraint is not positive
+         *
+         * @param target the angle to move to
+         * @return 0 on success
+         * @return INT_MAX on failure, setting errno
+         */
+        int start(Angle target);
+        /**
+         * @brief Command the motor group to follow the profile at the current time
+         *
+         * This function should be called periodically, like in a control loop. After the profile ends, it keeps
+         * holding the target.
+         *
+         * This function uses the following values of errno when an error state is reached:
+         *
+         * ENODEV: the port cannot be configured as a motor
+         *
+         * EAGAIN: start() hasn't succeeded yet
+         *
+         * @return 0 on success
+         * @return INT_MAX on failure, setting errno
+         */
+        int update();
+        /**
+         * @brief Start a profile, and update it at a fixed rate until it ends
+         *
+         * This function blocks the task it is called from. When the profile ends, the motor group is stopped with
+         * MotorGroup::brake(), so it stays at the target if its brake mode is BrakeMode::HOLD.
+         *
+         * This function uses the same values of errno as start() and update()
+         *
+         * @param target the angle to move to
+         * @param period the time between updates
+         * @return 0 on success
+         * @return INT_MAX on failure, setting errno
+         */
+        int moveTo(Angle target, Time period = 10_msec);
+        /**
+         * @brief Whether the profile has ended
+         *
+         * @return true the profile has ended, or none was started
+         * @return false the profile is running
+         */
+        bool isFinished() const;
+        /**
+         * @brief Get the state of the profile at the last update
+         *
+         * @return ProfileState<Angle> the setpoint, at rest at 0 if no profile was started
+         */
+        ProfileState<Angle> getSetpoint() const;
+        /**
+         * @brief Set the limits of the profiles started after this call
+         *
+         * @param constraints the limits
+         */
+        void setConstraints(ProfileConstraints<Angle> constraints);
+        /**
+         * @brief Get the limits of the profiles
+         *
+         * @return ProfileConstraints<Angle> the limits
+         */
+        ProfileConstraints<Angle> getConstraints() const;
+    private:
+        MotorGroup& m_motors;
+        ProfileConstraints<Angle> m_constraints;
+        Divided<AngularVelocity, Angle> m_kP;
+        std::optional<AngularProfile> m_profile;
+        Time m_startTime = 0_sec;
+        ProfileState<Angle> m_setpoint = {0_stRad, 0_radps, 0_radps2};
+};
+} // namespace lemlib
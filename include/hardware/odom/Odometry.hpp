@@ -0,0 +1,201 @@
+#pragma once
+
+#include "hardware/IMU/IMU.hpp"
+#include "hardware/concurrency/Snapshot.hpp"
+#include "hardware/odom/TrackingWheel.hpp"
+#include "pros/rtos.hpp"
+#include "units/Pose.hpp"
+#include <atomic>
+#include <cstdint>
+#include <optional>
+
+namespace lemlib {
+/**
+ * @brief The state of the robot, as estimated by odometry
+ */
+struct OdomState {
+        units::Pose pose; /** position and heading of the robot */
+        units::VelocityPose velocity; /** velocity of the robot, in the field frame */
+        Time time = 0_sec; /** time the state was measured at, since PROS initialized */
+};
+
+/**
+ * @brief Tracks the position of the robot using tracking wheels and an optional IMU
+ *
+ * Odometry integrates the distance measured by the tracking wheels along arcs, which is exact if the robot moves at a
+ * constant linear and angular velocity between updates. The heading is measured by the IMU if there is one. Otherwise,
+ * it is calculated from the difference between two vertical tracking wheels.
+ *
+ * Updates run in a task at a fixed rate. The latest state is published through a Snapshot, so any task can read it
+ * at any time without blocking the odometry task. The time each update takes is measured, so it can be checked
+ * against the update period.
+ *
+ * The pose uses standard orientation: 0 is along the positive x axis, and angles increase counterclockwise.
+ *
+ * @b Example:
+ * @code {.cpp}
+ * lemlib::Rotation verticalEncoder = pros::Rotation(1);
+ * lemlib::Rotation horizontalEncoder = pros::Rotation(2);
+ * lemlib::V5IMU imu = pros::Imu(3);
+ * lemlib::TrackingWheel vertical(&verticalEncoder, 2.75_in, from_in(-1));
+ * lemlib::TrackingWheel horizontal(&horizontalEncoder, 2.75_in, from_in(-3));
+ * lemlib::Odometry odom(&vertical, nullptr, &horizontal, &imu);
+ *
+ * void initialize() {
+ *     imu.calibrate();
+ *     while (imu.isCalibrating()) pros::delay(10);
+ *     odom.start();
+ * }
+ *
+ * void opcontrol() {
+ *     while (true) {
+ *         const units::Pose pose = odom.getPose();
+ *         std::cout << to_in(pose.getX()) << ", " << to_in(pose.getY()) << std::endl;
+ *         pros::delay(50);
+ *     }
+ * }
+ * @endcode
+ */
+class Odometry {
+    public:
+        /**
+         * @brief Construct a new Odometry object
+         *
+         * At least one vertical tracking wheel is needed. If there is no IMU, a second vertical tracking wheel is
+         * needed to measure the heading, and the two wheels must have different offsets. Without a horizontal
+         * tracking wheel, the robot is assumed not to move sideways. All pointers must outlive the Odometry object.
+         *
+         * @param vertical1 a tracking wheel which rolls forwards
+         * @param vertical2 a second tracking wheel which rolls forwards, or nullptr
+         * @param horizontal a tracking wheel which rolls sideways, or nullptr
+         * @param imu the IMU used to measure heading, or nullptr
+         * @param period the time between updates
+         */
+        Odometry(TrackingWheel* vertical1, TrackingWheel* vertical2 = nullptr, TrackingWheel* horizontal = nullptr,
+                 IMU* imu = nullptr, Time period = 10_msec);
+        /**
+         * @brief Start the odometry task
+         *
+         * Tracking wheels are not reset, the first update only measures their current distance. If the task is
+         * already running, this function does nothing.
+         *
+         * This function uses the following values of errno when an error state is reached:
+         *
+         * EINVAL: there is no way to measure the heading, or no vertical tracking wheel. Without an IMU, the vertical
+         * tracking wheels must be at different offsets
+         *
+         * @param priority the priority of the odometry task
+         * @return 0 on success
+         * @return INT_MAX on failure, setting errno
+         */
+        int start(std::uint32_t priority = TASK_PRIORITY_MAX - 2);
+        /**
+         * @brief Stop the odometry task
+         *
+         * The last published state remains available
+         */
+        void stop();
+        /**
+         * @brief Run a single odometry update
+         *
+         * This function is called periodically by the odometry task. It should only be called directly when the task
+         * is not running, for example to step odometry manually.
+         *
+         * This function uses the following values of errno when an error state is reached:
+         *
+         * EINVAL: there is no way to measure the heading, or no vertical tracking wheel. Without an IMU, the vertical
+         * tracking wheels must be at different offsets
+         *
+         * It also uses the errno values of the tracking wheels and IMU. If a sensor fails, the update is skipped and
+         * the state is not changed.
+         *
+         * @return 0 on success
+         * @return INT_MAX on failure, setting errno
+         */
+        int update();
+        /**
+         * @brief Get the latest state of the robot
+         *
+         * This function never blocks, and can be called from any task
+         *
+         * @return OdomState the latest state
+         */
+        OdomState getState() const;
+        /**
+         * @brief Get the latest pose of the robot
+         *
+         * @return units::Pose the latest pose
+         */
+        units::Pose getPose() const;
+        /**
+         * @brief Get the latest velocity of the robot, in the field frame
+         *
+         * @return units::VelocityPose the latest velocity
+         */
+        units::VelocityPose getVelocity() const;
+        /**
+         * @brief Set the pose of the robot
+         *
+         * This function can be called from any task, but not from multiple tasks at the same time. The new pose is
+         * applied at the start of the next update.
+         *
+         * @param pose the new pose
+         */
+        void setPose(units::Pose pose);
+        /**
+         * @brief Get the longest time an update has taken since the latency was last reset
+         *
+         * @return Time the worst case update latency
+         */
+        Time getWorstCaseLatency() const;
+        /**
+         * @brief Get the time the last update took
+         *
+         * @return Time the last update latency
+         */
+        Time getLastLatency() const;
+        /**
+         * @brief Reset the worst case update latency
+         */
+        void resetLatency();
+        ~Odometry();
+    private:
+        /**
+         * @brief the distances measured by the sensors in a single update
+         */
+        struct Measurement {
+                Length vertical1 = 0_in;
+                Length vertical2 = 0_in;
+                Length horizontal = 0_in;
+                Angle heading = 0_stRad;
+        };
+
+        /**
+         * @brief read all the sensors
+         *
+         * @return 0 on success
+         * @return INT_MAX on failure, setting errno
+         */
+        int measure(Measurement& measurement);
+
+        TrackingWheel* m_vertical1;
+        TrackingWheel* m_vertical2;
+        TrackingWheel* m_horizontal;
+        IMU* m_imu;
+        Time m_period;
+
+        std::optional<pros::Task> m_task;
+        std::atomic<bool> m_running = false;
+
+        // only accessed by the task running updates
+        std::optional<Measurement> m_previous;
+        Angle m_headingOffset = 0_stRad;
+
+        Snapshot<OdomState> m_state;
+        Snapshot<units::Pose> m_requestedPose;
+        std::uint32_t m_appliedPoseVersion = 0;
+
+        std::atomic<std::uint32_t> m_lastLatency = 0; /** microseconds */
+        std::atomic<std::uint32_t> m_worstLatency = 0; /** microseconds */
+};
+} // namespace lemlib
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "hardware/encoder/Encoder.hpp"
+
+namespace lemlib {
+/**
+ * @brief A wheel attached to an encoder, used to measure the distance the robot travels
+ *
+ * A tracking wheel can be any encoder: a free spinning wheel on a Rotation sensor or Optical Shaft encoder, or a
+ * powered drivetrain wheel measured by a Motor or MotorGroup.
+ *
+ * If the encoder is a Rotation sensor which is sampling, the distance is measured from the latest sample. The tracking
+ * wheel doesn't read the sample buffer, so the samples are left for user code to read with Rotation::readSamples().
+ */
+class TrackingWheel {
+    public:
+        /**
+         * @brief Construct a new Tracking Wheel object
+         *
+         * The offset is the signed distance from the wheel to the tracking center of the robot, measured perpendicular
+         * to the direction the wheel rolls in. For vertical wheels, which roll forwards, a positive offset means the
+         * wheel is to the left of the tracking center. For horizontal wheels, which roll to the left, a positive offset
+         * means the wheel is in front of the tracking center.
+         *
+         * @param encoder the encoder measuring the rotation of the wheel. Must outlive the tracking wheel
+         * @param diameter the diameter of the wheel
+         * @param offset the signed offset of the wheel from the tracking center
+         *
+         * @b Example:
+         * @code {.cpp}
+         * lemlib::Rotation encoder = pros::Rotation(1);
+         * // 2.75" wheel, 5" to the right of the tracking center
+         * lemlib::TrackingWheel wheel(&encoder, 2.75_in, from_in(-5));
+         * @endcode
+         */
+        TrackingWheel(Encoder* encoder, Length diameter, Length offset);
+        /**
+         * @brief Get the distance the wheel has travelled
+         *
+         * The distance is measured relative to the last time the wheel was reset.
+         *
+         * This function uses the errno values of the encoder when an error state is reached
+         *
+         * @return Length the distance the wheel has travelled
+         * @return INFINITY if there is an error, setting errno
+         *
+         * @b Example:
+         * @code {.cpp}
+         * void initialize() {
+         *     const Length distance = wheel.getDistance();
+         *     if (distance == INFINITY) {
+         *         std::cout << "Error getting distance!" << std::endl;
+         *     } else {
+         *         std::cout << "Distance: " << to_in(distance) << std::endl;
+         *     }
+         * }
+         * @endcode
+         */
+        Length getDistance();
+        /**
+         * @brief Reset the distance the wheel has travelled to 0
+         *
+         * This function uses the errno values of the encoder when an error state is reached
+         *
+         * @return 0 on success
+         * @return INT_MAX on failure, setting errno
+         */
+        int reset();
+        /**
+         * @brief Get the signed offset of the wheel from the tracking center
+         *
+         * @return Length the offset
+         */
+        Length getOffset() const;
+        /**
+         * @brief Get the diameter of the wheel
+         *
+         * @return Length the diameter
+         */
+        Length getDiameter() const;
+    private:
+        Encoder* m_encoder;
+        Length m_diameter;
+        Length m_offset;
+};
+} // namespace lemlib
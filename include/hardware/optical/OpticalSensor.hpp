@@ -0,0 +1,223 @@
+#pragma once
+
+#include "hardware/concurrency/Queue.hpp"
+#include "pros/optical.hpp"
+#include "pros/rtos.hpp"
+#include "units/units.hpp"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+
+namespace lemlib {
+/**
+ * @brief A value measured by the optical sensor
+ */
+enum class OpticalChannel {
+    PROXIMITY, /** proximity, from 0 (far) to 255 (close) */
+    HUE /** hue, from 0 to 360 degrees */
+};
+
+/**
+ * @brief A range of values on a channel of the optical sensor, which generates events when it is entered or exited
+ */
+struct OpticalTrigger {
+        OpticalChannel channel; /** the channel to watch */
+        double low; /** the lowest value in the range. For hue, this may be greater than high to wrap through 0 */
+        double high; /** the highest value in the range */
+        Time debounce = 0_sec; /** how long the value has to stay in or out of the range before an event is generated */
+};
+
+/**
+ * @brief The type of an optical sensor event
+ */
+enum class OpticalEventType {
+    ENTER, /** the value entered the range of the trigger */
+    EXIT /** the value exited the range of the trigger */
+};
+
+/**
+ * @brief An event detected by the optical sensor sampler
+ */
+struct OpticalEvent {
+        std::size_t trigger = 0; /** the index of the trigger that generated the event */
+        OpticalEventType type = OpticalEventType::ENTER; /** whether the value entered or exited the range */
+        double value = 0; /** the first value that entered or exited the range */
+        Time time = 0_sec; /** the time of the first sample that entered or exited the range, since PROS initialized */
+};
+
+/**
+ * @brief Wrapper for the V5 Optical Sensor, with high rate event detection
+ *
+ * Polling the optical sensor from a control loop can miss short events, like a game object passing through an intake.
+ * Instead, a sampler task can read the sensor at a fixed rate, and check a set of triggers on every sample. Each time
+ * a value enters or exits the range of a trigger, and stays there for the debounce time, an event is pushed to a
+ * lock-free queue. Consumers can then react to every event, even if they run slower than the sampler.
+ *
+ * @b Example:
+ * @code {.cpp}
+ * lemlib::OpticalSensor optical = pros::Optical(1);
+ *
+ * void initialize() {
+ *     // an object is in the intake when the proximity is high for at least 10ms
+ *     optical.addTrigger({lemlib::OpticalChannel::PROXIMITY, 150, 255, 10_msec});
+ *     // a red object has a hue near 0
+ *     optical.addTrigger({lemlib::OpticalChannel::HUE, 340, 20});
+ *     optical.setLedBrightness(100_percent);
+ *     optical.startSampling();
+ * }
+ *
+ * void opcontrol() {
+ *     std::array<lemlib::OpticalEvent, 8> events;
+ *     while (true) {
+ *         const std::size_t count = optical.readEvents(events);
+ *         for (std::size_t i = 0; i < count; i++) {
+ *             if (events[i].trigger == 1 && events[i].type == lemlib::OpticalEventType::ENTER) reject();
+ *         }
+ *         pros::delay(10);
+ *     }
+ * }
+ * @endcode
+ */
+class OpticalSensor {
+    public:
+        static constexpr std::size_t MAX_TRIGGERS = 8; /** the maximum number of triggers */
+        static constexpr std::size_t EVENT_CAPACITY = 32; /** the number of events the queue can hold */
+
+        /**
+         * @brief Construct a new Optical Sensor
+         *
+         * @param sensor the optical sensor
+         */
+        OpticalSensor(pros::Optical sensor);
+        /**
+         * @brief whether the optical sensor is connected
+         *
+         * @return true the sensor is connected
+         * @return false the sensor is not connected
+         */
+        int isConnected();
+        /**
+         * @brief Get the proximity measured by the sensor
+         *
+         * This function uses the following values of errno when an error state is reached:
+         *
+         * ENXIO: the port is not within the range of valid ports (1-21)
+         * ENODEV: the port cannot be configured as an Optical Sensor
+         *
+         * @return int the proximity, from 0 (far) to 255 (close)
+         * @return INT_MAX if there is an error, setting errno
+         */
+        int getProximity();
+        /**
+         * @brief Get the hue measured by the sensor
+         *
+         * This function uses the following values of errno when an error state is reached:
+         *
+         * ENXIO: the port is not within the range of valid ports (1-21)
+         * ENODEV: the port cannot be configured as an Optical Sensor
+         *
+         * @return double the hue, from 0 to 360 degrees
+         * @return INFINITY if there is an error, setting errno
+         */
+        double getHue();
+        /**
+         * @brief Set the brightness of the sensor's LED
+         *
+         * This function uses the following values of errno when an error state is reached:
+         *
+         * ENXIO: the port is not within the range of valid ports (1-21)
+         * ENODEV: the port cannot be configured as an Optical Sensor
+         *
+         * @param brightness the brightness, from 0 to 1
+         * @return 0 on success
+         * @return INT_MAX on failure, setting errno
+         */
+        int setLedBrightness(Number brightness);
+        /**
+         * @brief Add a trigger
+         *
+         * Triggers can only be added while the sampler is not running.
+         *
+         * This function uses the following values of errno when an error state is reached:
+         *
+         * ENOMEM: there are already MAX_TRIGGERS triggers
+         * EBUSY: the sampler is running
+         *
+         * @param trigger the trigger to add
+         * @return int the index of the trigger, which is stored in the events it generates
+         * @return INT_MAX on failure, setting errno
+         */
+        int addTrigger(const OpticalTrigger& trigger);
+        /**
+         * @brief Start reading the sensor in a sampler task
+         *
+         * The sensor produces a new reading every integration time. Sampling faster than that only reads the same
+         * values again. If the sampler is already running, this function does nothing.
+         *
+         * @param period the time between samples
+         * @param priority the priority of the sampler task
+         */
+        void startSampling(Time period = 10_msec, std::uint32_t priority = TASK_PRIORITY_MAX - 2);
+        /**
+         * @brief Stop the sampler task
+         *
+         * Events that have not been read are discarded
+         */
+        void stopSampling();
+        /**
+         * @brief Read the events detected since the last call, oldest first
+         *
+         * Only one task may read events. If events are not read fast enough, the queue fills up, and new events are
+         * dropped.
+         *
+         * @param out where to store the events
+         * @return std::size_t the number of events read. 0 if the sampler is not running
+         */
+        std::size_t readEvents(std::span<OpticalEvent> out);
+        /**
+         * @brief Get the number of events dropped because they were not read fast enough
+         *
+         * @return std::uint32_t the number of events dropped since the sampler was started
+         */
+        std::uint32_t getDroppedEvents() const;
+        ~OpticalSensor();
+    private:
+        /**
+         * @brief the debounce state of a trigger
+         */
+        struct TriggerState {
+                bool inside = false; /** whether the value is in the range, after debouncing */
+                bool pending = false; /** whether the value has changed, but not for long enough */
+                double pendingValue = 0;
+                Time pendingTime = 0_sec;
+        };
+
+        /**
+         * @brief state shared with the sampler task
+         */
+        struct Sampler {
+                SPSCQueue<OpticalEvent, EVENT_CAPACITY> events;
+                std::array<TriggerState, MAX_TRIGGERS> states {};
+                std::atomic<bool> running = true;
+                std::optional<pros::Task> task;
+        };
+
+        /**
+         * @brief the loop run by the sampler task
+         */
+        void sample(std::uint32_t periodMs);
+        /**
+         * @brief check a trigger against a new value
+         */
+        void check(std::size_t index, double value, Time time);
+
+        pros::Optical m_sensor;
+        std::array<OpticalTrigger, MAX_TRIGGERS> m_triggers {};
+        std::size_t m_triggerCount = 0;
+        std::unique_ptr<Sampler> m_sampler;
+};
+} // namespace lemlib
@@ -0,0 +1,239 @@
+#pragma once
+
+#include "hardware/IMU/IMU.hpp"
+#include "hardware/concurrency/Queue.hpp"
+#include "hardware/encoder/Encoder.hpp"
+#include "pros/rtos.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <optional>
+
+namespace lemlib {
+/**
+ * @brief A single sensor reading, as stored in a recording
+ */
+struct SensorRecord {
+        std::uint64_t time = 0; /** microseconds since PROS initialized */
+        double value = 0; /** the reading in radians, or INFINITY if the read failed */
+        std::uint32_t channel = 0; /** the channel of the sensor which was read */
+        std::int32_t error = 0; /** errno if the read failed, otherwise 0 */
+};
+
+/**
+ * @brief Records sensor readings to a file, so they can be replayed later
+ *
+ * Sensors are recorded by wrapping them in a RecordingEncoder or RecordingIMU, each with its own channel. Every reading
+ * is added to a lock-free queue, so sensors can be read from any task, and reading them never waits for the file. A low
+ * priority task writes the queue to the file. If the queue fills up, readings are dropped and counted.
+ *
+ * The file has the same format as a Logger<SensorRecord>: the characters "LLOG", the size of a SensorRecord as a little
+ * endian 32 bit integer, then the records. It can be replayed with SensorReplay.
+ *
+ * @b Example:
+ * @code {.cpp}
+ * lemlib::SensorRecorder recorder("/usd/match.bin");
+ * lemlib::Rotation leftRotation = pros::Rotation(1);
+ * lemlib::V5IMU v5imu = pros::Imu(2);
+ * lemlib::RecordingEncoder leftEncoder(&leftRotation, &recorder, 0);
+ * lemlib::RecordingIMU imu(&v5imu, &recorder, 1);
+ *
+ * void initialize() {
+ *     recorder.start();
+ *     // use leftEncoder and imu instead of the real sensors
+ * }
+ * @endcode
+ */
+class SensorRecorder {
+    public:
+        static constexpr std::size_t QUEUE_SIZE = 1024; /** the number of readings waiting to be written */
+
+        /**
+         * @brief Construct a new SensorRecorder object
+         *
+         * The file is not opened until start() is called
+         *
+         * @param path the path of the file. Files on the SD card start with /usd/
+         */
+        SensorRecorder(const char* path);
+        /**
+         * @brief Open the file, replacing it if it exists, and start the task which writes readings to it
+         *
+         * If the task is already running, this function does nothing
+         *
+         * This function uses the errno values of fopen and fwrite when an error state is reached, for example:
+         *
+         * ENXIO: there is no SD card
+         *
+         * @param priority the priority of the task. It should be lower than the priority of the tasks reading sensors
+         * @return 0 on success
+         * @return INT_MAX on failure, setting errno
+         */
+        int start(std::uint32_t priority = TASK_PRIORITY_MIN + 1);
+        /**
+         * @brief Stop the task, write the readings in the queue, and close the file
+         *
+         * This function uses the errno values of fwrite and fclose when an error state is reached, including the error
+         * of a write by the task
+         *
+         * @return 0 on success
+         * @return INT_MAX if a write failed, setting errno
+         */
+        int stop();
+        /**
+         * @brief Record a reading
+         *
+         * This function never blocks, and can be called from any task. It is called by the recording sensors.
+         *
+         * @param channel the channel of the sensor
+         * @param value the reading in radians, or INFINITY if the read failed
+         * @param error errno if the read failed, otherwise 0
+         */
+        void record(std::uint32_t channel, double value, std::int32_t error);
+        /**
+         * @brief Write the readings in the queue to the file
+         *
+         * This function is called by the task. It should only be called directly when the task is not running.
+         *
+         * If a write fails, the error is kept until the file is opened again by start(), and nothing else is written to
+         * the file. The task stops, and the readings recorded after the error are dropped.
+         *
+         * @return int the number of readings written
+         * @return INT_MAX if a write failed, now or before, setting errno
+         */
+        int flush();
+        /**
+         * @brief Get the error of the write which failed
+         *
+         * @return int errno of the write which failed, or 0 if no write failed
+         */
+        int getError() const;
+        /**
+         * @brief Get the number of readings dropped because the queue was full
+         *
+         * @return std::uint32_t the number of readings dropped
+         */
+        std::uint32_t getDropped() const;
+        ~SensorRecorder();
+    private:
+        const char* m_path;
+        std::FILE* m_file = nullptr;
+        MPSCQueue<SensorRecord, QUEUE_SIZE> m_queue;
+        std::atomic<int> m_error = 0; /** errno of the write which failed, or 0 */
+
+        std::optional<pros::Task> m_task;
+        std::atomic<bool> m_running = false;
+};
+
+/**
+ * @brief An encoder which records every angle it measures
+ *
+ * Every call is forwarded to the wrapped encoder. The result of each getAngle() call is recorded, including errors.
+ */
+class RecordingEncoder : public Encoder {
+    public:
+        /**
+         * @brief Construct a new RecordingEncoder object
+         *
+         * @param encoder the encoder to record. Must outlive the RecordingEncoder
+         * @param recorder the recorder to add readings to. Must outlive the RecordingEncoder
+         * @param channel the channel of the encoder. Must be different for every recorded sensor
+         */
+        RecordingEncoder(Encoder* encoder, SensorRecorder* recorder, std::uint32_t channel);
+        /**
+         * @brief whether the wrapped encoder is connected
+         *
+         * @return 0 if its not connected
+         * @return 1 if it is connected
+         * @return INT_MAX if there is an error, setting errno
+         */
+        int isConnected() override;
+        /**
+         * @brief Get the angle measured by the wrapped encoder, and record it
+         *
+         * @return Angle the relative angle measured by the encoder
+         * @return INFINITY if there is an error, setting errno
+         */
+        Angle getAngle() override;
+        /**
+         * @brief Set the relative angle of the wrapped encoder
+         *
+         * @param angle the relative angle to set the measured angle to
+         * @return 0 on success
+         * @return INT_MAX on failure, setting errno
+         */
+        int setAngle(Angle angle) override;
+    private:
+        Encoder* m_encoder;
+        SensorRecorder* m_recorder;
+        std::uint32_t m_channel;
+};
+
+/**
+ * @brief An IMU which records every rotation it measures
+ *
+ * Every call is forwarded to the wrapped IMU. The result of each getRotation() call is recorded, including errors.
+ */
+class RecordingIMU : public IMU {
+    public:
+        /**
+         * @brief Construct a new RecordingIMU object
+         *
+         * @param imu the IMU to record. Must outlive the RecordingIMU
+         * @param recorder the recorder to add readings to. Must outlive the RecordingIMU
+         * @param channel the channel of the IMU. Must be different for every recorded sensor
+         */
+        RecordingIMU(IMU* imu, SensorRecorder* recorder, std::uint32_t channel);
+        /**
+         * @brief calibrate the wrapped IMU
+         *
+         * @return 0 success
+         * @return INT_MAX error occurred, setting errno
+         */
+        int calibrate() override;
+        /**
+         * @brief check if the wrapped IMU is calibrated
+         *
+         * @return true the IMU is calibrated
+         * @return false the IMU is not calibrated
+         * @return INT_MAX error occurred, setting errno
+         */
+        int isCalibrated() override;
+        /**
+         * @brief check if the wrapped IMU is calibrating
+         *
+         * @return true the IMU is calibrating
+         * @return false the IMU is not calibrating
+         * @return INT_MAX error occurred, setting errno
+         */
+        int isCalibrating() override;
+        /**
+         * @brief whether the wrapped IMU is connected
+         *
+         * @return true the IMU is connected
+         * @return false the IMU is not connected
+         * @return INT_MAX error occurred, setting errno
+         */
+        int isConnected() override;
+        /**
+         * @brief Get the rotation of the wrapped IMU, and record it
+         *
+         * @return Angle the rotation of the IMU
+         * @return INFINITY error occurred, setting errno
+         */
+        Angle getRotation() override;
+        /**
+         * @brief Set the rotation of the wrapped IMU
+         *
+         * @param rotation the rotation to set the measured rotation to
+         * @return int 0 success
+         * @return INT_MAX error occurred, setting errno
+         */
+        int setRotation(Angle rotation) override;
+    private:
+        IMU* m_imu;
+        SensorRecorder* m_recorder;
+        std::uint32_t m_channel;
+};
+} // namespace lemlib
@@ -0,0 +1,267 @@
+#pragma once
+
+#include "hardware/IMU/IMU.hpp"
+#include "hardware/encoder/Encoder.hpp"
+#include "hardware/replay/SensorRecorder.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace lemlib {
+/**
+ * @brief How a SensorReplay plays back a recording
+ */
+enum class ReplayMode {
+    SEQUENTIAL, /** each read returns the next reading of the sensor, so the recording plays as fast as it is read */
+    TIMED, /** each read returns the latest reading of the sensor at the replay time, which is set by the caller */
+};
+
+/**
+ * @brief Plays back a recording made by a SensorRecorder
+ *
+ * Recorded sensors are played back by a ReplayEncoder or ReplayIMU with the same channel. This way, code using the
+ * sensors, like odometry, can be run on a computer with the exact readings of a real match, to find bugs or measure
+ * performance.
+ *
+ * In SEQUENTIAL mode, each read returns the next reading of the sensor. If the code reads the sensors in the same order
+ * as when the recording was made, it gets the same readings, as fast as it can process them.
+ *
+ * In TIMED mode, each read returns the latest reading at the replay time, which is controlled with setTime() and
+ * advance(). Advancing the time by the period of the control loop each iteration simulates running in real time,
+ * while still being deterministic.
+ *
+ * The whole recording is loaded into memory. A SensorReplay and its sensors are not thread safe.
+ *
+ * @b Example:
+ * @code {.cpp}
+ * int main() {
+ *     lemlib::SensorReplay replay(lemlib::ReplayMode::TIMED);
+ *     if (replay.load("match.bin") == INT_MAX) return 1;
+ *     lemlib::ReplayEncoder leftEncoder(&replay, 0);
+ *     lemlib::ReplayIMU imu(&replay, 1);
+ *     while (!replay.isFinished()) {
+ *         replay.advance(10_msec);
+ *         std::cout << to_stDeg(imu.getRotation()) << std::endl;
+ *     }
+ * }
+ * @endcode
+ */
+class SensorReplay {
+    public:
+        /**
+         * @brief Construct a new SensorReplay object
+         *
+         * @param mode how the recording is played back
+         */
+        SensorReplay(ReplayMode mode = ReplayMode::SEQUENTIAL);
+        /**
+         * @brief Load a recording, and start playing it from the beginning
+         *
+         * This function uses the following values of errno when an error state is reached:
+         *
+         * EINVAL: the file is not a recording
+         *
+         * It also uses the errno values of fopen.
+         *
+         * @param path the path of the recording
+         * @return 0 on success
+         * @return INT_MAX on failure, setting errno
+         */
+        int load(const char* path);
+        /**
+         * @brief Start playing the recording from the beginning again
+         */
+        void rewind();
+        /**
+         * @brief Set the replay time, used in TIMED mode
+         *
+         * @param time the time since PROS initialized, in the recording
+         */
+        void setTime(Time time);
+        /**
+         * @brief Advance the replay time, used in TIMED mode
+         *
+         * @param time how much to advance the replay time by
+         */
+        void advance(Time time);
+        /**
+         * @brief Get the replay time
+         *
+         * In SEQUENTIAL mode, this is the time of the last reading returned
+         *
+         * @return Time the time since PROS initialized, in the recording
+         */
+        Time getTime() const;
+        /**
+         * @brief Get the time of the first reading in the recording
+         *
+         * @return Time the time of the first reading, or 0 if the recording is empty
+         */
+        Time getStartTime() const;
+        /**
+         * @brief Get the time of the last reading in the recording
+         *
+         * @return Time the time of the last reading, or 0 if the recording is empty
+         */
+        Time getEndTime() const;
+        /**
+         * @brief Whether the end of the recording has been reached
+         *
+         * In SEQUENTIAL mode, this is when every reading has been returned. In TIMED mode, it is when the replay time
+         * is past the last reading.
+         *
+         * @return true the end of the recording has been reached
+         * @return false there are readings left
+         */
+        bool isFinished() const;
+        /**
+         * @brief Whether a channel has any readings in the recording
+         *
+         * @param channel the channel
+         * @return true the channel has readings
+         * @return false the channel has no readings
+         */
+        bool hasChannel(std::uint32_t channel) const;
+        /**
+         * @brief Read the next reading of a channel
+         *
+         * This function is called by the replay sensors
+         *
+         * This function uses the following values of errno when an error state is reached:
+         *
+         * ENODATA: there is no reading, because the channel has no readings left, or none before the replay time
+         *
+         * It also uses the errno values recorded with the reading.
+         *
+         * @param channel the channel
+         * @return double the reading in radians
+         * @return INFINITY if there is no reading or the reading was an error, setting errno
+         */
+        double read(std::uint32_t channel);
+    private:
+        /**
+         * @brief the readings of a single channel
+         */
+        struct Channel {
+                std::vector<std::size_t> records; /** indices of the records of the channel, in order */
+                std::size_t next = 0; /** index in records of the next record to return */
+        };
+
+        ReplayMode m_mode;
+        std::vector<SensorRecord> m_records;
+        std::unordered_map<std::uint32_t, Channel> m_channels;
+        std::size_t m_remaining = 0; /** records not returned yet, in SEQUENTIAL mode */
+        std::uint64_t m_time = 0; /** microseconds */
+};
+
+/**
+ * @brief An encoder which plays back the angles recorded by a RecordingEncoder
+ *
+ * setAngle() does nothing, as the effect of setting the angle of the original encoder is already part of the
+ * recorded angles.
+ */
+class ReplayEncoder : public Encoder {
+    public:
+        /**
+         * @brief Construct a new ReplayEncoder object
+         *
+         * @param replay the recording to play back. Must outlive the ReplayEncoder
+         * @param channel the channel the encoder was recorded on
+         */
+        ReplayEncoder(SensorReplay* replay, std::uint32_t channel);
+        /**
+         * @brief whether the encoder was recorded
+         *
+         * @return 0 if the channel has no readings
+         * @return 1 if the channel has readings
+         */
+        int isConnected() override;
+        /**
+         * @brief Get the next recorded angle
+         *
+         * This function uses the following values of errno when an error state is reached:
+         *
+         * ENODATA: there is no reading left, or none before the replay time
+         *
+         * It also uses the errno values recorded with the angle.
+         *
+         * @return Angle the recorded angle
+         * @return INFINITY if there is an error, setting errno
+         */
+        Angle getAngle() override;
+        /**
+         * @brief Does nothing, the recorded angles already include the effects of setting the angle
+         *
+         * @return 0
+         */
+        int setAngle(Angle angle) override;
+    private:
+        SensorReplay* m_replay;
+        std::uint32_t m_channel;
+};
+
+/**
+ * @brief An IMU which plays back the rotations recorded by a RecordingIMU
+ *
+ * The IMU is always calibrated, and setRotation() does nothing, as the effect of setting the rotation of the original
+ * IMU is already part of the recorded rotations.
+ */
+class ReplayIMU : public IMU {
+    public:
+        /**
+         * @brief Construct a new ReplayIMU object
+         *
+         * @param replay the recording to play back. Must outlive the ReplayIMU
+         * @param channel the channel the IMU was recorded on
+         */
+        ReplayIMU(SensorReplay* replay, std::uint32_t channel);
+        /**
+         * @brief Does nothing, the recorded rotations are already calibrated
+         *
+         * @return 0
+         */
+        int calibrate() override;
+        /**
+         * @brief The replayed IMU is always calibrated
+         *
+         * @return true
+         */
+        int isCalibrated() override;
+        /**
+         * @brief The replayed IMU is never calibrating
+         *
+         * @return false
+         */
+        int isCalibrating() override;
+        /**
+         * @brief whether the IMU was recorded
+         *
+         * @return true the channel has readings
+         * @return false the channel has no readings
+         */
+        int isConnected() override;
+        /**
+         * @brief Get the next recorded rotation
+         *
+         * This function uses the following values of errno when an error state is reached:
+         *
+         * ENODATA: there is no reading left, or none before the replay time
+         *
+         * It also uses the errno values recorded with the rotation.
+         *
+         * @return Angle the recorded rotation
+         * @return INFINITY error occurred, setting errno
+         */
+        Angle getRotation() override;
+        /**
+         * @brief Does nothing, the recorded rotations already include the effects of setting the rotation
+         *
+         * @return 0
+         */
+        int setRotation(Angle rotation) override;
+    private:
+        SensorReplay* m_replay;
+        std::uint32_t m_channel;
+};
+} // namespace lemlib
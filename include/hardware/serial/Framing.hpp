@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace lemlib {
+/**
+ * @brief calculate the CRC-16/CCITT-FALSE checksum of some data
+ *
+ * @param data the data to check
+ * @return std::uint16_t the checksum
+ */
+std::uint16_t crc16(std::span<const std::uint8_t> data);
+
+/**
+ * @brief the maximum size of some data after it is COBS encoded, not including the zero byte which ends the frame
+ *
+ * @param length the size of the data
+ * @return constexpr std::size_t the maximum size of the encoded data
+ */
+constexpr std::size_t cobsMaxSize(std::size_t length) { return length + length / 254 + 1; }
+
+/**
+ * @brief encode data with Consistent Overhead Byte Stuffing (COBS)
+ *
+ * COBS removes every zero byte from the data, so a zero byte can be used to mark the end of a frame. The zero byte is
+ * not written by this function.
+ *
+ * @param data the data to encode
+ * @param out where to write the encoded data. Must hold at least cobsMaxSize(data.size()) bytes
+ * @return std::size_t the size of the encoded data
+ */
+std::size_t cobsEncode(std::span<const std::uint8_t> data, std::uint8_t* out);
+
+/**
+ * @brief decode COBS encoded data in place
+ *
+ * Decoding can be done in place because the decoded data is always shorter than the encoded data
+ *
+ * @param data the encoded data, without the zero byte which ends the frame
+ * @param length the size of the encoded data
+ * @return std::size_t the size of the decoded data, or SIZE_MAX if the data is not valid COBS
+ */
+std::size_t cobsDecode(std::uint8_t* data, std::size_t length);
+} // namespace lemlib
@@ -0,0 +1,171 @@
+#pragma once
+
+#include "hardware/concurrency/Snapshot.hpp"
+#include "pros/rtos.hpp"
+#include "pros/serial.hpp"
+#include "units/units.hpp"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+
+namespace lemlib {
+/**
+ * @brief The latest value received on a channel of a SerialPort
+ */
+struct SerialChannelValue {
+        std::int32_t value = 0; /** the value sent by the device */
+        Time time = 0_sec; /** the time the value was received, since PROS initialized */
+};
+
+/**
+ * @brief Receives values from a custom sensor connected to a smart port
+ *
+ * Custom sensors, like a coprocessor reading encoders or a gyro, send frames over the smart port's RS-485 serial
+ * line. Each frame carries a single signed 32 bit value on one of MAX_CHANNELS channels, so one device can report
+ * several sensors.
+ *
+ * Before framing, a frame is 7 bytes long:
+ *
+ * | byte | content                                                      |
+ * | ---- | ------------------------------------------------------------ |
+ * | 0    | channel                                                      |
+ * | 1-4  | value, little endian two's complement                        |
+ * | 5-6  | CRC-16/CCITT-FALSE of bytes 0-4, little endian               |
+ *
+ * The frame is then encoded with Consistent Overhead Byte Stuffing (COBS), which removes every zero byte, and a zero
+ * byte is sent after it. This way, the receiver can always find the start of the next frame, even after noise or a
+ * dropped byte. encodeFrame() can be used to build frames on the device.
+ *
+ * Bytes are read straight into a fixed buffer, and frames are decoded in place, so receiving never allocates or copies
+ * a frame. A task reads the port at a fixed rate, and publishes the latest value of each channel through a Snapshot.
+ *
+ * @b Example:
+ * @code {.cpp}
+ * lemlib::SerialPort coprocessor(1, 115200);
+ * lemlib::SerialEncoder leftEncoder(&coprocessor, 0, 2048);
+ * lemlib::SerialEncoder rightEncoder(&coprocessor, 1, 2048);
+ *
+ * void initialize() {
+ *     coprocessor.start();
+ * }
+ * @endcode
+ */
+class SerialPort {
+    public:
+        static constexpr std::size_t MAX_CHANNELS = 16; /** the number of channels on a port */
+        static constexpr std::size_t PAYLOAD_SIZE = 7; /** the size of a frame before it is encoded */
+        static constexpr std::size_t FRAME_SIZE = PAYLOAD_SIZE + 2; /** the size of an encoded frame */
+
+        /**
+         * @brief Construct a new SerialPort object
+         *
+         * @param port the smart port the device is connected to
+         * @param baudrate the baudrate of the device
+         */
+        SerialPort(std::uint8_t port, std::int32_t baudrate);
+        /**
+         * @brief Start the task reading the port
+         *
+         * If the task is already running, this function does nothing
+         *
+         * @param period the time between reads
+         * @param priority the priority of the task
+         */
+        void start(Time period = 5_msec, std::uint32_t priority = TASK_PRIORITY_MAX - 2);
+        /**
+         * @brief Stop the task reading the port
+         */
+        void stop();
+        /**
+         * @brief Read all available bytes from the port, and process the frames in them
+         *
+         * This function is called periodically by the task. It should only be called directly when the task is not
+         * running.
+         *
+         * This function uses the following values of errno when an error state is reached:
+         *
+         * ENXIO: the port is not within the range of valid ports (1-21)
+         * EACCES: another resource is currently trying to access the port
+         *
+         * @return 0 on success
+         * @return INT_MAX on failure, setting errno
+         */
+        int update();
+        /**
+         * @brief Process bytes received from the device
+         *
+         * This function is called by update(). It can also be used to feed recorded bytes to the port.
+         *
+         * @param bytes the received bytes
+         */
+        void receive(std::span<const std::uint8_t> bytes);
+        /**
+         * @brief Get the latest value received on a channel
+         *
+         * This function never blocks, and can be called from any task
+         *
+         * @param channel the channel
+         * @return std::optional<SerialChannelValue> the latest value, or std::nullopt if no value has been received
+         */
+        std::optional<SerialChannelValue> getChannel(std::uint8_t channel) const;
+        /**
+         * @brief Get the number of valid frames received
+         *
+         * @return std::uint32_t the number of valid frames
+         */
+        std::uint32_t getFrameCount() const;
+        /**
+         * @brief Get the number of frames dropped because their CRC did not match
+         *
+         * @return std::uint32_t the number of frames with CRC errors
+         */
+        std::uint32_t getCrcErrors() const;
+        /**
+         * @brief Get the number of frames dropped because they could not be decoded
+         *
+         * This includes frames with the wrong length, invalid COBS encoding, or an invalid channel
+         *
+         * @return std::uint32_t the number of frames with framing errors
+         */
+        std::uint32_t getFramingErrors() const;
+        /**
+         * @brief Build a frame
+         *
+         * This function is meant to be used on the device sending the frames, or to test the port
+         *
+         * @param channel the channel to send the value on
+         * @param value the value to send
+         * @return std::array<std::uint8_t, FRAME_SIZE> the encoded frame, including the zero byte at the end
+         */
+        static std::array<std::uint8_t, FRAME_SIZE> encodeFrame(std::uint8_t channel, std::int32_t value);
+        ~SerialPort();
+    private:
+        /**
+         * @brief process the complete frames in the buffer, and move the incomplete frame to the start
+         *
+         * @param received the number of bytes added to the end of the buffer
+         */
+        void processBuffer(std::size_t received);
+        /**
+         * @brief decode and check a single frame, without the zero byte, in place
+         */
+        void processFrame(std::uint8_t* data, std::size_t length);
+
+        pros::Serial m_serial;
+        // received bytes which are not a complete frame yet
+        std::array<std::uint8_t, FRAME_SIZE * 8> m_buffer {};
+        std::size_t m_length = 0;
+
+        std::array<Snapshot<SerialChannelValue>, MAX_CHANNELS> m_channels;
+
+        std::atomic<std::uint32_t> m_frames = 0;
+        std::atomic<std::uint32_t> m_crcErrors = 0;
+        std::atomic<std::uint32_t> m_framingErrors = 0;
+
+        std::optional<pros::Task> m_task;
+        std::atomic<bool> m_running = false;
+};
+} // namespace lemlib
@@ -0,0 +1,191 @@
+#pragma once
+
+#include "hardware/concurrency/Queue.hpp"
+#include "hardware/serial/Framing.hpp"
+#include "pros/rtos.hpp"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <optional>
+
+namespace lemlib {
+/**
+ * @brief Streams the values of signals to a computer, as compact binary frames
+ *
+ * Signals, like the angle of a motor or the heading of an IMU, are registered with a name, a function which measures
+ * them, and a resolution. Every time sample() is called, each signal is measured and rounded to a whole number of its
+ * resolution. The sampled values are put in a frame, which is added to a buffer. A low priority task writes the buffer
+ * to the output, usually stdout, which is sent to the computer over USB. Sampling never waits for the output, so it can
+ * be called from a control loop without disturbing its timing. If the buffer is full, the frame is dropped instead.
+ *
+ * Most frames only contain the change of each signal since the previous frame, which usually fits in 1 or 2 bytes. A
+ * keyframe, with the full value of every signal, is sent every KEYFRAME_INTERVAL frames, after a schema frame which
+ * describes the signals. This way, a computer which starts listening late, or misses a frame, can decode the stream
+ * again once the next keyframe arrives. Each signal takes 1 or 2 bytes in a delta frame, so 50 signals at 100 Hz need
+ * between 7 and 13 kB/s, including a schema and keyframe every second. The signals of a 16 motor robot need 9 kB/s.
+ *
+ * Before framing, the frames are laid out as follows. Integers are little endian, and varints are LEB128 encoded.
+ * Signed varints are zigzag encoded first, so small negative numbers are also short.
+ *
+ * | frame    | content                                                                                 |
+ * | -------- | --------------------------------------------------------------------------------------- |
+ * | schema   | 0x01, signal count (u8), then for each signal: name length (u8), name, resolution (f64) |
+ * | keyframe | 0x02, sequence (u16), time in us (varint), value of each signal (signed varint)         |
+ * | delta    | 0x03, sequence (u16), us since the last frame (varint), change of each signal (signed varint) |
+ *
+ * Values are the signal divided by its resolution. A signal which could not be measured is sent as the smallest 64 bit
+ * integer. Each frame ends with the CRC-16/CCITT-FALSE of its other bytes, then it is COBS encoded and followed by a
+ * zero byte, like the frames of a SerialPort. The sequence number counts keyframes and delta frames, so missed frames
+ * can be detected.
+ *
+ * tools/telemetry_decode.py decodes the stream into CSV, with a column for the time and for each signal.
+ *
+ * @b Example:
+ * @code {.cpp}
+ * lemlib::Motor leftMotor = pros::Motor(1);
+ * lemlib::V5IMU imu = pros::Imu(2);
+ * lemlib::Telemetry telemetry;
+ *
+ * void opcontrol() {
+ *     telemetry.addSignal("left angle (deg)", [] { return to_stDeg(leftMotor.getAngle()); }, 0.1);
+ *     telemetry.addSignal("heading (deg)", [] { return to_stDeg(imu.getRotation()); }, 0.01);
+ *     telemetry.start();
+ *     std::uint32_t time = pros::millis();
+ *     while (true) {
+ *         // control code
+ *         telemetry.sample();
+ *         pros::Task::delay_until(&time, 10);
+ *     }
+ * }
+ * @endcode
+ */
+class Telemetry {
+    public:
+        static constexpr std::size_t MAX_SIGNALS = 64; /** the maximum number of signals */
+        static constexpr std::size_t MAX_NAME_LENGTH = 32; /** longer names are cut off */
+        static constexpr std::size_t BUFFER_SIZE = 8192; /** the number of bytes waiting to be written */
+        static constexpr std::uint32_t KEYFRAME_INTERVAL = 100; /** the number of frames between keyframes */
+
+        /**
+         * @brief Construct a new Telemetry object
+         *
+         * When writing to stdout, PROS wraps everything written in its own COBS frames, so that it can tell stdout and
+         * stderr apart. Pass --pros to the decoder in this case, or disable the wrapping with
+         * pros::c::serctl(SERCTL_DISABLE_COBS, nullptr).
+         *
+         * @param output where to write the frames. Must stay open while the writer task is running
+         */
+        explicit Telemetry(std::FILE* output = stdout);
+        /**
+         * @brief Register a signal
+         *
+         * This function must be called from the same task as sample(). Adding a signal sends a new schema frame and
+         * keyframe with the next sample.
+         *
+         * This function uses the following values of errno when an error state is reached:
+         *
+         * ENOSPC: there are already MAX_SIGNALS signals
+         * EINVAL: the resolution is not positive
+         *
+         * @param name the name of the signal, which is the name of its column in the CSV
+         * @param source the function which measures the signal. It should return INFINITY or NAN on failure
+         * @param resolution the smallest change in the signal which is sent. Bigger resolutions need fewer bytes
+         * @return int the index of the signal
+         * @return INT_MAX on failure, setting errno
+         */
+        int addSignal(const char* name, std::function<double()> source, double resolution = 0.001);
+        /**
+         * @brief Measure every signal, and add a frame with their values to the buffer
+         *
+         * This function never blocks. It should be called from a single task, usually at the end of each iteration of
+         * the control loop.
+         *
+         * This function uses the following values of errno when an error state is reached:
+         *
+         * ENOBUFS: the buffer is full, so the frame was dropped
+         *
+         * @return 0 on success
+         * @return INT_MAX on failure, setting errno
+         */
+        int sample();
+        /**
+         * @brief Start the task which writes the buffer to the output
+         *
+         * If the task is already running, this function does nothing
+         *
+         * @param priority the priority of the writer task. It should be lower than the priority of control loops
+         */
+        void start(std::uint32_t priority = TASK_PRIORITY_MIN + 1);
+        /**
+         * @brief Stop the writer task
+         *
+         * Frames in the buffer stay there until the task is started again
+         */
+        void stop();
+        /**
+         * @brief Write all the frames in the buffer to the output
+         *
+         * This function is called by the writer task, and may block until the output accepts the data. It should only
+         * be called directly when the task is not running.
+         *
+         * @return std::size_t the number of bytes written
+         */
+        std::size_t flush();
+        /**
+         * @brief Get the number of frames dropped because the buffer was full
+         *
+         * @return std::uint32_t the number of frames dropped
+         */
+        std::uint32_t getDroppedFrames() const;
+        ~Telemetry();
+    private:
+        // the largest keyframe or delta frame, varints can be up to 10 bytes long
+        static constexpr std::size_t MAX_FRAME_SIZE = 3 + 10 + MAX_SIGNALS * 10 + 2;
+        static constexpr std::size_t MAX_SCHEMA_SIZE = 2 + MAX_SIGNALS * (1 + MAX_NAME_LENGTH + 8) + 2;
+
+        /**
+         * @brief a registered signal
+         */
+        struct Signal {
+                std::array<char, MAX_NAME_LENGTH> name {};
+                std::size_t nameLength = 0;
+                std::function<double()> source;
+                double resolution = 1;
+                std::int64_t previous = 0; /** the value in the last frame added to the buffer */
+        };
+
+        /**
+         * @brief add the schema frame to the buffer
+         */
+        bool pushSchema();
+        /**
+         * @brief COBS encode a frame, and add it to the buffer
+         *
+         * @param frame the frame, with space for the CRC after it
+         * @param length the length of the frame, not including the CRC
+         */
+        bool pushFrame(std::uint8_t* frame, std::size_t length);
+
+        std::array<Signal, MAX_SIGNALS> m_signals;
+        std::size_t m_signalCount = 0;
+
+        // state of the stream, only accessed by the sampling task
+        bool m_schemaSent = false;
+        bool m_keyframeSent = false;
+        std::uint32_t m_framesSinceKeyframe = 0;
+        std::uint16_t m_sequence = 0;
+        std::uint64_t m_previousTime = 0;
+
+        std::array<std::uint8_t, cobsMaxSize(MAX_SCHEMA_SIZE) + 1> m_encoded; /** the frame being added to the buffer */
+
+        SPSCQueue<std::uint8_t, BUFFER_SIZE> m_buffer;
+        std::atomic<std::uint32_t> m_droppedFrames = 0;
+        std::FILE* m_output;
+
+        std::optional<pros::Task> m_task;
+        std::atomic<bool> m_running = false;
+};
+} // namespace lemlib
@@ -5,15 +5,9 @@
 class Angle : public Quantity<std::ratio<0>, std::ratio<0>, std::ratio<0>, std::ratio<0>, std::ratio<1>, std::ratio<0>,
                               std::ratio<0>, std::ratio<0>> {
     public:
-        explicit constexpr Angle(double value)
-            : Quantity<std::ratio<0>, std::ratio<0>, std::ratio<0>, std::ratio<0>, std::ratio<1>, std::ratio<0>,
-                       std::ratio<0>, std::ratio<0>>(value) {}
-
-        constexpr Angle(Quantity<std::ratio<0>, std::ratio<0>, std::ratio<0>, std::ratio<0>, std::ratio<1>,
-                                 std::ratio<0>, std::ratio<0>, std::ratio<0>>
-                            value)
-            : Quantity<std::ratio<0>, std::ratio<0>, std::ratio<0>, std::ratio<0>, std::ratio<1>, std::ratio<0>,
-                       std::ratio<0>, std::ratio<0>>(value) {};
+        explicit constexpr Angle(double value) : Self(value) {}
+
+        constexpr Angle(Self value) : Self(value) {};
 };
 
 constexpr Angle rad = Angle(1.0);
@@ -1,14 +1,22 @@
 #pragma once
 
+#include <algorithm>
 #include <cmath>
-#include <ratio>
+#include <cstdint>
 #include <iostream>
+#include <ratio>
+#include <type_traits>
 
 // define M_PI if not already defined
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
 
+// define M_TWOPI if not already defined, the same way newlib does
+#ifndef M_TWOPI
+#define M_TWOPI (M_PI * 2.0)
+#endif
+
 // define typenames
 
 /**
@@ -117,15 +125,11 @@ template <typename Q> struct LookupName {
 
 template <typename Q> using Named = typename LookupName<Q>::Named;
 
-// quantity checker. Used by the isQuantity concept
-template <typename Mass = std::ratio<0>, typename Length = std::ratio<0>, typename Time = std::ratio<0>,
-          typename Current = std::ratio<0>, typename Angle = std::ratio<0>, typename Temperature = std::ratio<0>,
-          typename Luminosity = std::ratio<0>, typename Moles = std::ratio<0>>
-void quantityChecker(Quantity<Mass, Length, Time, Current, Angle, Temperature, Luminosity, Moles> q) {}
-
 // isQuantity concept
+// every quantity has a Self type, which is the Quantity it is or derives from. Checking this is much cheaper for the
+// compiler than deducing the 8 template arguments of Quantity through overload resolution
 template <typename Q>
-concept isQuantity = requires(Q q) { quantityChecker(q); };
+concept isQuantity = requires { typename Q::Self; } && std::is_base_of_v<typename Q::Self, Q>;
 
 // Isomorphic concept - used to ensure unit equivalecy
 template <typename Q, typename... Quantities>
@@ -134,35 +138,60 @@ concept Isomorphic = ((std::convertible_to<Q, Quantities> && std::convertible_to
 // Un(type)safely coerce the a unit into a different unit
 template <isQuantity Q1, isQuantity Q2> constexpr inline Q1 unit_cast(Q2 quantity) { return Q1(quantity.internal()); }
 
+namespace units::detail {
+// the exponents of a quantity's dimensions are rarely anything other than small integers, so the overflow-checked
+// arithmetic of std::ratio_add and friends, which instantiates a deep tree of helper templates for every exponent,
+// is not needed. These calculate the exponent directly and let std::ratio reduce it, which results in exactly the same
+// types in a fraction of the instantiations
+template <typename R1, typename R2> using RatioAdd =
+    typename std::ratio<R1::num * R2::den + R2::num * R1::den, R1::den * R2::den>::type;
+
+template <typename R1, typename R2> using RatioSubtract =
+    typename std::ratio<R1::num * R2::den - R2::num * R1::den, R1::den * R2::den>::type;
+
+template <typename R, std::intmax_t num, std::intmax_t den> using RatioScale =
+    typename std::ratio<R::num * num, R::den * den>::type;
+} // namespace units::detail
+
 template <isQuantity Q1, isQuantity Q2> using Multiplied = Named<Quantity<
-    std::ratio_add<typename Q1::mass, typename Q2::mass>, std::ratio_add<typename Q1::length, typename Q2::length>,
-    std::ratio_add<typename Q1::time, typename Q2::time>, std::ratio_add<typename Q1::current, typename Q2::current>,
-    std::ratio_add<typename Q1::angle, typename Q2::angle>,
-    std::ratio_add<typename Q1::temperature, typename Q2::temperature>,
-    std::ratio_add<typename Q1::luminosity, typename Q2::luminosity>,
-    std::ratio_add<typename Q1::moles, typename Q2::moles>>>;
-
-template <isQuantity Q1, isQuantity Q2> using Divided =
-    Named<Quantity<std::ratio_subtract<typename Q1::mass, typename Q2::mass>,
-                   std::ratio_subtract<typename Q1::length, typename Q2::length>,
-                   std::ratio_subtract<typename Q1::time, typename Q2::time>,
-                   std::ratio_subtract<typename Q1::current, typename Q2::current>,
-                   std::ratio_subtract<typename Q1::angle, typename Q2::angle>,
-                   std::ratio_subtract<typename Q1::temperature, typename Q2::temperature>,
-                   std::ratio_subtract<typename Q1::luminosity, typename Q2::luminosity>,
-                   std::ratio_subtract<typename Q1::moles, typename Q2::moles>>>;
-
-template <isQuantity Q, typename factor> using Exponentiated = Named<
-    Quantity<std::ratio_multiply<typename Q::mass, factor>, std::ratio_multiply<typename Q::length, factor>,
-             std::ratio_multiply<typename Q::time, factor>, std::ratio_multiply<typename Q::current, factor>,
-             std::ratio_multiply<typename Q::angle, factor>, std::ratio_multiply<typename Q::temperature, factor>,
-             std::ratio_multiply<typename Q::luminosity, factor>, std::ratio_multiply<typename Q::moles, factor>>>;
-
-template <isQuantity Q, typename quotient> using Rooted = Named<
-    Quantity<std::ratio_divide<typename Q::mass, quotient>, std::ratio_divide<typename Q::length, quotient>,
-             std::ratio_divide<typename Q::time, quotient>, std::ratio_divide<typename Q::current, quotient>,
-             std::ratio_divide<typename Q::angle, quotient>, std::ratio_divide<typename Q::temperature, quotient>,
-             std::ratio_divide<typename Q::luminosity, quotient>, std::ratio_divide<typename Q::moles, quotient>>>;
+    units::detail::RatioAdd<typename Q1::mass, typename Q2::mass>,
+    units::detail::RatioAdd<typename Q1::length, typename Q2::length>,
+    units::detail::RatioAdd<typename Q1::time, typename Q2::time>,
+    units::detail::RatioAdd<typename Q1::current, typename Q2::current>,
+    units::detail::RatioAdd<typename Q1::angle, typename Q2::angle>,
+    units::detail::RatioAdd<typename Q1::temperature, typename Q2::temperature>,
+    units::detail::RatioAdd<typename Q1::luminosity, typename Q2::luminosity>,
+    units::detail::RatioAdd<typename Q1::moles, typename Q2::moles>>>;
+
+template <isQuantity Q1, isQuantity Q2> using Divided = Named<Quantity<
+    units::detail::RatioSubtract<typename Q1::mass, typename Q2::mass>,
+    units::detail::RatioSubtract<typename Q1::length, typename Q2::length>,
+    units::detail::RatioSubtract<typename Q1::time, typename Q2::time>,
+    units::detail::RatioSubtract<typename Q1::current, typename Q2::current>,
+    units::detail::RatioSubtract<typename Q1::angle, typename Q2::angle>,
+    units::detail::RatioSubtract<typename Q1::temperature, typename Q2::temperature>,
+    units::detail::RatioSubtract<typename Q1::luminosity, typename Q2::luminosity>,
+    units::detail::RatioSubtract<typename Q1::moles, typename Q2::moles>>>;
+
+template <isQuantity Q, typename factor> using Exponentiated = Named<Quantity<
+    units::detail::RatioScale<typename Q::mass, factor::num, factor::den>,
+    units::detail::RatioScale<typename Q::length, factor::num, factor::den>,
+    units::detail::RatioScale<typename Q::time, factor::num, factor::den>,
+    units::detail::RatioScale<typename Q::current, factor::num, factor::den>,
+    units::detail::RatioScale<typename Q::angle, factor::num, factor::den>,
+    units::detail::RatioScale<typename Q::temperature, factor::num, factor::den>,
+    units::detail::RatioScale<typename Q::luminosity, factor::num, factor::den>,
+    units::detail::RatioScale<typename Q::moles, factor::num, factor::den>>>;
+
+template <isQuantity Q, typename quotient> using Rooted = Named<Quantity<
+    units::detail::RatioScale<typename Q::mass, quotient::den, quotient::num>,
+    units::detail::RatioScale<typename Q::length, quotient::den, quotient::num>,
+    units::detail::RatioScale<typename Q::time, quotient::den, quotient::num>,
+    units::detail::RatioScale<typename Q::current, quotient::den, quotient::num>,
+    units::detail::RatioScale<typename Q::angle, quotient::den, quotient::num>,
+    units::detail::RatioScale<typename Q::temperature, quotient::den, quotient::num>,
+    units::detail::RatioScale<typename Q::luminosity, quotient::den, quotient::num>,
+    units::detail::RatioScale<typename Q::moles, quotient::den, quotient::num>>>;
 
 template <isQuantity Q, isQuantity R> constexpr Q operator+(Q lhs, R rhs)
     requires Isomorphic<Q, R>
@@ -230,28 +259,15 @@ template <isQuantity Q, isQuantity R> constexpr bool operator>(const Q& lhs, con
     class Name : public Quantity<std::ratio<m>, std::ratio<l>, std::ratio<t>, std::ratio<i>, std::ratio<a>,            \
                                  std::ratio<o>, std::ratio<j>, std::ratio<n>> {                                        \
         public:                                                                                                        \
-            explicit constexpr Name(double value)                                                                      \
-                : Quantity<std::ratio<m>, std::ratio<l>, std::ratio<t>, std::ratio<i>, std::ratio<a>, std::ratio<o>,   \
-                           std::ratio<j>, std::ratio<n>>(value) {}                                                     \
-            constexpr Name(Quantity<std::ratio<m>, std::ratio<l>, std::ratio<t>, std::ratio<i>, std::ratio<a>,         \
-                                    std::ratio<o>, std::ratio<j>, std::ratio<n>>                                       \
-                               value)                                                                                  \
-                : Quantity<std::ratio<m>, std::ratio<l>, std::ratio<t>, std::ratio<i>, std::ratio<a>, std::ratio<o>,   \
-                           std::ratio<j>, std::ratio<n>>(value) {};                                                    \
+            explicit constexpr Name(double value) : Self(value) {}                                                     \
+            constexpr Name(Self value) : Self(value) {};                                                               \
     };                                                                                                                 \
-    template <> struct LookupName<Quantity<std::ratio<m>, std::ratio<l>, std::ratio<t>, std::ratio<i>, std::ratio<a>,  \
-                                           std::ratio<o>, std::ratio<j>, std::ratio<n>>> {                             \
+    template <> struct LookupName<Name::Self> {                                                                        \
             using Named = Name;                                                                                        \
     };                                                                                                                 \
     constexpr Name suffix = Name(1.0);                                                                                 \
-    constexpr Name operator""_##suffix(long double value) {                                                            \
-        return Name(Quantity<std::ratio<m>, std::ratio<l>, std::ratio<t>, std::ratio<i>, std::ratio<a>, std::ratio<o>, \
-                             std::ratio<j>, std::ratio<n>>(static_cast<double>(value)));                               \
-    }                                                                                                                  \
-    constexpr Name operator""_##suffix(unsigned long long value) {                                                     \
-        return Name(Quantity<std::ratio<m>, std::ratio<l>, std::ratio<t>, std::ratio<i>, std::ratio<a>, std::ratio<o>, \
-                             std::ratio<j>, std::ratio<n>>(static_cast<double>(value)));                               \
-    }                                                                                                                  \
+    constexpr Name operator""_##suffix(long double value) { return Name(static_cast<double>(value)); }                 \
+    constexpr Name operator""_##suffix(unsigned long long value) { return Name(static_cast<double>(value)); }          \
     inline std::ostream& operator<<(std::ostream& os, const Name& quantity) {                                          \
         os << quantity.internal() << "_" << #suffix;                                                                   \
         return os;                                                                                                     \
@@ -259,12 +275,18 @@ template <isQuantity Q, isQuantity R> constexpr bool operator>(const Q& lhs, con
     constexpr inline Name from_##suffix(double value) { return Name(value); }                                          \
     constexpr inline double to_##suffix(Name quantity) { return quantity.internal(); }
 
+// literals are defined in terms of the constant they create, so no operator overload resolution is needed to
+// evaluate them
 #define NEW_UNIT_LITERAL(Name, suffix, multiple)                                                                       \
     constexpr Name suffix = multiple;                                                                                  \
-    constexpr Name operator""_##suffix(long double value) { return static_cast<double>(value) * multiple; }            \
-    constexpr Name operator""_##suffix(unsigned long long value) { return static_cast<double>(value) * multiple; }     \
-    constexpr inline Name from_##suffix(double value) { return value * multiple; }                                     \
-    constexpr inline double to_##suffix(Name quantity) { return quantity.convert(multiple); }
+    constexpr Name operator""_##suffix(long double value) {                                                            \
+        return Name(static_cast<double>(value) * suffix.internal());                                                   \
+    }                                                                                                                  \
+    constexpr Name operator""_##suffix(unsigned long long value) {                                                     \
+        return Name(static_cast<double>(value) * suffix.internal());                                                   \
+    }                                                                                                                  \
+    constexpr inline Name from_##suffix(double value) { return Name(value * suffix.internal()); }                      \
+    constexpr inline double to_##suffix(Name quantity) { return quantity.internal() / suffix.internal(); }
 
 #define NEW_METRIC_PREFIXES(Name, base)                                                                                \
     NEW_UNIT_LITERAL(Name, T##base, base * 1E12)                                                                       \
@@ -0,0 +1,51 @@
+#include "hardware/Motors/Battery.hpp"
+#include "pros/misc.hpp"
+#include "pros/rtos.hpp"
+#include <atomic>
+#include <climits>
+#include <cmath>
+
+namespace lemlib {
+/** the time between battery samples */
+static constexpr std::uint32_t BATTERY_PERIOD = 100;
+/** the weight of each new sample in the low pass filter */
+static constexpr double BATTERY_SMOOTHING = 0.5;
+
+/** the filtered battery voltage, in volts */
+static std::atomic<double> batteryVoltage = INFINITY;
+static std::atomic<bool> batterySampling = false;
+
+/**
+ * @brief read the battery, and add the reading to the filtered voltage
+ */
+static void sampleBattery() {
+    const std::int32_t millivolts = pros::battery::get_voltage();
+    // keep the last voltage if the battery can't be read
+    if (millivolts == INT_MAX || millivolts <= 0) return;
+    const double voltage = millivolts / 1000.0;
+    const double previous = batteryVoltage.load(std::memory_order_relaxed);
+    // only the sampling task writes after the first sample, so a plain load and store is enough
+    if (previous == INFINITY) batteryVoltage.store(voltage, std::memory_order_relaxed);
+    else batteryVoltage.store(previous + BATTERY_SMOOTHING * (voltage - previous), std::memory_order_relaxed);
+}
+
+void startBatterySampling() {
+    // checked before the exchange, so calls after the first are only a load
+    if (batterySampling.load(std::memory_order_relaxed) || batterySampling.exchange(true)) return;
+    sampleBattery();
+    pros::Task(
+        [] {
+            std::uint32_t time = pros::millis();
+            while (true) {
+                pros::Task::delay_until(&time, BATTERY_PERIOD);
+                sampleBattery();
+            }
+        },
+        TASK_PRIORITY_MIN + 1, TASK_STACK_DEPTH_MIN, "battery");
+}
+
+Voltage getBatteryVoltage() {
+    startBatterySampling();
+    return from_volt(batteryVoltage.load(std::memory_order_relaxed));
+}
+} // namespace lemlib
@@ -0,0 +1,215 @@
+#include "hardware/Motors/Characterization.hpp"
+#include "pros/rtos.hpp"
+#include <array>
+#include <cerrno>
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include <utility>
+
+namespace lemlib {
+/**
+ * how many samples on each side are used to calculate the velocity and acceleration of a sample. A narrow window
+ * leaves the noise of the encoder counts in the acceleration, which biases kA towards 0, while a wide one smooths the
+ * start of the step test. With 300 counts per rotation, 4 samples underestimated kA by 15%, and 8 by less than 5%
+ */
+static constexpr std::size_t DERIVATIVE_WINDOW = 8;
+
+/**
+ * @brief the result of a characterization that failed
+ */
+static CharacterizationResult failedResult(std::size_t samples) {
+    return {{from_volt(INFINITY), from_volt(INFINITY) / 1_radps, from_volt(INFINITY) / 1_radps2, 0_volt / 1_radps},
+            Number(0),
+            samples};
+}
+
+Characterization::Characterization(CharacterizationSettings settings)
+    : m_settings(settings),
+      m_result(failedResult(0)) {
+    const Time duration = m_settings.rampVoltage / m_settings.rampRate + m_settings.stepDuration;
+    // leave some room for the updates being a little faster than the period
+    m_samples.reserve(std::ceil(to_num(duration / m_settings.period) * 1.25) + 1);
+}
+
+Voltage Characterization::update(Angle angle, Time time) {
+    if (!m_started) {
+        m_started = true;
+        m_phaseStart = time;
+    }
+    Voltage voltage = 0_volt;
+    switch (m_phase) {
+        case Phase::QUASISTATIC:
+            voltage = m_settings.rampRate * (time - m_phaseStart);
+            if (voltage < m_settings.rampVoltage) break;
+            m_phase = Phase::REST;
+            m_phaseStart = time;
+            [[fallthrough]];
+        case Phase::REST:
+            // the mechanism isn't moving on its own, so these samples aren't recorded
+            if (time - m_phaseStart < m_settings.restDuration) return 0_volt;
+            m_phase = Phase::STEP;
+            m_phaseStart = time;
+            [[fallthrough]];
+        case Phase::STEP:
+            if (time - m_phaseStart < m_settings.stepDuration) {
+                voltage = m_settings.stepVoltage;
+                break;
+            }
+            m_phase = Phase::FINISHED;
+            [[fallthrough]];
+        case Phase::FINISHED: return 0_volt;
+    }
+    // never grow the buffer, so the tests don't allocate memory
+    if (m_samples.size() < m_samples.capacity()) {
+        const bool step = m_phase == Phase::STEP;
+        m_samples.push_back({time, voltage, angle, from_radps(INFINITY), from_radps2(INFINITY), step});
+    }
+    return voltage;
+}
+
+bool Characterization::isFinished() const { return m_phase == Phase::FINISHED; }
+
+CharacterizationResult Characterization::fit() {
+    const std::size_t w = DERIVATIVE_WINDOW;
+    // the derivatives are central differences, which don't lag behind like a filter would. Samples whose neighbours
+    // are from the other test don't have derivatives
+    auto sameTest = [&](std::size_t i) {
+        return i >= 2 * w && i + 2 * w < m_samples.size() && m_samples[i - 2 * w].step == m_samples[i].step &&
+               m_samples[i + 2 * w].step == m_samples[i].step;
+    };
+    for (std::size_t i = w; i + w < m_samples.size(); i++) {
+        const CharacterizationSample& before = m_samples[i - w];
+        const CharacterizationSample& after = m_samples[i + w];
+        if (before.step != after.step || after.time <= before.time) continue;
+        m_samples[i].velocity = (after.angle - before.angle) / (after.time - before.time);
+    }
+    for (std::size_t i = 0; i < m_samples.size(); i++) {
+        if (!sameTest(i)) continue;
+        const CharacterizationSample& before = m_samples[i - w];
+        const CharacterizationSample& after = m_samples[i + w];
+        m_samples[i].acceleration = (after.velocity - before.velocity) / (after.time - before.time);
+    }
+
+    // least squares fit of voltage = kS * sign(velocity) + kV * velocity + kA * acceleration, by solving the normal
+    // equations. Units are stripped, as the matrix mixes them
+    std::array<std::array<double, 4>, 3> system {};
+    double sum = 0;
+    double sumSquares = 0;
+    std::size_t count = 0;
+    for (const CharacterizationSample& sample : m_samples) {
+        if (!sameTest(&sample - m_samples.data())) continue;
+        if (units::abs(sample.velocity) < m_settings.minVelocity) continue;
+        const std::array<double, 3> x = {double(units::sgn(sample.velocity)), to_radps(sample.velocity),
+                                         to_radps2(sample.acceleration)};
+        const double y = to_volt(sample.voltage);
+        for (int row = 0; row < 3; row++) {
+            for (int col = 0; col < 3; col++) system[row][col] += x[row] * x[col];
+            system[row][3] += x[row] * y;
+        }
+        sum += y;
+        sumSquares += y * y;
+        count++;
+    }
+    if (count < 3) {
+        errno = EDOM;
+        return m_result = failedResult(count);
+    }
+    // gaussian elimination with partial pivoting
+    for (int col = 0; col < 3; col++) {
+        int pivot = col;
+        for (int row = col + 1; row < 3; row++) {
+            if (std::abs(system[row][col]) > std::abs(system[pivot][col])) pivot = row;
+        }
+        if (std::abs(system[pivot][col]) < 1e-9) {
+            errno = EDOM;
+            return m_result = failedResult(count);
+        }
+        std::swap(system[col], system[pivot]);
+        for (int row = 0; row < 3; row++) {
+            if (row == col) continue;
+            const double factor = system[row][col] / system[col][col];
+            for (int i = col; i < 4; i++) system[row][i] -= factor * system[col][i];
+        }
+    }
+    const double kS = system[0][3] / system[0][0];
+    const double kV = system[1][3] / system[1][1];
+    const double kA = system[2][3] / system[2][2];
+
+    // r squared, from the residuals of the fit
+    double residuals = 0;
+    for (const CharacterizationSample& sample : m_samples) {
+        if (!sameTest(&sample - m_samples.data())) continue;
+        if (units::abs(sample.velocity) < m_settings.minVelocity) continue;
+        const double predicted = kS * units::sgn(sample.velocity) + kV * to_radps(sample.velocity) +
+                                 kA * to_radps2(sample.acceleration);
+        residuals += std::pow(to_volt(sample.voltage) - predicted, 2);
+    }
+    const double total = sumSquares - sum * sum / count;
+    m_result = {{from_volt(kS), from_volt(kV) / 1_radps, from_volt(kA) / 1_radps2, 0_volt / 1_radps},
+                Number(total > 0 ? 1 - residuals / total : 0),
+                count};
+    return m_result;
+}
+
+int Characterization::save(const char* path) const {
+    std::FILE* file = std::fopen(path, "w");
+    if (file == nullptr) return INT_MAX;
+    std::fprintf(file, "# kS (V): %f\n", to_volt(m_result.gains.kS));
+    std::fprintf(file, "# kV (V/(rad/s)): %f\n", to_volt(m_result.gains.kV * 1_radps));
+    std::fprintf(file, "# kA (V/(rad/s^2)): %f\n", to_volt(m_result.gains.kA * 1_radps2));
+    std::fprintf(file, "# r^2: %f\n", to_num(m_result.rSquared));
+    std::fprintf(file, "time,voltage,angle,velocity,acceleration,test\n");
+    for (const CharacterizationSample& sample : m_samples) {
+        std::fprintf(file, "%f,%f,%f,%f,%f,%s\n", to_sec(sample.time), to_volt(sample.voltage),
+                     to_stRad(sample.angle), to_radps(sample.velocity), to_radps2(sample.acceleration),
+                     sample.step ? "step" : "quasistatic");
+    }
+    // writes to the SD card are buffered, so errors may only show up when the file is closed
+    return std::fclose(file) == 0 ? 0 : INT_MAX;
+}
+
+const std::vector<CharacterizationSample>& Characterization::getSamples() const { return m_samples; }
+
+void Characterization::reset() {
+    m_samples.clear();
+    m_phase = Phase::QUASISTATIC;
+    m_started = false;
+    m_result = failedResult(0);
+}
+
+/**
+ * @brief run a characterization on anything with getAngle() and move(), like a Motor or MotorGroup
+ */
+template <typename T>
+static CharacterizationResult runCharacterization(T& motor, CharacterizationSettings settings, const char* path) {
+    Characterization characterization(settings);
+    std::uint32_t time = pros::millis();
+    while (!characterization.isFinished()) {
+        const Angle angle = motor.getAngle();
+        if (angle == from_stDeg(INFINITY)) {
+            // keep the errno of getAngle()
+            const int error = errno;
+            motor.move(0);
+            errno = error;
+            return failedResult(0);
+        }
+        const Voltage voltage = characterization.update(angle, from_usec(pros::micros()));
+        // the voltages are for a V5 motor, and move() scales them for EXP motors
+        motor.move(to_num(voltage / 12_volt));
+        pros::Task::delay_until(&time, std::lround(to_msec(settings.period)));
+    }
+    motor.move(0);
+    const CharacterizationResult result = characterization.fit();
+    if (path != nullptr) characterization.save(path);
+    return result;
+}
+
+CharacterizationResult characterize(Motor& motor, CharacterizationSettings settings, const char* path) {
+    return runCharacterization(motor, settings, path);
+}
+
+CharacterizationResult characterize(MotorGroup& motorGroup, CharacterizationSettings settings, const char* path) {
+    return runCharacterization(motorGroup, settings, path);
+}
+} // namespace lemlib
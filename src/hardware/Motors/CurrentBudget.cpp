@@ -0,0 +1,168 @@
+#include "hardware/Motors/CurrentBudget.hpp"
+#include <cerrno>
+#include <climits>
+#include <cmath>
+
+namespace lemlib {
+/** a mechanism drawing more than this fraction of its limit is assumed to want its maximum current */
+static constexpr double SATURATION = 0.9;
+/** the current each motor can draw above what it wants, when the budget allows it, so it can speed up */
+static constexpr Current HEADROOM = 0.25_amp;
+
+CurrentBudget::CurrentBudget(Current budget)
+    : m_budget(to_amp(budget)) {}
+
+int CurrentBudget::add(Motor* motor, int priority, Current maxCurrent) {
+    return add(std::variant<Motor*, MotorGroup*>(motor), priority, maxCurrent);
+}
+
+int CurrentBudget::add(MotorGroup* motorGroup, int priority, Current maxCurrent) {
+    return add(std::variant<Motor*, MotorGroup*>(motorGroup), priority, maxCurrent);
+}
+
+int CurrentBudget::add(std::variant<Motor*, MotorGroup*> device, int priority, Current maxCurrent) {
+    if (m_count == MAX_MECHANISMS) {
+        errno = ENOSPC;
+        return INT_MAX;
+    }
+    for (std::size_t i = 0; i < m_count; i++) {
+        if (m_mechanisms[i].device == device) {
+            errno = EEXIST;
+            return INT_MAX;
+        }
+    }
+    Mechanism& mechanism = m_mechanisms[m_count];
+    mechanism.device = device;
+    mechanism.priority = priority;
+    mechanism.maxCurrent = maxCurrent;
+    mechanism.limit = maxCurrent;
+    mechanism.stats = CurrentBudgetStats();
+    mechanism.stats.limit = maxCurrent;
+    mechanism.published.publish(mechanism.stats);
+    // keep the order sorted by priority, after mechanisms with the same priority
+    std::size_t position = m_count;
+    while (position > 0 && m_mechanisms[m_order[position - 1]].priority < priority) {
+        m_order[position] = m_order[position - 1];
+        position--;
+    }
+    m_order[position] = m_count;
+    return m_count++;
+}
+
+void CurrentBudget::update() {
+    // read the current of every motor once
+    for (std::size_t i = 0; i < m_count; i++) {
+        Mechanism& mechanism = m_mechanisms[i];
+        Current total = 0_amp;
+        mechanism.motors = 0;
+        auto addCurrent = [&](Current current) {
+            // assume the worst for motors that can't be read
+            total += current == from_amp(INFINITY) ? mechanism.maxCurrent : current;
+            mechanism.motors++;
+        };
+        if (Motor* const* motor = std::get_if<Motor*>(&mechanism.device)) {
+            // a single motor which can't be read is most likely disconnected
+            const Current current = (*motor)->getCurrent();
+            if (current != from_amp(INFINITY)) addCurrent(current);
+        } else {
+            for (Current current : std::get<MotorGroup*>(mechanism.device)->getCurrents()) addCurrent(current);
+        }
+        const Current limit = mechanism.limit * mechanism.motors;
+        if (total >= limit * SATURATION) mechanism.wanted = mechanism.maxCurrent * mechanism.motors;
+        else mechanism.wanted = units::min(total, mechanism.maxCurrent * mechanism.motors);
+    }
+
+    // give out the budget from the highest priority down
+    Current remaining = from_amp(m_budget.load(std::memory_order_relaxed));
+    std::size_t start = 0;
+    while (start < m_count) {
+        // find the mechanisms with the same priority
+        std::size_t end = start;
+        Current wanted = 0_amp;
+        while (end < m_count && m_mechanisms[m_order[end]].priority == m_mechanisms[m_order[start]].priority) {
+            wanted += m_mechanisms[m_order[end]].wanted;
+            end++;
+        }
+        const Number fraction = wanted <= remaining ? 1_num : remaining / wanted;
+        // mechanisms which get all they want can draw a little more, so they can speed up before the next update, as
+        // long as the level stays within what is left
+        Current headroom = 0_amp;
+        for (std::size_t i = start; i < end; i++) {
+            const Mechanism& mechanism = m_mechanisms[m_order[i]];
+            if (mechanism.motors == 0) continue;
+            headroom += units::min(HEADROOM, mechanism.maxCurrent - mechanism.wanted / mechanism.motors) *
+                        mechanism.motors;
+        }
+        const Number headroomFraction =
+            fraction < 1_num || headroom <= 0_amp ? 0_num : units::min(1_num, (remaining - wanted) / headroom);
+        Current given = 0_amp;
+        for (std::size_t i = start; i < end; i++) {
+            Mechanism& mechanism = m_mechanisms[m_order[i]];
+            if (mechanism.motors == 0) continue;
+            const Current wantedPerMotor = mechanism.wanted / mechanism.motors;
+            mechanism.limit = wantedPerMotor * fraction +
+                              units::min(HEADROOM, mechanism.maxCurrent - wantedPerMotor) * headroomFraction;
+            given += mechanism.limit * mechanism.motors;
+            if (Motor* const* motor = std::get_if<Motor*>(&mechanism.device)) {
+                (*motor)->setCurrentLimit(mechanism.limit);
+            } else {
+                std::get<MotorGroup*>(mechanism.device)->setCurrentLimit(mechanism.limit);
+            }
+
+            CurrentBudgetStats& stats = mechanism.stats;
+            stats.updates++;
+            stats.limit = mechanism.limit;
+            if (fraction < 1_num && mechanism.wanted > 0_amp) {
+                stats.limitedUpdates++;
+                stats.lowestFraction = units::min(stats.lowestFraction, fraction);
+                stats.averageFraction += (fraction - stats.averageFraction) / stats.limitedUpdates;
+            }
+            mechanism.published.publish(stats);
+        }
+        remaining -= units::min(given, remaining);
+        start = end;
+    }
+}
+
+void CurrentBudget::start(std::uint32_t priority, Time period) {
+    if (m_running.exchange(true)) return;
+    m_task = pros::Task(
+        [this, period] {
+            std::uint32_t time = pros::millis();
+            while (m_running) {
+                update();
+                pros::Task::delay_until(&time, std::lround(to_msec(period)));
+            }
+        },
+        priority, TASK_STACK_DEPTH_DEFAULT, "current budget");
+}
+
+void CurrentBudget::stop() {
+    if (!m_running.exchange(false)) return;
+    m_task->join();
+    m_task.reset();
+}
+
+void CurrentBudget::setBudget(Current budget) { m_budget.store(to_amp(budget), std::memory_order_relaxed); }
+
+Current CurrentBudget::getBudget() const { return from_amp(m_budget.load(std::memory_order_relaxed)); }
+
+CurrentBudgetStats CurrentBudget::getStats(int index) const {
+    if (index < 0 || index >= int(m_count)) {
+        errno = EINVAL;
+        return {};
+    }
+    return m_mechanisms[index].published.read();
+}
+
+void CurrentBudget::resetStats() {
+    for (std::size_t i = 0; i < m_count; i++) {
+        Mechanism& mechanism = m_mechanisms[i];
+        mechanism.stats = CurrentBudgetStats();
+        mechanism.stats.limit = mechanism.limit;
+        mechanism.published.publish(mechanism.stats);
+    }
+}
+
+CurrentBudget::~CurrentBudget() { stop(); }
+} // namespace lemlib
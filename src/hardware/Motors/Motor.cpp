@@ -1,7 +1,11 @@
 #include "hardware/Motors/Motor.hpp"
+#include "hardware/Motors/Battery.hpp"
 #include "hardware/util.hpp"
 #include "pros/abstract_motor.hpp"
+#include "pros/rtos.hpp"
 #include "units/Angle.hpp"
+#include <algorithm>
+#include <cmath>
 
 namespace lemlib {
 pros::MotorBrake brakeModeToMotorBrake(BrakeMode mode) {
@@ -33,14 +37,54 @@ int Motor::move(double percent) {
     // the V5 and EXP motors have different voltage caps, so we need to scale based on the motor type
     // V5 motors have their voltage capped at 12v, while EXP motors have their voltage capped at 7.2v
     // but they have the same max velocity, so we can scale the percent power based on the motor type
+    double maxVoltage;
     switch (getType()) {
-        case (MotorType::V5): return convertStatus(m_motor.move_voltage(percent * 12000));
-        case (MotorType::EXP): return convertStatus(m_motor.move_voltage(percent * 7200));
+        case (MotorType::V5): maxVoltage = 12000; break;
+        case (MotorType::EXP): maxVoltage = 7200; break;
         default: return INT_MAX;
     }
+    if (m_thermalModel != nullptr) {
+        m_thermalModel->update(getCurrent(), getTemperature(), from_usec(pros::micros()));
+        percent *= to_num(m_thermalModel->getDeratingScale());
+    }
+    if (m_stallDetector != nullptr) {
+        const Voltage output =
+            m_stallDetector->update(from_volt(percent * 12), getCurrent(), getAngle(), from_usec(pros::micros()));
+        if (m_stallDetector->isBraking()) {
+            // the motor is stopped, so the output ramps up from 0 once the brake is released
+            m_voltageSlew.reset();
+            return brake();
+        }
+        percent = to_num(output / 12_volt);
+    }
+    // the slew is applied last, so reverse pulses and changes of the derating are limited too
+    if (m_voltageSlew.isLimited()) {
+        percent = to_num(m_voltageSlew.update(from_volt(percent * 12), from_usec(pros::micros())) / 12_volt);
+    }
+    double voltage = percent * maxVoltage;
+    if (m_compensation > 0_volt) {
+        // the battery is sampled since compensation was enabled, so this only reads the cached voltage
+        const Voltage battery = getBatteryVoltage();
+        // don't compensate if the battery hasn't been read yet
+        if (battery != from_volt(INFINITY)) {
+            voltage = std::clamp(voltage * to_num(m_compensation / battery), -maxVoltage, maxVoltage);
+        }
+    }
+    return convertStatus(m_motor.move_voltage(voltage));
 }
 
-int Motor::moveVelocity(AngularVelocity velocity) {
+int Motor::moveVelocity(AngularVelocity velocity, AngularAcceleration acceleration) {
+    if (m_velocitySlew.isLimited()) {
+        velocity = m_velocitySlew.update(velocity, from_usec(pros::micros()));
+        acceleration = m_velocitySlew.getRate();
+    }
+    if (m_velocityMode == VelocityMode::FEEDFORWARD) {
+        const Angle angle = getAngle();
+        if (angle == from_stDeg(INFINITY)) return INT_MAX;
+        const Voltage voltage = m_velocityController.update(angle, from_usec(pros::micros()), velocity, acceleration);
+        // the gains are for a V5 motor, and move() scales the voltage for EXP motors
+        return move(to_num(voltage / 12_volt));
+    }
     // pros uses an integer value to represent the rpm of the motor
     return convertStatus(m_motor.move_velocity(to_rpm(units::round(velocity, rpm))));
 }
@@ -51,6 +95,46 @@ int Motor::setBrakeMode(BrakeMode mode) { return convertStatus(m_motor.set_brake
 
 BrakeMode Motor::getBrakeMode() const { return motorBrakeToBrakeMode(m_motor.get_brake_mode()); }
 
+Current Motor::getCurrent() const {
+    const std::int32_t current = m_motor.get_current_draw();
+    // pros measures current in milliamps
+    if (current == INT32_MAX) return from_amp(INFINITY);
+    return from_amp(current / 1000.0);
+}
+
+int Motor::setCurrentLimit(Current limit) {
+    return convertStatus(m_motor.set_current_limit(std::lround(to_amp(limit) * 1000)));
+}
+
+Current Motor::getCurrentLimit() const {
+    const std::int32_t limit = m_motor.get_current_limit();
+    if (limit == INT32_MAX) return from_amp(INFINITY);
+    return from_amp(limit / 1000.0);
+}
+
+Temperature Motor::getTemperature() const {
+    // pros measures temperature in celsius
+    const double temperature = m_motor.get_temperature();
+    if (temperature == INFINITY) return units::from_kelvin(INFINITY);
+    return units::from_celsius(temperature);
+}
+
+void Motor::setThermalModel(ThermalModel* model) { m_thermalModel = model; }
+
+ThermalModel* Motor::getThermalModel() const { return m_thermalModel; }
+
+void Motor::setStallDetector(StallDetector* detector) { m_stallDetector = detector; }
+
+StallDetector* Motor::getStallDetector() const { return m_stallDetector; }
+
+void Motor::setVoltageSlew(SlewLimits<Voltage> limits) { m_voltageSlew.setLimits(limits); }
+
+SlewLimits<Voltage> Motor::getVoltageSlew() const { return m_voltageSlew.getLimits(); }
+
+void Motor::setVelocitySlew(SlewLimits<AngularVelocity> limits) { m_velocitySlew.setLimits(limits); }
+
+SlewLimits<AngularVelocity> Motor::getVelocitySlew() const { return m_velocitySlew.getLimits(); }
+
 int Motor::isConnected() { return m_motor.is_installed(); }
 
 Angle Motor::getAngle() {
@@ -127,6 +211,25 @@ void Motor::setReversed(bool reversed) {
     m_motor.set_reversed(reversed);
 }
 
+void Motor::setVoltageCompensation(Voltage reference) {
+    // sample the battery now, rather than in the first call to move()
+    if (reference > 0_volt) startBatterySampling();
+    m_compensation = reference;
+}
+
+Voltage Motor::getVoltageCompensation() const { return m_compensation; }
+
+void Motor::setVelocityMode(VelocityMode mode) {
+    m_velocityMode = mode;
+    m_velocityController.reset();
+}
+
+VelocityMode Motor::getVelocityMode() const { return m_velocityMode; }
+
+void Motor::setVelocityGains(VelocityGains gains) { m_velocityController.setGains(gains); }
+
+VelocityGains Motor::getVelocityGains() const { return m_velocityController.getGains(); }
+
 int Motor::getPort() const { return m_motor.get_port(); }
 
 int Motor::getAbsoluteCounts() {
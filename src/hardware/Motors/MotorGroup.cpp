@@ -1,4 +1,6 @@
 #include "hardware/Motors/MotorGroup.hpp"
+#include "hardware/Motors/Battery.hpp"
+#include "pros/rtos.hpp"
 #include <climits>
 #include <errno.h>
 #include <utility>
@@ -14,8 +16,39 @@ MotorGroup::MotorGroup(pros::v5::MotorGroup motors, AngularVelocity outputVeloci
     for (int i = 0; i < motors.size(); i++) m_motors.push_back(std::pair<int8_t, bool>(motors.get_port(i), true));
 }
 
-int MotorGroup::move(double percent) {
-    const std::vector<Motor> motors = getMotors();
+int MotorGroup::move(double percent) { return moveMotors(getMotors(), percent); }
+
+int MotorGroup::moveMotors(const std::vector<Motor>& motors, double percent) {
+    if (m_stallDetector != nullptr) {
+        // the detector watches the whole group, using the average current of the motors that could be read
+        Current current = 0_amp;
+        int count = 0;
+        for (const Motor& motor : motors) {
+            const Current motorCurrent = motor.getCurrent();
+            if (motorCurrent == from_amp(INFINITY)) continue;
+            current += motorCurrent;
+            count++;
+        }
+        const Voltage output = m_stallDetector->update(from_volt(percent * 12),
+                                                       count == 0 ? from_amp(INFINITY) : current / count,
+                                                       getAverageAngle(motors), from_usec(pros::micros()));
+        if (m_stallDetector->isBraking()) {
+            // the motors are stopped, so the output ramps up from 0 once the brake is released
+            m_voltageSlew.reset();
+            bool success = false;
+            for (Motor motor : motors) {
+                const int result = motor.brake();
+                if (result == 0) success = true;
+            }
+            // as long as one motor brakes successfully, return 0 (success)
+            return success ? 0 : INT_MAX;
+        }
+        percent = to_num(output / 12_volt);
+    }
+    // the slew is applied last, so reverse pulses are limited too
+    if (m_voltageSlew.isLimited()) {
+        percent = to_num(m_voltageSlew.update(from_volt(percent * 12), from_usec(pros::micros())) / 12_volt);
+    }
     bool success = false;
     for (Motor motor : motors) {
         const int result = motor.move(percent);
@@ -25,9 +58,22 @@ int MotorGroup::move(double percent) {
     return success ? 0 : INT_MAX;
 }
 
-int MotorGroup::moveVelocity(AngularVelocity velocity) {
+int MotorGroup::moveVelocity(AngularVelocity velocity, AngularAcceleration acceleration) {
     const std::vector<Motor> motors = getMotors();
+    if (m_velocitySlew.isLimited()) {
+        velocity = m_velocitySlew.update(velocity, from_usec(pros::micros()));
+        acceleration = m_velocitySlew.getRate();
+    }
     bool success = false;
+    if (m_velocityMode == VelocityMode::FEEDFORWARD) {
+        // the whole group shares one estimator, so the angle of every motor is only read once
+        const Angle angle = getAverageAngle(motors);
+        if (angle == from_stDeg(INFINITY)) return INT_MAX;
+        const Voltage voltage = m_velocityController.update(angle, from_usec(pros::micros()), velocity, acceleration);
+        // the gear ratio of each motor is its cartridge over the output velocity, so every motor runs at the same
+        // fraction of its maximum velocity, and needs the same voltage
+        return moveMotors(motors, to_num(voltage / 12_volt));
+    }
     for (Motor motor : motors) {
         // since the motors in the group are geared together, we need to account for different gearings
         // of different motors in the group
@@ -72,6 +118,24 @@ std::vector<BrakeMode> MotorGroup::getBrakeModes() {
     return brakeModes;
 }
 
+std::vector<Current> MotorGroup::getCurrents() {
+    const std::vector<Motor> motors = getMotors();
+    std::vector<Current> currents;
+    for (const Motor& motor : motors) currents.push_back(motor.getCurrent());
+    return currents;
+}
+
+int MotorGroup::setCurrentLimit(Current limit) {
+    const std::vector<Motor> motors = getMotors();
+    bool success = false;
+    for (Motor motor : motors) {
+        const int result = motor.setCurrentLimit(limit);
+        if (result == 0) success = true;
+    }
+    // as long as one motor sets the current limit successfully, return 0 (success)
+    return success ? 0 : INT_MAX;
+}
+
 int MotorGroup::isConnected() {
     const std::vector<Motor> motors = getMotors();
     for (Motor motor : motors) {
@@ -82,8 +146,9 @@ int MotorGroup::isConnected() {
     return 0;
 }
 
-Angle MotorGroup::getAngle() {
-    const std::vector<Motor> motors = getMotors();
+Angle MotorGroup::getAngle() { return getAverageAngle(getMotors()); }
+
+Angle MotorGroup::getAverageAngle(const std::vector<Motor>& motors) {
     // get the average angle of all motors in the group
     Angle angle = 0_stDeg;
     int errors = 0;
@@ -107,7 +172,7 @@ Angle MotorGroup::getAngle() {
     // if no motors are connected, return INFINITY
     if (errors == motors.size()) return from_stDeg(INFINITY);
     // otherwise, return the average angle
-    return angle / (getSize() - errors);
+    return angle / (motors.size() - errors);
 }
 
 int MotorGroup::setAngle(Angle angle) {
@@ -190,10 +255,45 @@ const std::vector<Motor> MotorGroup::getMotors() {
         // add the motor and set save it as connected
         pair.second = true;
         motors.push_back(pros::Motor(pair.first));
+        // the motor objects are created on demand, so they need the settings of the group
+        motors.back().setVoltageCompensation(m_compensation);
     }
     return motors;
 }
 
+void MotorGroup::setVoltageCompensation(Voltage reference) {
+    // sample the battery now, rather than in the first call to move()
+    if (reference > 0_volt) startBatterySampling();
+    m_compensation = reference;
+}
+
+Voltage MotorGroup::getVoltageCompensation() const { return m_compensation; }
+
+void MotorGroup::setVelocityMode(VelocityMode mode) {
+    m_velocityMode = mode;
+    m_velocityController.reset();
+}
+
+VelocityMode MotorGroup::getVelocityMode() const { return m_velocityMode; }
+
+void MotorGroup::setVelocityGains(VelocityGains gains) { m_velocityController.setGains(gains); }
+
+VelocityGains MotorGroup::getVelocityGains() const { return m_velocityController.getGains(); }
+
+void MotorGroup::setStallDetector(StallDetector* detector) { m_stallDetector = detector; }
+
+StallDetector* MotorGroup::getStallDetector() const { return m_stallDetector; }
+
+void MotorGroup::setVoltageSlew(SlewLimits<Voltage> limits) { m_voltageSlew.setLimits(limits); }
+
+SlewLimits<Voltage> MotorGroup::getVoltageSlew() const { return m_voltageSlew.getLimits(); }
+
+void MotorGroup::setVelocitySlew(SlewLimits<AngularVelocity> limits) { m_velocitySlew.setLimits(limits); }
+
+SlewLimits<AngularVelocity> MotorGroup::getVelocitySlew() const { return m_velocitySlew.getLimits(); }
+
+AngularVelocity MotorGroup::getOutputVelocity() const { return m_outputVelocity; }
+
 void MotorGroup::removeMotor(Motor motor) { removeMotor(motor.getPort()); }
 
 int MotorGroup::configureMotor(int port) {
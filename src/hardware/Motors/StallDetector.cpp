@@ -0,0 +1,84 @@
+#include "hardware/Motors/StallDetector.hpp"
+
+namespace lemlib {
+StallDetector::StallDetector(StallSettings settings)
+    : m_settings(settings) {}
+
+Voltage StallDetector::update(Voltage commanded, Current current, Angle angle, Time time) {
+    // measurements that failed are ignored
+    if (angle == from_stRad(INFINITY) || current == from_amp(INFINITY)) {
+        if (m_brakeEnd && time < *m_brakeEnd) return 0_volt;
+        return m_pulseEnd && time < *m_pulseEnd ? m_pulseVoltage : commanded;
+    }
+    const AngularVelocity velocity = m_velocity.update(angle, time);
+    if (m_pulseEnd) {
+        if (time < *m_pulseEnd) return m_pulseVoltage;
+        // give the motor time to speed up again before pulsing again
+        m_pulseEnd.reset();
+        m_retry = time + m_settings.stallTime;
+        m_since.reset();
+    }
+    if (m_brakeEnd) {
+        if (time < *m_brakeEnd) return 0_volt;
+        // a braked motor can't show that the stall cleared, so it is driven again for a while before braking again
+        m_brakeEnd.reset();
+        m_retry = time + m_settings.stallTime;
+        m_since.reset();
+    }
+    const bool driven = units::abs(commanded) >= m_settings.minVoltage;
+    // the velocity in the direction the motor is commanded to move
+    const AngularVelocity forward = commanded < 0_volt ? velocity * -1 : velocity;
+    // the condition which changes the state has to hold for a while before the state changes
+    const bool changing = m_stalled ? !driven || forward >= m_settings.clearVelocity
+                                    : driven && forward <= m_settings.stallVelocity && current >= m_settings.minCurrent;
+    if (!changing) m_since.reset();
+    else if (!m_since) m_since = time;
+    if (m_since && time - *m_since >= (m_stalled ? m_settings.clearTime : m_settings.stallTime)) {
+        m_stalled = !m_stalled;
+        m_since.reset();
+        if (m_stalled) m_stalls++;
+        raise(m_stalled, time);
+        if (m_stalled) m_retry = time;
+    }
+    // keep pulsing while the motor is stalled
+    if (m_stalled && m_settings.action == StallAction::REVERSE_PULSE && time >= m_retry) {
+        m_pulseVoltage = commanded < 0_volt ? m_settings.reverseVoltage : m_settings.reverseVoltage * -1;
+        m_pulseEnd = time + m_settings.reverseTime;
+        return m_pulseVoltage;
+    }
+    if (m_stalled && m_settings.action == StallAction::BRAKE && time >= m_retry) {
+        m_brakeEnd = time + m_settings.brakeTime;
+        return 0_volt;
+    }
+    return commanded;
+}
+
+bool StallDetector::isStalled() const { return m_stalled; }
+
+bool StallDetector::isBraking() const { return m_brakeEnd.has_value(); }
+
+void StallDetector::setCallback(std::function<void(const StallEvent&)> callback) { m_callback = callback; }
+
+std::optional<StallEvent> StallDetector::popEvent() { return m_events.pop(); }
+
+std::uint32_t StallDetector::getStallCount() const { return m_stalls; }
+
+void StallDetector::setSettings(StallSettings settings) { m_settings = settings; }
+
+StallSettings StallDetector::getSettings() const { return m_settings; }
+
+void StallDetector::reset() {
+    m_velocity.reset();
+    m_stalled = false;
+    m_since.reset();
+    m_pulseEnd.reset();
+    m_brakeEnd.reset();
+}
+
+void StallDetector::raise(bool stalled, Time time) {
+    const StallEvent event = {this, stalled, time};
+    if (m_callback) m_callback(event);
+    // the event is dropped if the queue is full, but the callback still gets it
+    m_events.push(event);
+}
+} // namespace lemlib
@@ -0,0 +1,180 @@
+#include "hardware/Motors/ThermalModel.hpp"
+#include <array>
+#include <cerrno>
+#include <cmath>
+
+namespace lemlib {
+/** the step size of the temperature reported by the motor */
+static constexpr Temperature SENSOR_RESOLUTION = 5_kelvin;
+
+ThermalModel::ThermalModel(ThermalCoefficients coefficients)
+    : m_coefficients(coefficients),
+      m_temperature(coefficients.ambient),
+      m_sensorTemperature(coefficients.ambient) {}
+
+void ThermalModel::predict(Current current, Time dt) {
+    // exact solution over the step, so it is stable for any step size
+    const Temperature target = m_coefficients.ambient + m_coefficients.heating * current * current;
+    const Temperature previous = m_temperature;
+    m_temperature = target + (previous - target) * std::exp(-to_num(dt / m_coefficients.timeConstant));
+    // the sensor follows the average temperature of the windings over the step
+    const Temperature average = (previous + m_temperature) / 2;
+    m_sensorTemperature =
+        average + (m_sensorTemperature - average) * std::exp(-to_num(dt / m_coefficients.sensorTimeConstant));
+}
+
+Temperature ThermalModel::update(Current current, Temperature measured, Time time) {
+    const bool valid = measured != units::from_kelvin(INFINITY);
+    if (!m_initialized) {
+        m_initialized = true;
+        // the reported temperature is rounded down, so the middle of the step is the best guess
+        m_temperature = valid ? measured + SENSOR_RESOLUTION / 2 : m_coefficients.ambient;
+        m_sensorTemperature = m_temperature;
+        m_time = time;
+        return m_temperature;
+    }
+    const Time dt = time - m_time;
+    m_time = time;
+    if (current != from_amp(INFINITY) && dt > 0_sec) predict(current, dt);
+    if (valid) {
+        // if the sensor reports a different step than predicted, the whole model is off by about the same amount
+        const Temperature corrected = units::clamp(m_sensorTemperature, measured, measured + SENSOR_RESOLUTION);
+        m_temperature += corrected - m_sensorTemperature;
+        m_sensorTemperature = corrected;
+    }
+    return m_temperature;
+}
+
+Temperature ThermalModel::getTemperature() const { return m_temperature; }
+
+Temperature ThermalModel::getSensorTemperature() const { return m_sensorTemperature; }
+
+Time ThermalModel::getTimeToTemperature(Temperature temperature, Current current) const {
+    if (m_temperature >= temperature) return 0_sec;
+    const Temperature target = m_coefficients.ambient + m_coefficients.heating * current * current;
+    if (target <= temperature) return from_sec(INFINITY);
+    // solve temperature = target + (current temperature - target) * e^(-t / timeConstant) for t
+    return m_coefficients.timeConstant * -std::log(to_num((temperature - target) / (m_temperature - target)));
+}
+
+Time ThermalModel::getTimeToDerate(Current current) const {
+    // the motor derates when its sensor reaches the temperature, which lags behind the windings
+    if (m_sensorTemperature >= DERATE_TEMPERATURE) return 0_sec;
+    const Temperature target = m_coefficients.ambient + m_coefficients.heating * current * current;
+    const Time tau = m_coefficients.timeConstant;
+    const Time sensorTau = m_coefficients.sensorTimeConstant;
+    // the windings approach the target exponentially, and the sensor follows the windings with its own time constant:
+    // sensor(t) = target + a * e^(-t / tau) + b * e^(-t / sensorTau)
+    const Temperature windings = m_temperature - target;
+    auto windingsAt = [&](Time t) { return target + windings * std::exp(-to_num(t / tau)); };
+    auto sensorAt = [&](Time t) {
+        const Temperature sensor = m_sensorTemperature - target;
+        if (units::abs(tau - sensorTau) < 1e-6 * tau) {
+            // both time constants are the same, so the solution has a repeated pole
+            return target + (sensor + windings * to_num(t / tau)) * std::exp(-to_num(t / tau));
+        }
+        const Temperature a = windings * to_num(tau / (tau - sensorTau));
+        return target + a * std::exp(-to_num(t / tau)) + (sensor - a) * std::exp(-to_num(t / sensorTau));
+    };
+    // find when a function which is negative at start and positive at end changes sign
+    auto bisect = [](auto function, Time start, Time end) {
+        for (int i = 0; i < 60; i++) {
+            const Time middle = (start + end) / 2;
+            if (function(middle)) end = middle;
+            else start = middle;
+        }
+        return end;
+    };
+    auto reached = [&](Time t) { return sensorAt(t) >= DERATE_TEMPERATURE; };
+    if (target > DERATE_TEMPERATURE) {
+        // the sensor ends up above the temperature, and only crosses it once
+        Time end = tau + sensorTau;
+        while (!reached(end)) end *= 2;
+        return bisect(reached, 0_sec, end);
+    }
+    // otherwise, the sensor can only reach the temperature if it is still heating up from windings which are cooling
+    // down. It peaks when it catches up with the windings
+    if (m_temperature <= target || m_sensorTemperature >= m_temperature) return from_sec(INFINITY);
+    Time end = tau + sensorTau;
+    while (windingsAt(end) > sensorAt(end)) end *= 2;
+    const Time peak = bisect([&](Time t) { return windingsAt(t) <= sensorAt(t); }, 0_sec, end);
+    if (!reached(peak)) return from_sec(INFINITY);
+    return bisect(reached, 0_sec, peak);
+}
+
+void ThermalModel::setDerating(ThermalDerating derating) {
+    m_derating = derating;
+    m_derate = true;
+}
+
+void ThermalModel::disableDerating() { m_derate = false; }
+
+Number ThermalModel::getDeratingScale() const {
+    if (!m_derate || m_temperature <= m_derating.start) return 1_num;
+    if (m_temperature >= m_derating.end) return m_derating.minimum;
+    const Number progress = (m_temperature - m_derating.start) / (m_derating.end - m_derating.start);
+    return 1_num - progress * (1_num - m_derating.minimum);
+}
+
+void ThermalModel::setCoefficients(ThermalCoefficients coefficients) { m_coefficients = coefficients; }
+
+ThermalCoefficients ThermalModel::getCoefficients() const { return m_coefficients; }
+
+/**
+ * @brief the squared error of the model without corrections, compared to the reported temperatures
+ */
+static double fitError(std::span<const ThermalSample> samples, ThermalModel& model) {
+    double error = 0;
+    for (std::size_t i = 1; i < samples.size(); i++) {
+        const Current current = samples[i - 1].current;
+        model.update(current == from_amp(INFINITY) ? 0_amp : current, units::from_kelvin(INFINITY), samples[i].time);
+        if (samples[i].temperature == units::from_kelvin(INFINITY)) continue;
+        // only the distance outside the reported step is an error, as the sensor rounds down
+        const Temperature predicted = model.getSensorTemperature();
+        const Temperature low = samples[i].temperature;
+        const Temperature high = low + SENSOR_RESOLUTION;
+        if (predicted < low) error += std::pow(units::to_kelvin(low - predicted), 2);
+        else if (predicted > high) error += std::pow(units::to_kelvin(predicted - high), 2);
+    }
+    return error;
+}
+
+ThermalCoefficients ThermalModel::fit(std::span<const ThermalSample> samples, Temperature ambient) {
+    if (samples.size() < 2) {
+        errno = EDOM;
+        return {units::from_kelvin(INFINITY) / (1_amp * 1_amp), from_sec(INFINITY), from_sec(INFINITY), ambient};
+    }
+    // the model isn't linear in the time constants, so the coefficients are found by a pattern search. Each coefficient
+    // is multiplied and divided by a factor, and the factor shrinks once none of the changes improve the fit
+    // start from the default coefficients
+    const ThermalCoefficients initial;
+    std::array<double, 3> coefficients = {units::to_kelvin(initial.heating * (1_amp * 1_amp)),
+                                          to_sec(initial.timeConstant), to_sec(initial.sensorTimeConstant)};
+    auto error = [&](const std::array<double, 3>& c) {
+        ThermalModel model({units::from_kelvin(c[0]) / (1_amp * 1_amp), from_sec(c[1]), from_sec(c[2]), ambient});
+        model.update(0_amp, units::from_kelvin(INFINITY), samples[0].time);
+        return fitError(samples, model);
+    };
+    double best = error(coefficients);
+    double factor = 2;
+    for (int iteration = 0; iteration < 200 && factor > 1.001; iteration++) {
+        bool improved = false;
+        for (double& coefficient : coefficients) {
+            for (double change : {factor, 1 / factor}) {
+                const double previous = coefficient;
+                coefficient *= change;
+                const double result = error(coefficients);
+                if (result < best) {
+                    best = result;
+                    improved = true;
+                } else {
+                    coefficient = previous;
+                }
+            }
+        }
+        if (!improved) factor = std::sqrt(factor);
+    }
+    return {units::from_kelvin(coefficients[0]) / (1_amp * 1_amp), from_sec(coefficients[1]),
+            from_sec(coefficients[2]), ambient};
+}
+} // namespace lemlib
@@ -0,0 +1,56 @@
+#include "hardware/Motors/VelocityController.hpp"
+
+namespace lemlib {
+VelocityEstimator::VelocityEstimator(Time timeConstant, Time timeout)
+    : m_timeConstant(timeConstant),
+      m_timeout(timeout) {}
+
+AngularVelocity VelocityEstimator::update(Angle angle, Time time) {
+    if (!m_initialized) {
+        m_initialized = true;
+        m_angle = angle;
+        m_time = time;
+        return m_velocity;
+    }
+    const Time dt = time - m_time;
+    // the motor only measures its position every 10 ms, so an unchanged angle usually means there is no new
+    // measurement yet. The measurement is only used once the angle changes, or the timeout shows it is stopped
+    if (dt <= 0_sec || (angle == m_angle && dt < m_timeout)) return m_velocity;
+    const AngularVelocity raw = (angle - m_angle) / dt;
+    // the weight of the new measurement depends on the time since the last one, so the filter behaves the same no
+    // matter how often it is updated
+    m_velocity += (raw - m_velocity) * (dt / (m_timeConstant + dt));
+    m_angle = angle;
+    m_time = time;
+    return m_velocity;
+}
+
+AngularVelocity VelocityEstimator::getVelocity() const { return m_velocity; }
+
+void VelocityEstimator::reset() {
+    m_initialized = false;
+    m_velocity = 0_radps;
+}
+
+VelocityController::VelocityController(VelocityGains gains, VelocityEstimator estimator)
+    : m_gains(gains),
+      m_estimator(estimator) {}
+
+Voltage VelocityController::update(Angle angle, Time time, AngularVelocity velocity,
+                                   AngularAcceleration acceleration) {
+    const AngularVelocity measured = m_estimator.update(angle, time);
+    // static friction only needs to be overcome when the target is to move
+    Voltage voltage = velocity == 0_radps ? 0_volt : m_gains.kS * units::sgn(velocity);
+    voltage += m_gains.kV * velocity + m_gains.kA * acceleration;
+    voltage += m_gains.kP * (velocity - measured);
+    return voltage;
+}
+
+void VelocityController::setGains(VelocityGains gains) { m_gains = gains; }
+
+VelocityGains VelocityController::getGains() const { return m_gains; }
+
+AngularVelocity VelocityController::getVelocity() const { return m_estimator.getVelocity(); }
+
+void VelocityController::reset() { m_estimator.reset(); }
+} // namespace lemlib
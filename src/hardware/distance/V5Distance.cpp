@@ -0,0 +1,40 @@
+#include "hardware/distance/V5Distance.hpp"
+#include <cmath>
+#include <limits.h>
+
+namespace lemlib {
+V5Distance::V5Distance(pros::Distance sensor)
+    : m_sensor(sensor) {}
+
+int V5Distance::isConnected() { return m_sensor.is_installed(); }
+
+Length V5Distance::getDistance() {
+    const std::int32_t result = m_sensor.get_distance();
+    // check for errors
+    if (result == INT_MAX) return from_mm(INFINITY);
+    return from_mm(result);
+}
+
+Number V5Distance::getConfidence() { return getReading().confidence; }
+
+DistanceReading V5Distance::getReading() {
+    const std::int32_t distance = m_sensor.get_distance();
+    // check for errors
+    if (distance == INT_MAX) return {from_mm(INFINITY), Number(INFINITY)};
+    // the sensor returns 9999 if it can't detect an object
+    if (distance == 9999) return {from_mm(distance), Number(0)};
+    // confidence is only measured for objects further than 200mm away
+    if (distance <= 200) return {from_mm(distance), Number(1)};
+    const std::int32_t confidence = m_sensor.get_confidence();
+    // check for errors
+    if (confidence == INT_MAX) return {from_mm(distance), Number(INFINITY)};
+    return {from_mm(distance), Number(confidence / 63.0)};
+}
+
+LinearVelocity V5Distance::getObjectVelocity() {
+    const double result = m_sensor.get_object_velocity();
+    // check for errors
+    if (result == INFINITY) return from_mps(INFINITY);
+    return from_mps(result);
+}
+} // namespace lemlib
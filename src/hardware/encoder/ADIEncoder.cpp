@@ -1,12 +1,29 @@
 #include "hardware/encoder/ADIEncoder.hpp"
+#include "pros/rtos.hpp"
+#include <algorithm>
+#include <cerrno>
 #include <cmath>
 #include <limits.h>
 
 namespace lemlib {
-ADIEncoder::ADIEncoder(pros::adi::Encoder encoder)
-    : m_encoder(encoder) {}
+/**
+ * @brief the longest time between ticks of a moving encoder, in microseconds
+ *
+ * If no tick has been counted for longer, the encoder is at a standstill. The ticks counted when it starts moving again
+ * are measured over at most this time, rather than over the whole standstill
+ */
+static constexpr std::uint64_t MAX_TICK_INTERVAL = 100000;
+
+ADIEncoder::ADIEncoder(pros::adi::Encoder encoder, int ticksPerRotation)
+    : m_encoder(encoder),
+      m_ticksPerRotation(ticksPerRotation) {}
 
 int ADIEncoder::isConnected() {
+    // check for errors
+    if (m_ticksPerRotation <= 0) {
+        errno = EINVAL;
+        return INT_MAX;
+    }
     // it's not possible to check if the ADIEncoder is connected, so we just return 1 to indicate that it is
     // we do run a simple test however to check if the ports are valid
     if (m_encoder.get_value() == INT_MAX) {
@@ -17,28 +34,81 @@ int ADIEncoder::isConnected() {
     return 1;
 }
 
-Angle ADIEncoder::getAngle() {
-    const int raw = m_encoder.get_value();
+/**
+ * @brief unwrap a 32 bit hardware count into a 64 bit count
+ *
+ * The low 32 bits of the unwrapped count match the hardware count, so the difference between them is the number of
+ * ticks counted since the last read, even if the hardware count overflowed
+ */
+static std::int64_t unwrap(std::int64_t previous, std::int32_t raw) {
+    return previous + static_cast<std::int32_t>(static_cast<std::uint32_t>(raw) - static_cast<std::uint32_t>(previous));
+}
+
+int ADIEncoder::readTicks(std::int64_t& count) {
+    // an encoder without a positive number of ticks per rotation can't measure an angle
+    if (m_ticksPerRotation <= 0) {
+        errno = EINVAL;
+        return INT_MAX;
+    }
+    const std::int32_t raw = m_encoder.get_value();
     // check for errors
     if (raw == INT_MAX) {
         errno = ENODEV;
-        return Angle(INFINITY);
+        return INT_MAX;
     }
+    std::int64_t previous = m_count.load(std::memory_order_relaxed);
+    count = unwrap(previous, raw);
+    // if another task updated the count first, its read is at least as recent, so don't overwrite it
+    if (!m_count.compare_exchange_strong(previous, count, std::memory_order_relaxed)) count = unwrap(previous, raw);
+    return 0;
+}
+
+Angle ADIEncoder::toAngle(double ticks) const { return from_stRot(ticks / m_ticksPerRotation); }
+
+Angle ADIEncoder::getAngle() {
+    std::int64_t count;
+    // check for errors
+    if (readTicks(count) == INT_MAX) return from_stDeg(INFINITY);
     // return the angle
-    return from_stDeg(raw) + m_offset;
+    return toAngle(count + m_offset.load(std::memory_order_relaxed));
 }
 
 int ADIEncoder::setAngle(Angle angle) {
-    // the Vex SDK does not support setting the relative angle of an ADI encoder to a specific value
-    // but we can overcome this limitation by resetting the relative angle to zero and saving an offset
-    m_offset = angle;
-    const int result = m_encoder.reset();
+    // the hardware counter isn't reset, as ticks counted between the reset and the next read would be lost
+    // instead, an offset is saved, which is applied to every read in a single step
+    std::int64_t count;
     // check for errors
-    if (result == INT_MAX) {
-        errno = ENODEV;
-        return INT_MAX;
-    }
+    if (readTicks(count) == INT_MAX) return INT_MAX;
+    const std::int64_t ticks = std::llround(to_stRot(angle) * m_ticksPerRotation);
+    m_offset.store(ticks - count, std::memory_order_relaxed);
     // return 0 on success
     return 0;
 }
-} // namespace lemlib
\ No newline at end of file
+
+AngularVelocity ADIEncoder::getVelocity() {
+    std::int64_t count;
+    // check for errors
+    if (readTicks(count) == INT_MAX) return from_rpm(INFINITY);
+    const std::uint64_t now = pros::micros();
+    if (!m_velocityInitialized) {
+        m_velocityInitialized = true;
+        m_lastChangeCount = count;
+        m_lastChangeTime = now;
+        return from_rpm(0);
+    }
+    const bool standstill = now - m_lastChangeTime > MAX_TICK_INTERVAL;
+    const double elapsed = std::min(now - m_lastChangeTime, MAX_TICK_INTERVAL);
+    if (count != m_lastChangeCount) {
+        // the ticks were counted over the time since the last tick, or since the encoder started moving again
+        m_ticksPerMicrosecond = (count - m_lastChangeCount) / elapsed;
+        m_lastChangeCount = count;
+        m_lastChangeTime = now;
+    } else if (standstill) {
+        m_ticksPerMicrosecond = 0;
+    } else if (std::abs(m_ticksPerMicrosecond) * elapsed > 1) {
+        // no tick has been counted, so the encoder is moving at most 1 tick over the time since the last tick
+        m_ticksPerMicrosecond = std::copysign(1 / elapsed, m_ticksPerMicrosecond);
+    }
+    return toAngle(m_ticksPerMicrosecond * 1E6) / 1_sec;
+}
+} // namespace lemlib
@@ -1,23 +1,122 @@
 #include "hardware/encoder/Rotation.hpp"
+#include <algorithm>
+#include <cmath>
 #include <limits.h>
 
 namespace lemlib {
+/**
+ * @brief convert a position in centidegrees to an angle
+ */
+static Angle fromCentidegrees(std::int64_t position) { return from_stDeg(position / 100.0); }
+
 Rotation::Rotation(pros::Rotation encoder)
     : m_encoder(encoder) {}
 
 int Rotation::isConnected() { return m_encoder.is_installed(); }
 
 Angle Rotation::getAngle() {
-    const float angle = float(m_encoder.get_position()) / 100;
+    if (m_sampler) return m_sampler->latest.read().angle;
+    const std::int32_t position = m_encoder.get_position();
     // check for errors
-    if (angle == INFINITY) return from_stDeg(INFINITY);
-    return from_stDeg(angle);
+    if (position == INT_MAX) return from_stDeg(INFINITY);
+    return fromCentidegrees(position + m_offset);
 }
 
 int Rotation::setAngle(Angle angle) {
-    const int result = m_encoder.set_position(to_stDeg(angle) * 100);
+    const std::int64_t position = std::llround(to_stDeg(angle) * 100);
+    // the sampler owns the position while it is running
+    if (m_sampler) {
+        m_sampler->requestedPosition.publish(position);
+        return 0;
+    }
+    // the sensor can only store unsigned positions, so the position is kept as an offset instead
+    const int result = m_encoder.reset_position();
     // check for errors
     if (result == INT_MAX) return INT_MAX;
+    m_offset = position;
+    return 0;
+}
+
+AngularVelocity Rotation::getVelocity() {
+    if (m_sampler) return m_sampler->latest.read().velocity;
+    const std::int32_t velocity = m_encoder.get_velocity();
+    // check for errors
+    if (velocity == INT_MAX) return from_degps(INFINITY);
+    return from_degps(velocity / 100.0);
+}
+
+int Rotation::setDataRate(Time rate) {
+    const int result = m_encoder.set_data_rate(std::lround(to_msec(rate)));
+    // check for errors
+    if (result == INT_MAX) return INT_MAX;
+    return 0;
+}
+
+int Rotation::startSampling(Time period, std::uint32_t priority) {
+    if (m_sampler) return 0;
+    const std::uint32_t periodMs = std::max(5L, std::lround(to_msec(period)));
+    if (setDataRate(from_msec(periodMs)) == INT_MAX) return INT_MAX;
+    // take the first sample now, so the angle is valid as soon as this function returns
+    const std::int32_t position = m_encoder.get_position();
+    const std::int32_t velocity = m_encoder.get_velocity();
+    // check for errors
+    if (position == INT_MAX || velocity == INT_MAX) return INT_MAX;
+    const std::int64_t accumulated = position + m_offset;
+    m_sampler = std::make_unique<Sampler>();
+    m_sampler->latest.publish({accumulated, fromCentidegrees(accumulated), from_degps(velocity / 100.0),
+                               from_usec(pros::micros())});
+    m_sampler->task = pros::Task([this, periodMs, position, accumulated] { sample(periodMs, position, accumulated); },
+                                 priority, TASK_STACK_DEPTH_DEFAULT, "rotation sampler");
     return 0;
 }
-} // namespace lemlib
\ No newline at end of file
+
+void Rotation::sample(std::uint32_t periodMs, std::int32_t position, std::int64_t accumulated) {
+    std::uint32_t time = pros::millis();
+    std::uint32_t appliedVersion = 0;
+    while (m_sampler->running) {
+        pros::Task::delay_until(&time, periodMs);
+        const std::int32_t newPosition = m_encoder.get_position();
+        const std::int32_t velocity = m_encoder.get_velocity();
+        const std::uint64_t now = pros::micros();
+        // skip samples that fail, the next good sample catches up
+        if (newPosition == INT_MAX || velocity == INT_MAX) continue;
+        // subtract as unsigned integers so the difference is correct even if the sensor position overflows
+        accumulated += static_cast<std::int32_t>(static_cast<std::uint32_t>(newPosition) -
+                                                 static_cast<std::uint32_t>(position));
+        position = newPosition;
+        // apply a position set by another task
+        const std::uint32_t version = m_sampler->requestedPosition.getVersion();
+        if (version != appliedVersion) {
+            appliedVersion = version;
+            accumulated = m_sampler->requestedPosition.read();
+        }
+        const RotationSample sample = {accumulated, fromCentidegrees(accumulated), from_degps(velocity / 100.0),
+                                       from_usec(now)};
+        m_sampler->samples.push(sample);
+        m_sampler->latest.publish(sample);
+    }
+}
+
+void Rotation::stopSampling() {
+    if (!m_sampler) return;
+    m_sampler->running = false;
+    // wait for the sampler to finish its current sample
+    m_sampler->task->join();
+    // keep the angle measured by the sampler
+    const std::int32_t position = m_encoder.get_position();
+    if (position != INT_MAX) m_offset = m_sampler->latest.read().position - position;
+    m_sampler.reset();
+}
+
+std::size_t Rotation::readSamples(std::span<RotationSample> out) {
+    if (!m_sampler) return 0;
+    return m_sampler->samples.pop(out);
+}
+
+std::uint32_t Rotation::getDroppedSamples() const {
+    if (!m_sampler) return 0;
+    return m_sampler->samples.getDropped();
+}
+
+Rotation::~Rotation() { stopSampling(); }
+} // namespace lemlib
@@ -0,0 +1,43 @@
+#include "hardware/encoder/SerialEncoder.hpp"
+#include <cerrno>
+#include <cmath>
+#include <limits.h>
+
+namespace lemlib {
+SerialEncoder::SerialEncoder(SerialPort* port, std::uint8_t channel, int ticksPerRotation, Time timeout)
+    : m_port(port),
+      m_channel(channel),
+      m_ticksPerRotation(ticksPerRotation),
+      m_timeout(timeout) {}
+
+int SerialEncoder::readTicks(std::int32_t& ticks) {
+    const std::optional<SerialChannelValue> value = m_port->getChannel(m_channel);
+    // check that the value exists and isn't stale
+    if (!value || from_usec(pros::micros()) - value->time > m_timeout) {
+        errno = ENODEV;
+        return INT_MAX;
+    }
+    ticks = value->value;
+    return 0;
+}
+
+int SerialEncoder::isConnected() {
+    std::int32_t ticks;
+    return readTicks(ticks) == 0;
+}
+
+Angle SerialEncoder::getAngle() {
+    std::int32_t ticks;
+    // check for errors
+    if (readTicks(ticks) == INT_MAX) return from_stDeg(INFINITY);
+    return from_stRot(double(ticks + m_offset.load(std::memory_order_relaxed)) / m_ticksPerRotation);
+}
+
+int SerialEncoder::setAngle(Angle angle) {
+    std::int32_t ticks;
+    // check for errors
+    if (readTicks(ticks) == INT_MAX) return INT_MAX;
+    m_offset.store(std::llround(to_stRot(angle) * m_ticksPerRotation) - ticks, std::memory_order_relaxed);
+    return 0;
+}
+} // namespace lemlib
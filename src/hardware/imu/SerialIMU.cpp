@@ -0,0 +1,49 @@
+#include "hardware/IMU/SerialIMU.hpp"
+#include <cerrno>
+#include <cmath>
+#include <limits.h>
+
+namespace lemlib {
+SerialIMU::SerialIMU(SerialPort* port, std::uint8_t channel, int ticksPerRotation, Time timeout)
+    : m_port(port),
+      m_channel(channel),
+      m_ticksPerRotation(ticksPerRotation),
+      m_timeout(timeout) {}
+
+int SerialIMU::readTicks(std::int32_t& ticks) {
+    const std::optional<SerialChannelValue> value = m_port->getChannel(m_channel);
+    // check that the value exists and isn't stale
+    if (!value || from_usec(pros::micros()) - value->time > m_timeout) {
+        errno = ENODEV;
+        return INT_MAX;
+    }
+    ticks = value->value;
+    return 0;
+}
+
+int SerialIMU::calibrate() { return 0; }
+
+int SerialIMU::isCalibrated() { return isConnected(); }
+
+int SerialIMU::isCalibrating() { return !isConnected(); }
+
+int SerialIMU::isConnected() {
+    std::int32_t ticks;
+    return readTicks(ticks) == 0;
+}
+
+Angle SerialIMU::getRotation() {
+    std::int32_t ticks;
+    // check for errors
+    if (readTicks(ticks) == INT_MAX) return from_stDeg(INFINITY);
+    return from_stRot(double(ticks + m_offset.load(std::memory_order_relaxed)) / m_ticksPerRotation);
+}
+
+int SerialIMU::setRotation(Angle rotation) {
+    std::int32_t ticks;
+    // check for errors
+    if (readTicks(ticks) == INT_MAX) return INT_MAX;
+    m_offset.store(std::llround(to_stRot(rotation) * m_ticksPerRotation) - ticks, std::memory_order_relaxed);
+    return 0;
+}
+} // namespace lemlib
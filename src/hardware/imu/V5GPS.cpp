@@ -0,0 +1,122 @@
+#include "hardware/IMU/V5GPS.hpp"
+#include "hardware/math/SE2.hpp"
+#include <cerrno>
+#include <cmath>
+#include <limits.h>
+
+namespace lemlib {
+V5GPS::V5GPS(pros::Gps gps, Odometry* odometry, Time latency)
+    : m_gps(gps),
+      m_odometry(odometry),
+      m_latency(latency) {}
+
+int V5GPS::calibrate() { return 0; }
+
+int V5GPS::isCalibrated() { return m_gps.get_error() != INFINITY; }
+
+int V5GPS::isCalibrating() {
+    // the sensor reports EAGAIN while it is calibrating
+    if (m_gps.get_error() != INFINITY) return false;
+    return errno == EAGAIN;
+}
+
+int V5GPS::isConnected() { return m_gps.is_installed(); }
+
+Angle V5GPS::getRotation() {
+    const double result = m_gps.get_heading_raw();
+    // check for errors
+    if (result == INFINITY) return from_stDeg(INFINITY);
+    return from_cDeg(result) + from_stRad(m_rotationOffset.load(std::memory_order_relaxed));
+}
+
+int V5GPS::setRotation(Angle rotation) {
+    const double result = m_gps.get_heading_raw();
+    // check for errors
+    if (result == INFINITY) return INT_MAX;
+    m_rotationOffset.store(to_stRad(rotation - from_cDeg(result)), std::memory_order_relaxed);
+    return 0;
+}
+
+int V5GPS::read(GPSReading& reading) {
+    const pros::gps_status_s_t status = m_gps.get_position_and_orientation();
+    const double heading = m_gps.get_heading_raw();
+    const double error = m_gps.get_error();
+    // check for errors
+    if (status.x == INFINITY || heading == INFINITY || error == INFINITY) return INT_MAX;
+    reading.pose = units::Pose(from_m(status.x), from_m(status.y), from_cDeg(heading));
+    reading.error = from_m(error);
+    reading.time = from_usec(pros::micros());
+    return 0;
+}
+
+GPSReading V5GPS::getReading() {
+    if (m_sampler) return m_sampler->latest.read();
+    GPSReading reading;
+    // check for errors
+    if (read(reading) == INT_MAX) reading.error = from_m(INFINITY);
+    return reading;
+}
+
+int V5GPS::startSampling(std::uint32_t priority) {
+    if (m_sampler) return 0;
+    // check for errors
+    if (m_gps.set_data_rate(to_msec(DATA_RATE)) == INT_MAX) return INT_MAX;
+    m_sampler = std::make_unique<Sampler>();
+    // the reading is invalid until the first sample
+    GPSReading first;
+    first.error = from_m(INFINITY);
+    m_sampler->latest.publish(first);
+    m_sampler->task = pros::Task([this] { sample(); }, priority, TASK_STACK_DEPTH_DEFAULT, "gps sampler");
+    return 0;
+}
+
+void V5GPS::sample() {
+    Sampler& sampler = *m_sampler;
+    std::uint32_t time = pros::millis();
+    while (sampler.running) {
+        pros::Task::delay_until(&time, to_msec(DATA_RATE));
+        // record where odometry thinks the robot is, so later readings can be compensated
+        std::optional<OdomState> odom;
+        if (m_odometry != nullptr) {
+            odom = m_odometry->getState();
+            sampler.history[sampler.historyNext] = *odom;
+            sampler.historyNext = (sampler.historyNext + 1) % HISTORY_SIZE;
+            if (sampler.historyCount < HISTORY_SIZE) sampler.historyCount++;
+        }
+        GPSReading reading;
+        // skip samples that fail
+        if (read(reading) == INT_MAX) continue;
+        if (odom) reading.pose = compensate(sampler, reading.pose, reading.time - m_latency, *odom);
+        sampler.samples.push(reading);
+        sampler.latest.publish(reading);
+    }
+}
+
+units::Pose V5GPS::compensate(const Sampler& sampler, const units::Pose& pose, Time measured, const OdomState& now) {
+    // find the newest odometry state from before the pose was measured, or the oldest state if there is none
+    const OdomState* then = nullptr;
+    for (std::size_t i = 1; i <= sampler.historyCount; i++) {
+        then = &sampler.history[(sampler.historyNext + HISTORY_SIZE - i) % HISTORY_SIZE];
+        if (then->time <= measured) break;
+    }
+    if (then == nullptr) return pose;
+    // how the robot moved since the pose was measured, in the frame of the robot at that time
+    const SE2 delta = SE2(then->pose).inverse() * SE2(now.pose);
+    return (SE2(pose) * delta).toPose();
+}
+
+void V5GPS::stopSampling() {
+    if (!m_sampler) return;
+    m_sampler->running = false;
+    // wait for the sampler to finish its current sample
+    m_sampler->task->join();
+    m_sampler.reset();
+}
+
+std::size_t V5GPS::readSamples(std::span<GPSReading> out) {
+    if (!m_sampler) return 0;
+    return m_sampler->samples.pop(out);
+}
+
+V5GPS::~V5GPS() { stopSampling(); }
+} // namespace lemlib
@@ -0,0 +1,74 @@
+#include "hardware/motion/DifferentialDrive.hpp"
+#include "pros/rtos.hpp"
+#include <climits>
+
+namespace lemlib {
+DifferentialDrive::DifferentialDrive(MotorGroup& left, MotorGroup& right, Length trackWidth, Length wheelDiameter)
+    : m_left(left),
+      m_right(right),
+      m_trackWidth(trackWidth),
+      m_wheelDiameter(wheelDiameter) {}
+
+WheelSpeeds DifferentialDrive::toWheelSpeeds(units::VelocityPose velocity) const {
+    // the speed each wheel needs to go faster or slower than the center of the robot to turn
+    const LinearVelocity turn = from_mps(to_radps(velocity.getOrientation()) * to_m(m_trackWidth) / 2);
+    return {velocity.getX() - turn, velocity.getX() + turn};
+}
+
+units::VelocityPose DifferentialDrive::toChassisVelocity(WheelSpeeds speeds) const {
+    const AngularVelocity angular = from_radps(to_mps(speeds.right - speeds.left) / to_m(m_trackWidth));
+    return units::VelocityPose((speeds.left + speeds.right) / 2, 0_mps, angular);
+}
+
+WheelSpeeds DifferentialDrive::desaturate(WheelSpeeds speeds, LinearVelocity maxSpeed) {
+    const LinearVelocity fastest = units::max(units::abs(speeds.left), units::abs(speeds.right));
+    if (fastest <= maxSpeed) return speeds;
+    // scaling both sides by the same factor keeps the curvature
+    const Number scale = maxSpeed / fastest;
+    return {speeds.left * scale, speeds.right * scale};
+}
+
+int DifferentialDrive::move(units::VelocityPose velocity, units::AccelerationPose acceleration) {
+    const WheelSpeeds requested = toWheelSpeeds(velocity);
+    const WheelSpeeds speeds = desaturate(requested, getMaxSpeed());
+    // the acceleration is scaled by the same factor as the velocity, so the robot speeds up along the same path
+    const LinearVelocity fastest = units::max(units::abs(requested.left), units::abs(requested.right));
+    const LinearVelocity limited = units::max(units::abs(speeds.left), units::abs(speeds.right));
+    const double scale = fastest > 0_mps ? to_num(limited / fastest) : 1;
+    const double turn = to_radps2(acceleration.getOrientation()) * to_m(m_trackWidth) / 2;
+    const double radius = to_m(m_wheelDiameter) / 2;
+    const AngularAcceleration leftAcceleration = from_radps2((to_mps2(acceleration.getX()) - turn) * scale / radius);
+    const AngularAcceleration rightAcceleration = from_radps2((to_mps2(acceleration.getX()) + turn) * scale / radius);
+    // everything is calculated before either side is commanded, so both sides change in the same tick
+    const int left = m_left.moveVelocity(toAngular(speeds.left), leftAcceleration);
+    const int right = m_right.moveVelocity(toAngular(speeds.right), rightAcceleration);
+    return left == 0 && right == 0 ? 0 : INT_MAX;
+}
+
+units::VelocityPose DifferentialDrive::getVelocity() {
+    const Angle leftAngle = m_left.getAngle();
+    const Angle rightAngle = m_right.getAngle();
+    if (leftAngle == from_stDeg(INFINITY) || rightAngle == from_stDeg(INFINITY)) {
+        return units::VelocityPose(from_mps(INFINITY), from_mps(INFINITY), from_radps(INFINITY));
+    }
+    const Time time = from_usec(pros::micros());
+    return toChassisVelocity(
+        {toLinear(m_leftVelocity.update(leftAngle, time)), toLinear(m_rightVelocity.update(rightAngle, time))});
+}
+
+LinearVelocity DifferentialDrive::getMaxSpeed() const {
+    return toLinear(units::min(m_left.getOutputVelocity(), m_right.getOutputVelocity()));
+}
+
+Length DifferentialDrive::getTrackWidth() const { return m_trackWidth; }
+
+Length DifferentialDrive::getWheelDiameter() const { return m_wheelDiameter; }
+
+LinearVelocity DifferentialDrive::toLinear(AngularVelocity velocity) const {
+    return from_mps(to_radps(velocity) * to_m(m_wheelDiameter) / 2);
+}
+
+AngularVelocity DifferentialDrive::toAngular(LinearVelocity velocity) const {
+    return from_radps(to_mps(velocity) / to_m(m_wheelDiameter) * 2);
+}
+} // namespace lemlib
@@ -0,0 +1,60 @@
+#include "hardware/motion/ProfiledMove.hpp"
+#include "pros/rtos.hpp"
+#include <cerrno>
+#include <climits>
+#include <cmath>
+
+namespace lemlib {
+ProfiledMove::ProfiledMove(MotorGroup& motors, ProfileConstraints<Angle> constraints,
+                           Divided<AngularVelocity, Angle> kP)
+    : m_motors(motors),
+      m_constraints(constraints),
+      m_kP(kP) {}
+
+int ProfiledMove::start(Angle target) {
+    const Angle angle = m_motors.getAngle();
+    if (angle == from_stDeg(INFINITY)) return INT_MAX;
+    errno = 0;
+    AngularProfile profile(angle, target, m_constraints);
+    if (errno == EINVAL) return INT_MAX;
+    m_profile = profile;
+    m_startTime = from_usec(pros::micros());
+    m_setpoint = m_profile->sample(0_sec);
+    return 0;
+}
+
+int ProfiledMove::update() {
+    if (!m_profile) {
+        errno = EAGAIN;
+        return INT_MAX;
+    }
+    m_setpoint = m_profile->sample(from_usec(pros::micros()) - m_startTime);
+    const Angle angle = m_motors.getAngle();
+    if (angle == from_stDeg(INFINITY)) return INT_MAX;
+    // correct the error which the profile can't account for, like the load on the mechanism
+    return m_motors.moveVelocity(m_setpoint.velocity + m_kP * (m_setpoint.position - angle), m_setpoint.acceleration);
+}
+
+int ProfiledMove::moveTo(Angle target, Time period) {
+    if (start(target) != 0) return INT_MAX;
+    std::uint32_t time = pros::millis();
+    while (!isFinished()) {
+        if (update() != 0) return INT_MAX;
+        pros::Task::delay_until(&time, std::lround(to_msec(period)));
+    }
+    // nothing updates the velocity correction after this returns, so it would keep the motors moving past the target.
+    // The profile ends at rest, so the motors are stopped instead
+    m_setpoint = m_profile->sample(m_profile->getDuration());
+    return m_motors.brake();
+}
+
+bool ProfiledMove::isFinished() const {
+    return !m_profile || from_usec(pros::micros()) - m_startTime >= m_profile->getDuration();
+}
+
+ProfileState<Angle> ProfiledMove::getSetpoint() const { return m_setpoint; }
+
+void ProfiledMove::setConstraints(ProfileConstraints<Angle> constraints) { m_constraints = constraints; }
+
+ProfileConstraints<Angle> ProfiledMove::getConstraints() const { return m_constraints; }
+} // namespace lemlib
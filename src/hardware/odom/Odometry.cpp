@@ -0,0 +1,165 @@
+#include "hardware/odom/Odometry.hpp"
+#include <cerrno>
+#include <cmath>
+#include <limits.h>
+
+namespace lemlib {
+/**
+ * @brief calculate the length of the chord of an arc
+ *
+ * @param arc the length the arc measured by a tracking wheel
+ * @param dTheta the change in heading along the arc, in radians
+ * @param radiusOffset the difference between the radius of the tracking center and the radius of the wheel
+ * @return Length the length of the chord travelled by the tracking center
+ */
+static Length chord(Length arc, double dTheta, Length radiusOffset) {
+    // the robot drove straight, so the arc is the chord
+    if (std::abs(dTheta) < 1e-9) return arc;
+    return 2 * std::sin(dTheta / 2) * (arc / dTheta + radiusOffset);
+}
+
+/**
+ * @brief whether the sensors can measure the heading
+ *
+ * Without an IMU, the heading is the difference of the vertical wheels divided by the distance between them, so they
+ * must not be at the same offset
+ */
+static bool canMeasureHeading(const TrackingWheel* vertical1, const TrackingWheel* vertical2, const IMU* imu) {
+    if (vertical1 == nullptr) return false;
+    if (imu != nullptr) return true;
+    return vertical2 != nullptr && vertical1->getOffset() != vertical2->getOffset();
+}
+
+Odometry::Odometry(TrackingWheel* vertical1, TrackingWheel* vertical2, TrackingWheel* horizontal, IMU* imu,
+                   Time period)
+    : m_vertical1(vertical1),
+      m_vertical2(vertical2),
+      m_horizontal(horizontal),
+      m_imu(imu),
+      m_period(period) {}
+
+int Odometry::start(std::uint32_t priority) {
+    if (!canMeasureHeading(m_vertical1, m_vertical2, m_imu)) {
+        errno = EINVAL;
+        return INT_MAX;
+    }
+    if (m_running.exchange(true)) return 0;
+    // the first update only measures the sensors
+    m_previous.reset();
+    m_task = pros::Task(
+        [this] {
+            std::uint32_t time = pros::millis();
+            while (m_running) {
+                update();
+                pros::Task::delay_until(&time, to_msec(m_period));
+            }
+        },
+        priority, TASK_STACK_DEPTH_DEFAULT, "odometry");
+    return 0;
+}
+
+void Odometry::stop() {
+    if (!m_running.exchange(false)) return;
+    // wait for the task to finish its current update, so it can't be interrupted while using a sensor
+    m_task->join();
+    m_task.reset();
+}
+
+int Odometry::measure(Measurement& measurement) {
+    // check that there are enough sensors, in case update is called without starting the task
+    if (!canMeasureHeading(m_vertical1, m_vertical2, m_imu)) {
+        errno = EINVAL;
+        return INT_MAX;
+    }
+    measurement.vertical1 = m_vertical1->getDistance();
+    if (measurement.vertical1 == from_m(INFINITY)) return INT_MAX;
+    if (m_vertical2 != nullptr) {
+        measurement.vertical2 = m_vertical2->getDistance();
+        if (measurement.vertical2 == from_m(INFINITY)) return INT_MAX;
+    }
+    if (m_horizontal != nullptr) {
+        measurement.horizontal = m_horizontal->getDistance();
+        if (measurement.horizontal == from_m(INFINITY)) return INT_MAX;
+    }
+    if (m_imu != nullptr) {
+        measurement.heading = m_imu->getRotation();
+        if (measurement.heading == from_stRad(INFINITY)) return INT_MAX;
+    } else {
+        // a wheel to the left of the tracking center moves backwards when the robot turns counterclockwise
+        measurement.heading = from_stRad(to_num((measurement.vertical2 - measurement.vertical1) /
+                                                (m_vertical1->getOffset() - m_vertical2->getOffset())));
+    }
+    return 0;
+}
+
+int Odometry::update() {
+    const std::uint64_t start = pros::micros();
+    Measurement current;
+    if (measure(current) == INT_MAX) return INT_MAX;
+    // this is the only task that publishes the state, so the last published state is the current state
+    OdomState state = m_state.read();
+    const Time now = from_sec(start * 1E-6);
+    // apply a pose set by another task
+    const std::uint32_t poseVersion = m_requestedPose.getVersion();
+    if (poseVersion != m_appliedPoseVersion) {
+        m_appliedPoseVersion = poseVersion;
+        state.pose = m_requestedPose.read();
+        m_previous.reset();
+    }
+
+    if (!m_previous) {
+        // nothing to integrate yet, just line the measured heading up with the pose
+        m_headingOffset = state.pose.getOrientation() - current.heading;
+        state.velocity = units::VelocityPose();
+    } else {
+        const Measurement& previous = *m_previous;
+        const Angle prevTheta = previous.heading + m_headingOffset;
+        const double dTheta = to_stRad(current.heading - previous.heading);
+        // distance travelled by the tracking center, in the frame of the robot
+        Length forward = chord(current.vertical1 - previous.vertical1, dTheta, m_vertical1->getOffset());
+        if (m_vertical2 != nullptr) {
+            forward += chord(current.vertical2 - previous.vertical2, dTheta, m_vertical2->getOffset());
+            forward /= 2;
+        }
+        const Length left = m_horizontal == nullptr
+                                ? 0_in
+                                : chord(current.horizontal - previous.horizontal, dTheta,
+                                        m_horizontal->getOffset() * -1.0);
+        // the chord points along the average heading of the arc
+        const Angle avgTheta = prevTheta + from_stRad(dTheta / 2);
+        const double sin = std::sin(to_stRad(avgTheta));
+        const double cos = std::cos(to_stRad(avgTheta));
+        const Length dx = forward * cos - left * sin;
+        const Length dy = forward * sin + left * cos;
+        const Angle theta = current.heading + m_headingOffset;
+        state.pose = units::Pose(state.pose.getX() + dx, state.pose.getY() + dy, theta);
+        const Time dt = now - state.time;
+        if (dt > 0_sec) state.velocity = units::VelocityPose(dx / dt, dy / dt, from_stRad(dTheta) / dt);
+    }
+    state.time = now;
+    m_previous = current;
+    m_state.publish(state);
+    // measure how long the update took
+    const std::uint32_t latency = pros::micros() - start;
+    m_lastLatency.store(latency, std::memory_order_relaxed);
+    std::uint32_t worst = m_worstLatency.load(std::memory_order_relaxed);
+    while (latency > worst && !m_worstLatency.compare_exchange_weak(worst, latency, std::memory_order_relaxed));
+    return 0;
+}
+
+OdomState Odometry::getState() const { return m_state.read(); }
+
+units::Pose Odometry::getPose() const { return m_state.read().pose; }
+
+units::VelocityPose Odometry::getVelocity() const { return m_state.read().velocity; }
+
+void Odometry::setPose(units::Pose pose) { m_requestedPose.publish(pose); }
+
+Time Odometry::getWorstCaseLatency() const { return from_usec(m_worstLatency.load(std::memory_order_relaxed)); }
+
+Time Odometry::getLastLatency() const { return from_usec(m_lastLatency.load(std::memory_order_relaxed)); }
+
+void Odometry::resetLatency() { m_worstLatency.store(0, std::memory_order_relaxed); }
+
+Odometry::~Odometry() { stop(); }
+} // namespace lemlib
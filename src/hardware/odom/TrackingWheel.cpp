@@ -0,0 +1,26 @@
+#include "hardware/odom/TrackingWheel.hpp"
+#include <limits.h>
+
+namespace lemlib {
+TrackingWheel::TrackingWheel(Encoder* encoder, Length diameter, Length offset)
+    : m_encoder(encoder),
+      m_diameter(diameter),
+      m_offset(offset) {}
+
+Length TrackingWheel::getDistance() {
+    const Angle angle = m_encoder->getAngle();
+    // check for errors
+    if (angle == from_stRad(INFINITY)) return from_m(INFINITY);
+    return m_diameter / 2 * to_stRad(angle);
+}
+
+int TrackingWheel::reset() {
+    // check for errors
+    if (m_encoder->setAngle(0_stRad) == INT_MAX) return INT_MAX;
+    return 0;
+}
+
+Length TrackingWheel::getOffset() const { return m_offset; }
+
+Length TrackingWheel::getDiameter() const { return m_diameter; }
+} // namespace lemlib
@@ -0,0 +1,104 @@
+#include "hardware/optical/OpticalSensor.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <limits.h>
+
+namespace lemlib {
+OpticalSensor::OpticalSensor(pros::Optical sensor)
+    : m_sensor(sensor) {}
+
+int OpticalSensor::isConnected() { return m_sensor.is_installed(); }
+
+int OpticalSensor::getProximity() { return m_sensor.get_proximity(); }
+
+double OpticalSensor::getHue() { return m_sensor.get_hue(); }
+
+int OpticalSensor::setLedBrightness(Number brightness) {
+    const int pwm = std::clamp(std::lround(brightness.internal() * 100), 0L, 100L);
+    // check for errors
+    if (m_sensor.set_led_pwm(pwm) == INT_MAX) return INT_MAX;
+    return 0;
+}
+
+int OpticalSensor::addTrigger(const OpticalTrigger& trigger) {
+    // the sampler reads the triggers without synchronization, so they can't change while it runs
+    if (m_sampler) {
+        errno = EBUSY;
+        return INT_MAX;
+    }
+    if (m_triggerCount == MAX_TRIGGERS) {
+        errno = ENOMEM;
+        return INT_MAX;
+    }
+    m_triggers[m_triggerCount] = trigger;
+    return m_triggerCount++;
+}
+
+void OpticalSensor::startSampling(Time period, std::uint32_t priority) {
+    if (m_sampler) return;
+    const std::uint32_t periodMs = std::max(1L, std::lround(to_msec(period)));
+    m_sampler = std::make_unique<Sampler>();
+    m_sampler->task = pros::Task([this, periodMs] { sample(periodMs); }, priority, TASK_STACK_DEPTH_DEFAULT,
+                                 "optical sampler");
+}
+
+void OpticalSensor::sample(std::uint32_t periodMs) {
+    std::uint32_t time = pros::millis();
+    while (m_sampler->running) {
+        pros::Task::delay_until(&time, periodMs);
+        const std::int32_t proximity = m_sensor.get_proximity();
+        const double hue = m_sensor.get_hue();
+        const Time now = from_usec(pros::micros());
+        for (std::size_t i = 0; i < m_triggerCount; i++) {
+            const double value = m_triggers[i].channel == OpticalChannel::PROXIMITY ? proximity : hue;
+            // skip channels that failed
+            if (value == INT_MAX || value == INFINITY) continue;
+            check(i, value, now);
+        }
+    }
+}
+
+void OpticalSensor::check(std::size_t index, double value, Time time) {
+    const OpticalTrigger& trigger = m_triggers[index];
+    TriggerState& state = m_sampler->states[index];
+    // a hue range with low > high wraps through 0
+    const bool inside = trigger.low <= trigger.high ? value >= trigger.low && value <= trigger.high
+                                                    : value >= trigger.low || value <= trigger.high;
+    if (inside == state.inside) {
+        // the value went back before the debounce time passed
+        state.pending = false;
+        return;
+    }
+    if (!state.pending) {
+        state.pending = true;
+        state.pendingValue = value;
+        state.pendingTime = time;
+    }
+    if (time - state.pendingTime < trigger.debounce) return;
+    state.inside = inside;
+    state.pending = false;
+    m_sampler->events.push({index, inside ? OpticalEventType::ENTER : OpticalEventType::EXIT, state.pendingValue,
+                            state.pendingTime});
+}
+
+void OpticalSensor::stopSampling() {
+    if (!m_sampler) return;
+    m_sampler->running = false;
+    // wait for the sampler to finish its current sample
+    m_sampler->task->join();
+    m_sampler.reset();
+}
+
+std::size_t OpticalSensor::readEvents(std::span<OpticalEvent> out) {
+    if (!m_sampler) return 0;
+    return m_sampler->events.pop(out);
+}
+
+std::uint32_t OpticalSensor::getDroppedEvents() const {
+    if (!m_sampler) return 0;
+    return m_sampler->events.getDropped();
+}
+
+OpticalSensor::~OpticalSensor() { stopSampling(); }
+} // namespace lemlib
@@ -0,0 +1,134 @@
+#include "hardware/replay/SensorRecorder.hpp"
+#include <array>
+#include <cerrno>
+#include <cmath>
+#include <limits.h>
+
+namespace lemlib {
+SensorRecorder::SensorRecorder(const char* path)
+    : m_path(path) {}
+
+int SensorRecorder::start(std::uint32_t priority) {
+    if (m_running) return 0;
+    if (m_file == nullptr) {
+        m_error = 0;
+        m_file = std::fopen(m_path, "wb");
+        if (m_file == nullptr) return INT_MAX;
+        // use the same header as a Logger, so recordings can be read the same way
+        const std::uint32_t size = sizeof(SensorRecord);
+        const std::array<std::uint8_t, 8> header = {'L',
+                                                    'L',
+                                                    'O',
+                                                    'G',
+                                                    static_cast<std::uint8_t>(size),
+                                                    static_cast<std::uint8_t>(size >> 8),
+                                                    static_cast<std::uint8_t>(size >> 16),
+                                                    static_cast<std::uint8_t>(size >> 24)};
+        if (std::fwrite(header.data(), 1, header.size(), m_file) != header.size()) {
+            std::fclose(m_file);
+            m_file = nullptr;
+            return INT_MAX;
+        }
+    }
+    m_running = true;
+    m_task = pros::Task(
+        [this] {
+            while (m_running) {
+                // a failed write may have left part of a record in the file, so stop writing to it
+                if (flush() == INT_MAX) return;
+                pros::delay(20);
+            }
+        },
+        priority, TASK_STACK_DEPTH_DEFAULT, "sensor recorder");
+    return 0;
+}
+
+int SensorRecorder::stop() {
+    if (m_running.exchange(false)) {
+        // wait for the task to finish writing
+        m_task->join();
+        m_task.reset();
+    }
+    if (m_file == nullptr) return 0;
+    const bool flushed = flush() != INT_MAX;
+    // closing writes what is left in the buffer of the file, which can fail too
+    if (std::fclose(m_file) != 0 && flushed) m_error = errno != 0 ? errno : EIO;
+    m_file = nullptr;
+    // check for errors
+    if (const int error = m_error.load()) {
+        errno = error;
+        return INT_MAX;
+    }
+    return 0;
+}
+
+void SensorRecorder::record(std::uint32_t channel, double value, std::int32_t error) {
+    m_queue.push({pros::micros(), value, channel, error});
+}
+
+int SensorRecorder::flush() {
+    if (m_file == nullptr) return 0;
+    // check for errors
+    if (const int error = m_error.load()) {
+        errno = error;
+        return INT_MAX;
+    }
+    std::array<SensorRecord, 64> chunk;
+    int total = 0;
+    while (const std::size_t count = m_queue.pop(chunk)) {
+        if (std::fwrite(chunk.data(), sizeof(SensorRecord), count, m_file) != count) {
+            // keep the error, so the task which started the recorder can get it
+            m_error = errno != 0 ? errno : EIO;
+            return INT_MAX;
+        }
+        total += count;
+    }
+    return total;
+}
+
+int SensorRecorder::getError() const { return m_error.load(); }
+
+std::uint32_t SensorRecorder::getDropped() const { return m_queue.getDropped(); }
+
+SensorRecorder::~SensorRecorder() { stop(); }
+
+RecordingEncoder::RecordingEncoder(Encoder* encoder, SensorRecorder* recorder, std::uint32_t channel)
+    : m_encoder(encoder),
+      m_recorder(recorder),
+      m_channel(channel) {}
+
+int RecordingEncoder::isConnected() { return m_encoder->isConnected(); }
+
+Angle RecordingEncoder::getAngle() {
+    const Angle angle = m_encoder->getAngle();
+    // record errors too, so they are replayed as well
+    const int error = angle == from_stDeg(INFINITY) ? errno : 0;
+    m_recorder->record(m_channel, to_stRad(angle), error);
+    return angle;
+}
+
+int RecordingEncoder::setAngle(Angle angle) { return m_encoder->setAngle(angle); }
+
+RecordingIMU::RecordingIMU(IMU* imu, SensorRecorder* recorder, std::uint32_t channel)
+    : m_imu(imu),
+      m_recorder(recorder),
+      m_channel(channel) {}
+
+int RecordingIMU::calibrate() { return m_imu->calibrate(); }
+
+int RecordingIMU::isCalibrated() { return m_imu->isCalibrated(); }
+
+int RecordingIMU::isCalibrating() { return m_imu->isCalibrating(); }
+
+int RecordingIMU::isConnected() { return m_imu->isConnected(); }
+
+Angle RecordingIMU::getRotation() {
+    const Angle rotation = m_imu->getRotation();
+    // record errors too, so they are replayed as well
+    const int error = rotation == from_stDeg(INFINITY) ? errno : 0;
+    m_recorder->record(m_channel, to_stRad(rotation), error);
+    return rotation;
+}
+
+int RecordingIMU::setRotation(Angle rotation) { return m_imu->setRotation(rotation); }
+} // namespace lemlib
@@ -0,0 +1,117 @@
+#include "hardware/replay/SensorReplay.hpp"
+#include <array>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits.h>
+
+namespace lemlib {
+SensorReplay::SensorReplay(ReplayMode mode)
+    : m_mode(mode) {}
+
+int SensorReplay::load(const char* path) {
+    std::FILE* file = std::fopen(path, "rb");
+    if (file == nullptr) return INT_MAX;
+    // check the header, so a file with a different record layout isn't misread
+    std::array<std::uint8_t, 8> header {};
+    const bool read = std::fread(header.data(), 1, header.size(), file) == header.size();
+    const std::uint32_t size =
+        header[4] | header[5] << 8 | header[6] << 16 | static_cast<std::uint32_t>(header[7]) << 24;
+    if (!read || std::memcmp(header.data(), "LLOG", 4) != 0 || size != sizeof(SensorRecord)) {
+        std::fclose(file);
+        errno = EINVAL;
+        return INT_MAX;
+    }
+    m_records.clear();
+    SensorRecord record;
+    while (std::fread(&record, sizeof(record), 1, file) == 1) m_records.push_back(record);
+    std::fclose(file);
+    m_channels.clear();
+    for (std::size_t i = 0; i < m_records.size(); i++) m_channels[m_records[i].channel].records.push_back(i);
+    rewind();
+    return 0;
+}
+
+void SensorReplay::rewind() {
+    for (auto& [id, channel] : m_channels) channel.next = 0;
+    m_remaining = m_records.size();
+    m_time = m_records.empty() ? 0 : m_records.front().time;
+}
+
+void SensorReplay::setTime(Time time) { m_time = std::llround(to_usec(time)); }
+
+void SensorReplay::advance(Time time) { m_time += std::llround(to_usec(time)); }
+
+Time SensorReplay::getTime() const { return from_usec(m_time); }
+
+Time SensorReplay::getStartTime() const { return m_records.empty() ? 0_sec : from_usec(m_records.front().time); }
+
+Time SensorReplay::getEndTime() const { return m_records.empty() ? 0_sec : from_usec(m_records.back().time); }
+
+bool SensorReplay::isFinished() const {
+    if (m_mode == ReplayMode::SEQUENTIAL) return m_remaining == 0;
+    return m_records.empty() || m_time > m_records.back().time;
+}
+
+bool SensorReplay::hasChannel(std::uint32_t channel) const { return m_channels.contains(channel); }
+
+double SensorReplay::read(std::uint32_t id) {
+    const auto it = m_channels.find(id);
+    if (it == m_channels.end()) {
+        errno = ENODATA;
+        return INFINITY;
+    }
+    Channel& channel = it->second;
+    const SensorRecord* record = nullptr;
+    if (m_mode == ReplayMode::SEQUENTIAL) {
+        if (channel.next < channel.records.size()) {
+            record = &m_records[channel.records[channel.next++]];
+            m_remaining--;
+            m_time = record->time;
+        }
+    } else {
+        // skip to the latest record at or before the replay time
+        while (channel.next < channel.records.size() && m_records[channel.records[channel.next]].time <= m_time) {
+            channel.next++;
+        }
+        if (channel.next > 0) record = &m_records[channel.records[channel.next - 1]];
+    }
+    if (record == nullptr) {
+        errno = ENODATA;
+        return INFINITY;
+    }
+    // replay errors the same way they were recorded
+    if (record->error != 0) {
+        errno = record->error;
+        return INFINITY;
+    }
+    return record->value;
+}
+
+ReplayEncoder::ReplayEncoder(SensorReplay* replay, std::uint32_t channel)
+    : m_replay(replay),
+      m_channel(channel) {}
+
+int ReplayEncoder::isConnected() { return m_replay->hasChannel(m_channel); }
+
+Angle ReplayEncoder::getAngle() { return from_stRad(m_replay->read(m_channel)); }
+
+int ReplayEncoder::setAngle(Angle) { return 0; }
+
+ReplayIMU::ReplayIMU(SensorReplay* replay, std::uint32_t channel)
+    : m_replay(replay),
+      m_channel(channel) {}
+
+int ReplayIMU::calibrate() { return 0; }
+
+int ReplayIMU::isCalibrated() { return true; }
+
+int ReplayIMU::isCalibrating() { return false; }
+
+int ReplayIMU::isConnected() { return m_replay->hasChannel(m_channel); }
+
+Angle ReplayIMU::getRotation() { return from_stRad(m_replay->read(m_channel)); }
+
+int ReplayIMU::setRotation(Angle) { return 0; }
+} // namespace lemlib
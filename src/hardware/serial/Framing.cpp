@@ -0,0 +1,48 @@
+#include "hardware/serial/Framing.hpp"
+#include <cstdint>
+
+namespace lemlib {
+std::uint16_t crc16(std::span<const std::uint8_t> data) {
+    std::uint16_t crc = 0xFFFF;
+    for (const std::uint8_t byte : data) {
+        crc ^= static_cast<std::uint16_t>(byte) << 8;
+        for (int bit = 0; bit < 8; bit++) crc = crc & 0x8000 ? (crc << 1) ^ 0x1021 : crc << 1;
+    }
+    return crc;
+}
+
+std::size_t cobsEncode(std::span<const std::uint8_t> data, std::uint8_t* out) {
+    // each block starts with the distance to the next zero byte, which is written once the block ends
+    std::size_t codeIndex = 0;
+    std::size_t write = 1;
+    std::uint8_t code = 1;
+    for (const std::uint8_t byte : data) {
+        if (byte != 0) {
+            out[write++] = byte;
+            code++;
+        }
+        // blocks can be at most 254 bytes long, a full block isn't followed by a zero
+        if (byte == 0 || code == 0xFF) {
+            out[codeIndex] = code;
+            codeIndex = write++;
+            code = 1;
+        }
+    }
+    out[codeIndex] = code;
+    return write;
+}
+
+std::size_t cobsDecode(std::uint8_t* data, std::size_t length) {
+    std::size_t read = 0;
+    std::size_t write = 0;
+    while (read < length) {
+        // each block starts with the distance to the next zero byte
+        const std::uint8_t code = data[read++];
+        if (code == 0 || read + code - 1 > length) return SIZE_MAX;
+        for (std::uint8_t i = 1; i < code; i++) data[write++] = data[read++];
+        // blocks of 254 bytes aren't followed by a zero, and neither is the last block
+        if (code != 0xFF && read < length) data[write++] = 0;
+    }
+    return write;
+}
+} // namespace lemlib
@@ -0,0 +1,121 @@
+#include "hardware/serial/SerialPort.hpp"
+#include "hardware/serial/Framing.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits.h>
+
+namespace lemlib {
+SerialPort::SerialPort(std::uint8_t port, std::int32_t baudrate)
+    : m_serial(port, baudrate) {}
+
+void SerialPort::start(Time period, std::uint32_t priority) {
+    if (m_running.exchange(true)) return;
+    const std::uint32_t periodMs = std::max(1L, std::lround(to_msec(period)));
+    m_task = pros::Task(
+        [this, periodMs] {
+            std::uint32_t time = pros::millis();
+            while (m_running) {
+                update();
+                pros::Task::delay_until(&time, periodMs);
+            }
+        },
+        priority, TASK_STACK_DEPTH_DEFAULT, "serial port");
+}
+
+void SerialPort::stop() {
+    if (!m_running.exchange(false)) return;
+    // wait for the task to finish reading
+    m_task->join();
+    m_task.reset();
+}
+
+int SerialPort::update() {
+    while (true) {
+        // read straight into the buffer, after the incomplete frame
+        const std::int32_t result = m_serial.read(m_buffer.data() + m_length, m_buffer.size() - m_length);
+        // check for errors
+        if (result == INT_MAX) return INT_MAX;
+        if (result <= 0) return 0;
+        processBuffer(result);
+    }
+}
+
+void SerialPort::receive(std::span<const std::uint8_t> bytes) {
+    while (!bytes.empty()) {
+        const std::size_t count = std::min(bytes.size(), m_buffer.size() - m_length);
+        std::memcpy(m_buffer.data() + m_length, bytes.data(), count);
+        bytes = bytes.subspan(count);
+        processBuffer(count);
+    }
+}
+
+void SerialPort::processBuffer(std::size_t received) {
+    const std::size_t scanned = m_length;
+    m_length += received;
+    std::size_t start = 0;
+    // only the new bytes can contain a zero byte, as the incomplete frame had none
+    for (std::size_t i = scanned; i < m_length; i++) {
+        if (m_buffer[i] != 0) continue;
+        processFrame(m_buffer.data() + start, i - start);
+        start = i + 1;
+    }
+    if (start == 0 && m_length == m_buffer.size()) {
+        // the buffer is full, but there is no frame in it, so the data is garbage
+        m_framingErrors.fetch_add(1, std::memory_order_relaxed);
+        m_length = 0;
+        return;
+    }
+    // move the incomplete frame to the start of the buffer
+    std::memmove(m_buffer.data(), m_buffer.data() + start, m_length - start);
+    m_length -= start;
+}
+
+void SerialPort::processFrame(std::uint8_t* data, std::size_t length) {
+    // consecutive zero bytes can be sent to resynchronize, they aren't errors
+    if (length == 0) return;
+    if (length != FRAME_SIZE - 1 || cobsDecode(data, length) != PAYLOAD_SIZE || data[0] >= MAX_CHANNELS) {
+        m_framingErrors.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    const std::uint16_t crc = data[5] | data[6] << 8;
+    if (crc != crc16({data, 5})) {
+        m_crcErrors.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    const std::uint32_t value = data[1] | data[2] << 8 | data[3] << 16 | static_cast<std::uint32_t>(data[4]) << 24;
+    m_channels[data[0]].publish({static_cast<std::int32_t>(value), from_usec(pros::micros())});
+    m_frames.fetch_add(1, std::memory_order_relaxed);
+}
+
+std::optional<SerialChannelValue> SerialPort::getChannel(std::uint8_t channel) const {
+    if (channel >= MAX_CHANNELS) return std::nullopt;
+    // nothing has been published on this channel yet
+    if (m_channels[channel].getVersion() == 0) return std::nullopt;
+    return m_channels[channel].read();
+}
+
+std::uint32_t SerialPort::getFrameCount() const { return m_frames.load(std::memory_order_relaxed); }
+
+std::uint32_t SerialPort::getCrcErrors() const { return m_crcErrors.load(std::memory_order_relaxed); }
+
+std::uint32_t SerialPort::getFramingErrors() const { return m_framingErrors.load(std::memory_order_relaxed); }
+
+std::array<std::uint8_t, SerialPort::FRAME_SIZE> SerialPort::encodeFrame(std::uint8_t channel, std::int32_t value) {
+    const std::uint32_t bits = static_cast<std::uint32_t>(value);
+    std::array<std::uint8_t, PAYLOAD_SIZE> payload = {channel,
+                                                      static_cast<std::uint8_t>(bits),
+                                                      static_cast<std::uint8_t>(bits >> 8),
+                                                      static_cast<std::uint8_t>(bits >> 16),
+                                                      static_cast<std::uint8_t>(bits >> 24)};
+    const std::uint16_t crc = crc16(std::span(payload).first(5));
+    payload[5] = static_cast<std::uint8_t>(crc);
+    payload[6] = static_cast<std::uint8_t>(crc >> 8);
+    std::array<std::uint8_t, FRAME_SIZE> frame {};
+    cobsEncode(payload, frame.data());
+    // the last byte of the array is already the zero byte that ends the frame
+    return frame;
+}
+
+SerialPort::~SerialPort() { stop(); }
+} // namespace lemlib
@@ -0,0 +1,174 @@
+#include "hardware/telemetry/Telemetry.hpp"
+#include "hardware/serial/Framing.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <limits.h>
+
+namespace lemlib {
+/** the value sent for a signal which could not be measured */
+static constexpr std::int64_t MISSING = INT64_MIN;
+
+/**
+ * @brief write an unsigned LEB128 varint
+ *
+ * @return std::size_t the number of bytes written
+ */
+static std::size_t writeVarint(std::uint8_t* out, std::uint64_t value) {
+    std::size_t length = 0;
+    while (value >= 0x80) {
+        out[length++] = static_cast<std::uint8_t>(value) | 0x80;
+        value >>= 7;
+    }
+    out[length++] = static_cast<std::uint8_t>(value);
+    return length;
+}
+
+/**
+ * @brief zigzag encode a signed integer, so numbers close to 0 have short varints
+ */
+static std::uint64_t zigzag(std::int64_t value) {
+    return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+}
+
+/**
+ * @brief measure a signal, in multiples of its resolution
+ */
+static std::int64_t quantize(double value, double resolution) {
+    const double scaled = std::round(value / resolution);
+    // values too big to send are treated like failed measurements
+    if (!std::isfinite(scaled) || std::abs(scaled) > 0x1p62) return MISSING;
+    return static_cast<std::int64_t>(scaled);
+}
+
+Telemetry::Telemetry(std::FILE* output)
+    : m_output(output) {}
+
+int Telemetry::addSignal(const char* name, std::function<double()> source, double resolution) {
+    if (m_signalCount == MAX_SIGNALS) {
+        errno = ENOSPC;
+        return INT_MAX;
+    }
+    if (!(resolution > 0)) {
+        errno = EINVAL;
+        return INT_MAX;
+    }
+    Signal& signal = m_signals[m_signalCount];
+    signal.nameLength = std::min(std::strlen(name), MAX_NAME_LENGTH);
+    std::memcpy(signal.name.data(), name, signal.nameLength);
+    signal.source = std::move(source);
+    signal.resolution = resolution;
+    signal.previous = 0;
+    // the computer needs to know about the new signal before it can decode any more frames
+    m_schemaSent = false;
+    m_keyframeSent = false;
+    return m_signalCount++;
+}
+
+int Telemetry::sample() {
+    // send a keyframe, and the schema before it, every so often so the stream can be decoded from any point
+    if (m_framesSinceKeyframe >= KEYFRAME_INTERVAL) m_schemaSent = m_keyframeSent = false;
+    if (!m_schemaSent) {
+        if (!pushSchema()) {
+            m_droppedFrames.fetch_add(1, std::memory_order_relaxed);
+            errno = ENOBUFS;
+            return INT_MAX;
+        }
+        m_schemaSent = true;
+    }
+    const bool keyframe = !m_keyframeSent;
+    const std::uint64_t time = pros::micros();
+    std::array<std::uint8_t, MAX_FRAME_SIZE> frame;
+    std::array<std::int64_t, MAX_SIGNALS> values;
+    frame[0] = keyframe ? 0x02 : 0x03;
+    frame[1] = static_cast<std::uint8_t>(m_sequence);
+    frame[2] = static_cast<std::uint8_t>(m_sequence >> 8);
+    std::size_t length = 3;
+    length += writeVarint(frame.data() + length, keyframe ? time : time - m_previousTime);
+    for (std::size_t i = 0; i < m_signalCount; i++) {
+        const Signal& signal = m_signals[i];
+        values[i] = quantize(signal.source(), signal.resolution);
+        // the difference wraps around, so it can be undone exactly even if a value is missing
+        const std::int64_t change = static_cast<std::int64_t>(static_cast<std::uint64_t>(values[i]) -
+                                                              static_cast<std::uint64_t>(signal.previous));
+        length += writeVarint(frame.data() + length, zigzag(keyframe ? values[i] : change));
+    }
+    if (!pushFrame(frame.data(), length)) {
+        // the next frame is relative to the last frame which was sent, so nothing else needs to change
+        m_droppedFrames.fetch_add(1, std::memory_order_relaxed);
+        errno = ENOBUFS;
+        return INT_MAX;
+    }
+    for (std::size_t i = 0; i < m_signalCount; i++) m_signals[i].previous = values[i];
+    m_previousTime = time;
+    m_sequence++;
+    if (keyframe) {
+        m_keyframeSent = true;
+        m_framesSinceKeyframe = 0;
+    }
+    m_framesSinceKeyframe++;
+    return 0;
+}
+
+bool Telemetry::pushSchema() {
+    std::array<std::uint8_t, MAX_SCHEMA_SIZE> frame;
+    frame[0] = 0x01;
+    frame[1] = static_cast<std::uint8_t>(m_signalCount);
+    std::size_t length = 2;
+    for (std::size_t i = 0; i < m_signalCount; i++) {
+        const Signal& signal = m_signals[i];
+        frame[length++] = static_cast<std::uint8_t>(signal.nameLength);
+        std::memcpy(frame.data() + length, signal.name.data(), signal.nameLength);
+        length += signal.nameLength;
+        std::uint64_t bits;
+        std::memcpy(&bits, &signal.resolution, sizeof(bits));
+        for (int byte = 0; byte < 8; byte++) frame[length++] = static_cast<std::uint8_t>(bits >> (byte * 8));
+    }
+    return pushFrame(frame.data(), length);
+}
+
+bool Telemetry::pushFrame(std::uint8_t* frame, std::size_t length) {
+    const std::uint16_t crc = crc16({frame, length});
+    frame[length++] = static_cast<std::uint8_t>(crc);
+    frame[length++] = static_cast<std::uint8_t>(crc >> 8);
+    std::size_t encodedLength = cobsEncode({frame, length}, m_encoded.data());
+    m_encoded[encodedLength++] = 0;
+    // the whole frame is added at once, so the writer never sends part of a frame
+    return m_buffer.push(std::span<const std::uint8_t>(m_encoded.data(), encodedLength));
+}
+
+void Telemetry::start(std::uint32_t priority) {
+    if (m_running.exchange(true)) return;
+    m_task = pros::Task(
+        [this] {
+            while (m_running) {
+                // sleep while there is nothing to write, so the task doesn't use any time
+                if (flush() == 0) pros::delay(5);
+            }
+        },
+        priority, TASK_STACK_DEPTH_DEFAULT, "telemetry");
+}
+
+void Telemetry::stop() {
+    if (!m_running.exchange(false)) return;
+    // wait for the task to finish writing
+    m_task->join();
+    m_task.reset();
+}
+
+std::size_t Telemetry::flush() {
+    std::array<std::uint8_t, 512> chunk;
+    std::size_t total = 0;
+    while (std::size_t count = m_buffer.pop(chunk)) {
+        std::fwrite(chunk.data(), 1, count, m_output);
+        total += count;
+    }
+    if (total > 0) std::fflush(m_output);
+    return total;
+}
+
+std::uint32_t Telemetry::getDroppedFrames() const { return m_droppedFrames.load(std::memory_order_relaxed); }
+
+Telemetry::~Telemetry() { stop(); }
+} // namespace lemlib
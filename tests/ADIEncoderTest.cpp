@@ -0,0 +1,71 @@
+#include "Host.hpp"
+#include "Test.hpp"
+#include "hardware/encoder/ADIEncoder.hpp"
+#include <cerrno>
+#include <climits>
+
+// an Optical Shaft encoder turns at a constant speed, stops for 5 seconds, and turns again. The velocity has to be 0
+// while it is stopped, and the first velocity after the standstill must not be divided by the whole standstill
+
+static constexpr double RPM = 500.0 / 360 * 60; /** 1 tick every 2 milliseconds */
+
+/**
+ * @brief turn the encoder at 1 tick every 2 milliseconds for 10 milliseconds, then read the velocity
+ */
+double turn(lemlib::ADIEncoder& encoder) {
+    for (int ms = 0; ms < 10; ms += 2) {
+        host::advanceClock(2_msec);
+        host::adiEncoder('A')++;
+    }
+    return to_rpm(encoder.getVelocity());
+}
+
+/**
+ * @brief keep the encoder still for some time, reading the velocity every 10 milliseconds
+ *
+ * @return double the last velocity, in rpm
+ */
+double stop(lemlib::ADIEncoder& encoder, Time time) {
+    double velocity = INFINITY;
+    for (Time elapsed = 0_sec; elapsed < time; elapsed += 10_msec) {
+        host::advanceClock(10_msec);
+        velocity = to_rpm(encoder.getVelocity());
+    }
+    return velocity;
+}
+
+int main() {
+    host::freezeClock();
+    lemlib::ADIEncoder encoder = pros::adi::Encoder('A', 'B');
+    CHECK(encoder.getVelocity() == 0_rpm);
+    for (int i = 0; i < 10; i++) CHECK_NEAR(turn(encoder), RPM, 1e-9);
+    CHECK_NEAR(to_stDeg(encoder.getAngle()), 50, 1e-9);
+
+    // the velocity decays to 1 tick over the time since the last tick, and is 0 once the encoder is at a standstill
+    CHECK_NEAR(stop(encoder, 30_msec), 1000.0 / 30 / 360 * 60, 1e-9);
+    CHECK(stop(encoder, 5_sec) == 0);
+    // the first ticks after the standstill are measured over at most 100ms, not over 5 seconds
+    const double first = turn(encoder);
+    std::printf("first velocity after the standstill: %.2f rpm (%.2f rpm)\n", first, RPM);
+    CHECK(first >= RPM / 10 - 1e-9 && first <= RPM);
+    CHECK_NEAR(turn(encoder), RPM, 1e-9);
+
+    // the encoder turns backwards
+    for (int ms = 0; ms < 10; ms += 2) {
+        host::advanceClock(2_msec);
+        host::adiEncoder('A')--;
+    }
+    CHECK(encoder.getVelocity() < 0_rpm);
+
+    // an encoder without a positive number of ticks per rotation is rejected
+    for (const int ticks : {0, -360}) {
+        lemlib::ADIEncoder invalid(pros::adi::Encoder('C', 'D'), ticks);
+        errno = 0;
+        CHECK(invalid.getAngle() == from_stDeg(INFINITY) && errno == EINVAL);
+        errno = 0;
+        CHECK(invalid.setAngle(0_stDeg) == INT_MAX && errno == EINVAL);
+        errno = 0;
+        CHECK(invalid.getVelocity() == from_rpm(INFINITY) && errno == EINVAL);
+    }
+    return host::result();
+}
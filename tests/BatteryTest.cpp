@@ -0,0 +1,64 @@
+#include "Host.hpp"
+#include "Test.hpp"
+#include "hardware/Motors/Battery.hpp"
+#include "hardware/Motors/Motor.hpp"
+#include "hardware/Motors/MotorGroup.hpp"
+
+// a motor and a motor group compensated for an 11.5 volt battery are moved at half power, with a full battery at 12.8
+// volts and a drained one at 11 volts. The voltage the motors actually get, which is the commanded fraction of the
+// battery voltage, has to be the same. Enabling compensation samples the battery, so move() never reads it
+
+/**
+ * @brief the voltage a motor actually gets, which is the commanded fraction of the battery voltage
+ */
+double applied(std::uint8_t port) { return host::motor(port).voltage / 12000.0 * host::battery() / 1000.0; }
+
+/**
+ * @brief change the battery voltage, and wait for the filtered voltage to follow it
+ */
+void setBattery(std::int32_t millivolts) {
+    host::battery() = millivolts;
+    host::advanceClock(3_sec);
+}
+
+int main() {
+    host::freezeClock();
+    lemlib::Motor motor = pros::Motor(1);
+    lemlib::MotorGroup group({pros::Motor(2), pros::Motor(-3)}, 200_rpm);
+
+    // without compensation, the motor gets less voltage as the battery drains
+    CHECK(motor.move(0.5) == 0);
+    CHECK(host::motor(1).voltage == 6000);
+    setBattery(11000);
+    CHECK(motor.move(0.5) == 0);
+    CHECK(host::motor(1).voltage == 6000);
+    CHECK_NEAR(applied(1), 5.5, 1e-9);
+
+    // enabling compensation reads the battery right away. The first move() only uses that reading, even though the
+    // battery changed, because it doesn't read the battery itself
+    motor.setVoltageCompensation(11.5_volt);
+    group.setVoltageCompensation(11.5_volt);
+    CHECK_NEAR(to_volt(lemlib::getBatteryVoltage()), 11, 1e-9);
+    host::battery() = 12800;
+    CHECK(motor.move(0.5) == 0);
+    CHECK_NEAR(host::motor(1).voltage, 6000 * 11.5 / 11, 1);
+
+    // the same percent gives the same voltage with a full and a drained battery, up to the millivolts being rounded
+    for (const std::int32_t battery : {12800, 11000, 12800}) {
+        setBattery(battery);
+        CHECK(motor.move(0.5) == 0);
+        CHECK(group.move(0.5) == 0);
+        std::printf("%.1f V battery: %.3f V, %.3f V and %.3f V applied\n", battery / 1000.0, applied(1), applied(2),
+                    applied(3));
+        CHECK_NEAR(applied(1), 5.75, 0.002);
+        CHECK_NEAR(applied(2), 5.75, 0.002);
+        // the second motor of the group is reversed
+        CHECK_NEAR(applied(3), -5.75, 0.002);
+    }
+
+    // below the reference voltage, full power is limited to the maximum voltage of the motor
+    setBattery(11000);
+    CHECK(motor.move(1) == 0);
+    CHECK(host::motor(1).voltage == 12000);
+    return host::result();
+}
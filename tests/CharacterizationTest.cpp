@@ -0,0 +1,94 @@
+#include "SimulatedMotor.hpp"
+#include "Test.hpp"
+#include "hardware/Motors/Characterization.hpp"
+#include <atomic>
+#include <cerrno>
+#include <optional>
+
+// a simulated motor with known feedforward constants is characterized, first by calling update() directly with ideal
+// and with quantized angles, and then through characterize() with the motor plugged into a port. The fit has to
+// recover the constants of the motor
+
+static constexpr std::uint8_t PORT = 1;
+
+/**
+ * @brief check that a fit recovered the constants of a motor
+ *
+ * @param tolerance the relative error allowed for kV and kA
+ */
+void checkResult(const lemlib::CharacterizationResult& result, const host::MotorConstants& constants,
+                 double tolerance) {
+    CHECK_NEAR(to_volt(result.gains.kS), constants.kS(), 0.05);
+    CHECK_NEAR(to_volt(result.gains.kV * 1_radps), constants.kV(), constants.kV() * tolerance);
+    CHECK_NEAR(to_volt(result.gains.kA * 1_radps2), constants.kA(), constants.kA() * tolerance);
+    CHECK(result.gains.kP == 0_volt / 1_radps);
+    CHECK(to_num(result.rSquared) > 0.99);
+    std::printf("  kS %.4f V (%.4f), kV %.5f V/(rad/s) (%.5f), kA %.5f V/(rad/s^2) (%.5f), r^2 %.5f, %zu samples\n",
+                to_volt(result.gains.kS), constants.kS(), to_volt(result.gains.kV * 1_radps), constants.kV(),
+                to_volt(result.gains.kA * 1_radps2), constants.kA(), to_num(result.rSquared), result.samples);
+}
+
+/**
+ * @brief run a characterization on a simulated motor, by calling update() every 10 milliseconds
+ *
+ * @param counts the resolution of the encoder in counts per rotation, or 0 for an ideal encoder
+ */
+lemlib::CharacterizationResult run(const host::MotorConstants& constants, double counts) {
+    host::SimulatedMotor motor(constants);
+    lemlib::Characterization characterization;
+    Time time = 0_sec;
+    while (!characterization.isFinished()) {
+        Angle angle = motor.getAngle();
+        if (counts > 0) angle = from_stRot(std::floor(to_stRot(angle) * counts) / counts);
+        motor.setVoltage(characterization.update(angle, time));
+        motor.simulate(10_msec);
+        time += 10_msec;
+    }
+    return characterization.fit();
+}
+
+int main() {
+    // a small flywheel on a blue cartridge, and a heavier mechanism with more friction on a red cartridge
+    const host::MotorConstants flywheel;
+    const host::MotorConstants arm = {.backEmf = 1.1, .inertia = 0.08, .friction = 0.3, .damping = 0.01};
+
+    std::printf("flywheel, ideal encoder\n");
+    checkResult(run(flywheel, 0), flywheel, 0.03);
+    std::printf("flywheel, 300 counts per rotation\n");
+    checkResult(run(flywheel, 300), flywheel, 0.05);
+    std::printf("arm, 1800 counts per rotation\n");
+    checkResult(run(arm, 1800), arm, 0.05);
+
+    // without samples, nothing can be fit
+    lemlib::Characterization empty;
+    errno = 0;
+    const lemlib::CharacterizationResult failed = empty.fit();
+    CHECK(errno == EDOM);
+    CHECK(failed.gains.kV == from_volt(INFINITY) / 1_radps);
+    CHECK(failed.samples == 0);
+
+    // the whole characterization of a motor in a port, run by a task while the motor is simulated every millisecond
+    host::freezeClock();
+    host::SimulatedMotor simulated(flywheel);
+    simulated.setPort(PORT);
+    lemlib::Motor motor = pros::Motor(PORT, pros::v5::MotorGears::blue);
+    std::optional<lemlib::CharacterizationResult> result;
+    std::atomic<bool> finished = false;
+    pros::Task characterization([&] {
+        result = lemlib::characterize(motor);
+        finished = true;
+    });
+    for (int ms = 0; !finished && ms < 60000; ms++) {
+        simulated.simulate(1_msec);
+        host::advanceClock(1_msec);
+    }
+    CHECK(finished);
+    characterization.join();
+    host::unfreezeClock();
+    std::printf("flywheel, through lemlib::characterize()\n");
+    if (CHECK(result.has_value())) checkResult(*result, flywheel, 0.05);
+    // the motor is stopped at the end
+    CHECK(host::motor(PORT).command == host::MotorCommand::VOLTAGE);
+    CHECK(host::motor(PORT).voltage == 0);
+    return host::result();
+}
@@ -0,0 +1,122 @@
+#include "SimulatedMotor.hpp"
+#include "Test.hpp"
+#include "hardware/Motors/CurrentBudget.hpp"
+#include <array>
+#include <cerrno>
+#include <climits>
+#include <vector>
+
+// a drivetrain of 2 motors and an intake share a 6 amp budget, with the drivetrain first. The motors limit their
+// current like the firmware does. While the mechanisms cruise, they get what they want with some headroom, and a jammed
+// intake gets its maximum. When the drivetrain is pushed too, the intake gets what is left. The current limits, and so
+// the current the motors draw, must never add up to more than the budget
+
+static constexpr std::array<std::uint8_t, 3> PORTS = {1, 2, 3};
+
+static std::array<host::SimulatedMotor, 3> simulated;
+
+/**
+ * @brief the sum of the current limits of the motors, in amps
+ */
+double totalLimit() {
+    double total = 0;
+    for (const std::uint8_t port : PORTS) total += host::motor(port).currentLimit / 1000.0;
+    return total;
+}
+
+/**
+ * @brief update the budget and simulate the motors every 10 milliseconds, checking the budget is kept
+ *
+ * @return double the largest total current drawn by the motors, in amps
+ */
+double run(lemlib::CurrentBudget& budget, Time duration) {
+    double peak = 0;
+    for (Time time = 0_sec; time < duration; time += 10_msec) {
+        budget.update();
+        CHECK(totalLimit() <= to_amp(budget.getBudget()) + 0.003);
+        double total = 0;
+        for (host::SimulatedMotor& motor : simulated) {
+            motor.simulate(10_msec);
+            total += to_amp(units::abs(motor.getCurrent()));
+        }
+        peak = std::max(peak, total);
+        host::advanceClock(10_msec);
+    }
+    return peak;
+}
+
+int main() {
+    host::freezeClock();
+    for (std::size_t i = 0; i < PORTS.size(); i++) {
+        simulated[i].setPort(PORTS[i]);
+        simulated[i].setCurrentLimited(true);
+        simulated[i].setLoad(0.05);
+    }
+    lemlib::MotorGroup drive({pros::Motor(1, pros::v5::MotorGears::blue), pros::Motor(2, pros::v5::MotorGears::blue)},
+                             600_rpm);
+    lemlib::Motor intake = pros::Motor(3, pros::v5::MotorGears::blue);
+    lemlib::CurrentBudget budget(6_amp);
+    CHECK(budget.add(&drive, 1) == 0);
+    CHECK(budget.add(&intake, 0) == 1);
+    errno = 0;
+    CHECK(budget.add(&intake, 1) == INT_MAX && errno == EEXIST);
+
+    // cruising: once the drivetrain has sped up, everything gets what it wants, plus at most 0.25 amps. Before, every
+    // motor got its maximum, which adds up to 7.5 amps
+    CHECK(drive.move(0.5) == 0);
+    CHECK(intake.move(0.5) == 0);
+    double peak = run(budget, 2_sec);
+    const double cruising = to_amp(intake.getCurrent());
+    std::printf("cruising: %.2f A at most, %.2f A limit for %.2f A\n", peak, to_amp(budget.getStats(1).limit),
+                cruising);
+    CHECK(cruising > 0.1);
+    CHECK(to_amp(budget.getStats(1).limit) > cruising && to_amp(budget.getStats(1).limit) <= cruising + 0.25 + 1e-9);
+    CHECK(totalLimit() < 6);
+    // while the drivetrain sped up, it wanted its maximum, so the intake was limited for a moment
+    CHECK(budget.getStats(1).limitedUpdates > 0 && budget.getStats(1).limitedUpdates < 50);
+
+    // the intake jams, so it draws its limit and gets its maximum, which the budget still allows
+    budget.resetStats();
+    simulated[2].setJammed(true);
+    CHECK(intake.move(1) == 0);
+    peak = run(budget, 1_sec);
+    std::printf("jammed intake: %.2f A at most, %.2f A limit\n", peak, to_amp(budget.getStats(1).limit));
+    CHECK(budget.getStats(1).limit == 2.5_amp);
+    CHECK(budget.getStats(1).limitedUpdates == 0);
+    budget.resetStats();
+
+    // the drivetrain is pushed against a wall, so it wants 5 amps and the intake only gets what is left
+    simulated[0].setJammed(true);
+    simulated[1].setJammed(true);
+    CHECK(drive.move(1) == 0);
+    peak = run(budget, 1_sec);
+    const lemlib::CurrentBudgetStats driveStats = budget.getStats(0);
+    const lemlib::CurrentBudgetStats intakeStats = budget.getStats(1);
+    std::printf("pushing: %.2f A at most, drive %.2f A limit, intake %.2f A limit, %u of %u updates limited\n", peak,
+                to_amp(driveStats.limit), to_amp(intakeStats.limit), intakeStats.limitedUpdates, intakeStats.updates);
+    CHECK(peak <= 6 + 0.003);
+    CHECK(driveStats.limit == 2.5_amp && driveStats.limitedUpdates == 0);
+    CHECK(intakeStats.updates == 100);
+    CHECK_NEAR(to_amp(intakeStats.limit), 1, 1e-9);
+    // the intake wants its maximum as soon as the drivetrain does
+    CHECK(intakeStats.limitedUpdates >= 98);
+    CHECK_NEAR(to_num(intakeStats.lowestFraction), 0.4, 1e-9);
+    CHECK(intakeStats.averageFraction < 0.5_num && intakeStats.averageFraction >= intakeStats.lowestFraction);
+
+    // with a bigger budget, both get their maximum again
+    budget.setBudget(10_amp);
+    run(budget, 100_msec);
+    CHECK(budget.getStats(1).limit == 2.5_amp);
+
+    // there is no mechanism 2
+    errno = 0;
+    CHECK(budget.getStats(2).updates == 0 && errno == EINVAL);
+    // and no room for more than MAX_MECHANISMS
+    std::vector<lemlib::Motor> motors;
+    for (std::uint8_t port = 4; port <= 17; port++) motors.push_back(pros::Motor(port));
+    for (lemlib::Motor& motor : motors) CHECK(budget.add(&motor, 0) != INT_MAX);
+    lemlib::Motor extra = pros::Motor(18);
+    errno = 0;
+    CHECK(budget.add(&extra, 0) == INT_MAX && errno == ENOSPC);
+    return host::result();
+}
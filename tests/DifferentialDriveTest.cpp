@@ -0,0 +1,95 @@
+#include "SimulatedMotor.hpp"
+#include "Test.hpp"
+#include "hardware/motion/DifferentialDrive.hpp"
+#include <array>
+#include <cmath>
+
+// a tank drive with 2 simulated motors on each side, geared to 450 rpm, is asked to drive and turn faster than its
+// wheels can go. The faster side has to be capped at the speed of the drive and the slower side scaled by the same
+// factor, so the robot still follows the same arc. The velocity measured by getVelocity() has to match the motors
+
+static constexpr std::array<std::int8_t, 4> PORTS = {-1, -2, 3, 4}; /** left, then right */
+
+/**
+ * @brief the curvature of a chassis velocity, in radians per meter
+ */
+double curvature(units::VelocityPose velocity) { return to_radps(velocity.getOrientation()) / to_mps(velocity.getX()); }
+
+int main() {
+    host::freezeClock();
+    // with little friction, the motors can reach their full speed on 12 volts
+    std::array<host::SimulatedMotor, 4> simulated;
+    for (std::size_t i = 0; i < PORTS.size(); i++) {
+        simulated[i] = host::SimulatedMotor({.friction = 0.002, .damping = 0});
+        simulated[i].setPort(std::abs(PORTS[i]));
+    }
+    lemlib::MotorGroup left({pros::Motor(PORTS[0], pros::v5::MotorGears::blue),
+                             pros::Motor(PORTS[1], pros::v5::MotorGears::blue)},
+                            450_rpm);
+    lemlib::MotorGroup right({pros::Motor(PORTS[2], pros::v5::MotorGears::blue),
+                              pros::Motor(PORTS[3], pros::v5::MotorGears::blue)},
+                             450_rpm);
+    lemlib::DifferentialDrive drive(left, right, 12_in, 3.25_in);
+    const double maxSpeed = to_mps(drive.getMaxSpeed());
+    CHECK_NEAR(maxSpeed, 450.0 / 60 * M_PI * to_m(3.25_in), 1e-9);
+
+    // the kinematics are each other's inverse
+    units::VelocityPose arc(1_mps, 0_mps, 90_degps);
+    const lemlib::WheelSpeeds arcSpeeds = drive.toWheelSpeeds(arc);
+    CHECK_NEAR(to_mps(arcSpeeds.right - arcSpeeds.left), M_PI / 2 * to_m(12_in), 1e-9);
+    units::VelocityPose roundTrip = drive.toChassisVelocity(arcSpeeds);
+    CHECK_NEAR(to_mps(roundTrip.getX()), 1, 1e-9);
+    CHECK_NEAR(to_degps(roundTrip.getOrientation()), 90, 1e-9);
+
+    // 1.5 meters per second and a turn of a full rotation per second needs the right side to go 2.46 meters per
+    // second, which is faster than the drive can
+    units::VelocityPose requested(1.5_mps, 0_mps, 360_degps);
+    const lemlib::WheelSpeeds unlimited = drive.toWheelSpeeds(requested);
+    CHECK(to_mps(unlimited.right) > maxSpeed);
+    const lemlib::WheelSpeeds limited = lemlib::DifferentialDrive::desaturate(unlimited, drive.getMaxSpeed());
+    CHECK_NEAR(to_mps(limited.right), maxSpeed, 1e-9);
+    CHECK_NEAR(to_mps(limited.left) / to_mps(limited.right), to_mps(unlimited.left) / to_mps(unlimited.right), 1e-9);
+    // speeds which the drive can reach aren't changed
+    const lemlib::WheelSpeeds slow = lemlib::DifferentialDrive::desaturate(arcSpeeds, drive.getMaxSpeed());
+    CHECK(slow.left == arcSpeeds.left && slow.right == arcSpeeds.right);
+
+    // drive the robot for 2 seconds, measuring its velocity every 10 milliseconds
+    units::VelocityPose measured;
+    for (int ms = 0; ms < 2000; ms += 10) {
+        CHECK(drive.move(requested) == 0);
+        for (host::SimulatedMotor& motor : simulated) motor.simulate(10_msec);
+        host::advanceClock(10_msec);
+        measured = drive.getVelocity();
+    }
+    // the faster side is commanded at full speed, 600 rpm of the motors, and the slower side in proportion. The left
+    // motors are reversed
+    const double leftRpm = -host::motor(1).targetVelocity;
+    const double rightRpm = host::motor(3).targetVelocity;
+    std::printf("commanded %.0f rpm and %.0f rpm\n", leftRpm, rightRpm);
+    CHECK(rightRpm == 600 && host::motor(4).targetVelocity == 600);
+    CHECK_NEAR(leftRpm / rightRpm, to_mps(limited.left) / to_mps(limited.right), 0.5 / 600);
+    CHECK(host::motor(2).targetVelocity == host::motor(1).targetVelocity);
+
+    // the velocity of the wheels, from the simulated motors
+    const double wheelRadius = to_m(3.25_in) / 2 * 450 / 600;
+    const lemlib::WheelSpeeds wheels = {from_mps(-to_radps(simulated[0].getVelocity()) * wheelRadius),
+                                        from_mps(to_radps(simulated[2].getVelocity()) * wheelRadius)};
+    units::VelocityPose actual = drive.toChassisVelocity(wheels);
+    std::printf("requested %.2f m/s at %.2f rad/m, driving %.2f m/s at %.2f rad/m, measured %.2f m/s at %.2f rad/m\n",
+                to_mps(requested.getX()), curvature(requested), to_mps(actual.getX()), curvature(actual),
+                to_mps(measured.getX()), curvature(measured));
+    // the robot follows the requested arc, slower
+    CHECK(actual.getX() < requested.getX());
+    CHECK_NEAR(curvature(actual), curvature(requested), curvature(requested) * 0.01);
+    // and getVelocity() measures what the wheels do
+    CHECK_NEAR(to_mps(measured.getX()), to_mps(actual.getX()), to_mps(actual.getX()) * 0.01);
+    CHECK_NEAR(to_radps(measured.getOrientation()), to_radps(actual.getOrientation()),
+               to_radps(actual.getOrientation()) * 0.01);
+    CHECK(measured.getY() == 0_mps);
+
+    // an unplugged side can't be measured
+    host::setInstalled(3, false);
+    host::setInstalled(4, false);
+    CHECK(drive.getVelocity().getX() == from_mps(INFINITY));
+    return host::result();
+}
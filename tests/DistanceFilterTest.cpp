@@ -0,0 +1,100 @@
+#include "Host.hpp"
+#include "Test.hpp"
+#include "hardware/distance/DistanceFilter.hpp"
+#include "hardware/distance/V5Distance.hpp"
+#include <cerrno>
+
+// V5 Distance sensors are filtered while the robot sits still in front of a wall, which makes the sensors report the
+// same reading over and over, and while the sensors lose the wall or are unplugged
+
+int main() {
+    host::DistanceSensor& frontSensor = host::distance(1);
+    host::DistanceSensor& backSensor = host::distance(2);
+    lemlib::V5Distance front = pros::Distance(1);
+    lemlib::V5Distance back = pros::Distance(2);
+
+    // the distance is read once for each reading, and the confidence belongs to it
+    frontSensor.distance = 1000;
+    frontSensor.confidence = 63;
+    lemlib::DistanceReading reading = front.getReading();
+    CHECK(frontSensor.distanceReads == 1);
+    CHECK_NEAR(to_mm(reading.distance), 1000, 1e-9);
+    CHECK_NEAR(reading.confidence.internal(), 1, 1e-9);
+    frontSensor.distance = 150;
+    frontSensor.confidence = 0;
+    CHECK_NEAR(front.getReading().confidence.internal(), 1, 1e-9);
+    frontSensor.distance = 9999;
+    CHECK_NEAR(front.getReading().confidence.internal(), 0, 1e-9);
+    host::setInstalled(1, false);
+    errno = 0;
+    reading = front.getReading();
+    CHECK(reading.distance == from_mm(INFINITY) && reading.confidence == Number(INFINITY));
+    CHECK(errno == ENODEV);
+    host::setInstalled(1, true);
+    CHECK(frontSensor.distanceReads == 3);
+
+    host::freezeClock();
+    lemlib::DistanceFilter<2> filter({&front, &back}, Number(0.25), 500_msec);
+    const auto update = [&](int steps) {
+        int result = 0;
+        for (int step = 0; step < steps; step++) {
+            if (filter.update() != 0) result = INT_MAX;
+            host::advanceClock(10_msec);
+        }
+        return result;
+    };
+
+    // sitting still for 3 seconds, the result stays valid even though the readings never change
+    frontSensor.distance = 812;
+    frontSensor.confidence = 50;
+    backSensor.distance = 430;
+    backSensor.confidence = 63;
+    frontSensor.distanceReads = 0;
+    for (int step = 0; step < 300; step++) {
+        CHECK(filter.update() == 0);
+        CHECK(filter.get(0).valid && filter.get(1).valid);
+        host::advanceClock(10_msec);
+    }
+    CHECK(frontSensor.distanceReads == 300);
+    CHECK_NEAR(to_mm(filter.get(0).distance), 812, 1e-9);
+    CHECK_NEAR(filter.get(0).confidence.internal(), 50 / 63.0, 1e-9);
+    CHECK_NEAR(to_mm(filter.get(1).distance), 430, 1e-9);
+
+    // the back sensor loses the wall for longer than the timeout
+    backSensor.distance = 9999;
+    backSensor.confidence = 0;
+    CHECK(update(49) == 0);
+    CHECK(filter.get(1).valid);
+    CHECK(update(2) == 0);
+    CHECK(!filter.get(1).valid);
+    CHECK(filter.get(0).valid);
+    // it sees the same wall as before, which is a new reading
+    backSensor.distance = 430;
+    backSensor.confidence = 63;
+    CHECK(update(1) == 0);
+    CHECK(filter.get(1).valid);
+    CHECK_NEAR(to_mm(filter.get(1).distance), 430, 1e-9);
+
+    // the front sensor is unplugged for longer than the timeout, then plugged back in
+    host::setInstalled(1, false);
+    CHECK(update(60) == INT_MAX);
+    CHECK(!filter.get(0).valid);
+    CHECK(filter.get(1).valid);
+    host::setInstalled(1, true);
+    CHECK(update(1) == 0);
+    CHECK(filter.get(0).valid);
+    CHECK_NEAR(to_mm(filter.get(0).distance), 812, 1e-9);
+
+    // an unconfident reading is ignored, and the median of the window rejects a single bad reading
+    for (const int distance : {800, 805, 2000, 810}) {
+        frontSensor.distance = distance;
+        frontSensor.confidence = distance == 2000 ? 40 : 55;
+        CHECK(update(3) == 0);
+    }
+    frontSensor.distance = 3000;
+    frontSensor.confidence = 10;
+    CHECK(update(3) == 0);
+    CHECK_NEAR(to_mm(filter.get(0).distance), 810, 1e-9);
+    host::unfreezeClock();
+    return host::result();
+}
@@ -0,0 +1,109 @@
+#include "Host.hpp"
+#include "Test.hpp"
+#include "hardware/math/FixedPoint.hpp"
+#include "hardware/replay/SensorRecorder.hpp"
+#include "hardware/replay/SensorReplay.hpp"
+#include <cerrno>
+#include <string>
+#include <vector>
+
+// a simulated drivetrain is run with fixed point math, and its encoders are recorded. Running the same math on the
+// replayed recording has to give bit-identical results at every step
+
+using namespace lemlib;
+
+static_assert(FixedAngle::fromTicks(360, 360).raw() == 36000);
+static_assert(FixedAngle::fromTicks(-7, 1800).raw() == -140);
+static_assert(FixedAngle::fromTicks(1, 7).raw() == 5143);
+static_assert(FixedAngle::fromTicks(-1, 7).raw() == -5143);
+static_assert((FixedAngle::max() + FixedAngle::fromRaw(1)) == FixedAngle::max());
+static_assert((-FixedAngle::min()) == FixedAngle::max());
+static_assert(FixedAngle::fromRaw(100).scale(3, 7).raw() == 43);
+static_assert(FixedAngle::fromRaw(-100).scale(3, 7).raw() == -43);
+
+/**
+ * @brief a 360 tick optical shaft encoder on a wheel, which turns with the simulated robot
+ */
+class SimulatedEncoder : public lemlib::Encoder {
+    public:
+        int isConnected() override { return 1; }
+
+        Angle getAngle() override { return FixedAngle::fromTicks(m_ticks, 360).toQuantity(); }
+
+        int setAngle(Angle angle) override { return 0; }
+
+        void simulate(Angle angle) { m_ticks = std::floor(to_stRot(angle) * 360); }
+    private:
+        std::int64_t m_ticks = 0;
+};
+
+/**
+ * @brief fixed point dead reckoning of the wheel travel and heading, which stores the raw values of every step
+ */
+struct FixedDrive {
+        FixedAngle previousLeft;
+        FixedAngle previousRight;
+        FixedAngle left;
+        FixedAngle right;
+        FixedAngle heading;
+        std::vector<std::int32_t> steps;
+
+        void update(Angle leftAngle, Angle rightAngle) {
+            const FixedAngle leftReading(leftAngle);
+            const FixedAngle rightReading(rightAngle);
+            left += leftReading - previousLeft;
+            right += rightReading - previousRight;
+            previousLeft = leftReading;
+            previousRight = rightReading;
+            // 3.25 inch wheels, 12.5 inch track width
+            heading = (right - left).scale(325, 2 * 1250);
+            steps.insert(steps.end(), {left.raw(), right.raw(), heading.raw()});
+        }
+};
+
+int main(int argc, char** argv) {
+    const std::string path = std::string(argv[0]) + ".bin";
+
+    // the ticks per rotation must be positive
+    errno = 0;
+    CHECK(FixedAngle::fromTicks(5, 0) == FixedAngle::max());
+    CHECK(errno == EDOM);
+    CHECK(FixedAngle::fromTicks(-5, -360) == FixedAngle::min());
+    CHECK(FixedAngle::fromTicks(0, 0) == FixedAngle());
+
+    // simulate 10 seconds of driving in a curve, with the encoders read every 10 milliseconds
+    host::freezeClock();
+    SimulatedEncoder leftEncoder;
+    SimulatedEncoder rightEncoder;
+    lemlib::SensorRecorder recorder(path.c_str());
+    lemlib::RecordingEncoder recordedLeft(&leftEncoder, &recorder, 0);
+    lemlib::RecordingEncoder recordedRight(&rightEncoder, &recorder, 1);
+    CHECK(recorder.start() == 0);
+    FixedDrive simulated;
+    for (int step = 0; step < 1000; step++) {
+        const double t = step * 0.01;
+        leftEncoder.simulate(from_stRot(1.7 * t + 0.3 * std::sin(t)));
+        rightEncoder.simulate(from_stRot(2.1 * t - 0.2 * std::sin(1.3 * t)));
+        simulated.update(recordedLeft.getAngle(), recordedRight.getAngle());
+        host::advanceClock(10_msec);
+    }
+    CHECK(recorder.stop() == 0);
+    CHECK(recorder.getDropped() == 0);
+
+    // summing the fixed point steps is exact
+    CHECK(simulated.left == FixedAngle(leftEncoder.getAngle()));
+    CHECK(simulated.right == FixedAngle(rightEncoder.getAngle()));
+
+    lemlib::SensorReplay replay;
+    CHECK(replay.load(path.c_str()) == 0);
+    lemlib::ReplayEncoder replayedLeft(&replay, 0);
+    lemlib::ReplayEncoder replayedRight(&replay, 1);
+    FixedDrive replayed;
+    for (int step = 0; step < 1000; step++) replayed.update(replayedLeft.getAngle(), replayedRight.getAngle());
+    CHECK(replay.isFinished());
+    CHECK(replayed.steps == simulated.steps);
+    std::printf("%zu raw values compared, final heading %d centidegrees\n", replayed.steps.size(),
+                replayed.heading.raw());
+    std::remove(path.c_str());
+    return host::result();
+}
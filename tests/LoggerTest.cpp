@@ -0,0 +1,131 @@
+#include "Host.hpp"
+#include "Test.hpp"
+#include "hardware/logging/Logger.hpp"
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// records are logged to a regular file, both by calling flush() directly and with the task writing the buffers. Both
+// buffers are filled so records get dropped, and the file has to hold exactly the records which weren't dropped
+
+struct Record {
+        std::uint32_t index;
+        float value;
+};
+
+/**
+ * @brief read a log file, checking its header
+ */
+std::vector<Record> load(const std::string& path) {
+    std::vector<Record> records;
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    CHECK(file != nullptr);
+    if (file == nullptr) return records;
+    std::uint8_t header[8];
+    CHECK(std::fread(header, 1, 8, file) == 8);
+    CHECK(std::memcmp(header, "LLOG", 4) == 0);
+    CHECK(header[4] == sizeof(Record) && header[5] == 0 && header[6] == 0 && header[7] == 0);
+    Record record;
+    while (std::fread(&record, sizeof(Record), 1, file) == 1) records.push_back(record);
+    std::fclose(file);
+    return records;
+}
+
+/**
+ * @brief check that a log file holds exactly the expected records, in order
+ */
+void checkFile(const std::string& path, const std::vector<std::uint32_t>& expected) {
+    const std::vector<Record> records = load(path);
+    CHECK(records.size() == expected.size());
+    for (std::size_t i = 0; i < std::min(records.size(), expected.size()); i++) {
+        CHECK(records[i].index == expected[i]);
+        CHECK(records[i].value == expected[i] * 0.5f);
+    }
+}
+
+int main(int argc, char** argv) {
+    const std::string path = std::string(argv[0]) + ".bin";
+
+    // files which can't be opened
+    lemlib::Logger<Record> missing("/nonexistent/directory/log.bin");
+    errno = 0;
+    CHECK(missing.open() == INT_MAX);
+    CHECK(errno == ENOENT);
+    CHECK(missing.start() == INT_MAX);
+
+    // without the task, with buffers of 4 records
+    host::freezeClock();
+    {
+        lemlib::Logger<Record, 4> logger(path.c_str(), 50_msec);
+        CHECK(logger.open() == 0);
+        std::vector<std::uint32_t> expected;
+        std::uint32_t dropped = 0;
+        const auto append = [&](std::uint32_t index) {
+            if (logger.append({index, index * 0.5f})) expected.push_back(index);
+            else dropped++;
+        };
+        // the first buffer fills, then the second one, then records are dropped
+        for (std::uint32_t index = 0; index < 12; index++) append(index);
+        CHECK(dropped == 4);
+        CHECK(logger.getDropped() == 4);
+        CHECK(logger.getWritten() == 0);
+        // writing the first buffer lets the second one be handed over once it is full
+        CHECK(logger.flush() == 4);
+        CHECK(logger.flush() == 0);
+        for (std::uint32_t index = 12; index < 14; index++) append(index);
+        CHECK(logger.flush() == 4);
+        CHECK(logger.getWritten() == 8);
+        // a buffer which held records for longer than the flush period is handed over with the next record
+        host::advanceClock(60_msec);
+        append(14);
+        CHECK(logger.flush() == 2);
+        append(15);
+        CHECK(logger.stop() == 0);
+        CHECK(logger.getWritten() == 12);
+        CHECK(logger.getDropped() == 4);
+        CHECK(dropped == 4);
+        checkFile(path, expected);
+    }
+
+    // with the task, which writes a buffer every 10 milliseconds
+    {
+        lemlib::Logger<Record, 64> logger(path.c_str(), 1_sec);
+        CHECK(logger.start() == 0);
+        std::vector<std::uint32_t> expected;
+        std::uint32_t dropped = 0;
+        std::uint32_t index = 0;
+        const auto append = [&] {
+            if (logger.append({index, index * 0.5f})) expected.push_back(index);
+            else dropped++;
+            index++;
+        };
+        // a record every millisecond for 2 seconds fits easily
+        for (int ms = 0; ms < 2000; ms++) {
+            append();
+            host::advanceClock(1_msec);
+        }
+        CHECK(dropped == 0);
+        // a burst of 300 records between task runs fills both buffers
+        for (int i = 0; i < 300; i++) append();
+        CHECK(dropped > 0);
+        CHECK(dropped < 300 - 64);
+        const std::uint32_t burstDropped = dropped;
+        host::advanceClock(20_msec);
+        // and the logger recovers once the task wrote them
+        for (int ms = 0; ms < 500; ms++) {
+            append();
+            host::advanceClock(1_msec);
+        }
+        CHECK(logger.stop() == 0);
+        CHECK(dropped == burstDropped);
+        CHECK(logger.getDropped() == dropped);
+        CHECK(logger.getWritten() == expected.size());
+        CHECK(expected.size() + dropped == index);
+        checkFile(path, expected);
+        std::printf("%u records appended, %u dropped in a burst, %zu written\n", index, dropped, expected.size());
+    }
+    host::unfreezeClock();
+    std::remove(path.c_str());
+    return host::result();
+}
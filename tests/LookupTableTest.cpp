@@ -0,0 +1,64 @@
+#include "Test.hpp"
+#include "hardware/math/LookupTable.hpp"
+#include <cmath>
+
+// tables with evenly and unevenly spaced inputs are looked up with linear and cubic interpolation. Lookups have to hit
+// every entry exactly, clamp outside of the table, and the cubic curve must not overshoot the data
+
+// the example from the documentation, which is built at compile time
+constexpr lemlib::LookupTable<Length, AngularVelocity, 4> flywheelSpeed(
+    {1_ft, 3_ft, 6_ft, 10_ft}, {2000_rpm, 2400_rpm, 2900_rpm, 3300_rpm}, lemlib::Interpolation::CUBIC);
+constexpr auto torqueCurve =
+    lemlib::LookupTable<AngularVelocity, Torque, 5>::uniform(0_rpm, 200_rpm, {2.1_Nm, 1.6_Nm, 1.05_Nm, 0.5_Nm, 0_Nm});
+
+static_assert(!flywheelSpeed.isUniform());
+static_assert(torqueCurve.isUniform());
+static_assert(torqueCurve(100_rpm) == 1.05_Nm);
+
+int main() {
+    // every entry is hit exactly, and inputs outside of the table are clamped
+    const Length distances[] = {1_ft, 3_ft, 6_ft, 10_ft};
+    const double speeds[] = {2000, 2400, 2900, 3300};
+    for (int i = 0; i < 4; i++) CHECK_NEAR(to_rpm(flywheelSpeed(distances[i])), speeds[i], 1e-9);
+    CHECK_NEAR(to_rpm(flywheelSpeed(0_ft)), 2000, 1e-9);
+    CHECK_NEAR(to_rpm(flywheelSpeed(20_ft)), 3300, 1e-9);
+    CHECK_NEAR(to_Nm(torqueCurve(from_rpm(-50))), 2.1, 1e-9);
+    CHECK_NEAR(to_Nm(torqueCurve(300_rpm)), 0, 1e-9);
+    CHECK(flywheelSpeed.getMinInput() == 1_ft && flywheelSpeed.getMaxInput() == 10_ft);
+
+    // linear interpolation is a straight line between the entries
+    CHECK_NEAR(to_Nm(torqueCurve(25_rpm)), 1.85, 1e-9);
+    CHECK_NEAR(to_Nm(torqueCurve(175_rpm)), 0.25, 1e-9);
+
+    // the same table with unevenly spaced inputs is found by a binary search, and gives the same results
+    const lemlib::LookupTable<AngularVelocity, Torque, 5> searched({0_rpm, 50_rpm, 100_rpm, 150_rpm, 300_rpm},
+                                                                   {2.1_Nm, 1.6_Nm, 1.05_Nm, 0.5_Nm, 0_Nm});
+    CHECK(!searched.isUniform());
+    for (double rpm = 0; rpm < 150; rpm += 0.5) {
+        CHECK_NEAR(to_Nm(searched(from_rpm(rpm))), to_Nm(torqueCurve(from_rpm(rpm))), 1e-12);
+    }
+    CHECK_NEAR(to_Nm(searched(225_rpm)), 0.25, 1e-9);
+
+    // the cubic curve stays between neighbouring entries, so it doesn't overshoot, and it is smooth
+    double previous = to_rpm(flywheelSpeed(1_ft));
+    double previousSlope = 0;
+    double largestKink = 0;
+    for (double feet = 1.01; feet <= 10; feet += 0.01) {
+        const double speed = to_rpm(flywheelSpeed(from_ft(feet)));
+        CHECK(speed >= previous - 1e-9);
+        CHECK(speed >= 2000 && speed <= 3300);
+        const double slope = (speed - previous) / 0.01;
+        if (feet > 1.02) largestKink = std::max(largestKink, std::abs(slope - previousSlope));
+        previous = speed;
+        previousSlope = slope;
+    }
+    // the slope never jumps, even across the entries
+    CHECK(largestKink < 5);
+
+    // a flat stretch in the data stays flat, where the monotone curve has a slope of 0 at the local extremes
+    const lemlib::LookupTable<Time, Voltage, 4> plateau({0_sec, 1_sec, 2_sec, 3_sec}, {0_volt, 6_volt, 6_volt, 0_volt},
+                                                        lemlib::Interpolation::CUBIC);
+    for (double t = 1; t <= 2; t += 0.1) CHECK_NEAR(to_volt(plateau(from_sec(t))), 6, 1e-9);
+    for (double t = 0; t <= 3; t += 0.01) CHECK(to_volt(plateau(from_sec(t))) <= 6 + 1e-9);
+    return host::result();
+}
@@ -0,0 +1,100 @@
+#include "Test.hpp"
+#include "hardware/motion/MotionProfile.hpp"
+#include <cerrno>
+#include <cmath>
+
+// trapezoidal and S-curve profiles of a lift are sampled every 0.1 milliseconds, for moves long enough to cruise, and
+// moves too short to reach the maximum velocity or acceleration. Every profile has to start and end at rest at its
+// endpoints, stay within its constraints, and change its position and velocity continuously, and with a finite jerk,
+// its acceleration too
+
+static constexpr double DT = 1e-4; /** seconds between samples */
+
+/**
+ * @brief sample a profile from before it starts to after it ends, and check it
+ *
+ * @return double the largest velocity, in rotations per second
+ */
+double checkProfile(const lemlib::AngularProfile& profile, lemlib::ProfileConstraints<Angle> constraints) {
+    const double velocity = to_rps(constraints.maxVelocity);
+    const double acceleration = to_rps2(constraints.maxAcceleration);
+    const double jerk = to_rps3(constraints.maxJerk);
+    const double duration = to_sec(profile.getDuration());
+    const double direction = profile.getGoal() < profile.getStart() ? -1 : 1;
+    lemlib::ProfileState<Angle> previous = profile.sample(from_sec(-DT));
+    CHECK(previous.position == profile.getStart() && previous.velocity == 0_rps && previous.acceleration == 0_rps2);
+    double largest = 0;
+    for (double t = 0; t < duration + 10 * DT; t += DT) {
+        const lemlib::ProfileState<Angle> state = profile.sample(from_sec(t));
+        const double v = to_rps(state.velocity);
+        const double a = to_rps2(state.acceleration);
+        largest = std::max(largest, std::abs(v));
+        CHECK(std::abs(v) <= velocity * (1 + 1e-9));
+        CHECK(std::abs(a) <= acceleration * (1 + 1e-9));
+        // the profile never moves backwards
+        CHECK(v * direction >= 0);
+        CHECK(to_stRot(state.position - previous.position) * direction >= -1e-12);
+        // and nothing jumps between samples, up to the rounding of the phases
+        CHECK(std::abs(to_stRot(state.position - previous.position)) <= velocity * DT * (1 + 1e-6));
+        CHECK(std::abs(v - to_rps(previous.velocity)) <= acceleration * DT * (1 + 1e-6));
+        if (std::isfinite(jerk)) CHECK(std::abs(a - to_rps2(previous.acceleration)) <= jerk * DT * (1 + 1e-6));
+        previous = state;
+    }
+    CHECK(previous.position == profile.getGoal() && previous.velocity == 0_rps && previous.acceleration == 0_rps2);
+    return largest;
+}
+
+int main() {
+    // a trapezoid: a quarter second to reach 1 rotation per second, which covers 0.125 rotations, then cruising
+    const lemlib::ProfileConstraints<Angle> trapezoid = {1_rps, 4_rps2};
+    const lemlib::AngularProfile cruising(0_stRot, 2_stRot, trapezoid);
+    CHECK_NEAR(to_sec(cruising.getDuration()), 0.25 + 1.75 + 0.25, 1e-9);
+    CHECK(cruising.getPeakVelocity() == 1_rps);
+    CHECK_NEAR(to_stRot(cruising.sample(0.25_sec).position), 0.125, 1e-9);
+    CHECK_NEAR(to_rps2(cruising.sample(0.1_sec).acceleration), 4, 1e-9);
+    CHECK_NEAR(to_rps2(cruising.sample(2.2_sec).acceleration), -4, 1e-9);
+    CHECK_NEAR(checkProfile(cruising, trapezoid), 1, 1e-9);
+
+    // too short to reach the maximum velocity, so it peaks at sqrt(acceleration * distance)
+    const lemlib::AngularProfile shortTrapezoid(1_stRot, 1.1_stRot, trapezoid);
+    CHECK_NEAR(to_rps(shortTrapezoid.getPeakVelocity()), std::sqrt(4 * 0.1), 1e-9);
+    CHECK_NEAR(to_sec(shortTrapezoid.getDuration()), 2 * std::sqrt(0.1 / 4), 1e-9);
+    checkProfile(shortTrapezoid, trapezoid);
+
+    // an S-curve takes a quarter second to ramp up to the maximum acceleration, so reaching the maximum velocity takes
+    // half a second instead of a quarter, and covers 0.25 rotations
+    const lemlib::ProfileConstraints<Angle> sCurve = {1_rps, 4_rps2, 16_rps3};
+    const lemlib::AngularProfile smooth(0_stRot, 2_stRot, sCurve);
+    CHECK_NEAR(to_sec(smooth.getDuration()), 0.5 + 1.5 + 0.5, 1e-9);
+    CHECK_NEAR(to_stRot(smooth.sample(0.5_sec).position), 0.25, 1e-9);
+    CHECK_NEAR(to_rps2(smooth.sample(0.25_sec).acceleration), 4, 1e-9);
+    CHECK_NEAR(checkProfile(smooth, sCurve), 1, 1e-9);
+
+    // too short to reach the maximum velocity, but long enough to reach the maximum acceleration
+    const lemlib::AngularProfile shortSmooth(0_stRot, 0.9_stRot, {2_rps, 4_rps2, 16_rps3});
+    CHECK(shortSmooth.getPeakVelocity() < 2_rps && shortSmooth.getPeakVelocity() > 1_rps);
+    CHECK_NEAR(to_rps2(shortSmooth.sample(shortSmooth.getDuration() / 4).acceleration), 4, 1e-9);
+    checkProfile(shortSmooth, {2_rps, 4_rps2, 16_rps3});
+
+    // too short to reach either, so the acceleration only ramps up and down, and peaks below the maximum
+    const lemlib::AngularProfile tiny(0_stRot, from_stRot(-0.02), sCurve);
+    CHECK(tiny.getPeakVelocity() > from_rps(-1) && tiny.getPeakVelocity() < 0_rps);
+    const double peakAcceleration = to_rps2(tiny.sample(tiny.getDuration() / 4).acceleration);
+    CHECK(peakAcceleration < 0 && peakAcceleration > -4);
+    // the peak velocity is reached halfway, and covers half the distance
+    CHECK_NEAR(to_stRot(tiny.sample(tiny.getDuration() / 2).position), -0.01, 1e-9);
+    CHECK_NEAR(to_rps(tiny.sample(tiny.getDuration() / 2).velocity), to_rps(tiny.getPeakVelocity()), 1e-9);
+    checkProfile(tiny, sCurve);
+
+    // a profile to where it starts takes no time
+    const lemlib::AngularProfile still(1_stRot, 1_stRot, sCurve);
+    CHECK(still.getDuration() == 0_sec);
+    CHECK(still.sample(1_sec).position == 1_stRot);
+
+    // constraints which aren't positive stay at the start
+    errno = 0;
+    const lemlib::AngularProfile invalid(0_stRot, 1_stRot, {0_rps, 4_rps2});
+    CHECK(errno == EINVAL);
+    CHECK(invalid.getDuration() == 0_sec && invalid.getGoal() == 0_stRot);
+    return host::result();
+}
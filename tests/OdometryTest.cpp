@@ -0,0 +1,155 @@
+#include "Host.hpp"
+#include "Test.hpp"
+#include "hardware/odom/Odometry.hpp"
+#include <cerrno>
+#include <climits>
+#include <cmath>
+
+// a robot drives a 20 second path which speeds up, slows down, strafes and turns both ways. The sensors are simulated
+// with the resolution of a V5 rotation sensor, and the error of the odometry is accumulated along the whole path
+
+/**
+ * @brief an encoder with the resolution of a V5 rotation sensor, 36000 ticks per rotation
+ */
+class SimulatedEncoder : public lemlib::Encoder {
+    public:
+        int isConnected() override { return 1; }
+
+        Angle getAngle() override { return from_stRot(std::floor(m_rotations * 36000) / 36000); }
+
+        int setAngle(Angle angle) override {
+            m_rotations = to_stRot(angle);
+            return 0;
+        }
+
+        void move(Angle angle) { m_rotations += to_stRot(angle); }
+    private:
+        double m_rotations = 0;
+};
+
+/**
+ * @brief an IMU with the resolution of the V5 inertial sensor, 0.01 degrees
+ */
+class SimulatedIMU : public lemlib::IMU {
+    public:
+        int calibrate() override { return 0; }
+
+        int isCalibrated() override { return 1; }
+
+        int isCalibrating() override { return 0; }
+
+        int isConnected() override { return 1; }
+
+        Angle getRotation() override { return from_stDeg(std::round(to_stDeg(m_rotation) * 100) / 100); }
+
+        int setRotation(Angle rotation) override {
+            m_rotation = rotation;
+            return 0;
+        }
+
+        void move(Angle angle) { m_rotation += angle; }
+    private:
+        Angle m_rotation = 1_stRad;
+};
+
+struct Error {
+        double position; /** the largest distance between the estimated and true position, in meters */
+        double heading; /** the largest difference between the estimated and true heading, in radians */
+        double speed; /** the largest error of the estimated speed, in meters per second */
+};
+
+/**
+ * @brief drive the path, and get the largest error of the odometry along it
+ *
+ * @param useTask whether the odometry task updates the odometry, instead of calling update()
+ */
+Error drive(bool twoVerticals, bool imu, bool useTask) {
+    const double diameter = 0.07; // 2.75 inch wheels
+    const double left = 0.1; // offset of the first vertical wheel
+    const double right = -0.12; // offset of the second vertical wheel
+    const double back = -0.05; // offset of the horizontal wheel
+    SimulatedEncoder encoder1;
+    SimulatedEncoder encoder2;
+    SimulatedEncoder horizontalEncoder;
+    SimulatedIMU simulatedIMU;
+    lemlib::TrackingWheel vertical1(&encoder1, from_m(diameter), from_m(left));
+    lemlib::TrackingWheel vertical2(&encoder2, from_m(diameter), from_m(right));
+    lemlib::TrackingWheel horizontal(&horizontalEncoder, from_m(diameter), from_m(back));
+    lemlib::Odometry odom(&vertical1, twoVerticals ? &vertical2 : nullptr, &horizontal, imu ? &simulatedIMU : nullptr);
+    odom.setPose(units::Pose(1_m, 2_m, 0.5_stRad));
+    double x = 1;
+    double y = 2;
+    double theta = 0.5;
+    host::freezeClock();
+    if (useTask) CHECK(odom.start() == 0);
+    else CHECK(odom.update() == 0);
+    Error error = {0, 0, 0};
+    for (int step = 0; step < 2000; step++) {
+        const double t = step * 0.01;
+        // forward, left, and counterclockwise velocity of the robot
+        const double forward = 1.0 + 0.5 * std::sin(t);
+        const double strafe = 0.3 * std::cos(0.7 * t);
+        const double turn = 0.8 * std::sin(0.3 * t) + 0.2;
+        // integrate the true motion much more finely than the odometry updates
+        for (int substep = 0; substep < 100; substep++) {
+            const double dt = 0.01 / 100;
+            x += (forward * std::cos(theta) - strafe * std::sin(theta)) * dt;
+            y += (forward * std::sin(theta) + strafe * std::cos(theta)) * dt;
+            theta += turn * dt;
+            encoder1.move(from_stRad((forward - left * turn) * dt / (diameter / 2)));
+            encoder2.move(from_stRad((forward - right * turn) * dt / (diameter / 2)));
+            horizontalEncoder.move(from_stRad((strafe + back * turn) * dt / (diameter / 2)));
+            simulatedIMU.move(from_stRad(turn * dt));
+        }
+        host::advanceClock(10_msec);
+        if (!useTask) CHECK(odom.update() == 0);
+        units::Pose pose = odom.getPose();
+        error.position = std::max(error.position, std::hypot(to_m(pose.getX()) - x, to_m(pose.getY()) - y));
+        error.heading = std::max(error.heading, std::abs(to_stRad(pose.getOrientation()) - theta));
+        // the velocity is averaged over the last update, so it lags by half an update
+        if (step > 0) {
+            units::VelocityPose velocity = odom.getVelocity();
+            const double speed = std::hypot(velocity.getX().internal(), velocity.getY().internal());
+            const double previous = std::hypot(1.0 + 0.5 * std::sin(t - 0.005), 0.3 * std::cos(0.7 * (t - 0.005)));
+            error.speed = std::max(error.speed, std::abs(speed - previous));
+        }
+    }
+    if (useTask) odom.stop();
+    host::unfreezeClock();
+    return error;
+}
+
+int main() {
+    struct Config {
+            const char* name;
+            bool twoVerticals;
+            bool imu;
+            bool useTask;
+    };
+
+    for (const Config& config : {Config {"2 verticals, horizontal", true, false, false},
+                                 Config {"1 vertical, horizontal, IMU", false, true, false},
+                                 Config {"2 verticals, horizontal, IMU", true, true, false},
+                                 Config {"2 verticals, horizontal, IMU, task", true, true, true}}) {
+        const Error error = drive(config.twoVerticals, config.imu, config.useTask);
+        std::printf("%-36s largest error: position %.2f mm, heading %.3f deg, speed %.1f mm/s\n", config.name,
+                    error.position * 1000, error.heading * 180 / M_PI, error.speed * 1000);
+        CHECK(error.position < 0.003);
+        CHECK(error.heading < 0.05 * M_PI / 180);
+        CHECK(error.speed < 0.01);
+    }
+
+    // two vertical wheels at the same offset can't measure the heading, even when update() is called directly
+    SimulatedEncoder encoder1;
+    SimulatedEncoder encoder2;
+    lemlib::TrackingWheel vertical1(&encoder1, 2.75_in, 0.1_m);
+    lemlib::TrackingWheel vertical2(&encoder2, 2.75_in, 0.1_m);
+    lemlib::Odometry odom(&vertical1, &vertical2, nullptr, nullptr);
+    errno = 0;
+    CHECK(odom.start() == INT_MAX);
+    CHECK(errno == EINVAL);
+    errno = 0;
+    CHECK(odom.update() == INT_MAX);
+    CHECK(errno == EINVAL);
+    return host::result();
+}
@@ -0,0 +1,105 @@
+#include "Host.hpp"
+#include "Test.hpp"
+#include "hardware/optical/OpticalSensor.hpp"
+#include <array>
+#include <cerrno>
+#include <climits>
+#include <vector>
+
+// objects pass in front of a simulated optical sensor sampled every 5 milliseconds. A proximity trigger has to ignore
+// glitches shorter than its debounce time, and a hue range which wraps through 0 has to treat 350 and 10 degrees as
+// the same color. Every event has to keep the value and the time of the first sample which entered or exited the range
+
+using lemlib::OpticalEventType;
+
+static std::vector<lemlib::OpticalEvent> events;
+
+/**
+ * @brief set the values measured by the sensor, let the sampler read them, and read the events
+ *
+ * @return Time the time of the sample
+ */
+Time step(lemlib::OpticalSensor& optical, std::int32_t proximity, double hue) {
+    host::optical(1).proximity = proximity;
+    host::optical(1).hue = hue;
+    host::advanceClock(5_msec);
+    std::array<lemlib::OpticalEvent, 4> read;
+    const std::size_t count = optical.readEvents(read);
+    events.insert(events.end(), read.begin(), read.begin() + count);
+    return host::now();
+}
+
+/**
+ * @brief check an event
+ */
+bool check(const lemlib::OpticalEvent& event, std::size_t trigger, OpticalEventType type, double value, Time time) {
+    return event.trigger == trigger && event.type == type && event.value == value && event.time == time;
+}
+
+int main() {
+    host::freezeClock();
+    lemlib::OpticalSensor optical = pros::Optical(1);
+    CHECK(optical.setLedBrightness(50_percent) == 0);
+    CHECK(host::optical(1).ledPwm == 50);
+    CHECK(optical.addTrigger({lemlib::OpticalChannel::PROXIMITY, 150, 255, 10_msec}) == 0);
+    CHECK(optical.addTrigger({lemlib::OpticalChannel::HUE, 340, 20}) == 1);
+    CHECK(optical.addTrigger({lemlib::OpticalChannel::HUE, 100, 140}) == 2);
+    optical.startSampling(5_msec);
+    // the triggers can't change while the sampler runs
+    errno = 0;
+    CHECK(optical.addTrigger({lemlib::OpticalChannel::HUE, 0, 10}) == INT_MAX && errno == EBUSY);
+
+    // nothing in front of the sensor, then a glitch of the proximity for one sample
+    for (int i = 0; i < 3; i++) step(optical, 0, 180);
+    step(optical, 200, 180);
+    for (int i = 0; i < 3; i++) step(optical, 0, 180);
+    CHECK(events.empty());
+
+    // an object enters, and the proximity dips for one sample while it passes, which isn't an exit
+    const Time entered = step(optical, 180, 180);
+    for (int i = 0; i < 3; i++) step(optical, 200, 180);
+    step(optical, 100, 180);
+    for (int i = 0; i < 3; i++) step(optical, 200, 180);
+    const Time exited = step(optical, 50, 180);
+    for (int i = 0; i < 3; i++) step(optical, 0, 180);
+
+    // a red object, whose hue goes back and forth through 0, then a green one
+    const Time red = step(optical, 0, 350);
+    for (const double hue : {10.0, 359.9, 0.0, 20.0}) step(optical, 0, hue);
+    const Time orange = step(optical, 0, 30);
+    const Time redAgain = step(optical, 0, 5);
+    const Time green = step(optical, 0, 120);
+
+    for (const lemlib::OpticalEvent& event : events) {
+        std::printf("trigger %zu %s at %.0f ms, value %.1f\n", event.trigger,
+                    event.type == OpticalEventType::ENTER ? "enter" : "exit", to_msec(event.time), event.value);
+    }
+    CHECK(events.size() == 7);
+    if (events.size() == 7) {
+        // the events keep the first sample in or out of the range, even though they're generated 10ms later
+        CHECK(check(events[0], 0, OpticalEventType::ENTER, 180, entered));
+        CHECK(check(events[1], 0, OpticalEventType::EXIT, 50, exited));
+        CHECK(check(events[2], 1, OpticalEventType::ENTER, 350, red));
+        CHECK(check(events[3], 1, OpticalEventType::EXIT, 30, orange));
+        CHECK(check(events[4], 1, OpticalEventType::ENTER, 5, redAgain));
+        CHECK(check(events[5], 1, OpticalEventType::EXIT, 120, green));
+        CHECK(check(events[6], 2, OpticalEventType::ENTER, 120, green));
+    }
+
+    // samples of an unplugged sensor are skipped, so they don't generate events
+    events.clear();
+    host::setInstalled(1, false);
+    for (int i = 0; i < 5; i++) step(optical, 0, 180);
+    host::setInstalled(1, true);
+    CHECK(events.empty());
+    CHECK(optical.getDroppedEvents() == 0);
+
+    // once the sampler stops, triggers can be added again, up to MAX_TRIGGERS
+    optical.stopSampling();
+    for (std::size_t i = 3; i < lemlib::OpticalSensor::MAX_TRIGGERS; i++) {
+        CHECK(optical.addTrigger({lemlib::OpticalChannel::PROXIMITY, 0, 10}) == int(i));
+    }
+    errno = 0;
+    CHECK(optical.addTrigger({lemlib::OpticalChannel::PROXIMITY, 0, 10}) == INT_MAX && errno == ENOMEM);
+    return host::result();
+}
@@ -0,0 +1,45 @@
+#include "Test.hpp"
+#include "hardware/motion/PID.hpp"
+#include "units/Angle.hpp"
+
+// the cost of one PID update, with only the proportional term, with the whole controller, and with the whole controller
+// limited, filtered and unwinding its integral, which is the most work an update does
+
+static constexpr int UPDATES = 10000000;
+
+static const lemlib::PIDGains<Angle, Voltage> GAINS = {from_volt(30) / 1_stRad, from_volt(20) / (1_stRad * 1_sec),
+                                                       from_volt(2) / 1_radps};
+
+/**
+ * @brief measure the updates of a controller, following a setpoint that the measurement lags behind
+ */
+double measure(lemlib::PID<Angle, Voltage>& pid) {
+    double sum = 0;
+    const double time = host::benchmark(UPDATES, [&](int i) {
+        const Angle setpoint = from_stRad(i % 1000 * 0.01);
+        sum += to_volt(pid.update(setpoint, setpoint - 0.2_stRad, i * 10_msec));
+    });
+    CHECK(std::isfinite(sum));
+    return time;
+}
+
+int main() {
+    lemlib::PID<Angle, Voltage> proportional({GAINS.kP});
+    lemlib::PID<Angle, Voltage> unlimited(GAINS);
+    lemlib::PID<Angle, Voltage> limited(GAINS, {.minOutput = from_volt(-1),
+                                                .maxOutput = 1_volt,
+                                                .maxIntegral = 0.5_volt,
+                                                .derivativeTimeConstant = 20_msec});
+    const double proportionalTime = measure(proportional);
+    const double unlimitedTime = measure(unlimited);
+    const double limitedTime = measure(limited);
+    // the limited controller saturates, and unwinds its integral
+    CHECK(limited.getOutput() == 1_volt);
+    CHECK(limited.getIntegral() == 0_volt);
+
+    std::printf("%d updates\n", UPDATES);
+    std::printf("  proportional only                %6.1f ns/update\n", proportionalTime);
+    std::printf("  PID                              %6.1f ns/update\n", unlimitedTime);
+    std::printf("  PID, limited, filtered, unwound  %6.1f ns/update\n", limitedTime);
+    return host::result();
+}
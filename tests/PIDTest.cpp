@@ -0,0 +1,112 @@
+#include "SimulatedMotor.hpp"
+#include "Test.hpp"
+#include "hardware/motion/PID.hpp"
+#include <random>
+
+// a PID controller moves a simulated arm 3 radians, with and without a load holding it back, and with and without
+// back-calculation. The measurement is noisy and the loop runs every 10 milliseconds, like on the robot.
+// Back-calculation has to reduce the overshoot, and the arm has to settle at the setpoint
+
+using Controller = lemlib::PID<Angle, Voltage>;
+
+static const lemlib::PIDGains<Angle, Voltage> GAINS = {from_volt(30) / 1_stRad, from_volt(20) / (1_stRad * 1_sec),
+                                                       from_volt(2) / 1_radps};
+static const lemlib::PIDSettings<Voltage> SETTINGS = {.minOutput = from_volt(-12),
+                                                      .maxOutput = 12_volt,
+                                                      .derivativeTimeConstant = 20_msec};
+static const Angle SETPOINT = 3_stRad;
+
+/**
+ * @brief how the arm responded to the step
+ */
+struct Response {
+        double overshoot = 0; /** the furthest past the setpoint, in radians */
+        Time settled = from_sec(INFINITY); /** when the arm came within 0.05 radians of the setpoint for good */
+        double finalError = 0; /** in radians */
+};
+
+/**
+ * @brief move a simulated arm to the setpoint for 4 seconds
+ *
+ * @param load the torque holding the arm back, in newton meters
+ * @param antiWindupTime how fast the integral unwinds, or INFINITY to only clamp it
+ */
+Response step(double load, Time antiWindupTime) {
+    host::SimulatedMotor arm({.backEmf = 1.1, .inertia = 0.03, .friction = 0.1, .damping = 0.01});
+    arm.setLoad(load);
+    lemlib::PIDSettings<Voltage> settings = SETTINGS;
+    settings.antiWindupTime = antiWindupTime;
+    Controller pid(GAINS, settings);
+    // the same noise for every run, so the runs can be compared
+    std::mt19937 random(1);
+    std::normal_distribution<double> noise(0, 0.002);
+    Response response;
+    for (Time time = 0_sec; time < 4_sec; time += 10_msec) {
+        const Angle measurement = arm.getAngle() + from_stRad(noise(random));
+        arm.setVoltage(pid.update(SETPOINT, measurement, time));
+        arm.simulate(10_msec);
+        const double error = to_stRad(SETPOINT - arm.getAngle());
+        response.overshoot = std::max(response.overshoot, -error);
+        if (std::abs(error) > 0.05) response.settled = from_sec(INFINITY);
+        else if (response.settled == from_sec(INFINITY)) response.settled = time + 10_msec;
+    }
+    response.finalError = to_stRad(SETPOINT - arm.getAngle());
+    std::printf("  overshoot %.3f rad, settled %.2f s, final error %.4f rad\n", response.overshoot,
+                to_sec(response.settled), response.finalError);
+    return response;
+}
+
+int main() {
+    // the first update only uses the proportional term
+    Controller first(GAINS, SETTINGS);
+    CHECK(first.update(0.2_stRad, 0_stRad, 1_sec) == 6_volt);
+    CHECK(first.getIntegral() == 0_volt);
+    CHECK(first.update(0.2_stRad, 0_stRad, 1.5_sec) == 6_volt);
+    CHECK_NEAR(to_volt(first.getIntegral()), 2, 1e-9);
+    CHECK(first.update(2_stRad, 0_stRad, 2_sec) == 12_volt);
+
+    // regression: back-calculation only unwinds the integral to 0. The integral winds up while the output is below
+    // its limit, then a large error saturates the output. The standard form pushed the integral far below 0, so the
+    // mechanism stopped short of the setpoint until the integral wound back up
+    Controller windup(GAINS, SETTINGS);
+    Time time = 0_sec;
+    for (; time < 1_sec; time += 10_msec) windup.update(0.1_stRad, 0_stRad, time);
+    CHECK(windup.getIntegral() > 0.5_volt);
+    bool negative = false;
+    for (; time < 2_sec; time += 10_msec) {
+        CHECK(windup.update(3_stRad, 0_stRad, time) == 12_volt);
+        negative = negative || windup.getIntegral() < 0_volt;
+    }
+    CHECK(!negative);
+    CHECK(windup.getIntegral() == 0_volt);
+    // and the integral winds up again once the output is below its limit
+    windup.update(0.1_stRad, 0_stRad, time);
+    windup.update(0.1_stRad, 0_stRad, time + 10_msec);
+    CHECK(windup.getIntegral() > 0_volt);
+
+    // the integral is clamped, in both directions
+    Controller clamped(GAINS, {.maxIntegral = 1_volt});
+    for (time = 0_sec; time < 1_sec; time += 10_msec) clamped.update(0_stRad, 0.5_stRad, time);
+    CHECK(clamped.getIntegral() == from_volt(-1));
+
+    // reset() forgets everything
+    windup.reset();
+    CHECK(windup.getIntegral() == 0_volt && windup.getOutput() == 0_volt && windup.getError() == 0_stRad);
+
+    // the step response of the arm
+    std::printf("no load, clamp only\n");
+    const Response free = step(0, from_sec(INFINITY));
+    std::printf("no load, back-calculation\n");
+    const Response freeBackCalculation = step(0, 100_msec);
+    std::printf("with load, clamp only\n");
+    const Response loaded = step(0.8, from_sec(INFINITY));
+    std::printf("with load, back-calculation\n");
+    const Response loadedBackCalculation = step(0.8, 100_msec);
+    CHECK(freeBackCalculation.overshoot < free.overshoot);
+    CHECK(loadedBackCalculation.overshoot < loaded.overshoot);
+    for (const Response& response : {freeBackCalculation, loadedBackCalculation}) {
+        CHECK(response.settled < 2_sec);
+        CHECK(std::abs(response.finalError) < 0.01);
+    }
+    return host::result();
+}
@@ -0,0 +1,73 @@
+#include "SimulatedMotor.hpp"
+#include "Test.hpp"
+#include "hardware/motion/ProfiledMove.hpp"
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <climits>
+
+// a lift of 2 simulated motors, loaded by its weight, is moved 5 rotations up by moveTo() in a task, while the motors
+// are simulated every millisecond. The lift has to follow the profile, and once moveTo() returns, it has to stay at the
+// target instead of moving on at the last commanded velocity
+
+static std::array<host::SimulatedMotor, 2> simulated;
+
+/**
+ * @brief simulate the motors for a millisecond
+ */
+void step() {
+    for (host::SimulatedMotor& motor : simulated) motor.simulate(1_msec);
+    host::advanceClock(1_msec);
+}
+
+int main() {
+    host::freezeClock();
+    for (std::size_t i = 0; i < simulated.size(); i++) {
+        simulated[i].setPort(i + 1);
+        simulated[i].setLoad(0.05);
+    }
+    lemlib::MotorGroup lift({pros::Motor(1, pros::v5::MotorGears::blue), pros::Motor(2, pros::v5::MotorGears::blue)},
+                            600_rpm);
+    lift.setBrakeMode(lemlib::BrakeMode::HOLD);
+    lemlib::ProfiledMove move(lift, {3_rps, 20_rps2, 200_rps3}, 5_rps / 1_stRot);
+
+    // nothing to update before a profile is started
+    errno = 0;
+    CHECK(move.update() == INT_MAX && errno == EAGAIN);
+    CHECK(move.isFinished());
+
+    std::atomic<bool> finished = false;
+    std::atomic<int> result = INT_MAX;
+    pros::Task task([&] {
+        result = move.moveTo(5_stRot);
+        finished = true;
+    });
+    double worstError = 0;
+    int ms = 0;
+    for (; !finished && ms < 10000; ms++) {
+        step();
+        // the setpoint is only sampled every 10 milliseconds, so the lift is compared to the profile at the last update
+        if (ms % 10 == 0) {
+            const double error = to_stRot(move.getSetpoint().position - lift.getAngle());
+            worstError = std::max(worstError, std::abs(error));
+        }
+    }
+    task.join();
+    const double endError = to_stRot(5_stRot - lift.getAngle());
+    std::printf("moved in %d ms, %.3f rotations from the profile at most, %.3f from the target at the end\n", ms,
+                worstError, endError);
+    CHECK(finished && result == 0);
+    CHECK(worstError < 0.1);
+    CHECK(move.isFinished());
+    CHECK(move.getSetpoint().position == 5_stRot && move.getSetpoint().velocity == 0_rps);
+    // the motors are stopped, instead of running on at kP times the last error
+    CHECK(host::motor(1).command == host::MotorCommand::BRAKE && host::motor(2).command == host::MotorCommand::BRAKE);
+
+    // nothing updates the lift after moveTo() returns, and it stays close to the target
+    for (int i = 0; i < 2000; i++) step();
+    const double heldError = to_stRot(5_stRot - lift.getAngle());
+    std::printf("%.3f rotations from the target 2 seconds later\n", heldError);
+    CHECK(std::abs(endError) < 0.05);
+    CHECK(std::abs(heldError) < 0.05);
+    return host::result();
+}
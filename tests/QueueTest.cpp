@@ -0,0 +1,164 @@
+#include "Test.hpp"
+#include "hardware/concurrency/Queue.hpp"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// several producer tasks push to one consumer. On the computer, tasks are threads which can be preempted between any
+// two instructions, or run at the same time on several cores, which is much harsher than the brain. Each value carries
+// its producer and its index, so the consumer can tell if any value is lost, duplicated or reordered
+
+static constexpr std::uint32_t PRODUCERS = 8;
+static constexpr std::uint32_t VALUES = 100000; /** values pushed by each producer */
+static constexpr std::uint32_t BURST = 99; /** values pushed before a producer lets other tasks run, more than fit */
+
+struct Value {
+        std::uint32_t producer;
+        std::uint32_t index;
+};
+
+/**
+ * @brief what the consumer received from each producer
+ */
+struct Received {
+        std::vector<std::uint32_t> count = std::vector<std::uint32_t>(PRODUCERS); /** values received */
+        std::vector<std::int64_t> last = std::vector<std::int64_t>(PRODUCERS, -1); /** index of the last value */
+        std::uint32_t reordered = 0; /** values which came before an earlier value, or twice */
+        std::uint32_t batches = 0; /** SPSC batches which were split */
+
+        void receive(const Value& value) {
+            if (value.index <= last[value.producer]) reordered++;
+            last[value.producer] = value.index;
+            count[value.producer]++;
+        }
+};
+
+/**
+ * @brief push values from several tasks, and pop them from this one until every producer finished
+ *
+ * The consumer polls without sleeping, so the queue is only full when the producers are faster than it
+ *
+ * @param retry whether producers retry values which didn't fit, so none are lost
+ * @return the number of failed pushes of each producer
+ */
+template <typename Queue> std::vector<std::uint32_t> stress(Queue& queue, std::uint32_t producers, bool retry,
+                                                            Received& received) {
+    std::vector<std::uint32_t> failed(producers);
+    std::atomic<std::uint32_t> finished = 0;
+    std::vector<pros::Task> tasks;
+    for (std::uint32_t producer = 0; producer < producers; producer++) {
+        tasks.emplace_back([&, producer] {
+            for (std::uint32_t index = 0; index < VALUES; index++) {
+                while (!queue.push(Value {producer, index})) {
+                    failed[producer]++;
+                    if (!retry) break;
+                    std::this_thread::yield();
+                }
+                // let the other tasks run now and then, like the scheduler on the brain would
+                if (index % BURST == BURST - 1) std::this_thread::yield();
+            }
+            finished++;
+        });
+    }
+    std::array<Value, 16> values;
+    while (true) {
+        // check if the producers finished before popping, so the last values are always popped
+        const bool done = finished == producers;
+        pros::Task::notify_take(true, 0);
+        std::size_t count;
+        while ((count = queue.pop(values)) > 0) {
+            for (std::size_t i = 0; i < count; i++) received.receive(values[i]);
+        }
+        if (done) break;
+        // let the producers run when the queue is empty, in case there aren't enough cores for every task
+        std::this_thread::yield();
+    }
+    for (pros::Task& task : tasks) task.join();
+    return failed;
+}
+
+/**
+ * @brief check that every value was received exactly once and in order, unless it was dropped, and that every failed
+ * push was counted
+ */
+template <typename Queue> void check(const Queue& queue, const std::vector<std::uint32_t>& failed, bool retry,
+                                     const Received& received) {
+    std::uint32_t totalFailed = 0;
+    for (std::size_t producer = 0; producer < failed.size(); producer++) {
+        CHECK(received.count[producer] + (retry ? 0 : failed[producer]) == VALUES);
+        totalFailed += failed[producer];
+    }
+    CHECK(received.reordered == 0);
+    CHECK(queue.getDropped() == totalFailed);
+    CHECK(queue.empty());
+}
+
+int main() {
+    // MPSC, with the producers retrying until every value fits
+    {
+        lemlib::MPSCQueue<Value, 64> queue(pros::Task::current());
+        Received received;
+        const std::vector<std::uint32_t> failed = stress(queue, PRODUCERS, true, received);
+        check(queue, failed, true, received);
+        std::printf("MPSC, %u producers retrying: %u of %u values received, %u pushes retried\n", PRODUCERS,
+                    PRODUCERS * VALUES, PRODUCERS * VALUES, queue.getDropped());
+    }
+
+    // MPSC, with the producers dropping values when the queue is full
+    {
+        lemlib::MPSCQueue<Value, 64> queue(pros::Task::current());
+        Received received;
+        const std::vector<std::uint32_t> failed = stress(queue, PRODUCERS, false, received);
+        check(queue, failed, false, received);
+        std::printf("MPSC, %u producers: %u of %u values dropped\n", PRODUCERS, queue.getDropped(),
+                    PRODUCERS * VALUES);
+    }
+
+    // SPSC, with single values
+    {
+        lemlib::SPSCQueue<Value, 64> queue(pros::Task::current());
+        Received received;
+        const std::vector<std::uint32_t> failed = stress(queue, 1, false, received);
+        check(queue, failed, false, received);
+        std::printf("SPSC: %u of %u values dropped\n", queue.getDropped(), VALUES);
+    }
+
+    // SPSC, with batches of 3 values which have to arrive together or not at all
+    {
+        lemlib::SPSCQueue<Value, 64> queue(pros::Task::current());
+        std::uint32_t dropped = 0;
+        std::atomic<bool> finished = false;
+        pros::Task producer([&] {
+            for (std::uint32_t index = 0; index + 3 <= VALUES; index += 3) {
+                const std::array<Value, 3> batch = {Value {0, index}, Value {0, index + 1}, Value {0, index + 2}};
+                if (!queue.push(std::span<const Value>(batch))) dropped += 3;
+                if (index % BURST == BURST - 3) std::this_thread::yield();
+            }
+            finished = true;
+        });
+        Received received;
+        while (true) {
+            const bool done = finished;
+            pros::Task::notify_take(true, 0);
+            while (std::optional<Value> first = queue.pop()) {
+                received.receive(*first);
+                // the whole batch was published at once, so the rest of it has to be in the queue already
+                if (first->index % 3 != 0) received.batches++;
+                for (std::uint32_t i = 1; i < 3; i++) {
+                    const std::optional<Value> value = queue.pop();
+                    if (value) received.receive(*value);
+                    if (!value || value->index != first->index + i) received.batches++;
+                }
+            }
+            if (done) break;
+            std::this_thread::yield();
+        }
+        producer.join();
+        CHECK(received.count[0] + dropped == VALUES / 3 * 3);
+        CHECK(received.reordered == 0);
+        CHECK(received.batches == 0);
+        CHECK(queue.getDropped() == dropped);
+        std::printf("SPSC batches of 3: %u of %u values dropped\n", dropped, VALUES / 3 * 3);
+    }
+    return host::result();
+}
@@ -0,0 +1,49 @@
+#include "Test.hpp"
+#include "hardware/math/SE2.hpp"
+#include <vector>
+
+// transforms a batch of 1,000 points, like a scan from a distance sensor, from the robot frame to the field frame.
+// SE2 caches the sine and cosine of its rotation, which is compared to computing them again for every point
+
+using namespace units;
+
+static constexpr int POINTS = 1000;
+static constexpr int BATCHES = 10000;
+
+int main() {
+    const lemlib::SE2 robot(1_m, 2_m, 30_stDeg);
+    std::vector<V2Position> scan;
+    for (int i = 0; i < POINTS; i++) scan.emplace_back(from_cm(i % 37), from_cm(i % 53 - 26));
+    std::vector<V2Position> batch(POINTS);
+    std::vector<V2Position> single(POINTS);
+    std::vector<V2Position> uncached(POINTS);
+
+    const double batchTime = host::benchmark(BATCHES, [&](int) { robot.apply(scan, batch); });
+    const double singleTime = host::benchmark(BATCHES, [&](int) {
+        for (int i = 0; i < POINTS; i++) single[i] = robot * scan[i];
+    });
+    const double uncachedTime = host::benchmark(BATCHES, [&](int) {
+        for (int i = 0; i < POINTS; i++) {
+            // stops the compiler from moving the sine and cosine out of the loop, which it can't do when each point is
+            // transformed by a separate call
+            double theta = robot.getTheta().internal();
+            asm volatile("" : "+m"(theta));
+            const double sin = std::sin(theta);
+            const double cos = std::cos(theta);
+            const Length x = scan[i].getX();
+            const Length y = scan[i].getY();
+            uncached[i] = V2Position(robot.getX() + x * cos - y * sin, robot.getY() + x * sin + y * cos);
+        }
+    });
+
+    for (int i = 0; i < POINTS; i++) {
+        CHECK(batch[i].getX() == single[i].getX() && batch[i].getY() == single[i].getY());
+        CHECK_NEAR(to_m(batch[i].getX()), to_m(uncached[i].getX()), 1e-9);
+        CHECK_NEAR(to_m(batch[i].getY()), to_m(uncached[i].getY()), 1e-9);
+    }
+    std::printf("%d points, %d batches\n", POINTS, BATCHES);
+    std::printf("  SE2::apply(span)       %8.1f ns/batch %6.2f ns/point\n", batchTime, batchTime / POINTS);
+    std::printf("  SE2 * point            %8.1f ns/batch %6.2f ns/point\n", singleTime, singleTime / POINTS);
+    std::printf("  sin and cos per point  %8.1f ns/batch %6.2f ns/point\n", uncachedTime, uncachedTime / POINTS);
+    return host::result();
+}
@@ -0,0 +1,47 @@
+#include "Test.hpp"
+#include "hardware/math/SE2.hpp"
+#include <cmath>
+
+// interpolation goes through the logarithm and the exponential of a transform, which divide by the rotation. For small
+// rotations the division has to be replaced by a series, and the result has to stay finite and accurate right up to
+// the point where the exact formula takes over
+
+/**
+ * @brief interpolate halfway from the origin to 1 meter forward, turned by a rotation
+ */
+lemlib::SE2 halfway(double theta) { return lemlib::SE2().interpolate(lemlib::SE2(1_m, 0_m, from_stRad(theta)), 0.5); }
+
+int main() {
+    // rotations around the point where the series is used, and rotations so small that 1 - cos(theta) rounds to 0
+    for (const double theta : {0.0, 5e-9, 1e-8, 1e-6, 9.99e-5, 1.001e-4, 1e-3, -1e-6}) {
+        const lemlib::SE2 mid = halfway(theta);
+        CHECK(std::isfinite(to_m(mid.getX())) && std::isfinite(to_m(mid.getY())));
+        // the arc passes through x = 0.5 up to terms of the fourth order in the rotation
+        CHECK_NEAR(to_m(mid.getX()), 0.5, theta * theta + 1e-15);
+        CHECK_NEAR(to_m(mid.getY()), -theta / 8, theta * theta + 1e-15);
+        CHECK_NEAR(to_stRad(mid.getTheta()), theta / 2, 1e-15);
+        // interpolating all the way ends at the other transform
+        const lemlib::SE2 end = lemlib::SE2().interpolate(lemlib::SE2(1_m, 0_m, from_stRad(theta)), 1);
+        CHECK_NEAR(to_m(end.getX()), 1, 1e-12);
+        CHECK_NEAR(to_m(end.getY()), 0, 1e-12);
+    }
+
+    // the series and the exact formula agree where one takes over from the other
+    const lemlib::SE2 below = halfway(1e-4 * (1 - 1e-9));
+    const lemlib::SE2 above = halfway(1e-4 * (1 + 1e-9));
+    CHECK_NEAR(to_m(below.getX()), to_m(above.getX()), 1e-14);
+    CHECK_NEAR(to_m(below.getY()), to_m(above.getY()), 1e-13);
+
+    // a pure rotation turns in place, the shortest way
+    const lemlib::SE2 turn = lemlib::SE2().interpolate(lemlib::SE2(0_m, 0_m, from_stRad(1.5 * M_PI)), 0.5);
+    CHECK_NEAR(to_m(turn.getX()), 0, 1e-12);
+    CHECK_NEAR(to_m(turn.getY()), 0, 1e-12);
+    CHECK_NEAR(to_stRad(turn.getTheta()), -M_PI / 4, 1e-12);
+
+    // a quarter circle of radius 1 meter, which passes through the point at 45 degrees halfway
+    const lemlib::SE2 arc = lemlib::SE2().interpolate(lemlib::SE2(1_m, 1_m, from_stRad(M_PI / 2)), 0.5);
+    CHECK_NEAR(to_m(arc.getX()), std::sin(M_PI / 4), 1e-12);
+    CHECK_NEAR(to_m(arc.getY()), 1 - std::cos(M_PI / 4), 1e-12);
+    CHECK_NEAR(to_stRad(arc.getTheta()), M_PI / 4, 1e-12);
+    return host::result();
+}
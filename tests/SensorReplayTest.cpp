@@ -0,0 +1,161 @@
+#include "Host.hpp"
+#include "Test.hpp"
+#include "hardware/replay/SensorRecorder.hpp"
+#include "hardware/replay/SensorReplay.hpp"
+#include <cerrno>
+#include <climits>
+#include <cstdio>
+#include <string>
+
+// an encoder read every 10 milliseconds and an IMU read every 20 milliseconds are recorded, including a failed read.
+// Replaying the recording, the sensors have to return the same readings and errors, in the order they were read or at
+// the replay time. A recording to a full disk has to report the failed write, instead of losing readings silently
+
+/**
+ * @brief an encoder whose angle is set by the test. Reads fail with ENODEV while it is unplugged
+ */
+class TestEncoder : public lemlib::Encoder {
+    public:
+        int isConnected() override { return !unplugged; }
+
+        Angle getAngle() override {
+            if (!unplugged) return angle;
+            errno = ENODEV;
+            return from_stRad(INFINITY);
+        }
+
+        int setAngle(Angle) override { return 0; }
+
+        Angle angle = 0_stRad;
+        bool unplugged = false;
+};
+
+/**
+ * @brief an IMU whose rotation is set by the test
+ */
+class TestIMU : public lemlib::IMU {
+    public:
+        int calibrate() override { return 0; }
+
+        int isCalibrated() override { return true; }
+
+        int isCalibrating() override { return false; }
+
+        int isConnected() override { return true; }
+
+        Angle getRotation() override { return rotation; }
+
+        int setRotation(Angle) override { return 0; }
+
+        Angle rotation = 0_stRad;
+};
+
+/**
+ * @brief the angle of the encoder at a step, in radians
+ */
+double encoderAngle(int step) { return step * 0.01; }
+
+/**
+ * @brief the rotation of the IMU at a step, in radians
+ */
+double imuRotation(int step) { return -step * 0.002; }
+
+int main(int argc, char** argv) {
+    const std::string path = std::string(argv[0]) + ".bin";
+
+    // record for a second, starting at 1 second. The encoder is unplugged for the read at step 50
+    host::freezeClock(1_sec);
+    TestEncoder encoder;
+    TestIMU imu;
+    lemlib::SensorRecorder recorder(path.c_str());
+    lemlib::RecordingEncoder recordedEncoder(&encoder, &recorder, 0);
+    lemlib::RecordingIMU recordedIMU(&imu, &recorder, 1);
+    CHECK(recorder.start() == 0);
+    for (int step = 0; step < 100; step++) {
+        encoder.angle = from_stRad(encoderAngle(step));
+        encoder.unplugged = step == 50;
+        imu.rotation = from_stRad(imuRotation(step));
+        recordedEncoder.getAngle();
+        if (step % 2 == 0) recordedIMU.getRotation();
+        host::advanceClock(10_msec);
+    }
+    CHECK(recorder.stop() == 0);
+    CHECK(recorder.getError() == 0);
+    CHECK(recorder.getDropped() == 0);
+
+    // SEQUENTIAL: every reading in the order it was recorded, as fast as it is read
+    lemlib::SensorReplay sequential;
+    CHECK(sequential.load(path.c_str()) == 0);
+    CHECK(sequential.hasChannel(0) && sequential.hasChannel(1) && !sequential.hasChannel(2));
+    CHECK(sequential.getStartTime() == 1_sec && sequential.getEndTime() == 1.99_sec);
+    lemlib::ReplayEncoder replayedEncoder(&sequential, 0);
+    lemlib::ReplayIMU replayedIMU(&sequential, 1);
+    for (int step = 0; step < 100; step++) {
+        errno = 0;
+        const Angle angle = replayedEncoder.getAngle();
+        if (step == 50) CHECK(angle == from_stRad(INFINITY) && errno == ENODEV);
+        else CHECK(to_stRad(angle) == encoderAngle(step));
+        if (step % 2 == 0) CHECK(to_stRad(replayedIMU.getRotation()) == imuRotation(step));
+        CHECK_NEAR(to_sec(sequential.getTime()), 1 + step * 0.01, 1e-9);
+    }
+    CHECK(sequential.isFinished());
+    // the channels have no readings left
+    errno = 0;
+    CHECK(replayedEncoder.getAngle() == from_stRad(INFINITY) && errno == ENODATA);
+    // and the recording can be played again
+    sequential.rewind();
+    CHECK(!sequential.isFinished());
+    CHECK(to_stRad(replayedEncoder.getAngle()) == encoderAngle(0));
+
+    // TIMED: the latest reading at the replay time, which skips readings and repeats them
+    lemlib::SensorReplay timed(lemlib::ReplayMode::TIMED);
+    CHECK(timed.load(path.c_str()) == 0);
+    lemlib::ReplayEncoder timedEncoder(&timed, 0);
+    lemlib::ReplayIMU timedIMU(&timed, 1);
+    // there is no reading before the recording starts
+    timed.setTime(0.5_sec);
+    errno = 0;
+    CHECK(timedIMU.getRotation() == from_stRad(INFINITY) && errno == ENODATA);
+    timed.setTime(1.255_sec);
+    CHECK(to_stRad(timedEncoder.getAngle()) == encoderAngle(25));
+    CHECK(to_stRad(timedIMU.getRotation()) == imuRotation(24));
+    // reading again at the same time repeats the reading
+    CHECK(to_stRad(timedEncoder.getAngle()) == encoderAngle(25));
+    timed.advance(0.25_sec);
+    errno = 0;
+    CHECK(timedEncoder.getAngle() == from_stRad(INFINITY) && errno == ENODEV);
+    CHECK(to_stRad(timedIMU.getRotation()) == imuRotation(50));
+    timed.advance(0.3_sec);
+    CHECK(to_stRad(timedEncoder.getAngle()) == encoderAngle(80));
+    CHECK(!timed.isFinished());
+    timed.setTime(2_sec);
+    CHECK(to_stRad(timedEncoder.getAngle()) == encoderAngle(99));
+    CHECK(to_stRad(timedIMU.getRotation()) == imuRotation(98));
+    CHECK(timed.isFinished());
+
+    // a file which isn't a recording is rejected
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    std::fputs("not a recording", file);
+    std::fclose(file);
+    errno = 0;
+    CHECK(timed.load(path.c_str()) == INT_MAX && errno == EINVAL);
+    std::remove(path.c_str());
+
+    // on Linux, writes to /dev/full fail with ENOSPC once the buffer of the file is full. The task stops writing, and
+    // the error is reported by getError() and stop()
+    lemlib::SensorRecorder full("/dev/full");
+    lemlib::RecordingEncoder fullEncoder(&encoder, &full, 0);
+    encoder.unplugged = false;
+    CHECK(full.start() == 0);
+    for (int step = 0; step < 2000; step++) {
+        fullEncoder.getAngle();
+        host::advanceClock(10_msec);
+    }
+    std::printf("recording to /dev/full: error %d, %u readings dropped\n", full.getError(), full.getDropped());
+    CHECK(full.getError() == ENOSPC);
+    // the task stopped, so the queue fills up and readings are dropped
+    CHECK(full.getDropped() > 0);
+    errno = 0;
+    CHECK(full.stop() == INT_MAX && errno == ENOSPC);
+    return host::result();
+}
@@ -0,0 +1,135 @@
+#include "Host.hpp"
+#include "Test.hpp"
+#include "hardware/serial/Framing.hpp"
+#include "hardware/serial/SerialPort.hpp"
+#include <map>
+#include <vector>
+
+// a coprocessor sends a recorded stream of frames, with corrupted frames and resynchronization bytes mixed in. The
+// stream is fed straight into the decoder to measure its throughput, and then over a simulated 115200 baud serial line
+// to measure the latency from the last byte of a frame arriving to its value being published
+
+static constexpr int FRAMES = 20000;
+static constexpr int BAUDRATE = 115200;
+
+/**
+ * @brief frames recorded from a coprocessor, which pin down the wire format
+ */
+static constexpr std::uint8_t RECORDING[] = {
+    0x04, 0x03, 0xe8, 0x03, 0x01, 0x03, 0xa7, 0xa7, 0x00, // channel 3, value 1000
+    0x08, 0x0f, 0xff, 0xff, 0xff, 0xff, 0x3a, 0xed, 0x00, // channel 15, value -1
+    0x01, 0x01, 0x01, 0x01, 0x01, 0x03, 0x0c, 0x11, 0x00, // channel 0, value 0
+};
+
+struct Stream {
+        std::vector<std::uint8_t> bytes;
+        std::vector<std::pair<std::size_t, std::int32_t>> ends; /** the end and value of each valid frame */
+        std::uint32_t crcErrors = 0;
+        std::uint32_t framingErrors = 0;
+};
+
+Stream record() {
+    Stream stream;
+    for (int i = 0; i < FRAMES; i++) {
+        const auto frame = lemlib::SerialPort::encodeFrame(i % 16, i);
+        if (i % 500 == 250) {
+            // noise flipped a bit of the checksum
+            std::array<std::uint8_t, lemlib::SerialPort::PAYLOAD_SIZE> payload = {
+                std::uint8_t(i % 16), std::uint8_t(i), std::uint8_t(i >> 8), std::uint8_t(i >> 16), 0};
+            const std::uint16_t crc = lemlib::crc16(std::span(payload).first(5)) ^ 0x0100;
+            payload[5] = crc;
+            payload[6] = crc >> 8;
+            std::uint8_t encoded[lemlib::cobsMaxSize(lemlib::SerialPort::PAYLOAD_SIZE) + 1] = {};
+            const std::size_t length = lemlib::cobsEncode(payload, encoded);
+            stream.bytes.insert(stream.bytes.end(), encoded, encoded + length + 1);
+            stream.crcErrors++;
+        } else if (i % 500 == 100) {
+            // the coprocessor reset in the middle of a frame
+            stream.bytes.insert(stream.bytes.end(), frame.begin(), frame.begin() + 4);
+            stream.bytes.push_back(0);
+            stream.framingErrors++;
+        } else {
+            stream.bytes.insert(stream.bytes.end(), frame.begin(), frame.end());
+            stream.ends.emplace_back(stream.bytes.size(), i);
+        }
+        // the coprocessor sends zero bytes to resynchronize now and then, which aren't errors
+        if (i % 1000 == 999) stream.bytes.insert(stream.bytes.end(), {0, 0});
+    }
+    return stream;
+}
+
+int main() {
+    // the recorded frames decode to the values which were sent
+    for (int i = 0; i < 3; i++) {
+        const auto frame = lemlib::SerialPort::encodeFrame(std::array {3, 15, 0}[i], std::array {1000, -1, 0}[i]);
+        CHECK(std::equal(frame.begin(), frame.end(), RECORDING + i * lemlib::SerialPort::FRAME_SIZE));
+    }
+    lemlib::SerialPort recorded(1, BAUDRATE);
+    recorded.receive(RECORDING);
+    CHECK(recorded.getFrameCount() == 3);
+    CHECK(recorded.getChannel(3)->value == 1000);
+    CHECK(recorded.getChannel(15)->value == -1);
+    CHECK(recorded.getChannel(0)->value == 0);
+    CHECK(!recorded.getChannel(1));
+
+    // throughput of the decoder, with the stream split into chunks which don't line up with the frames
+    const Stream stream = record();
+    const std::uint32_t valid = stream.ends.size();
+    lemlib::SerialPort decoder(2, BAUDRATE);
+    const int iterations = 50;
+    const double time = host::benchmark(iterations, [&](int) {
+        for (std::size_t i = 0; i < stream.bytes.size(); i += 37) {
+            decoder.receive(std::span(stream.bytes).subspan(i, std::min<std::size_t>(37, stream.bytes.size() - i)));
+        }
+    });
+    CHECK(decoder.getFrameCount() == valid * iterations);
+    CHECK(decoder.getCrcErrors() == stream.crcErrors * iterations);
+    CHECK(decoder.getFramingErrors() == stream.framingErrors * iterations);
+    std::printf("decoded %d frames: %.1f ns/frame, %.1f MB/s\n", FRAMES, time / FRAMES,
+                stream.bytes.size() / time * 1000);
+
+    // latency over the serial line, with the port read by its task every 5 milliseconds
+    host::freezeClock();
+    lemlib::SerialPort port(3, BAUDRATE);
+    CHECK(host::serial(3).baudrate == BAUDRATE);
+    port.start(5_msec);
+    std::map<std::int32_t, Time> arrivals;
+    std::map<std::int32_t, Time> latencies;
+    std::size_t sent = 0;
+    std::size_t arrived = 0; /** the number of valid frames which arrived */
+    for (int ms = 1; sent < stream.bytes.size() || latencies.size() < valid; ms++) {
+        CHECK(ms < 60000);
+        if (ms >= 60000) break;
+        host::advanceClock(1_msec);
+        for (std::uint8_t channel = 0; channel < lemlib::SerialPort::MAX_CHANNELS; channel++) {
+            const std::optional<lemlib::SerialChannelValue> value = port.getChannel(channel);
+            if (value && !latencies.contains(value->value)) {
+                latencies.emplace(value->value, value->time - arrivals.at(value->value));
+            }
+        }
+        // the bytes which arrived during the last millisecond, at 10 bits per byte
+        const std::size_t end = std::min<std::size_t>(stream.bytes.size(), std::int64_t(ms) * BAUDRATE / 10 / 1000);
+        host::serial(3).send(std::span(stream.bytes).subspan(sent, end - sent));
+        for (; arrived < valid && stream.ends[arrived].first <= end; arrived++) {
+            arrivals.emplace(stream.ends[arrived].second, host::now());
+        }
+        sent = end;
+    }
+    port.stop();
+    host::unfreezeClock();
+    CHECK(port.getFrameCount() == valid);
+    CHECK(port.getCrcErrors() == stream.crcErrors);
+    CHECK(port.getFramingErrors() == stream.framingErrors);
+    CHECK(latencies.size() == valid);
+    Time total = 0_sec;
+    Time worst = 0_sec;
+    for (const auto& [value, latency] : latencies) {
+        total += latency;
+        worst = units::max(worst, latency);
+    }
+    std::printf("%u frames over %d baud: latency %.2f ms on average, %.2f ms at most\n", valid, BAUDRATE,
+                to_msec(total) / valid, to_msec(worst));
+    // a frame waits at most one period of the task
+    CHECK(worst < 5.001_msec);
+    return host::result();
+}
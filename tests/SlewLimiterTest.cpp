@@ -0,0 +1,163 @@
+#include "SimulatedMotor.hpp"
+#include "Test.hpp"
+#include "hardware/Motors/Motor.hpp"
+#include "hardware/Motors/SlewLimiter.hpp"
+#include "hardware/Motors/StallDetector.hpp"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// a slew limiter is updated every 10 milliseconds through steps and reversals, with a slower accelerating than
+// decelerating rate, and then with a jerk limit too. Every change of the output has to keep to the rate of its
+// direction, and every change of the rate to the jerk limit, including where the output crosses 0 and where it reaches
+// the target. A simulated intake reversed through move() and through a reverse pulse of its stall detector has to get
+// the same limits, which lower the peak current of the reversal
+
+static constexpr double DT = 0.01; /** seconds between updates */
+static const lemlib::SlewLimits<Voltage> LIMITS = {96_volt / 1_sec, 192_volt / 1_sec};
+
+static Time now = 0_sec;
+
+/**
+ * @brief the outputs of a limiter, in volts, when it is updated with a target every 10 milliseconds
+ */
+std::vector<double> outputs(lemlib::SlewLimiter<Voltage>& limiter, Voltage target, int updates) {
+    std::vector<double> result;
+    for (int i = 0; i < updates; i++) {
+        now += 10_msec;
+        result.push_back(to_volt(limiter.update(target, now)));
+    }
+    return result;
+}
+
+/**
+ * @brief check every change of the outputs keeps to the rates, and every change of the rate to the jerk limit
+ *
+ * @param previous the output before the first one
+ * @param accelerating the accelerating rate, in volts per second
+ * @param decelerating the decelerating rate, in volts per second
+ * @param jerk the jerk limit, in volts per second squared
+ * @return double the largest change of the rate between updates, in volts per second
+ */
+double checkLimits(const std::vector<double>& outputs, double previous, double accelerating, double decelerating,
+                   double jerk) {
+    double rate = 0;
+    double largestJerk = 0;
+    for (const double output : outputs) {
+        const double newRate = (output - previous) / DT;
+        // only the part of a change which moves away from 0 is accelerating
+        const double slowing = std::abs(output) < std::abs(previous) || output * previous < 0
+                                   ? std::min(std::abs(previous), std::abs(output - previous))
+                                   : 0;
+        const double speeding = std::abs(output - previous) - slowing;
+        CHECK(slowing <= decelerating * DT * 1.0001 + 1e-9);
+        CHECK(speeding <= accelerating * DT * 1.0001 + 1e-9 || (slowing > 0 && speeding <= decelerating * DT));
+        largestJerk = std::max(largestJerk, std::abs(newRate - rate));
+        CHECK(std::abs(newRate - rate) <= jerk * DT * 1.0001 + 1e-9);
+        rate = newRate;
+        previous = output;
+    }
+    // the output ends up at rest
+    largestJerk = std::max(largestJerk, std::abs(rate));
+    CHECK(rate == 0);
+    return largestJerk;
+}
+
+int main() {
+    // without limits, the output follows the target
+    lemlib::SlewLimiter<Voltage> unlimited;
+    CHECK(!unlimited.isLimited());
+    CHECK(unlimited.update(12_volt, 0_sec) == 12_volt);
+
+    // speed up at 24 volts per second, slow down at 48. The first update only records the time
+    lemlib::SlewLimiter<Voltage> asymmetric({24_volt / 1_sec, 48_volt / 1_sec});
+    CHECK(outputs(asymmetric, 12_volt, 2) == std::vector<double>({0, 0.24}));
+    asymmetric.reset(6_volt);
+    outputs(asymmetric, from_volt(-6), 1);
+    const std::vector<double> reversal = outputs(asymmetric, from_volt(-6), 100);
+    // 6 volts down at 0.48 volts per tick, including the tick which crosses 0, then up at 0.24 volts per tick
+    CHECK_NEAR(reversal[11], 0.24, 1e-9);
+    CHECK_NEAR(reversal[12], -0.24, 1e-9);
+    CHECK_NEAR(reversal[13], -0.48, 1e-9);
+    CHECK_NEAR(reversal[35], -5.76, 1e-9);
+    CHECK(reversal[37] == -6);
+    checkLimits(reversal, 6, 24, 48, INFINITY);
+    // a pause between updates only counts as MAX_STEP
+    now += 10_sec;
+    CHECK_NEAR(to_volt(asymmetric.update(0_volt, now)),
+               -6 + to_volt(48_volt / 1_sec * lemlib::SlewLimiter<Voltage>::MAX_STEP), 1e-9);
+
+    // with a jerk limit of 480 volts per second squared, the rate ramps up and down by 4.8 volts per second every tick
+    const lemlib::SlewLimits<Voltage> jerkLimits = {24_volt / 1_sec, 48_volt / 1_sec, 480_volt / 1_sec / 1_sec};
+    lemlib::SlewLimiter<Voltage> jerk(jerkLimits);
+    outputs(jerk, 12_volt, 1);
+    const std::vector<double> start = outputs(jerk, 12_volt, 100);
+    CHECK(jerk.getValue() == 12_volt);
+    // the output never overshoots
+    for (const double output : start) CHECK(output <= 12);
+    const double startJerk = checkLimits(start, 0, 24, 48, 480);
+    // a full reversal slows down at 48 volts per second, then eases to 24 volts per second before it crosses 0, and
+    // eases into the target. Before, the rate stayed at 48 volts per second after crossing 0, and dropped to 0 at once
+    const std::vector<double> reverse = outputs(jerk, from_volt(-12), 200);
+    CHECK(jerk.getValue() == from_volt(-12));
+    for (const double output : reverse) CHECK(output >= -12);
+    const double reverseJerk = checkLimits(reverse, 12, 24, 48, 480);
+    const double reverseDuration = std::find(reverse.begin(), reverse.end(), -12) - reverse.begin() + 1;
+    std::printf("jerk limited: %.2f V/s and %.2f V/s per tick at most, reversal in %.0f ticks\n", startJerk,
+                reverseJerk, reverseDuration);
+    // the jerk limit is used, but the reversal doesn't take much longer than without it
+    CHECK(reverseJerk > 4.8 * 0.9);
+    CHECK(reverseDuration < (12 / 0.48 + 12 / 0.24) * 1.3);
+    // the rate is reported, and is 0 at the target
+    CHECK(jerk.getRate() == 0_volt / 1_sec);
+
+    // a simulated intake reversed at full speed by move(), with and without the limits
+    double peakCurrent[2];
+    for (const bool limited : {false, true}) {
+        host::freezeClock();
+        host::SimulatedMotor simulated;
+        simulated.setPort(1 + limited);
+        lemlib::Motor motor = pros::Motor(1 + limited, pros::v5::MotorGears::blue);
+        if (limited) motor.setVoltageSlew(LIMITS);
+        std::vector<double> voltages;
+        for (int ms = 0; ms < 4000; ms += 10) {
+            CHECK(motor.move(ms < 2000 ? 1 : -1) == 0);
+            voltages.push_back(host::motor(1 + limited).voltage / 1000.0);
+            if (ms == 2000) simulated.takePeakCurrent();
+            simulated.simulate(10_msec);
+            host::advanceClock(10_msec);
+        }
+        peakCurrent[limited] = to_amp(simulated.takePeakCurrent());
+        // the voltage is rounded to millivolts
+        if (limited) checkLimits(voltages, 0, 96.2, 192.2, INFINITY);
+    }
+    std::printf("reversal: %.2f A, slew limited: %.2f A\n", peakCurrent[0], peakCurrent[1]);
+    CHECK(peakCurrent[1] < peakCurrent[0] * 0.8);
+
+    // an intake jammed after a second, until a reverse pulse of its stall detector frees it. The pulse goes through
+    // the slew limit, like every other command
+    host::freezeClock();
+    host::SimulatedMotor simulated;
+    simulated.setPort(3);
+    lemlib::Motor motor = pros::Motor(3, pros::v5::MotorGears::blue);
+    motor.setVoltageSlew(LIMITS);
+    lemlib::StallDetector detector({.action = lemlib::StallAction::REVERSE_PULSE});
+    motor.setStallDetector(&detector);
+    bool reversed = false;
+    double largestStep = 0;
+    double previous = 0;
+    for (int ms = 0; ms < 4000; ms += 10) {
+        simulated.setJammed(ms >= 1000 && !reversed);
+        CHECK(motor.move(1) == 0);
+        const double voltage = host::motor(3).voltage / 1000.0;
+        largestStep = std::max(largestStep, std::abs(voltage - previous));
+        previous = voltage;
+        reversed = reversed || voltage < 0;
+        simulated.simulate(10_msec);
+        host::advanceClock(10_msec);
+    }
+    std::printf("reverse pulse: %.2f V per tick at most\n", largestStep);
+    CHECK(reversed && detector.getStallCount() == 1);
+    CHECK(largestStep <= to_volt(LIMITS.decelerating * 10_msec) + 0.01);
+    return host::result();
+}
@@ -0,0 +1,105 @@
+#include "SimulatedMotor.hpp"
+#include "Test.hpp"
+#include "hardware/Motors/Motor.hpp"
+#include "hardware/Motors/StallDetector.hpp"
+#include <vector>
+
+// a simulated intake, driven at full power the whole time, jams for 5 seconds. The stall detector has to report the
+// jam, run its action while the intake stays jammed, and clear the stall once the intake is free again, for each action
+
+/**
+ * @brief what happened to the intake during a run
+ */
+struct Run {
+        std::vector<lemlib::StallEvent> events; /** from the callback */
+        std::vector<lemlib::StallEvent> popped; /** from the queue */
+        double jammedCurrent = 0; /** average current while jammed, in amps */
+        Time braked = 0_sec; /** how long the motor was braked */
+        Time reversed = 0_sec; /** how long the motor was driven backwards */
+        AngularVelocity finalVelocity = 0_radps;
+};
+
+/**
+ * @brief run the intake for 10 seconds, jammed from 2 to 7 seconds
+ *
+ * @param port the port of the intake, which is different for each run so every run starts with a new motor
+ */
+Run run(lemlib::StallSettings settings, std::uint8_t port) {
+    Run result;
+    host::freezeClock();
+    host::SimulatedMotor simulated;
+    simulated.setPort(port);
+    lemlib::Motor motor = pros::Motor(port, pros::v5::MotorGears::blue);
+    motor.setBrakeMode(lemlib::BrakeMode::BRAKE);
+    lemlib::StallDetector detector(settings);
+    detector.setCallback([&](const lemlib::StallEvent& event) { result.events.push_back(event); });
+    motor.setStallDetector(&detector);
+    int jammedSteps = 0;
+    for (int ms = 0; ms < 10000; ms += 10) {
+        simulated.setJammed(ms >= 2000 && ms < 7000);
+        CHECK(motor.move(1) == 0);
+        simulated.simulate(10_msec);
+        host::advanceClock(10_msec);
+        if (host::motor(port).command == host::MotorCommand::BRAKE) result.braked += 10_msec;
+        if (host::motor(port).voltage < 0) result.reversed += 10_msec;
+        if (ms >= 2000 && ms < 7000) {
+            result.jammedCurrent += to_amp(units::abs(simulated.getCurrent()));
+            jammedSteps++;
+        }
+        while (const std::optional<lemlib::StallEvent> event = detector.popEvent()) result.popped.push_back(*event);
+    }
+    result.jammedCurrent /= jammedSteps;
+    result.finalVelocity = simulated.getVelocity();
+    host::unfreezeClock();
+    CHECK(detector.getStallCount() == 1);
+    CHECK(!detector.isStalled());
+    CHECK(!detector.isBraking());
+    return result;
+}
+
+/**
+ * @brief check that the stall was reported soon after the jam, and cleared soon after the intake was free
+ */
+void checkEvents(const Run& result) {
+    CHECK(result.events.size() == 2);
+    CHECK(result.popped.size() == result.events.size());
+    if (result.events.size() != 2 || result.popped.size() != 2) return;
+    CHECK(result.events[0].stalled && !result.events[1].stalled);
+    CHECK(result.events[0].time == result.popped[0].time && result.events[1].time == result.popped[1].time);
+    // the stall time, and the time the velocity estimate takes to drop
+    CHECK(result.events[0].time > 2.25_sec && result.events[0].time < 2.5_sec);
+    // the clear time, and the time the intake takes to speed up, but also the time the action takes to let it move
+    CHECK(result.events[1].time > 7.1_sec && result.events[1].time < 8.5_sec);
+    std::printf("  stalled at %.2f s, cleared at %.2f s, %.2f A while jammed, braked %.2f s, reversed %.2f s\n",
+                to_sec(result.events[0].time), to_sec(result.events[1].time), result.jammedCurrent,
+                to_sec(result.braked), to_sec(result.reversed));
+}
+
+int main() {
+    // only reporting the stall, the intake pushes against the jam the whole time
+    std::printf("NONE\n");
+    const Run none = run({.action = lemlib::StallAction::NONE}, 1);
+    checkEvents(none);
+    CHECK(none.braked == 0_sec && none.reversed == 0_sec);
+    CHECK(none.jammedCurrent > 2.3);
+
+    // braking, which used to keep the intake braked forever, as a braked intake can't show that it moves again
+    std::printf("BRAKE\n");
+    const Run brake = run({.action = lemlib::StallAction::BRAKE, .brakeTime = 1_sec}, 2);
+    checkEvents(brake);
+    // braked for a second at a time, then driven for the stall time to see if the jam cleared
+    CHECK(brake.braked > 3_sec && brake.braked < 4.5_sec);
+    CHECK(brake.reversed == 0_sec);
+    CHECK(brake.jammedCurrent < none.jammedCurrent / 2);
+
+    // reverse pulses, which stop pushing against the jam too
+    std::printf("REVERSE_PULSE\n");
+    const Run pulse = run({.action = lemlib::StallAction::REVERSE_PULSE}, 3);
+    checkEvents(pulse);
+    CHECK(pulse.braked == 0_sec);
+    CHECK(pulse.reversed > 1_sec);
+
+    // the intake runs at full speed once the stall cleared
+    for (const Run& result : {none, brake, pulse}) CHECK(result.finalVelocity > 500_rpm);
+    return host::result();
+}
@@ -0,0 +1,246 @@
+#include "Host.hpp"
+#include "Test.hpp"
+#include "hardware/serial/Framing.hpp"
+#include "hardware/telemetry/Telemetry.hpp"
+#include <array>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+// the signals of a robot, 50 of them at 100 Hz for 10 seconds, are streamed to a file. Decoding the file, here and with
+// tools/telemetry_decode.py, has to give back every sampled value, and the stream has to stay within its bandwidth.
+// Like `make test`, the test has to run from the root of the repository to find the decoder
+
+static constexpr std::size_t SIGNALS = 50;
+static constexpr int FRAMES = 1000;
+static constexpr std::int64_t MISSING = INT64_MIN;
+
+static std::array<double, SIGNALS> values;
+
+/**
+ * @brief a signal of the simulated robot
+ */
+struct Signal {
+        std::string name;
+        double resolution;
+};
+
+/**
+ * @brief the signals of a robot with 16 motors: their angles, velocities, temperatures and currents, and the pose
+ */
+std::vector<Signal> robotSignals() {
+    std::vector<Signal> signals;
+    for (int i = 1; i <= 16; i++) signals.push_back({"motor " + std::to_string(i) + " angle (deg)", 0.1});
+    for (int i = 1; i <= 16; i++) signals.push_back({"motor " + std::to_string(i) + " velocity (rpm)", 1});
+    for (int i = 1; i <= 8; i++) signals.push_back({"motor " + std::to_string(i) + " temperature (C)", 0.1});
+    for (int i = 1; i <= 7; i++) signals.push_back({"motor " + std::to_string(i) + " current (mA)", 1});
+    signals.push_back({"x (m)", 0.001});
+    signals.push_back({"y (m)", 0.001});
+    signals.push_back({"heading (deg)", 0.01});
+    return signals;
+}
+
+/**
+ * @brief set the values of the signals at a frame. The last current can't be measured every 7th frame
+ */
+void simulate(int frame, std::mt19937& random) {
+    std::normal_distribution<double> noise(0, 1);
+    const double t = frame * 0.01;
+    for (int i = 0; i < 16; i++) {
+        const double rpm = 100 + 30 * i; // up to 550 rpm, which is 33 degrees per frame
+        values[i] = rpm * 6 * t;
+        values[16 + i] = rpm + 2 * noise(random);
+    }
+    for (int i = 0; i < 8; i++) values[32 + i] = 30 + t + 0.05 * noise(random);
+    for (int i = 0; i < 7; i++) values[40 + i] = 1200 + 20 * noise(random);
+    if (frame % 7 == 0) values[46] = INFINITY;
+    values[47] = std::cos(t);
+    values[48] = std::sin(t);
+    values[49] = t * 57.3;
+}
+
+/**
+ * @brief what was decoded from a stream
+ */
+struct Decoded {
+        std::vector<std::string> names;
+        std::vector<double> resolutions;
+        std::vector<std::uint64_t> times; /** of each sample, in microseconds */
+        std::vector<std::vector<std::int64_t>> samples; /** the values of each sample, in multiples of the resolution */
+        int badFrames = 0;
+};
+
+std::uint64_t readVarint(const std::uint8_t*& data) {
+    std::uint64_t value = 0;
+    for (int shift = 0;; shift += 7) {
+        const std::uint8_t byte = *data++;
+        value |= std::uint64_t(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return value;
+    }
+}
+
+std::int64_t unzigzag(std::uint64_t value) { return std::int64_t(value >> 1) ^ -std::int64_t(value & 1); }
+
+/**
+ * @brief decode a stream, following the format in the documentation of Telemetry
+ */
+Decoded decode(std::vector<std::uint8_t> stream) {
+    Decoded decoded;
+    std::size_t start = 0;
+    for (std::size_t end = 0; end < stream.size(); end++) {
+        if (stream[end] != 0) continue;
+        std::uint8_t* frame = stream.data() + start;
+        const std::size_t length = lemlib::cobsDecode(frame, end - start);
+        start = end + 1;
+        if (length == SIZE_MAX || length < 3 || lemlib::crc16({frame, length - 2}) !=
+                                                     (frame[length - 2] | frame[length - 1] << 8)) {
+            decoded.badFrames++;
+            continue;
+        }
+        const std::uint8_t* data = frame + 1;
+        if (frame[0] == 0x01) {
+            decoded.names.clear();
+            decoded.resolutions.clear();
+            const std::size_t count = *data++;
+            for (std::size_t i = 0; i < count; i++) {
+                const std::size_t nameLength = *data++;
+                decoded.names.emplace_back(reinterpret_cast<const char*>(data), nameLength);
+                data += nameLength;
+                double resolution;
+                std::memcpy(&resolution, data, sizeof(resolution));
+                decoded.resolutions.push_back(resolution);
+                data += sizeof(resolution);
+            }
+            continue;
+        }
+        const bool keyframe = frame[0] == 0x02;
+        const std::uint16_t sequence = data[0] | data[1] << 8;
+        data += 2;
+        // frames are never dropped here, so the sequence has to count every sample
+        if (sequence != decoded.samples.size()) decoded.badFrames++;
+        const std::uint64_t time = readVarint(data);
+        decoded.times.push_back(keyframe ? time : decoded.times.back() + time);
+        std::vector<std::int64_t> sample;
+        for (std::size_t i = 0; i < decoded.names.size(); i++) {
+            const std::int64_t value = unzigzag(readVarint(data));
+            sample.push_back(keyframe ? value : std::int64_t(std::uint64_t(decoded.samples.back()[i]) + value));
+        }
+        decoded.samples.push_back(sample);
+    }
+    return decoded;
+}
+
+/**
+ * @brief read a whole file
+ */
+std::vector<std::uint8_t> readFile(const std::filesystem::path& path) {
+    std::vector<std::uint8_t> data(std::filesystem::file_size(path));
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    data.resize(std::fread(data.data(), 1, data.size(), file));
+    std::fclose(file);
+    return data;
+}
+
+int main() {
+    host::freezeClock(1_sec);
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "lemlib_telemetry_test.bin";
+    std::FILE* output = std::fopen(path.c_str(), "wb");
+    lemlib::Telemetry telemetry(output);
+    const std::vector<Signal> signals = robotSignals();
+    for (std::size_t i = 0; i < SIGNALS; i++) {
+        CHECK(telemetry.addSignal(signals[i].name.c_str(), [i] { return values[i]; }, signals[i].resolution) ==
+              int(i));
+    }
+
+    // sample every 10ms, writing the stream after every frame to measure its size
+    std::mt19937 random(1);
+    std::vector<std::vector<std::int64_t>> sampled;
+    std::size_t bytes = 0;
+    std::size_t deltaBytes = 0;
+    std::size_t largestDelta = 0;
+    for (int frame = 0; frame < FRAMES; frame++) {
+        simulate(frame, random);
+        CHECK(telemetry.sample() == 0);
+        const std::size_t written = telemetry.flush();
+        bytes += written;
+        // every 100th frame has the schema and a keyframe
+        if (frame % lemlib::Telemetry::KEYFRAME_INTERVAL != 0) {
+            deltaBytes += written;
+            largestDelta = std::max(largestDelta, written);
+        }
+        std::vector<std::int64_t> quantized;
+        for (std::size_t i = 0; i < SIGNALS; i++) {
+            const double scaled = std::round(values[i] / signals[i].resolution);
+            quantized.push_back(std::isfinite(scaled) ? std::int64_t(scaled) : MISSING);
+        }
+        sampled.push_back(quantized);
+        host::advanceClock(10_msec);
+    }
+    std::fclose(output);
+    const int deltas = FRAMES - FRAMES / lemlib::Telemetry::KEYFRAME_INTERVAL;
+    const double rate = bytes / (FRAMES * 0.01) / 1000;
+    std::printf("%zu signals at 100 Hz: %.1f bytes per delta frame, %zu at most, %.1f kB/s\n", SIGNALS,
+                double(deltaBytes) / deltas, largestDelta, rate);
+    // a delta frame has 7 bytes of header, checksum and framing, 2 bytes for the time, and 1 or 2 bytes per signal
+    CHECK(deltaBytes >= deltas * (9 + SIGNALS) && largestDelta <= 9 + 2 * SIGNALS);
+    // the bandwidth in the documentation of Telemetry
+    CHECK(rate > 7 && rate < 13);
+
+    // the stream decodes to every sampled value
+    const Decoded decoded = decode(readFile(path));
+    CHECK(decoded.badFrames == 0);
+    CHECK(decoded.names.size() == SIGNALS);
+    for (std::size_t i = 0; i < std::min(SIGNALS, decoded.names.size()); i++) {
+        CHECK(decoded.names[i] == signals[i].name && decoded.resolutions[i] == signals[i].resolution);
+    }
+    CHECK(decoded.samples == sampled);
+    CHECK(decoded.times.size() == FRAMES && decoded.times.front() == 1000000 && decoded.times.back() == 10990000);
+
+    // and so does the decoder for the computer, if python is installed
+    const std::string csvPath = path.string() + ".csv";
+    const std::string errorPath = path.string() + ".err";
+    const std::string command =
+        "python3 tools/telemetry_decode.py " + path.string() + " > " + csvPath + " 2> " + errorPath;
+    if (std::system("python3 --version > /dev/null 2>&1") != 0) {
+        std::printf("python3 is not installed, skipping tools/telemetry_decode.py\n");
+        return host::result();
+    }
+    CHECK(std::system(command.c_str()) == 0);
+    const std::vector<std::uint8_t> errors = readFile(errorPath);
+    CHECK(std::string(errors.begin(), errors.end()) == "bad frames: 0, missed frames: 0\n");
+    const std::vector<std::uint8_t> csv = readFile(csvPath);
+    std::size_t rows = 0;
+    std::size_t mismatches = 0;
+    std::size_t line = 0;
+    for (std::size_t begin = 0; begin < csv.size(); line++) {
+        std::size_t end = begin;
+        while (end < csv.size() && csv[end] != '\n') end++;
+        const std::string row(csv.begin() + begin, csv.begin() + end);
+        begin = end + 1;
+        // the schema is sent every second, but the header is only written again when the signals change
+        if (line == 0) {
+            CHECK(row.rfind("time (s),\"motor 1 angle (deg)\"", 0) == 0);
+            continue;
+        }
+        const char* cell = row.c_str();
+        char* next;
+        const double time = std::strtod(cell, &next);
+        if (std::abs(time - decoded.times[rows] / 1e6) > 1e-6) mismatches++;
+        for (std::size_t i = 0; i < SIGNALS; i++) {
+            cell = next + 1;
+            const double value = std::strtod(cell, &next);
+            const std::int64_t expected = sampled[rows][i];
+            if (expected == MISSING ? next != cell : std::llround(value / signals[i].resolution) != expected) {
+                mismatches++;
+            }
+        }
+        rows++;
+    }
+    std::printf("tools/telemetry_decode.py: %zu rows, %zu mismatches\n", rows, mismatches);
+    CHECK(rows == FRAMES);
+    CHECK(mismatches == 0);
+    return host::result();
+}
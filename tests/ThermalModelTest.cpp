@@ -0,0 +1,247 @@
+#include "SimulatedMotor.hpp"
+#include "Test.hpp"
+#include "hardware/Motors/Motor.hpp"
+#include "hardware/Motors/ThermalModel.hpp"
+#include <cerrno>
+#include <vector>
+
+// a ThermalModel is fit to logs, first to a log made by a model with known coefficients, which fit() has to recover,
+// and then to a log of a simulated motor whose heat flows through its housing, which the model only approximates. The
+// fitted model then predicts the temperature of the simulated motor through a different workload, while being
+// corrected by the temperature the motor reports. The time until the motor derates has to match when the sensor of the
+// model actually reaches 55 degrees, and Motor::move() has to derate the power as the model heats up
+
+static constexpr double PERIOD = 0.1; /** seconds between samples */
+
+/**
+ * @brief how hard an intake is loaded at a time, which is jammed, pushing game elements, or spinning freely
+ *
+ * @param seconds the time since the log started
+ * @param cycle how long a cycle of the workload lasts, in seconds
+ * @param end when the intake is turned off to cool down, in seconds
+ */
+double load(double seconds, double cycle, double end) {
+    if (seconds >= end) return -1;
+    const double phase = std::fmod(seconds, cycle) / cycle;
+    if (phase < 0.2) return INFINITY;
+    if (phase < 0.6) return 0.25;
+    return 0;
+}
+
+/**
+ * @brief log a simulated intake running a workload
+ *
+ * @param housing where to store the temperature of the housing at each sample, before the sensor rounds it
+ */
+std::vector<lemlib::ThermalSample> record(host::SimulatedMotor& motor, double duration, double cycle, double end,
+                                          std::vector<Temperature>* housing = nullptr) {
+    std::vector<lemlib::ThermalSample> samples;
+    for (double seconds = 0; seconds <= duration; seconds += PERIOD) {
+        samples.push_back({from_sec(seconds), units::abs(motor.getCurrent()), motor.getSensorTemperature()});
+        if (housing != nullptr) housing->push_back(motor.getHousingTemperature());
+        const double torque = load(seconds, cycle, end);
+        motor.setVoltage(torque < 0 ? 0_volt : 12_volt);
+        motor.setJammed(torque == INFINITY);
+        motor.setLoad(torque == INFINITY || torque < 0 ? 0 : torque);
+        motor.simulate(from_sec(PERIOD));
+    }
+    return samples;
+}
+
+/**
+ * @brief how far the temperature a model predicts the sensor to measure is from the temperature of the housing
+ */
+struct PredictionError {
+        double average = 0; /** in kelvin */
+        double worst = 0; /** in kelvin */
+};
+
+/**
+ * @brief run a model through a log, and compare its predictions to the temperature of the housing
+ *
+ * @param corrected whether the model is corrected by the reported temperature, like on the robot
+ */
+PredictionError predict(lemlib::ThermalModel model, const std::vector<lemlib::ThermalSample>& log,
+                        const std::vector<Temperature>& housing, bool corrected) {
+    PredictionError error;
+    for (std::size_t i = 0; i < log.size(); i++) {
+        // the current was measured at the start of the period, and the model assumes it was constant since
+        const Current current = i == 0 ? 0_amp : log[i - 1].current;
+        model.update(current, corrected || i == 0 ? log[i].temperature : units::from_kelvin(INFINITY), log[i].time);
+        const double difference = std::abs(units::to_kelvin(model.getSensorTemperature() - housing[i]));
+        error.average += difference / log.size();
+        error.worst = std::max(error.worst, difference);
+    }
+    return error;
+}
+
+/**
+ * @brief run a model with a constant current until its sensor reaches the derate temperature, or stops heating up
+ *
+ * @return Time how long it took, or INFINITY if the sensor didn't reach it
+ */
+Time simulateDerate(lemlib::ThermalModel model, Current current, Time start) {
+    Temperature previous = model.getSensorTemperature();
+    for (Time time = 0_sec; time < 3000_sec; time += 10_msec) {
+        if (model.getSensorTemperature() >= lemlib::ThermalModel::DERATE_TEMPERATURE) return time;
+        model.update(current, units::from_kelvin(INFINITY), start + time + 10_msec);
+        // once the sensor cools down, it won't heat up again with the same current
+        if (model.getSensorTemperature() < previous) return from_sec(INFINITY);
+        previous = model.getSensorTemperature();
+    }
+    return from_sec(INFINITY);
+}
+
+/**
+ * @brief heat a model from the ambient temperature with a current, until its sensor reaches a temperature
+ *
+ * @return Time the time of the last update
+ */
+Time heat(lemlib::ThermalModel& model, Current current, Temperature sensor) {
+    Time time = 0_sec;
+    model.update(0_amp, units::from_kelvin(INFINITY), time);
+    while (model.getSensorTemperature() < sensor) {
+        time += 10_msec;
+        model.update(current, units::from_kelvin(INFINITY), time);
+    }
+    return time;
+}
+
+int main() {
+    // too few samples
+    const std::vector<lemlib::ThermalSample> one = {{0_sec, 1_amp, 25_celsius}};
+    errno = 0;
+    CHECK(lemlib::ThermalModel::fit(one, 25_celsius).timeConstant == from_sec(INFINITY));
+    CHECK(errno == EDOM);
+
+    // a log made by the model itself, with the temperature reported in steps of 5 degrees
+    const lemlib::ThermalCoefficients truth = {9_kelvin / (1_amp * 1_amp), 200_sec, 45_sec, 22_celsius};
+    lemlib::ThermalModel generator(truth);
+    std::vector<lemlib::ThermalSample> log;
+    generator.update(0_amp, units::from_kelvin(INFINITY), 0_sec);
+    for (int i = 0; i <= 15 * 60 * 10; i++) {
+        const Time time = i * 100_msec;
+        const Current current = time < 600_sec ? from_amp(1.5 + std::sin(to_sec(time) / 20)) : 0_amp;
+        generator.update(current, units::from_kelvin(INFINITY), time);
+        const double sensor = units::to_celsius(generator.getSensorTemperature());
+        log.push_back({time, current, units::from_celsius(std::floor(sensor / 5) * 5)});
+    }
+    const lemlib::ThermalCoefficients fitted = lemlib::ThermalModel::fit(log, 22_celsius);
+    std::printf("fit to the model: heating %.2f K/A^2 (9), time constant %.0f s (200), sensor %.1f s (45)\n",
+                units::to_kelvin(fitted.heating * (1_amp * 1_amp)), to_sec(fitted.timeConstant),
+                to_sec(fitted.sensorTimeConstant));
+    CHECK_NEAR(units::to_kelvin(fitted.heating * (1_amp * 1_amp)), 9, 0.9);
+    CHECK_NEAR(to_sec(fitted.timeConstant), 200, 20);
+    CHECK_NEAR(to_sec(fitted.sensorTimeConstant), 45, 15);
+    CHECK(fitted.ambient == 22_celsius);
+
+    // a log of a simulated intake, jammed and loaded for 10 minutes and then cooling down
+    host::SimulatedMotor training;
+    const std::vector<lemlib::ThermalSample> trainingLog = record(training, 900, 30, 600);
+    const lemlib::ThermalCoefficients coefficients = lemlib::ThermalModel::fit(trainingLog, 25_celsius);
+    std::printf("fit to the simulated motor: heating %.2f K/A^2, time constant %.0f s, sensor %.1f s\n",
+                units::to_kelvin(coefficients.heating * (1_amp * 1_amp)), to_sec(coefficients.timeConstant),
+                to_sec(coefficients.sensorTimeConstant));
+
+    // the same intake through a different workload, predicted by the fitted and the default model
+    host::SimulatedMotor motor;
+    std::vector<Temperature> housing;
+    const std::vector<lemlib::ThermalSample> matchLog = record(motor, 1200, 45, 900, &housing);
+    PredictionError reported;
+    for (std::size_t i = 0; i < matchLog.size(); i++) {
+        const double difference = units::to_kelvin(housing[i] - matchLog[i].temperature);
+        reported.average += difference / matchLog.size();
+        reported.worst = std::max(reported.worst, difference);
+    }
+    const PredictionError fittedError = predict(lemlib::ThermalModel(coefficients), matchLog, housing, true);
+    const PredictionError defaultError = predict(lemlib::ThermalModel(), matchLog, housing, true);
+    const PredictionError uncorrectedError = predict(lemlib::ThermalModel(coefficients), matchLog, housing, false);
+    std::printf("error of the sensor temperature, compared to the housing:\n");
+    std::printf("  reported by the motor     %5.2f K on average, %5.2f K at most\n", reported.average, reported.worst);
+    std::printf("  fitted model              %5.2f K on average, %5.2f K at most\n", fittedError.average,
+                fittedError.worst);
+    std::printf("  default model             %5.2f K on average, %5.2f K at most\n", defaultError.average,
+                defaultError.worst);
+    std::printf("  fitted model, uncorrected %5.2f K on average, %5.2f K at most\n", uncorrectedError.average,
+                uncorrectedError.worst);
+    // the fitted model knows the temperature better than the motor reports it
+    CHECK(fittedError.average < reported.average / 2);
+    CHECK(fittedError.average < defaultError.average);
+    CHECK(fittedError.worst < 3);
+    // and the fit carries over to a different workload, even without corrections
+    CHECK(uncorrectedError.average < 2);
+
+    // the motor derates once the sensor reaches 55 degrees, which is well after the windings do
+    lemlib::ThermalModel heating;
+    heating.update(0_amp, units::from_kelvin(INFINITY), 0_sec);
+    const Time toDerate = heating.getTimeToDerate(2_amp);
+    const Time windingsTo55 = heating.getTimeToTemperature(lemlib::ThermalModel::DERATE_TEMPERATURE, 2_amp);
+    const Time simulatedDerate = simulateDerate(heating, 2_amp, 0_sec);
+    std::printf("at 2 A, derating in %.1f s (simulated %.1f s), the windings reach 55 C in %.1f s\n", to_sec(toDerate),
+                to_sec(simulatedDerate), to_sec(windingsTo55));
+    CHECK_NEAR(to_sec(toDerate), to_sec(simulatedDerate), 0.1);
+    CHECK(toDerate > windingsTo55 + 20_sec);
+    // the same when the sensor is as slow as the windings
+    lemlib::ThermalModel slowSensor({12.8_kelvin / (1_amp * 1_amp), 100_sec, 100_sec, 25_celsius});
+    slowSensor.update(0_amp, units::from_kelvin(INFINITY), 0_sec);
+    CHECK_NEAR(to_sec(slowSensor.getTimeToDerate(2_amp)), to_sec(simulateDerate(slowSensor, 2_amp, 0_sec)), 0.1);
+    // a motor which cools down to below 55 degrees never derates
+    CHECK(heating.getTimeToDerate(1_amp) == from_sec(INFINITY));
+    // a motor whose windings are hot keeps heating the sensor after the current drops, so it can still derate. Cut at
+    // 52 degrees, the windings are already above 55 degrees, but the motor only derates once the sensor catches up
+    for (const double sensor : {45.0, 52.0}) {
+        lemlib::ThermalModel cooling;
+        const Time time = heat(cooling, 2.5_amp, units::from_celsius(sensor));
+        const Time predicted = cooling.getTimeToDerate(1.5_amp);
+        const Time simulated = simulateDerate(cooling, 1.5_amp, time);
+        std::printf("current cut at %.0f C (windings %.1f C): derating in %.1f s (simulated %.1f s)\n", sensor,
+                    units::to_celsius(cooling.getTemperature()), to_sec(predicted), to_sec(simulated));
+        if (sensor == 45) {
+            CHECK(predicted == from_sec(INFINITY) && simulated == from_sec(INFINITY));
+        } else {
+            CHECK(simulated != from_sec(INFINITY));
+            CHECK_NEAR(to_sec(predicted), to_sec(simulated), 0.1);
+            CHECK(cooling.getTimeToTemperature(lemlib::ThermalModel::DERATE_TEMPERATURE, 1.5_amp) == 0_sec);
+        }
+    }
+    lemlib::ThermalModel hot;
+    heat(hot, 2.5_amp, 56_celsius);
+    CHECK(hot.getTimeToDerate(0_amp) == 0_sec);
+
+    // the power is derated in proportion to the predicted temperature, between the start and end temperatures. The
+    // first update uses the middle of the reported step
+    lemlib::ThermalModel derated;
+    CHECK(derated.getDeratingScale() == 1_num);
+    derated.setDerating({45_celsius, 55_celsius, 0.5_num});
+    derated.update(0_amp, 40_celsius, 0_sec);
+    CHECK(derated.getDeratingScale() == 1_num);
+    derated = lemlib::ThermalModel();
+    derated.setDerating({45_celsius, 55_celsius, 0.5_num});
+    derated.update(0_amp, 45_celsius, 0_sec);
+    CHECK_NEAR(to_num(derated.getDeratingScale()), 0.875, 1e-9);
+    derated.update(0_amp, 60_celsius, 1_sec);
+    CHECK(derated.getDeratingScale() == 0.5_num);
+    derated.disableDerating();
+    CHECK(derated.getDeratingScale() == 1_num);
+
+    // Motor::move() updates the model with the temperature the motor reports, and scales its power
+    host::freezeClock();
+    lemlib::Motor intake = pros::Motor(1);
+    lemlib::ThermalModel model;
+    model.setDerating({45_celsius, 55_celsius, 0.5_num});
+    intake.setThermalModel(&model);
+    host::motor(1).temperature = 45;
+    CHECK(intake.move(1) == 0);
+    CHECK(host::motor(1).voltage == 10500);
+    // the motor reports 55 degrees, so the whole model is shifted up to match
+    host::motor(1).temperature = 55;
+    host::advanceClock(10_msec);
+    CHECK(intake.move(1) == 0);
+    CHECK(host::motor(1).voltage == 6000);
+    CHECK(intake.move(-0.5) == 0);
+    CHECK(host::motor(1).voltage == -3000);
+    model.disableDerating();
+    CHECK(intake.move(1) == 0);
+    CHECK(host::motor(1).voltage == 12000);
+    return host::result();
+}
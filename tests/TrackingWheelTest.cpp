@@ -0,0 +1,51 @@
+#include "Host.hpp"
+#include "Test.hpp"
+#include "hardware/encoder/Rotation.hpp"
+#include "hardware/odom/TrackingWheel.hpp"
+#include <array>
+
+// a tracking wheel on a Rotation sensor sampled every 5 milliseconds, read by a 10 millisecond loop, has to measure the
+// latest sample. The tracking wheel leaves the sample buffer alone, so a user reading the samples gets both samples
+// every loop without any being dropped
+
+int main() {
+    host::freezeClock();
+    lemlib::Rotation encoder = pros::Rotation(1);
+    lemlib::TrackingWheel wheel(&encoder, 2_in, 0_in);
+    CHECK(encoder.startSampling(5_msec) == 0);
+    CHECK(host::rotation(1).dataRate == 5);
+    std::array<lemlib::RotationSample, 8> read;
+    std::int32_t position = 0;
+    std::size_t samples = 0;
+    bool ordered = true;
+    // run long enough to fill the sample buffer many times over if the samples weren't read
+    for (int loop = 0; loop < 10 * int(lemlib::Rotation::SAMPLE_CAPACITY); loop++) {
+        for (int sample = 0; sample < 2; sample++) {
+            position += 150;
+            host::rotation(1).position = position;
+            host::advanceClock(5_msec);
+        }
+        const Length distance = wheel.getDistance();
+        CHECK_NEAR(to_in(distance), position / 36000.0 * 2 * M_PI, 1e-9);
+        const std::size_t count = encoder.readSamples(read);
+        samples += count;
+        if (count != 2 || read[0].position != position - 150 || read[1].position != position) ordered = false;
+    }
+    CHECK(ordered);
+    CHECK(samples == 20 * lemlib::Rotation::SAMPLE_CAPACITY);
+    CHECK(encoder.getDroppedSamples() == 0);
+    std::printf("%zu samples read, %u dropped\n", samples, encoder.getDroppedSamples());
+
+    // without a reader the buffer fills up, but the tracking wheel still measures the latest sample
+    for (int loop = 0; loop < 2 * int(lemlib::Rotation::SAMPLE_CAPACITY); loop++) {
+        position += 150;
+        host::rotation(1).position = position;
+        host::advanceClock(5_msec);
+        CHECK_NEAR(to_in(wheel.getDistance()), position / 36000.0 * 2 * M_PI, 1e-9);
+    }
+    CHECK(encoder.getDroppedSamples() > 0);
+
+    encoder.stopSampling();
+    CHECK_NEAR(to_in(wheel.getDistance()), position / 36000.0 * 2 * M_PI, 1e-9);
+    return host::result();
+}
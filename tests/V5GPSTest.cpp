@@ -0,0 +1,189 @@
+#include "Host.hpp"
+#include "Test.hpp"
+#include "hardware/IMU/V5GPS.hpp"
+#include <cerrno>
+#include <cmath>
+#include <vector>
+
+// a robot drives a curve while a GPS trace is played back. Like a trace recorded from a real sensor, each pose in it
+// was measured 40 milliseconds before it can be read, is off by up to a centimeter, and the sensor drops out for a
+// moment. Compensating the latency with odometry has to bring the readings back to where the robot is when read
+
+static constexpr int DURATION = 8000; /** milliseconds */
+static constexpr int LATENCY = 40; /** milliseconds */
+static constexpr std::uint8_t PORT = 1;
+
+/**
+ * @brief an ideal encoder, the odometry error is tested separately
+ */
+class SimulatedEncoder : public lemlib::Encoder {
+    public:
+        int isConnected() override { return 1; }
+
+        Angle getAngle() override { return m_angle; }
+
+        int setAngle(Angle angle) override {
+            m_angle = angle;
+            return 0;
+        }
+
+        void move(Angle angle) { m_angle += angle; }
+    private:
+        Angle m_angle = 0_stRad;
+};
+
+struct TruePose {
+        double x; /** meters */
+        double y; /** meters */
+        double theta; /** standard radians */
+};
+
+/**
+ * @brief a reading of the GPS trace, in the units of the sensor
+ */
+struct TraceReading {
+        double x; /** meters */
+        double y; /** meters */
+        double heading; /** compass degrees */
+        double error; /** meters */
+};
+
+/**
+ * @brief uniform noise from -1 to 1, which is the same every run
+ */
+double noise(std::uint32_t& state) {
+    state = state * 1664525 + 1013904223;
+    return state / 2147483648.0 - 1;
+}
+
+int main() {
+    host::GpsSensor& sensor = host::gps(PORT);
+    lemlib::V5GPS uncompensated = pros::Gps(PORT);
+
+    // the sensor calibrates after it powers on
+    sensor.calibrating = true;
+    errno = 0;
+    CHECK(uncompensated.isCalibrating() && !uncompensated.isCalibrated());
+    CHECK(errno == EAGAIN);
+    CHECK(uncompensated.getReading().error == from_m(INFINITY));
+    CHECK(uncompensated.getRotation() == from_stDeg(INFINITY));
+    sensor.calibrating = false;
+    CHECK(!uncompensated.isCalibrating() && uncompensated.isCalibrated());
+
+    // the rotation is unbounded, and setting it only offsets getRotation()
+    sensor.x = 0.5;
+    sensor.y = -1.2;
+    sensor.heading = 405;
+    sensor.error = 0.01;
+    CHECK_NEAR(to_stDeg(uncompensated.getRotation()), -315, 1e-9);
+    CHECK(uncompensated.setRotation(0_stDeg) == 0);
+    sensor.heading = 495;
+    CHECK_NEAR(to_stDeg(uncompensated.getRotation()), -90, 1e-9);
+    lemlib::GPSReading reading = uncompensated.getReading();
+    CHECK_NEAR(to_m(reading.pose.getX()), 0.5, 1e-9);
+    CHECK_NEAR(to_m(reading.pose.getY()), -1.2, 1e-9);
+    CHECK_NEAR(to_stDeg(reading.pose.getOrientation()), -405, 1e-9);
+    CHECK_NEAR(to_m(reading.error), 0.01, 1e-9);
+
+    // the path of the robot, from 1 meter per second in a straight line to a tight turn, with a point every millisecond
+    const double diameter = 0.07;
+    const double left = 0.15;
+    const double right = -0.15;
+    const double back = -0.08;
+    std::vector<TruePose> path = {{-1, -1, 0.3}};
+    for (int ms = 1; ms <= DURATION; ms++) {
+        const double t = ms / 1000.0;
+        const double forward = 1.0 - 0.4 * std::cos(0.5 * t);
+        const double turn = 1.5 * std::sin(0.4 * t);
+        const TruePose& last = path.back();
+        path.push_back({last.x + forward * std::cos(last.theta) * 0.001,
+                        last.y + forward * std::sin(last.theta) * 0.001, last.theta + turn * 0.001});
+    }
+    // the GPS trace. Each reading shows the robot as it was LATENCY milliseconds before
+    std::vector<TraceReading> trace;
+    std::uint32_t state = 35;
+    for (int ms = 0; ms <= DURATION; ms++) {
+        const TruePose& measured = path[std::max(0, ms - LATENCY)];
+        trace.push_back({measured.x + 0.005 * noise(state), measured.y + 0.005 * noise(state),
+                         to_cDeg(from_stRad(measured.theta)) + 0.2 * noise(state), 0.008});
+    }
+
+    SimulatedEncoder encoder1;
+    SimulatedEncoder encoder2;
+    SimulatedEncoder horizontalEncoder;
+    lemlib::TrackingWheel vertical1(&encoder1, from_m(diameter), from_m(left));
+    lemlib::TrackingWheel vertical2(&encoder2, from_m(diameter), from_m(right));
+    lemlib::TrackingWheel horizontal(&horizontalEncoder, from_m(diameter), from_m(back));
+    lemlib::Odometry odom(&vertical1, &vertical2, &horizontal, nullptr);
+    odom.setPose(units::Pose(from_m(-1), from_m(-1), 0.3_stRad));
+    lemlib::V5GPS compensated(pros::Gps(PORT), &odom, from_msec(LATENCY));
+
+    host::freezeClock();
+    CHECK(odom.update() == 0);
+    CHECK(compensated.startSampling() == 0);
+    CHECK(uncompensated.startSampling() == 0);
+    CHECK(sensor.dataRate == 5);
+    std::array<lemlib::GPSReading, lemlib::V5GPS::SAMPLE_CAPACITY> samples;
+    int count = 0;
+    int uncompensatedCount = 0;
+    double worst = 0;
+    double total = 0;
+    double uncompensatedTotal = 0;
+    Time previous = 0_sec;
+    const auto error = [&](lemlib::GPSReading sample) {
+        const TruePose& truth = path.at(std::lround(to_msec(sample.time)));
+        return std::hypot(to_m(sample.pose.getX()) - truth.x, to_m(sample.pose.getY()) - truth.y);
+    };
+    for (int ms = 1; ms <= DURATION; ms++) {
+        const TruePose& from = path[ms - 1];
+        const TruePose& to = path[ms];
+        // move the tracking wheels by how far the robot moved in its own frame
+        const double cos = std::cos(from.theta);
+        const double sin = std::sin(from.theta);
+        const double forward = (to.x - from.x) * cos + (to.y - from.y) * sin;
+        const double strafe = -(to.x - from.x) * sin + (to.y - from.y) * cos;
+        const double turn = to.theta - from.theta;
+        encoder1.move(from_stRad((forward - left * turn) / (diameter / 2)));
+        encoder2.move(from_stRad((forward - right * turn) / (diameter / 2)));
+        horizontalEncoder.move(from_stRad((strafe + back * turn) / (diameter / 2)));
+        // play the trace back, with the sensor unplugged for 100 milliseconds
+        host::setInstalled(PORT, ms < 3000 || ms >= 3100);
+        sensor.x = trace[ms].x;
+        sensor.y = trace[ms].y;
+        sensor.heading = trace[ms].heading;
+        sensor.error = trace[ms].error;
+        host::advanceClock(1_msec);
+        if (ms % 5 == 0) CHECK(odom.update() == 0);
+        if (ms % 50 != 0) continue;
+        // the samples are read every 50 milliseconds. The first half second is left out, as the trace starts before
+        // the robot moved
+        const std::size_t read = compensated.readSamples(samples);
+        for (std::size_t i = 0; i < read; i++) {
+            CHECK(samples[i].time > previous);
+            previous = samples[i].time;
+            if (samples[i].time < 0.5_sec) continue;
+            count++;
+            total += error(samples[i]);
+            worst = std::max(worst, error(samples[i]));
+        }
+        const std::size_t uncompensatedRead = uncompensated.readSamples(samples);
+        for (std::size_t i = 0; i < uncompensatedRead; i++) {
+            if (samples[i].time < 0.5_sec) continue;
+            uncompensatedCount++;
+            uncompensatedTotal += error(samples[i]);
+        }
+    }
+    compensated.stopSampling();
+    uncompensated.stopSampling();
+    host::unfreezeClock();
+
+    // a sample every 5 milliseconds, except while the sensor was unplugged
+    CHECK(count == (DURATION - 500) / 5 + 1 - 20);
+    CHECK(uncompensatedCount == count);
+    std::printf("%d samples, position error %.1f mm on average and %.1f mm at most, %.1f mm without compensation\n",
+                count, total / count * 1000, worst * 1000, uncompensatedTotal / uncompensatedCount * 1000);
+    CHECK(total / count < 0.008);
+    CHECK(worst < 0.02);
+    CHECK(uncompensatedTotal / uncompensatedCount > 0.03);
+    return host::result();
+}
@@ -0,0 +1,84 @@
+#include "Host.hpp"
+#include "Test.hpp"
+#include "hardware/Motors/MotorGroup.hpp"
+#include <vector>
+
+// the cost of one control tick of an eight motor drivetrain side. In FEEDFORWARD mode the brain calculates the voltage,
+// so each tick reads every motor, updates the controller and sends a voltage to every motor. This is compared to the
+// controller alone, and to INTERNAL mode which only sends a velocity to every motor. The motors are simulated, so the
+// times only show how the modes compare, not how long a tick takes on the brain
+
+static constexpr int MOTORS = 8;
+static constexpr int TICKS = 200000;
+
+static const lemlib::VelocityGains GAINS = {.kS = 0.4_volt,
+                                            .kV = 12_volt / 600_rpm,
+                                            .kA = 0.1_volt / 1_radps2,
+                                            .kP = 2_volt / 100_rpm};
+
+/**
+ * @brief move to the next tick, 10 milliseconds later, with every simulated motor turning at 250 rpm
+ */
+void tick() {
+    host::advanceClock(10_msec);
+    for (std::uint8_t port = 1; port <= MOTORS; port++) host::motor(port).position = host::motor(port).position + 15;
+}
+
+int main() {
+    for (std::uint8_t port = 1; port <= MOTORS; port++) host::motor(port).velocity = 250;
+    host::freezeClock();
+
+    // the controller alone, once for the whole group
+    lemlib::VelocityController controller(GAINS);
+    Voltage controllerVoltage = 0_volt;
+    const double controllerTime = host::benchmark(TICKS, [&](int tick) {
+        controllerVoltage = controller.update(from_stDeg(tick * 15.0), tick * 10_msec, 400_rpm, 2_radps2);
+    });
+    CHECK(controllerVoltage > 0_volt && controllerVoltage < 12_volt);
+
+    // moving the clock and the motors, which is part of the other measurements
+    const double tickTime = host::benchmark(TICKS, [&](int) { tick(); });
+
+    lemlib::MotorGroup group({pros::Motor(1, pros::v5::MotorGears::blue), pros::Motor(-2, pros::v5::MotorGears::blue),
+                              pros::Motor(3, pros::v5::MotorGears::blue), pros::Motor(-4, pros::v5::MotorGears::blue),
+                              pros::Motor(5, pros::v5::MotorGears::blue), pros::Motor(-6, pros::v5::MotorGears::blue),
+                              pros::Motor(7, pros::v5::MotorGears::blue), pros::Motor(-8, pros::v5::MotorGears::blue)},
+                             450_rpm);
+    group.setVelocityGains(GAINS);
+
+    // the whole group in FEEDFORWARD mode
+    group.setVelocityMode(lemlib::VelocityMode::FEEDFORWARD);
+    const std::uint32_t commands = host::motor(1).commands;
+    int failures = 0;
+    const double feedforwardTime = host::benchmark(TICKS, [&](int) {
+        tick();
+        if (group.moveVelocity(300_rpm, 2_radps2) != 0) failures++;
+    });
+    CHECK(failures == 0);
+    CHECK(host::motor(1).commands - commands == TICKS);
+    for (std::uint8_t port = 1; port <= MOTORS; port++) {
+        CHECK(host::motor(port).command == host::MotorCommand::VOLTAGE);
+        // every motor gets the same voltage, with the reversed motors turning the other way
+        CHECK(host::motor(port).voltage == (port % 2 == 1 ? 1 : -1) * host::motor(1).voltage);
+    }
+
+    // the whole group in INTERNAL mode
+    group.setVelocityMode(lemlib::VelocityMode::INTERNAL);
+    const double internalTime = host::benchmark(TICKS, [&](int) {
+        tick();
+        if (group.moveVelocity(300_rpm) != 0) failures++;
+    });
+    CHECK(failures == 0);
+    CHECK(host::motor(1).command == host::MotorCommand::VELOCITY);
+    CHECK(host::motor(1).targetVelocity == 400);
+    host::unfreezeClock();
+
+    std::printf("%d motors, %d ticks\n", MOTORS, TICKS);
+    std::printf("  VelocityController::update   %8.1f ns/tick\n", controllerTime);
+    std::printf("  MotorGroup FEEDFORWARD       %8.1f ns/tick %6.1f ns/motor\n", feedforwardTime - tickTime,
+                (feedforwardTime - tickTime) / MOTORS);
+    std::printf("  MotorGroup INTERNAL          %8.1f ns/tick %6.1f ns/motor\n", internalTime - tickTime,
+                (internalTime - tickTime) / MOTORS);
+    std::printf("  (simulation, left out above) %8.1f ns/tick\n", tickTime);
+    return host::result();
+}
@@ -0,0 +1,38 @@
+#include "Host.hpp"
+#include "pros/adi.hpp"
+#include "pros/error.h"
+#include <array>
+
+// ADI quadrature encoders in the ports of the brain, whose count is set by the test
+
+namespace host {
+std::atomic<std::int32_t>& adiEncoder(std::uint8_t port) {
+    static std::array<std::atomic<std::int32_t>, 9> counts {};
+    if (port >= 'a' && port <= 'h') port -= 'a' - 1;
+    else if (port >= 'A' && port <= 'H') port -= 'A' - 1;
+    return counts.at(port);
+}
+} // namespace host
+
+namespace pros {
+namespace adi {
+Port::Port(std::uint8_t adi_port, adi_port_config_e_t)
+    : _smart_port(INTERNAL_ADI_PORT),
+      _adi_port(adi_port) {}
+
+ext_adi_port_tuple_t Port::get_port() const { return {_smart_port, _adi_port, PROS_ERR_BYTE}; }
+
+Encoder::Encoder(std::uint8_t adi_port_top, std::uint8_t adi_port_bottom, bool)
+    : Port(adi_port_top),
+      _port_pair(adi_port_top, adi_port_bottom) {}
+
+std::int32_t Encoder::reset() const {
+    host::adiEncoder(_adi_port) = 0;
+    return 1;
+}
+
+std::int32_t Encoder::get_value() const { return host::adiEncoder(_adi_port); }
+
+ext_adi_port_tuple_t Encoder::get_port() const { return {_smart_port, _port_pair.first, _port_pair.second}; }
+} // namespace adi
+} // namespace pros
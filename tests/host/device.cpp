@@ -0,0 +1,37 @@
+#include "Host.hpp"
+#include "pros/device.hpp"
+#include <array>
+#include <cerrno>
+
+// V5 smart ports. Each simulated device keeps its own state, and only whether something is plugged in is stored here
+
+namespace {
+std::array<std::atomic<bool>, 22> unplugged {};
+} // namespace
+
+namespace host {
+void setInstalled(std::uint8_t port, bool isInstalled) { unplugged.at(port) = !isInstalled; }
+
+bool checkPort(std::uint8_t port) {
+    if (port < 1 || port > 21) {
+        errno = ENXIO;
+        return false;
+    }
+    if (unplugged[port]) {
+        errno = ENODEV;
+        return false;
+    }
+    return true;
+}
+} // namespace host
+
+namespace pros {
+inline namespace v5 {
+Device::Device(const std::uint8_t port)
+    : _port(port) {}
+
+std::uint8_t Device::get_port() const { return _port; }
+
+bool Device::is_installed() { return host::checkPort(_port); }
+} // namespace v5
+} // namespace pros
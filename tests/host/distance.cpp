@@ -0,0 +1,44 @@
+#include "Host.hpp"
+#include "pros/distance.hpp"
+#include "pros/error.h"
+#include <array>
+#include <cmath>
+
+// V5 Distance sensors, whose state is set by the test
+
+namespace host {
+DistanceSensor& distance(std::uint8_t port) {
+    static std::array<DistanceSensor, 22> sensors;
+    return sensors.at(port);
+}
+} // namespace host
+
+namespace pros {
+inline namespace v5 {
+Distance::Distance(const std::uint8_t port)
+    : Device(port, DeviceType::distance) {}
+
+std::int32_t Distance::get() { return get_distance(); }
+
+std::int32_t Distance::get_distance() {
+    if (!host::checkPort(_port)) return PROS_ERR;
+    host::distance(_port).distanceReads++;
+    return host::distance(_port).distance;
+}
+
+std::int32_t Distance::get_confidence() {
+    if (!host::checkPort(_port)) return PROS_ERR;
+    return host::distance(_port).confidence;
+}
+
+std::int32_t Distance::get_object_size() {
+    if (!host::checkPort(_port)) return PROS_ERR;
+    return host::distance(_port).objectSize;
+}
+
+double Distance::get_object_velocity() {
+    if (!host::checkPort(_port)) return PROS_ERR_F;
+    return host::distance(_port).objectVelocity;
+}
+} // namespace v5
+} // namespace pros
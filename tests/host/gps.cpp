@@ -0,0 +1,111 @@
+#include "Host.hpp"
+#include "pros/error.h"
+#include "pros/gps.hpp"
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cmath>
+
+// V5 GPS sensors, whose state is set by the test. Only the position and heading are simulated, the IMU inside the
+// sensor always reads 0
+
+namespace host {
+GpsSensor& gps(std::uint8_t port) {
+    static std::array<GpsSensor, 22> sensors;
+    return sensors.at(port);
+}
+} // namespace host
+
+namespace {
+/**
+ * check that the sensor can be read, setting errno like PROS if it can't
+ */
+bool ready(std::uint8_t port) {
+    if (!host::checkPort(port)) return false;
+    if (host::gps(port).calibrating) {
+        errno = EAGAIN;
+        return false;
+    }
+    return true;
+}
+} // namespace
+
+namespace pros {
+inline namespace v5 {
+std::int32_t Gps::initialize_full(double xInitial, double yInitial, double headingInitial, double, double) const {
+    return set_position(xInitial, yInitial, headingInitial);
+}
+
+std::int32_t Gps::set_offset(double, double) const { return ready(_port) ? 1 : PROS_ERR; }
+
+gps_position_s_t Gps::get_offset() const {
+    if (!ready(_port)) return {PROS_ERR_F, PROS_ERR_F};
+    return {0, 0};
+}
+
+std::int32_t Gps::set_position(double xInitial, double yInitial, double headingInitial) const {
+    if (!ready(_port)) return PROS_ERR;
+    host::GpsSensor& sensor = host::gps(_port);
+    sensor.x = xInitial;
+    sensor.y = yInitial;
+    sensor.heading = headingInitial;
+    return 1;
+}
+
+std::int32_t Gps::set_data_rate(std::uint32_t rate) const {
+    if (!host::checkPort(_port)) return PROS_ERR;
+    host::gps(_port).dataRate = std::max(5u, rate / 5 * 5);
+    return 1;
+}
+
+double Gps::get_error() const { return ready(_port) ? host::gps(_port).error.load() : PROS_ERR_F; }
+
+gps_status_s_t Gps::get_position_and_orientation() const {
+    if (!ready(_port)) return {PROS_ERR_F, PROS_ERR_F, PROS_ERR_F, PROS_ERR_F, PROS_ERR_F};
+    const host::GpsSensor& sensor = host::gps(_port);
+    return {sensor.x, sensor.y, 0, 0, get_yaw()};
+}
+
+gps_position_s_t Gps::get_position() const { return {get_position_x(), get_position_y()}; }
+
+double Gps::get_position_x() const { return ready(_port) ? host::gps(_port).x.load() : PROS_ERR_F; }
+
+double Gps::get_position_y() const { return ready(_port) ? host::gps(_port).y.load() : PROS_ERR_F; }
+
+gps_orientation_s_t Gps::get_orientation() const { return {get_pitch(), get_roll(), get_yaw()}; }
+
+double Gps::get_pitch() const { return ready(_port) ? 0 : PROS_ERR_F; }
+
+double Gps::get_roll() const { return ready(_port) ? 0 : PROS_ERR_F; }
+
+double Gps::get_yaw() const {
+    if (!ready(_port)) return PROS_ERR_F;
+    // the yaw is from -180 to 180 degrees
+    return std::remainder(host::gps(_port).heading.load(), 360);
+}
+
+double Gps::get_heading() const {
+    if (!ready(_port)) return PROS_ERR_F;
+    const double heading = std::fmod(host::gps(_port).heading.load(), 360);
+    return heading < 0 ? heading + 360 : heading;
+}
+
+double Gps::get_heading_raw() const { return ready(_port) ? host::gps(_port).heading.load() : PROS_ERR_F; }
+
+gps_gyro_s_t Gps::get_gyro_rate() const { return {get_gyro_rate_x(), get_gyro_rate_y(), get_gyro_rate_z()}; }
+
+double Gps::get_gyro_rate_x() const { return ready(_port) ? 0 : PROS_ERR_F; }
+
+double Gps::get_gyro_rate_y() const { return ready(_port) ? 0 : PROS_ERR_F; }
+
+double Gps::get_gyro_rate_z() const { return ready(_port) ? 0 : PROS_ERR_F; }
+
+gps_accel_s_t Gps::get_accel() const { return {get_accel_x(), get_accel_y(), get_accel_z()}; }
+
+double Gps::get_accel_x() const { return ready(_port) ? 0 : PROS_ERR_F; }
+
+double Gps::get_accel_y() const { return ready(_port) ? 0 : PROS_ERR_F; }
+
+double Gps::get_accel_z() const { return ready(_port) ? 0 : PROS_ERR_F; }
+} // namespace v5
+} // namespace pros
@@ -0,0 +1,17 @@
+#include "Host.hpp"
+#include "pros/misc.hpp"
+
+// the battery of the brain, whose voltage is set by the test
+
+namespace host {
+std::atomic<std::int32_t>& battery() {
+    static std::atomic<std::int32_t> voltage = 12800;
+    return voltage;
+}
+} // namespace host
+
+namespace pros {
+namespace battery {
+std::int32_t get_voltage() { return host::battery(); }
+} // namespace battery
+} // namespace pros
@@ -0,0 +1,20 @@
+#include "pros/error.h"
+#include "pros/motor_group.hpp"
+#include <cerrno>
+
+// only the parts of pros::MotorGroup which lemlib::MotorGroup reads, which are stored in the object itself. Tests build
+// lemlib::MotorGroup from pros::Motor objects instead, as a pros::MotorGroup would need every motor function again
+
+namespace pros {
+inline namespace v5 {
+std::int8_t MotorGroup::size() const { return _ports.size(); }
+
+std::int8_t MotorGroup::get_port(const std::uint8_t index) const {
+    if (index >= _ports.size()) {
+        errno = EOVERFLOW;
+        return PROS_ERR_BYTE;
+    }
+    return _ports[index];
+}
+} // namespace v5
+} // namespace pros
@@ -0,0 +1,386 @@
+#include "Host.hpp"
+#include "pros/error.h"
+#include "pros/motors.hpp"
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdlib>
+
+// V5 and EXP smart motors, whose measurements are set by the test. Like PROS, a reversed motor is a pros::Motor with a
+// negative port, which flips the commands and measurements but not the motor itself
+
+namespace host {
+SmartMotor& motor(std::uint8_t port) {
+    static std::array<SmartMotor, 22> motors;
+    return motors.at(port);
+}
+} // namespace host
+
+namespace {
+/**
+ * the simulated motor of a pros::Motor, or nullptr when it can't be read, setting errno like PROS
+ */
+host::SmartMotor* find(std::int8_t port, std::uint8_t index) {
+    if (index != 0) {
+        errno = EOVERFLOW;
+        return nullptr;
+    }
+    if (!host::checkPort(std::abs(port))) return nullptr;
+    return &host::motor(std::abs(port));
+}
+
+double direction(std::int8_t port) { return port < 0 ? -1 : 1; }
+
+/**
+ * how many of the encoder units of a motor are in a degree of its output shaft
+ */
+double unitsPerDegree(const host::SmartMotor& motor) {
+    switch (motor.encoderUnits) {
+        case pros::MotorUnits::degrees: return 1;
+        case pros::MotorUnits::rotations: return 1 / 360.0;
+        case pros::MotorUnits::counts:
+            switch (motor.gearing) {
+                case pros::MotorGears::red: return 1800 / 360.0;
+                case pros::MotorGears::blue: return 300 / 360.0;
+                default: return 900 / 360.0;
+            }
+        default: return 1;
+    }
+}
+
+std::int32_t command(std::int8_t port, host::MotorCommand command, std::int32_t voltage = 0) {
+    host::SmartMotor* motor = find(port, 0);
+    if (motor == nullptr) return PROS_ERR;
+    motor->command = command;
+    motor->voltage = command == host::MotorCommand::VOLTAGE ? std::clamp(voltage, -12000, 12000) : 0;
+    motor->commands++;
+    return 1;
+}
+} // namespace
+
+namespace pros {
+inline namespace v5 {
+Motor::Motor(const std::int8_t port, const MotorGears gearset, const MotorUnits encoder_units)
+    : Device(std::abs(port), DeviceType::motor),
+      _port(port) {
+    if (gearset != MotorGears::invalid) set_gearing(gearset);
+    if (encoder_units != MotorUnits::invalid) set_encoder_units(encoder_units);
+}
+
+std::int32_t Motor::move(std::int32_t voltage) const { return move_voltage(voltage * 12000 / 127); }
+
+std::int32_t Motor::move_absolute(const double position, const std::int32_t velocity) const {
+    host::SmartMotor* motor = find(_port, 0);
+    if (motor == nullptr) return PROS_ERR;
+    motor->targetPosition = direction(_port) * position / unitsPerDegree(*motor);
+    motor->targetVelocity = std::abs(velocity);
+    return command(_port, host::MotorCommand::POSITION);
+}
+
+std::int32_t Motor::move_relative(const double position, const std::int32_t velocity) const {
+    const double current = get_position();
+    if (current == PROS_ERR_F) return PROS_ERR;
+    return move_absolute(current + position, velocity);
+}
+
+std::int32_t Motor::move_velocity(const std::int32_t velocity) const {
+    host::SmartMotor* motor = find(_port, 0);
+    if (motor == nullptr) return PROS_ERR;
+    motor->targetVelocity = direction(_port) * velocity;
+    return command(_port, host::MotorCommand::VELOCITY);
+}
+
+std::int32_t Motor::move_voltage(const std::int32_t voltage) const {
+    return command(_port, host::MotorCommand::VOLTAGE, direction(_port) * voltage);
+}
+
+std::int32_t Motor::brake(void) const { return command(_port, host::MotorCommand::BRAKE); }
+
+std::int32_t Motor::modify_profiled_velocity(const std::int32_t velocity) const {
+    host::SmartMotor* motor = find(_port, 0);
+    if (motor == nullptr) return PROS_ERR;
+    motor->targetVelocity = std::abs(velocity);
+    return 1;
+}
+
+double Motor::get_target_position(const std::uint8_t index) const {
+    const host::SmartMotor* motor = find(_port, index);
+    if (motor == nullptr) return PROS_ERR_F;
+    return direction(_port) * motor->targetPosition * unitsPerDegree(*motor);
+}
+
+std::int32_t Motor::get_target_velocity(const std::uint8_t index) const {
+    const host::SmartMotor* motor = find(_port, index);
+    if (motor == nullptr) return PROS_ERR;
+    return direction(_port) * motor->targetVelocity;
+}
+
+double Motor::get_actual_velocity(const std::uint8_t index) const {
+    const host::SmartMotor* motor = find(_port, index);
+    if (motor == nullptr) return PROS_ERR_F;
+    return direction(_port) * motor->velocity;
+}
+
+std::int32_t Motor::get_current_draw(const std::uint8_t index) const {
+    const host::SmartMotor* motor = find(_port, index);
+    if (motor == nullptr) return PROS_ERR;
+    return std::abs(motor->current);
+}
+
+std::int32_t Motor::get_direction(const std::uint8_t index) const {
+    const host::SmartMotor* motor = find(_port, index);
+    if (motor == nullptr) return PROS_ERR;
+    return direction(_port) * motor->velocity < 0 ? -1 : 1;
+}
+
+double Motor::get_efficiency(const std::uint8_t index) const {
+    // not simulated
+    return find(_port, index) == nullptr ? PROS_ERR_F : 0;
+}
+
+std::uint32_t Motor::get_faults(const std::uint8_t index) const {
+    // not simulated
+    return find(_port, index) == nullptr ? PROS_ERR : 0;
+}
+
+std::uint32_t Motor::get_flags(const std::uint8_t index) const {
+    // not simulated
+    return find(_port, index) == nullptr ? PROS_ERR : 0;
+}
+
+double Motor::get_position(const std::uint8_t index) const {
+    const host::SmartMotor* motor = find(_port, index);
+    if (motor == nullptr) return PROS_ERR_F;
+    return direction(_port) * motor->position * unitsPerDegree(*motor);
+}
+
+double Motor::get_power(const std::uint8_t index) const {
+    const host::SmartMotor* motor = find(_port, index);
+    if (motor == nullptr) return PROS_ERR_F;
+    return std::abs(motor->voltage / 1000.0 * motor->current / 1000.0);
+}
+
+std::int32_t Motor::get_raw_position(std::uint32_t* const timestamp, const std::uint8_t index) const {
+    const host::SmartMotor* motor = find(_port, index);
+    if (motor == nullptr) return PROS_ERR;
+    if (timestamp != nullptr) *timestamp = pros::millis();
+    return direction(_port) * motor->position * unitsPerDegree(*motor);
+}
+
+double Motor::get_temperature(const std::uint8_t index) const {
+    const host::SmartMotor* motor = find(_port, index);
+    if (motor == nullptr) return PROS_ERR_F;
+    return motor->temperature;
+}
+
+double Motor::get_torque(const std::uint8_t index) const {
+    // not simulated
+    return find(_port, index) == nullptr ? PROS_ERR_F : 0;
+}
+
+std::int32_t Motor::get_voltage(const std::uint8_t index) const {
+    const host::SmartMotor* motor = find(_port, index);
+    if (motor == nullptr) return PROS_ERR;
+    return direction(_port) * motor->voltage;
+}
+
+std::int32_t Motor::is_over_current(const std::uint8_t index) const {
+    const host::SmartMotor* motor = find(_port, index);
+    if (motor == nullptr) return PROS_ERR;
+    return std::abs(motor->current) >= motor->currentLimit;
+}
+
+std::int32_t Motor::is_over_temp(const std::uint8_t index) const {
+    const host::SmartMotor* motor = find(_port, index);
+    if (motor == nullptr) return PROS_ERR;
+    return motor->temperature >= 55;
+}
+
+MotorBrake Motor::get_brake_mode(const std::uint8_t index) const {
+    const host::SmartMotor* motor = find(_port, index);
+    if (motor == nullptr) return MotorBrake::invalid;
+    return motor->brakeMode;
+}
+
+std::int32_t Motor::get_current_limit(const std::uint8_t index) const {
+    const host::SmartMotor* motor = find(_port, index);
+    if (motor == nullptr) return PROS_ERR;
+    return motor->currentLimit;
+}
+
+MotorUnits Motor::get_encoder_units(const std::uint8_t index) const {
+    const host::SmartMotor* motor = find(_port, index);
+    if (motor == nullptr) return MotorUnits::invalid;
+    return motor->encoderUnits;
+}
+
+MotorGears Motor::get_gearing(const std::uint8_t index) const {
+    const host::SmartMotor* motor = find(_port, index);
+    if (motor == nullptr) return MotorGears::invalid;
+    return motor->gearing;
+}
+
+std::int32_t Motor::get_voltage_limit(const std::uint8_t index) const {
+    const host::SmartMotor* motor = find(_port, index);
+    if (motor == nullptr) return PROS_ERR;
+    return motor->voltageLimit;
+}
+
+std::int32_t Motor::is_reversed(const std::uint8_t index) const {
+    if (index != 0) {
+        errno = EOVERFLOW;
+        return PROS_ERR;
+    }
+    return _port < 0;
+}
+
+std::int32_t Motor::set_brake_mode(const MotorBrake mode, const std::uint8_t index) const {
+    host::SmartMotor* motor = find(_port, index);
+    if (motor == nullptr) return PROS_ERR;
+    motor->brakeMode = mode;
+    return 1;
+}
+
+std::int32_t Motor::set_brake_mode(const pros::motor_brake_mode_e_t mode, const std::uint8_t index) const {
+    return set_brake_mode(static_cast<MotorBrake>(mode), index);
+}
+
+std::int32_t Motor::set_current_limit(const std::int32_t limit, const std::uint8_t index) const {
+    host::SmartMotor* motor = find(_port, index);
+    if (motor == nullptr) return PROS_ERR;
+    motor->currentLimit = std::clamp(limit, 0, 2500);
+    return 1;
+}
+
+std::int32_t Motor::set_encoder_units(const MotorUnits units, const std::uint8_t index) const {
+    host::SmartMotor* motor = find(_port, index);
+    if (motor == nullptr) return PROS_ERR;
+    motor->encoderUnits = units;
+    return 1;
+}
+
+std::int32_t Motor::set_encoder_units(const pros::motor_encoder_units_e_t units, const std::uint8_t index) const {
+    return set_encoder_units(static_cast<MotorUnits>(units), index);
+}
+
+std::int32_t Motor::set_gearing(const MotorGears gearset, const std::uint8_t index) const {
+    host::SmartMotor* motor = find(_port, index);
+    if (motor == nullptr) return PROS_ERR;
+    // an EXP motor accepts any gearing, but keeps reporting green
+    if (!motor->exp) motor->gearing = gearset;
+    return 1;
+}
+
+std::int32_t Motor::set_gearing(const pros::motor_gearset_e_t gearset, const std::uint8_t index) const {
+    return set_gearing(static_cast<MotorGears>(gearset), index);
+}
+
+std::int32_t Motor::set_reversed(const bool reverse, const std::uint8_t index) {
+    if (index != 0) {
+        errno = EOVERFLOW;
+        return PROS_ERR;
+    }
+    _port = reverse ? -std::abs(_port) : std::abs(_port);
+    return 1;
+}
+
+std::int32_t Motor::set_voltage_limit(const std::int32_t limit, const std::uint8_t index) const {
+    host::SmartMotor* motor = find(_port, index);
+    if (motor == nullptr) return PROS_ERR;
+    motor->voltageLimit = std::clamp(limit, 0, 12000);
+    return 1;
+}
+
+std::int32_t Motor::set_zero_position(const double position, const std::uint8_t index) const {
+    host::SmartMotor* motor = find(_port, index);
+    if (motor == nullptr) return PROS_ERR;
+    // the current position becomes the one given
+    motor->position = direction(_port) * position / unitsPerDegree(*motor);
+    return 1;
+}
+
+std::int32_t Motor::tare_position(const std::uint8_t index) const { return set_zero_position(0, index); }
+
+std::int8_t Motor::size(void) const { return 1; }
+
+std::int8_t Motor::get_port(const std::uint8_t index) const {
+    if (index != 0) {
+        errno = EOVERFLOW;
+        return PROS_ERR_BYTE;
+    }
+    return _port;
+}
+
+std::vector<double> Motor::get_target_position_all(void) const { return {get_target_position()}; }
+
+std::vector<std::int32_t> Motor::get_target_velocity_all(void) const { return {get_target_velocity()}; }
+
+std::vector<double> Motor::get_actual_velocity_all(void) const { return {get_actual_velocity()}; }
+
+std::vector<std::int32_t> Motor::get_current_draw_all(void) const { return {get_current_draw()}; }
+
+std::vector<std::int32_t> Motor::get_direction_all(void) const { return {get_direction()}; }
+
+std::vector<double> Motor::get_efficiency_all(void) const { return {get_efficiency()}; }
+
+std::vector<std::uint32_t> Motor::get_faults_all(void) const { return {get_faults()}; }
+
+std::vector<std::uint32_t> Motor::get_flags_all(void) const { return {get_flags()}; }
+
+std::vector<double> Motor::get_position_all(void) const { return {get_position()}; }
+
+std::vector<double> Motor::get_power_all(void) const { return {get_power()}; }
+
+std::vector<std::int32_t> Motor::get_raw_position_all(std::uint32_t* const timestamp) const {
+    return {get_raw_position(timestamp)};
+}
+
+std::vector<double> Motor::get_temperature_all(void) const { return {get_temperature()}; }
+
+std::vector<double> Motor::get_torque_all(void) const { return {get_torque()}; }
+
+std::vector<std::int32_t> Motor::get_voltage_all(void) const { return {get_voltage()}; }
+
+std::vector<std::int32_t> Motor::is_over_current_all(void) const { return {is_over_current()}; }
+
+std::vector<std::int32_t> Motor::is_over_temp_all(void) const { return {is_over_temp()}; }
+
+std::vector<MotorBrake> Motor::get_brake_mode_all(void) const { return {get_brake_mode()}; }
+
+std::vector<std::int32_t> Motor::get_current_limit_all(void) const { return {get_current_limit()}; }
+
+std::vector<MotorUnits> Motor::get_encoder_units_all(void) const { return {get_encoder_units()}; }
+
+std::vector<MotorGears> Motor::get_gearing_all(void) const { return {get_gearing()}; }
+
+std::vector<std::int8_t> Motor::get_port_all(void) const { return {get_port()}; }
+
+std::vector<std::int32_t> Motor::get_voltage_limit_all(void) const { return {get_voltage_limit()}; }
+
+std::vector<std::int32_t> Motor::is_reversed_all(void) const { return {is_reversed()}; }
+
+std::int32_t Motor::set_brake_mode_all(const MotorBrake mode) const { return set_brake_mode(mode); }
+
+std::int32_t Motor::set_brake_mode_all(const pros::motor_brake_mode_e_t mode) const { return set_brake_mode(mode); }
+
+std::int32_t Motor::set_current_limit_all(const std::int32_t limit) const { return set_current_limit(limit); }
+
+std::int32_t Motor::set_encoder_units_all(const MotorUnits units) const { return set_encoder_units(units); }
+
+std::int32_t Motor::set_encoder_units_all(const pros::motor_encoder_units_e_t units) const {
+    return set_encoder_units(units);
+}
+
+std::int32_t Motor::set_gearing_all(const MotorGears gearset) const { return set_gearing(gearset); }
+
+std::int32_t Motor::set_gearing_all(const pros::motor_gearset_e_t gearset) const { return set_gearing(gearset); }
+
+std::int32_t Motor::set_reversed_all(const bool reverse) { return set_reversed(reverse); }
+
+std::int32_t Motor::set_voltage_limit_all(const std::int32_t limit) const { return set_voltage_limit(limit); }
+
+std::int32_t Motor::set_zero_position_all(const double position) const { return set_zero_position(position); }
+
+std::int32_t Motor::tare_position_all(void) const { return tare_position(); }
+} // namespace v5
+} // namespace pros
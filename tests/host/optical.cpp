@@ -0,0 +1,58 @@
+#include "Host.hpp"
+#include "pros/error.h"
+#include "pros/optical.hpp"
+#include <array>
+
+// V5 Optical sensors, whose state is set by the test. Only the proximity and the hue are simulated, the other readings
+// are always 0
+
+namespace host {
+OpticalSensor& optical(std::uint8_t port) {
+    static std::array<OpticalSensor, 22> sensors;
+    return sensors.at(port);
+}
+} // namespace host
+
+namespace pros {
+inline namespace v5 {
+Optical::Optical(const std::uint8_t port)
+    : Device(port, DeviceType::optical) {}
+
+double Optical::get_hue() {
+    if (!host::checkPort(_port)) return PROS_ERR_F;
+    return host::optical(_port).hue;
+}
+
+double Optical::get_saturation() { return host::checkPort(_port) ? 0 : PROS_ERR_F; }
+
+double Optical::get_brightness() { return host::checkPort(_port) ? 0 : PROS_ERR_F; }
+
+std::int32_t Optical::get_proximity() {
+    if (!host::checkPort(_port)) return PROS_ERR;
+    return host::optical(_port).proximity;
+}
+
+std::int32_t Optical::set_led_pwm(uint8_t value) {
+    if (!host::checkPort(_port)) return PROS_ERR;
+    host::optical(_port).ledPwm = value;
+    return 1;
+}
+
+std::int32_t Optical::get_led_pwm() {
+    if (!host::checkPort(_port)) return PROS_ERR;
+    return host::optical(_port).ledPwm;
+}
+
+pros::c::optical_rgb_s_t Optical::get_rgb() { return {}; }
+
+pros::c::optical_raw_s_t Optical::get_raw() { return {}; }
+
+pros::c::optical_direction_e_t Optical::get_gesture() { return pros::c::NO_GESTURE; }
+
+pros::c::optical_gesture_s_t Optical::get_gesture_raw() { return {}; }
+
+std::int32_t Optical::enable_gesture() { return host::checkPort(_port) ? 1 : PROS_ERR; }
+
+std::int32_t Optical::disable_gesture() { return host::checkPort(_port) ? 1 : PROS_ERR; }
+} // namespace v5
+} // namespace pros
@@ -0,0 +1,60 @@
+#include "Host.hpp"
+#include "pros/error.h"
+#include "pros/rotation.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <array>
+
+// V5 Rotation sensors, whose state is set by the test
+
+namespace host {
+RotationSensor& rotation(std::uint8_t port) {
+    static std::array<RotationSensor, 22> sensors;
+    return sensors.at(port);
+}
+} // namespace host
+
+namespace pros {
+inline namespace v5 {
+Rotation::Rotation(const std::int8_t port)
+    : Device(std::abs(port), DeviceType::rotation) {}
+
+std::int32_t Rotation::reset() { return reset_position(); }
+
+std::int32_t Rotation::set_data_rate(std::uint32_t rate) const {
+    if (!host::checkPort(_port)) return PROS_ERR;
+    host::rotation(_port).dataRate = std::max(5u, rate / 5 * 5);
+    return 1;
+}
+
+std::int32_t Rotation::set_position(std::uint32_t position) const {
+    if (!host::checkPort(_port)) return PROS_ERR;
+    host::rotation(_port).position = position;
+    return 1;
+}
+
+std::int32_t Rotation::reset_position() const { return set_position(0); }
+
+std::int32_t Rotation::get_position() const {
+    if (!host::checkPort(_port)) return PROS_ERR;
+    return host::rotation(_port).position;
+}
+
+std::int32_t Rotation::get_velocity() const {
+    if (!host::checkPort(_port)) return PROS_ERR;
+    return host::rotation(_port).velocity;
+}
+
+std::int32_t Rotation::get_angle() const {
+    if (!host::checkPort(_port)) return PROS_ERR;
+    const std::int32_t angle = host::rotation(_port).position % 36000;
+    return angle < 0 ? angle + 36000 : angle;
+}
+
+std::int32_t Rotation::set_reversed(bool value) const { return 1; }
+
+std::int32_t Rotation::reverse() const { return 1; }
+
+std::int32_t Rotation::get_reversed() const { return 0; }
+} // namespace v5
+} // namespace pros
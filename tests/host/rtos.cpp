@@ -0,0 +1,219 @@
+#include "Host.hpp"
+#include "pros/rtos.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+// PROS tasks and time, on top of std::thread and std::chrono. Tasks are never freed, like tasks which are never
+// removed on the brain.
+//
+// While the clock is frozen, the task which froze it moves it forward when it delays. Other tasks which delay wait for
+// the clock to reach the end of their delay, and the clock only moves once every task which woke up is waiting again,
+// so the tasks take turns like they would on the brain.
+
+namespace {
+struct HostTask {
+        std::thread thread;
+        std::condition_variable wake;
+        std::optional<std::uint64_t> deadline; /** when the task stops waiting for a frozen clock */
+        std::uint32_t notifications = 0;
+        bool waitingForNotification = false;
+        bool counted = false; /** whether the task is counted in busyTasks, which is the case for created tasks */
+        bool busy = false; /** whether the task is counted and isn't waiting for the clock or a notification */
+        bool finished = false;
+        std::mutex joinMutex;
+        bool joined = false;
+};
+
+/** if a task blocks on anything other than a delay or a notification, the clock moves anyway after this long */
+constexpr auto SETTLE_TIMEOUT = std::chrono::seconds(1);
+
+const auto start = std::chrono::steady_clock::now();
+std::mutex mutex;
+std::condition_variable idle;
+std::vector<HostTask*> tasks;
+int busyTasks = 0; /** created tasks which aren't waiting for the clock or a notification */
+std::atomic<bool> frozen = false;
+std::atomic<std::uint64_t> frozenMicros = 0;
+HostTask* owner = nullptr; /** the task which froze the clock */
+HostTask mainTask;
+thread_local HostTask* currentTask = &mainTask;
+
+std::uint64_t realMicros() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+void markBusy(HostTask* task) {
+    if (!task->counted) return;
+    task->busy = true;
+    busyTasks++;
+}
+
+void markIdle(HostTask* task) {
+    if (!task->counted) return;
+    task->busy = false;
+    busyTasks--;
+    idle.notify_all();
+}
+
+/**
+ * wake the tasks whose delay is over, and wait for them to wait again
+ */
+void settle(std::unique_lock<std::mutex>& lock) {
+    for (HostTask* task : tasks) {
+        if (task->deadline && (!frozen || *task->deadline <= frozenMicros)) {
+            task->deadline.reset();
+            markBusy(task);
+            task->wake.notify_all();
+        }
+    }
+    idle.wait_for(lock, SETTLE_TIMEOUT, [] { return busyTasks <= 0; });
+}
+
+void moveClock(std::unique_lock<std::mutex>& lock, std::uint64_t micros) {
+    frozenMicros += micros;
+    settle(lock);
+}
+} // namespace
+
+namespace host {
+void freezeClock(Time time) {
+    std::lock_guard lock(mutex);
+    frozenMicros = std::llround(to_usec(time));
+    frozen = true;
+    owner = currentTask;
+}
+
+void advanceClock(Time time) {
+    std::unique_lock lock(mutex);
+    moveClock(lock, std::llround(to_usec(time)));
+}
+
+void unfreezeClock() {
+    std::unique_lock lock(mutex);
+    frozen = false;
+    owner = nullptr;
+    settle(lock);
+}
+
+Time now() { return from_usec(pros::micros()); }
+} // namespace host
+
+namespace pros {
+namespace c {
+uint32_t millis() { return micros() / 1000; }
+
+uint64_t micros() { return frozen ? frozenMicros.load() : realMicros(); }
+
+void delay(const uint32_t milliseconds) {
+    std::unique_lock lock(mutex);
+    if (!frozen) {
+        lock.unlock();
+        std::this_thread::sleep_for(std::chrono::milliseconds(milliseconds));
+        return;
+    }
+    HostTask* task = currentTask;
+    if (task == owner) return moveClock(lock, milliseconds * 1000ull);
+    task->deadline = frozenMicros + milliseconds * 1000ull;
+    markIdle(task);
+    task->wake.wait(lock, [task] { return !task->deadline; });
+}
+
+void task_delay(const uint32_t milliseconds) { delay(milliseconds); }
+
+void task_delay_until(uint32_t* const prev_time, const uint32_t delta) {
+    *prev_time += delta;
+    const uint32_t now = millis();
+    // like FreeRTOS, a deadline which already passed doesn't delay
+    if (std::int32_t(*prev_time - now) > 0) delay(*prev_time - now);
+}
+} // namespace c
+
+inline namespace rtos {
+Task::Task(task_fn_t function, void* parameters, std::uint32_t, std::uint16_t, const char*) {
+    HostTask* host = new HostTask;
+    task = host;
+    std::unique_lock lock(mutex);
+    tasks.push_back(host);
+    host->counted = true;
+    markBusy(host);
+    host->thread = std::thread([host, function, parameters] {
+        currentTask = host;
+        function(parameters);
+        std::lock_guard lock(mutex);
+        host->finished = true;
+        markIdle(host);
+    });
+    // a new task runs until it waits, before the task which created it continues, like a higher priority task would
+    if (frozen) idle.wait_for(lock, SETTLE_TIMEOUT, [host] { return !host->busy; });
+}
+
+Task::Task(task_fn_t function, void* parameters, const char* name)
+    : Task(function, parameters, TASK_PRIORITY_DEFAULT, TASK_STACK_DEPTH_DEFAULT, name) {}
+
+Task::Task(task_t task)
+    : task(task) {}
+
+Task Task::current() { return Task(static_cast<task_t>(currentTask)); }
+
+std::uint32_t Task::notify() {
+    HostTask* host = static_cast<HostTask*>(task);
+    std::lock_guard lock(mutex);
+    host->notifications++;
+    if (host->waitingForNotification) {
+        host->waitingForNotification = false;
+        markBusy(host);
+        host->wake.notify_all();
+    }
+    return 1;
+}
+
+std::uint32_t Task::notify_take(bool clear_on_exit, std::uint32_t timeout) {
+    HostTask* host = currentTask;
+    std::unique_lock lock(mutex);
+    if (host->notifications == 0 && timeout != 0) {
+        host->waitingForNotification = true;
+        markIdle(host);
+        const auto notified = [host] { return !host->waitingForNotification; };
+        if (timeout == TIMEOUT_MAX) host->wake.wait(lock, notified);
+        else if (!host->wake.wait_for(lock, std::chrono::milliseconds(timeout), notified)) {
+            host->waitingForNotification = false;
+            markBusy(host);
+        }
+    }
+    const std::uint32_t value = host->notifications;
+    if (value != 0) host->notifications = clear_on_exit ? 0 : value - 1;
+    return value;
+}
+
+void Task::join() {
+    HostTask* host = static_cast<HostTask*>(task);
+    std::lock_guard joinLock(host->joinMutex);
+    if (host->joined) return;
+    {
+        // a task which is waiting for a frozen clock can only finish if the clock moves
+        std::unique_lock lock(mutex);
+        while (frozen && currentTask == owner && !host->finished) {
+            std::optional<std::uint64_t> next;
+            for (HostTask* other : tasks) {
+                if (other->deadline && (!next || *other->deadline < *next)) next = other->deadline;
+            }
+            if (!next) break;
+            moveClock(lock, *next > frozenMicros ? *next - frozenMicros : 0);
+        }
+    }
+    host->joined = true;
+    host->thread.join();
+}
+
+void Task::delay(const std::uint32_t milliseconds) { c::delay(milliseconds); }
+
+void Task::delay_until(std::uint32_t* const prev_time, const std::uint32_t delta) {
+    c::task_delay_until(prev_time, delta);
+}
+} // namespace rtos
+} // namespace pros
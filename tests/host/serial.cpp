@@ -0,0 +1,92 @@
+#include "Host.hpp"
+#include "pros/error.h"
+#include "pros/serial.hpp"
+#include <algorithm>
+#include <array>
+
+// smart ports in generic serial mode. Bytes arrive whenever the test sends them, and reads never block, like on the
+// brain
+
+namespace host {
+void SerialLine::send(std::span<const std::uint8_t> bytes) {
+    std::lock_guard lock(mutex);
+    received.insert(received.end(), bytes.begin(), bytes.end());
+}
+
+SerialLine& serial(std::uint8_t port) {
+    static std::array<SerialLine, 22> lines;
+    return lines.at(port);
+}
+} // namespace host
+
+namespace pros {
+Serial::Serial(std::uint8_t port, std::int32_t baudrate)
+    : Device(port, DeviceType::serial) {
+    set_baudrate(baudrate);
+}
+
+Serial::Serial(std::uint8_t port)
+    : Device(port, DeviceType::serial) {}
+
+std::int32_t Serial::set_baudrate(std::int32_t baudrate) const {
+    if (!host::checkPort(_port)) return PROS_ERR;
+    host::SerialLine& line = host::serial(_port);
+    std::lock_guard lock(line.mutex);
+    line.baudrate = baudrate;
+    return 1;
+}
+
+std::int32_t Serial::flush() const {
+    if (!host::checkPort(_port)) return PROS_ERR;
+    host::SerialLine& line = host::serial(_port);
+    std::lock_guard lock(line.mutex);
+    line.received.clear();
+    return 1;
+}
+
+std::int32_t Serial::get_read_avail() const {
+    if (!host::checkPort(_port)) return PROS_ERR;
+    host::SerialLine& line = host::serial(_port);
+    std::lock_guard lock(line.mutex);
+    return line.received.size();
+}
+
+std::int32_t Serial::get_write_free() const {
+    if (!host::checkPort(_port)) return PROS_ERR;
+    // the simulated device reads everything immediately
+    return 1024;
+}
+
+std::int32_t Serial::peek_byte() const {
+    if (!host::checkPort(_port)) return PROS_ERR;
+    host::SerialLine& line = host::serial(_port);
+    std::lock_guard lock(line.mutex);
+    return line.received.empty() ? -1 : line.received.front();
+}
+
+std::int32_t Serial::read_byte() const {
+    std::uint8_t byte;
+    const std::int32_t result = read(&byte, 1);
+    return result == 1 ? byte : (result == 0 ? -1 : result);
+}
+
+std::int32_t Serial::read(std::uint8_t* buffer, std::int32_t length) const {
+    if (!host::checkPort(_port)) return PROS_ERR;
+    host::SerialLine& line = host::serial(_port);
+    std::lock_guard lock(line.mutex);
+    const std::size_t count = std::min<std::size_t>(std::max(length, 0), line.received.size());
+    std::copy_n(line.received.begin(), count, buffer);
+    line.received.erase(line.received.begin(), line.received.begin() + count);
+    return count;
+}
+
+std::int32_t Serial::write_byte(std::uint8_t buffer) const { return write(&buffer, 1); }
+
+std::int32_t Serial::write(std::uint8_t* buffer, std::int32_t length) const {
+    if (!host::checkPort(_port)) return PROS_ERR;
+    host::SerialLine& line = host::serial(_port);
+    std::lock_guard lock(line.mutex);
+    line.sent.insert(line.sent.end(), buffer, buffer + std::max(length, 0));
+    return length;
+}
+} // namespace pros
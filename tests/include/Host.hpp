@@ -0,0 +1,212 @@
+#pragma once
+
+#include "pros/abstract_motor.hpp"
+#include "units/units.hpp"
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <span>
+#include <vector>
+
+/**
+ * @brief Control of the PROS functions which are replaced for tests built on a computer
+ *
+ * By default, pros::millis() and pros::micros() follow the real time since the test started, and pros::delay() sleeps,
+ * so tasks run like they would on the brain. A frozen clock only moves when it is advanced, or when a task delays,
+ * which makes single task tests deterministic and lets them simulate minutes in milliseconds.
+ */
+namespace host {
+/**
+ * @brief Freeze the clock at a time
+ *
+ * pros::delay() and pros::Task::delay_until() advance a frozen clock instead of sleeping
+ *
+ * @param time the time since the test started
+ */
+void freezeClock(Time time = 0_sec);
+/**
+ * @brief Advance a frozen clock
+ *
+ * @param time how far to advance the clock
+ */
+void advanceClock(Time time);
+/**
+ * @brief Make the clock follow the real time again
+ */
+void unfreezeClock();
+/**
+ * @brief Get the time of the clock
+ *
+ * @return Time the time since the test started
+ */
+Time now();
+
+/**
+ * @brief Plug a device into a port, or unplug it
+ *
+ * Every port has a device plugged in by default. Reading an unplugged device fails with ENODEV, like on the brain
+ *
+ * @param port the port, from 1 to 21
+ * @param installed whether a device is plugged into the port
+ */
+void setInstalled(std::uint8_t port, bool installed);
+
+/**
+ * @brief Check that a device is plugged into a port, which the simulated devices do before every call
+ *
+ * @param port the port
+ * @return true a device is plugged in
+ * @return false nothing is plugged in or the port is invalid, setting errno like PROS
+ */
+bool checkPort(std::uint8_t port);
+
+/**
+ * @brief The state of a simulated V5 Rotation sensor, which the test sets
+ */
+struct RotationSensor {
+        std::atomic<std::int32_t> position = 0; /** in centidegrees */
+        std::atomic<std::int32_t> velocity = 0; /** in centidegrees per second */
+        std::atomic<std::uint32_t> dataRate = 10; /** in milliseconds, as set by the code under test */
+};
+
+/**
+ * @brief Get the simulated Rotation sensor in a port
+ *
+ * @param port the port, from 1 to 21
+ * @return RotationSensor& the sensor
+ */
+RotationSensor& rotation(std::uint8_t port);
+
+/**
+ * @brief Get the count of the simulated ADI encoder plugged into a pair of ports of the brain, which the test sets
+ *
+ * @param port the top port of the encoder, from 'A' to 'H'
+ * @return std::atomic<std::int32_t>& the count, in ticks
+ */
+std::atomic<std::int32_t>& adiEncoder(std::uint8_t port);
+
+/**
+ * @brief The state of a simulated V5 Distance sensor, which the test sets
+ */
+struct DistanceSensor {
+        std::atomic<std::int32_t> distance = 9999; /** in millimeters, 9999 when there is no object */
+        std::atomic<std::int32_t> confidence = 0; /** from 0 to 63 */
+        std::atomic<std::int32_t> objectSize = 0; /** from 0 to 400 */
+        std::atomic<double> objectVelocity = 0; /** in meters per second */
+        std::atomic<std::uint32_t> distanceReads = 0; /** how often the code under test read the distance */
+};
+
+/**
+ * @brief Get the simulated Distance sensor in a port
+ *
+ * @param port the port, from 1 to 21
+ * @return DistanceSensor& the sensor
+ */
+DistanceSensor& distance(std::uint8_t port);
+
+/**
+ * @brief The state of a simulated V5 Optical sensor, which the test sets
+ */
+struct OpticalSensor {
+        std::atomic<std::int32_t> proximity = 0; /** from 0 (far) to 255 (close) */
+        std::atomic<double> hue = 0; /** from 0 to 360 degrees */
+        std::atomic<std::int32_t> ledPwm = 0; /** from 0 to 100, as set by the code under test */
+};
+
+/**
+ * @brief Get the simulated Optical sensor in a port
+ *
+ * @param port the port, from 1 to 21
+ * @return OpticalSensor& the sensor
+ */
+OpticalSensor& optical(std::uint8_t port);
+
+/**
+ * @brief The state of a simulated V5 GPS sensor, which the test sets
+ */
+struct GpsSensor {
+        std::atomic<double> x = 0; /** in meters, from the center of the field */
+        std::atomic<double> y = 0; /** in meters, from the center of the field */
+        std::atomic<double> heading = 0; /** unbounded, in compass degrees */
+        std::atomic<double> error = 0; /** RMS error of the position, in meters */
+        std::atomic<bool> calibrating = false; /** whether reads fail with EAGAIN */
+        std::atomic<std::uint32_t> dataRate = 20; /** in milliseconds, as set by the code under test */
+};
+
+/**
+ * @brief Get the simulated GPS sensor in a port
+ *
+ * @param port the port, from 1 to 21
+ * @return GpsSensor& the sensor
+ */
+GpsSensor& gps(std::uint8_t port);
+
+/**
+ * @brief The serial line of a smart port in generic serial mode, which connects the brain to a simulated device
+ */
+struct SerialLine {
+        std::mutex mutex;
+        std::deque<std::uint8_t> received; /** bytes sent by the device, which the brain hasn't read yet */
+        std::vector<std::uint8_t> sent; /** bytes written by the brain */
+        std::int32_t baudrate = 0; /** as set by the code under test */
+
+        /**
+         * @brief Send bytes from the device to the brain
+         *
+         * @param bytes the bytes
+         */
+        void send(std::span<const std::uint8_t> bytes);
+};
+
+/**
+ * @brief Get the serial line of a port
+ *
+ * @param port the port, from 1 to 21
+ * @return SerialLine& the serial line
+ */
+SerialLine& serial(std::uint8_t port);
+/**
+ * @brief How a simulated motor was last commanded
+ */
+enum class MotorCommand { VOLTAGE, VELOCITY, POSITION, BRAKE };
+
+/**
+ * @brief The state of a simulated V5 or EXP smart motor
+ *
+ * The code under test sets the command, and the test sets the measurements, usually from a model of the motor and
+ * what it drives. Everything is in the direction of the motor itself, which pros::Motor flips for reversed motors
+ */
+struct SmartMotor {
+        std::atomic<MotorCommand> command = MotorCommand::BRAKE;
+        std::atomic<std::int32_t> voltage = 0; /** in millivolts, as commanded, 0 unless the command is VOLTAGE */
+        std::atomic<std::int32_t> targetVelocity = 0; /** in rpm, as commanded by move_velocity() */
+        std::atomic<double> targetPosition = 0; /** in degrees, as commanded by move_absolute() or move_relative() */
+        std::atomic<std::uint32_t> commands = 0; /** how often the code under test moved or braked the motor */
+        std::atomic<double> position = 0; /** angle of the output shaft, in degrees */
+        std::atomic<double> velocity = 0; /** velocity of the output shaft, in rpm */
+        std::atomic<std::int32_t> current = 0; /** in milliamps */
+        std::atomic<double> temperature = 25; /** in degrees celsius */
+        std::atomic<bool> exp = false; /** whether it is an EXP motor, whose gearing is always green */
+        std::atomic<pros::MotorGears> gearing = pros::MotorGears::green;
+        std::atomic<pros::MotorBrake> brakeMode = pros::MotorBrake::coast;
+        std::atomic<pros::MotorUnits> encoderUnits = pros::MotorUnits::degrees;
+        std::atomic<std::int32_t> currentLimit = 2500; /** in milliamps */
+        std::atomic<std::int32_t> voltageLimit = 0; /** in millivolts, 0 when there is no limit */
+};
+
+/**
+ * @brief Get the simulated motor in a port
+ *
+ * @param port the port, from 1 to 21
+ * @return SmartMotor& the motor
+ */
+SmartMotor& motor(std::uint8_t port);
+
+/**
+ * @brief Get the voltage of the simulated battery, which the test sets
+ *
+ * @return std::atomic<std::int32_t>& the voltage in millivolts, 12800 unless the test changed it
+ */
+std::atomic<std::int32_t>& battery();
+} // namespace host
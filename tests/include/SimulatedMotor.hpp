@@ -0,0 +1,259 @@
+#pragma once
+
+#include "Host.hpp"
+#include "units/Angle.hpp"
+#include "units/Temperature.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace host {
+/**
+ * @brief The physical constants of a SimulatedMotor, in SI units at the output shaft
+ *
+ * The defaults are a V5 motor with a blue cartridge, which stalls at 2.5 amps and spins freely at about 600 rpm on 12
+ * volts, driving a small flywheel
+ */
+struct MotorConstants {
+        double resistance = 4.8; /** of the windings, in ohms */
+        double backEmf = 0.19; /** in volts per radian per second, which is also the torque in newton meters per amp */
+        double inertia = 0.002; /** of the motor and the mechanism, in kilogram square meters */
+        double friction = 0.02; /** coulomb friction, in newton meters */
+        double damping = 0.0005; /** viscous friction, in newton meters per radian per second */
+        double windingCapacity = 10; /** heat capacity of the windings, in joules per kelvin */
+        double windingResistance = 0.4; /** thermal resistance from the windings to the housing, in kelvin per watt */
+        double housingCapacity = 130; /** heat capacity of the housing, in joules per kelvin */
+        double housingResistance = 2.27; /** thermal resistance from the housing to the air, in kelvin per watt */
+        double ambient = 25; /** temperature of the air, in degrees celsius */
+
+        /**
+         * @brief The voltage to overcome static friction, which is kS of the feedforward gains
+         */
+        double kS() const { return resistance * friction / backEmf; }
+
+        /**
+         * @brief The voltage per radian per second, which is kV of the feedforward gains
+         */
+        double kV() const { return backEmf + resistance * damping / backEmf; }
+
+        /**
+         * @brief The voltage per radian per second squared, which is kA of the feedforward gains
+         */
+        double kA() const { return resistance * inertia / backEmf; }
+};
+
+/**
+ * @brief A simulated DC motor, with the mechanism it drives and how it heats up
+ *
+ * The windings are a resistance and a back EMF, and the mechanism an inertia with coulomb and viscous friction, so the
+ * motor follows voltage = kS * sign(velocity) + kV * velocity + kA * acceleration exactly, with the constants from
+ * MotorConstants. The heat of the current flows from the windings through the housing to the air, and the temperature
+ * sensor measures the housing in steps of 5 degrees, which is more detailed than what ThermalModel predicts.
+ *
+ * By default, the current isn't limited like the firmware of a V5 motor does, so its peaks show how hard the motor is
+ * driven. setCurrentLimited() limits it to the current limit of the smart motor instead.
+ *
+ * The motor can be driven directly with setVoltage(), or by the code under test through a simulated smart motor with
+ * setPort(), in which case simulate() reads the command of the smart motor and sets its measurements.
+ *
+ * @b Example:
+ * @code {.cpp}
+ * host::SimulatedMotor motor;
+ * motor.setPort(1);
+ * lemlib::Motor intake = pros::Motor(1);
+ * intake.move(1);
+ * motor.simulate(100_msec);
+ * std::printf("%f rpm\n", to_rpm(intake.getVelocity()));
+ * @endcode
+ */
+class SimulatedMotor {
+    public:
+        static constexpr double STEP = 1e-4; /** the time step of the simulation, in seconds */
+
+        /**
+         * @brief Construct a new SimulatedMotor, stopped at the ambient temperature
+         *
+         * @param constants the constants of the motor and mechanism
+         */
+        SimulatedMotor(MotorConstants constants = {})
+            : m_constants(constants),
+              m_winding(constants.ambient),
+              m_housing(constants.ambient) {}
+
+        /**
+         * @brief Drive the motor with a voltage, until the next call
+         *
+         * @param voltage the voltage, which is clamped to 12 volts either way
+         */
+        void setVoltage(Voltage voltage) { m_voltage = std::clamp(to_volt(voltage), -12.0, 12.0); }
+
+        /**
+         * @brief Let the code under test drive the motor through a simulated smart motor
+         *
+         * @param port the port of the smart motor, or 0 to drive the motor with setVoltage()
+         */
+        void setPort(std::uint8_t port) { m_port = port; }
+
+        /**
+         * @brief Limit the current to the current limit of the smart motor, by lowering the voltage like the firmware
+         *
+         * @param limited whether the current is limited. Only applies while the motor is driven through a port
+         */
+        void setCurrentLimited(bool limited) { m_currentLimited = limited; }
+
+        /**
+         * @brief Apply a torque to the mechanism, like a game element being pushed
+         *
+         * @param torque the torque against the positive direction, in newton meters
+         */
+        void setLoad(double torque) { m_load = torque; }
+
+        /**
+         * @brief Jam the mechanism, so it can't move at all until it is released
+         *
+         * @param jammed whether the mechanism is jammed
+         */
+        void setJammed(bool jammed) {
+            m_jammed = jammed;
+            if (jammed) m_velocity = 0;
+        }
+
+        /**
+         * @brief Advance the simulation
+         *
+         * @param duration how long to simulate
+         */
+        void simulate(Time duration) {
+            const int steps = std::max<int>(1, std::lround(to_sec(duration) / STEP));
+            const double dt = to_sec(duration) / steps;
+            for (int i = 0; i < steps; i++) step(dt);
+            if (m_port == 0) return;
+            // the smart motor reports the measurements at the end of the step
+            SmartMotor& motor = host::motor(m_port);
+            motor.position = m_angle * 180 / M_PI;
+            motor.velocity = m_velocity * 30 / M_PI;
+            motor.current = std::lround(m_current * 1000);
+            motor.temperature = units::to_celsius(getSensorTemperature());
+        }
+
+        Angle getAngle() const { return from_stRad(m_angle); }
+
+        AngularVelocity getVelocity() const { return from_radps(m_velocity); }
+
+        /**
+         * @brief Get the current through the windings, which is negative when it brakes a positive velocity
+         */
+        Current getCurrent() const { return from_amp(m_current); }
+
+        /**
+         * @brief Get the largest current since the last call, in either direction
+         */
+        Current takePeakCurrent() {
+            const double peak = m_peakCurrent;
+            m_peakCurrent = 0;
+            return from_amp(peak);
+        }
+
+        /**
+         * @brief Get the voltage applied to the windings in the last step
+         */
+        Voltage getVoltage() const { return from_volt(m_applied); }
+
+        Temperature getWindingTemperature() const { return units::from_celsius(m_winding); }
+
+        /**
+         * @brief Get the temperature of the housing, which the temperature sensor measures
+         */
+        Temperature getHousingTemperature() const { return units::from_celsius(m_housing); }
+
+        /**
+         * @brief Get the temperature the motor reports, which is the housing temperature rounded down to 5 degrees
+         */
+        Temperature getSensorTemperature() const { return units::from_celsius(std::floor(m_housing / 5) * 5); }
+
+        const MotorConstants& getConstants() const { return m_constants; }
+    private:
+        /**
+         * @brief the voltage the smart motor applies for its command, or NAN when the windings are disconnected
+         */
+        double commandedVoltage() const {
+            if (m_port == 0) return m_voltage;
+            const SmartMotor& motor = host::motor(m_port);
+            switch (motor.command.load()) {
+                case MotorCommand::VOLTAGE: return motor.voltage / 1000.0;
+                case MotorCommand::VELOCITY: {
+                    // the velocity controller of the motor, roughly
+                    const double target = motor.targetVelocity * M_PI / 30;
+                    return std::clamp(m_constants.kV() * target + 2 * (target - m_velocity), -12.0, 12.0);
+                }
+                case MotorCommand::POSITION: {
+                    const double error = motor.targetPosition * M_PI / 180 - m_angle;
+                    return std::clamp(10 * error - 0.5 * m_velocity, -12.0, 12.0);
+                }
+                case MotorCommand::BRAKE:
+                    switch (motor.brakeMode.load()) {
+                        case pros::MotorBrake::brake: return 0;
+                        // hold the angle the motor was braked at
+                        case pros::MotorBrake::hold:
+                            return std::clamp(10 * (m_holdAngle - m_angle) - 0.5 * m_velocity, -12.0, 12.0);
+                        default: return NAN;
+                    }
+            }
+            return NAN;
+        }
+
+        void step(double dt) {
+            if (m_port != 0) {
+                const bool braking = host::motor(m_port).command == MotorCommand::BRAKE;
+                if (braking && !m_braking) m_holdAngle = m_angle;
+                m_braking = braking;
+            }
+            const double voltage = commandedVoltage();
+            // a coasting motor has no current, and is driven by its back EMF instead
+            m_applied = std::isnan(voltage) ? m_constants.backEmf * m_velocity : voltage;
+            m_current = std::isnan(voltage) ? 0 : (voltage - m_constants.backEmf * m_velocity) / m_constants.resistance;
+            if (m_currentLimited && m_port != 0) {
+                const double limit = host::motor(m_port).currentLimit / 1000.0;
+                if (std::abs(m_current) > limit) {
+                    m_current = std::clamp(m_current, -limit, limit);
+                    m_applied = m_constants.backEmf * m_velocity + m_current * m_constants.resistance;
+                }
+            }
+            m_peakCurrent = std::max(m_peakCurrent, std::abs(m_current));
+            const double torque = m_constants.backEmf * m_current - m_load - m_constants.damping * m_velocity;
+            if (m_jammed) {
+                m_velocity = 0;
+            } else if (m_velocity == 0 && std::abs(torque) <= m_constants.friction) {
+                // static friction holds the mechanism still
+            } else {
+                const double direction = m_velocity != 0 ? (m_velocity > 0 ? 1 : -1) : (torque > 0 ? 1 : -1);
+                const double acceleration = (torque - direction * m_constants.friction) / m_constants.inertia;
+                const double velocity = m_velocity + acceleration * dt;
+                // friction stops the mechanism instead of reversing it
+                m_velocity = velocity * direction < 0 && std::abs(torque) <= m_constants.friction ? 0 : velocity;
+            }
+            m_angle += m_velocity * dt;
+            // the heat flows from the windings to the housing, and from the housing to the air
+            const double toHousing = (m_winding - m_housing) / m_constants.windingResistance;
+            const double toAir = (m_housing - m_constants.ambient) / m_constants.housingResistance;
+            const double heat = m_current * m_current * m_constants.resistance;
+            m_winding += (heat - toHousing) / m_constants.windingCapacity * dt;
+            m_housing += (toHousing - toAir) / m_constants.housingCapacity * dt;
+        }
+
+        MotorConstants m_constants;
+        std::uint8_t m_port = 0;
+        double m_voltage = 0; /** in volts, as set by setVoltage() */
+        double m_applied = 0; /** in volts */
+        double m_load = 0; /** in newton meters */
+        bool m_jammed = false;
+        bool m_currentLimited = false;
+        double m_angle = 0; /** in radians */
+        bool m_braking = false; /** whether the smart motor was braking in the last step */
+        double m_holdAngle = 0; /** the angle the smart motor was braked at, in radians */
+        double m_velocity = 0; /** in radians per second */
+        double m_current = 0; /** in amps */
+        double m_peakCurrent = 0; /** in amps */
+        double m_winding; /** in degrees celsius */
+        double m_housing; /** in degrees celsius */
+};
+} // namespace host
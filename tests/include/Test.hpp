@@ -0,0 +1,57 @@
+#pragma once
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+
+/**
+ * @brief Minimal checks for the host tests
+ *
+ * A failed check prints where it failed and the test keeps running, so one run reports every failure. main() returns
+ * host::result(), which makes `make test` stop at the first test with a failure.
+ */
+namespace host {
+inline int failures = 0;
+
+inline bool check(bool condition, const char* expression, const char* file, int line) {
+    if (!condition) {
+        std::printf("%s:%d: check failed: %s\n", file, line, expression);
+        failures++;
+    }
+    return condition;
+}
+
+inline bool checkNear(double actual, double expected, double tolerance, const char* expression, const char* file,
+                      int line) {
+    const bool condition = std::abs(actual - expected) <= tolerance;
+    if (!condition) {
+        std::printf("%s:%d: check failed: %s, got %g, expected %g +- %g\n", file, line, expression, actual, expected,
+                    tolerance);
+        failures++;
+    }
+    return condition;
+}
+
+inline int result() {
+    if (failures != 0) std::printf("%d check(s) failed\n", failures);
+    return failures == 0 ? 0 : 1;
+}
+
+/**
+ * @brief Measure how long a function takes on average
+ *
+ * @param iterations how many times to call the function
+ * @param function the function, which is passed the index of the iteration
+ * @return double the average time of a call, in nanoseconds
+ */
+template <typename F> double benchmark(int iterations, F&& function) {
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) function(i);
+    const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / iterations;
+}
+} // namespace host
+
+#define CHECK(condition) host::check(condition, #condition, __FILE__, __LINE__)
+#define CHECK_NEAR(actual, expected, tolerance)                                                                        \
+    host::checkNear(actual, expected, tolerance, #actual " == " #expected, __FILE__, __LINE__)
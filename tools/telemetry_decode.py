@@ -0,0 +1,187 @@
+#!/usr/bin/env python3
+"""Decode the binary stream written by lemlib::Telemetry into CSV.
+
+The stream can be read from a file, a serial port, or stdin:
+
+    python3 tools/telemetry_decode.py /dev/ttyACM1 --pros > log.csv
+
+Each row has the time in seconds, then the value of each signal. A new header
+row is written whenever the signals change. Only the standard library is used.
+"""
+
+import argparse
+import math
+import struct
+import sys
+
+SCHEMA = 0x01
+KEYFRAME = 0x02
+DELTA = 0x03
+MISSING = -(1 << 63)
+
+
+def crc16(data):
+    """CRC-16/CCITT-FALSE, the same checksum as lemlib::crc16"""
+    crc = 0xFFFF
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else crc << 1
+            crc &= 0xFFFF
+    return crc
+
+
+def cobs_decode(data):
+    """Decode a COBS frame without its zero byte, or return None if it is invalid"""
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        if code == 0 or i + code > len(data):
+            return None
+        out += data[i + 1:i + code]
+        i += code
+        # blocks of 254 bytes aren't followed by a zero, and neither is the last block
+        if code != 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def split_frames(chunks):
+    """Split a stream of byte chunks into frames at each zero byte"""
+    pending = bytearray()
+    for chunk in chunks:
+        pending += chunk
+        *frames, rest = pending.split(b"\0")
+        pending = bytearray(rest)
+        yield from frames
+
+
+def pros_stdout(chunks):
+    """Unwrap the stdout stream from the COBS packets PROS sends when stream multiplexing is enabled"""
+    for packet in split_frames(chunks):
+        decoded = cobs_decode(packet)
+        if decoded is not None and decoded[:4] == b"sout":
+            yield decoded[4:]
+
+
+def read_varint(data, offset):
+    value = 0
+    shift = 0
+    while True:
+        byte = data[offset]
+        offset += 1
+        value |= (byte & 0x7F) << shift
+        shift += 7
+        if not byte & 0x80:
+            return value, offset
+
+
+def unzigzag(value):
+    return (value >> 1) ^ -(value & 1)
+
+
+def wrap(value):
+    """Wrap an integer to a signed 64 bit integer, like the robot does"""
+    value &= (1 << 64) - 1
+    return value - (1 << 64) if value >= 1 << 63 else value
+
+
+class Decoder:
+    def __init__(self, out):
+        self.out = out
+        self.names = None
+        self.resolutions = None
+        self.decimals = None
+        self.values = None  # None until a keyframe arrives
+        self.time = 0
+        self.sequence = 0
+        self.bad_frames = 0
+        self.missed_frames = 0
+
+    def frame(self, encoded):
+        # zero bytes between frames can be sent to resynchronize
+        if not encoded:
+            return
+        data = cobs_decode(encoded)
+        if data is None or len(data) < 3 or crc16(data[:-2]) != struct.unpack_from("<H", data, len(data) - 2)[0]:
+            self.bad_frames += 1
+            return
+        data = data[:-2]
+        try:
+            if data[0] == SCHEMA:
+                self.schema(data)
+            elif data[0] in (KEYFRAME, DELTA):
+                self.sample(data)
+            else:
+                self.bad_frames += 1
+        except IndexError:
+            self.bad_frames += 1
+
+    def schema(self, data):
+        names = []
+        resolutions = []
+        offset = 2
+        for _ in range(data[1]):
+            length = data[offset]
+            names.append(data[offset + 1:offset + 1 + length].decode(errors="replace"))
+            offset += 1 + length
+            resolutions.append(struct.unpack_from("<d", data, offset)[0])
+            offset += 8
+        if names != self.names or resolutions != self.resolutions:
+            self.names = names
+            self.resolutions = resolutions
+            # print enough decimal places to show the resolution, without rounding errors
+            self.decimals = [max(0, math.ceil(-math.log10(resolution) - 1e-9)) for resolution in resolutions]
+            self.values = None
+            self.out.write(",".join(["time (s)"] + ['"' + name.replace('"', '""') + '"' for name in names]) + "\n")
+
+    def sample(self, data):
+        sequence = struct.unpack_from("<H", data, 1)[0]
+        if data[0] == DELTA:
+            # deltas can't be applied without the frame before them, so wait for the next keyframe
+            if self.values is None:
+                return
+            if sequence != (self.sequence + 1) & 0xFFFF:
+                self.missed_frames += (sequence - self.sequence - 1) & 0xFFFF
+                self.values = None
+                return
+        elif self.names is None:
+            return
+        elapsed, offset = read_varint(data, 3)
+        values = []
+        for i in range(len(self.names)):
+            value, offset = read_varint(data, offset)
+            value = unzigzag(value)
+            values.append(value if data[0] == KEYFRAME else wrap(self.values[i] + value))
+        self.time = elapsed if data[0] == KEYFRAME else self.time + elapsed
+        self.values = values
+        self.sequence = sequence
+        row = ["%.6f" % (self.time / 1e6)]
+        for value, resolution, decimals in zip(values, self.resolutions, self.decimals):
+            row.append("" if value == MISSING else "%.*f" % (decimals, value * resolution))
+        self.out.write(",".join(row) + "\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("input", nargs="?", default="-", help="file or serial port to read, or - for stdin")
+    parser.add_argument("--pros", action="store_true", help="the stream is wrapped in PROS stream multiplexing")
+    args = parser.parse_args()
+
+    source = sys.stdin.buffer if args.input == "-" else open(args.input, "rb", buffering=0)
+    chunks = iter(lambda: source.read(4096), b"")
+    if args.pros:
+        chunks = pros_stdout(chunks)
+    decoder = Decoder(sys.stdout)
+    try:
+        for encoded in split_frames(chunks):
+            decoder.frame(encoded)
+            sys.stdout.flush()
+    except KeyboardInterrupt:
+        pass
+    print("bad frames: %d, missed frames: %d" % (decoder.bad_frames, decoder.missed_frames), file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()